@@ -0,0 +1,61 @@
+#ifndef BOARD_H // защита от повторного включения заголовка: если BOARD_H не определён
+#define BOARD_H // определяет макрос BOARD_H чтобы предотвратить повторное включение
+
+#include <array> // подключает std::array для счётчиков поля фиксированного размера
+#include <vector> // подключает std::vector для счётчиков поля размера, заданного при создании сессии
+
+#include "brick_game_single.h" // подключает WINDOW_HEIGHT и WINDOW_WIDTH стандартного поля
+
+#define BOARD_MIN_SIZE 5 // наименьшая сторона поля: в нём должна помещаться матрица поворота фигуры Hero
+
+namespace s21 { // начало пространства имён s21
+
+/**
+ * @brief Поле с размерами, известными при компиляции.
+ *
+ * height() и width() — constexpr, поэтому циклы движка по полю разворачиваются
+ * и сворачиваются компилятором так же, как с макросами WINDOW_HEIGHT/WINDOW_WIDTH.
+ */
+template <int Height, int Width> // высота и ширина поля
+struct FixedBoard { // политика поля фиксированного размера
+  static_assert(Height >= BOARD_MIN_SIZE && Width >= BOARD_MIN_SIZE, "board is too small"); // поле вмещает поворот
+
+  using Fills = std::array<int, Height>; // тип счётчиков строк
+  using Heights = std::array<int, Width>; // тип высот столбцов
+
+  constexpr int height() const { return Height; } // высота поля
+  constexpr int width() const { return Width; } // ширина поля
+
+  void prepare(Fills& fills, Heights& heights) const { // обнуление счётчиков (память уже внутри объекта)
+    fills.fill(0); // строки пусты
+    heights.fill(0); // столбцы пусты
+  } // конец метода prepare
+}; // конец объявления FixedBoard
+
+using StandardBoard = FixedBoard<WINDOW_HEIGHT, WINDOW_WIDTH>; // стандартное поле 20x10, с которым работают фронтенды
+
+/**
+ * @brief Поле с размерами, выбираемыми при создании сессии.
+ *
+ * Используется для больших нестандартных полей (например, колодца шириной 40):
+ * размеры читаются из полей структуры, счётчики выделяются один раз в prepare().
+ */
+struct RuntimeBoard { // политика поля произвольного размера
+  int rows = WINDOW_HEIGHT; // высота поля
+  int cols = WINDOW_WIDTH; // ширина поля
+
+  using Fills = std::vector<int>; // тип счётчиков строк
+  using Heights = std::vector<int>; // тип высот столбцов
+
+  int height() const { return rows; } // высота поля
+  int width() const { return cols; } // ширина поля
+
+  void prepare(Fills& fills, Heights& heights) const { // выделение и обнуление счётчиков под размеры поля
+    fills.assign(rows, 0); // строки пусты
+    heights.assign(cols, 0); // столбцы пусты
+  } // конец метода prepare
+}; // конец объявления RuntimeBoard
+
+}  // namespace s21 // конец пространства имён s21
+
+#endif  // BOARD_H // конец защиты от повторного включения заголовка
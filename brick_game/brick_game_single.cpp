@@ -1,6 +1,13 @@
 #include "brick_game_single.h" // подключает общий заголовок с определением Game, GameInfo_t и константами окна
+
+#include <algorithm> // подключает std::swap_ranges для поля из снимка
+
 #include "tetris/tetris.h" // подключает заголовок класса Tetris
 #include "snake/snake.h" // подключает заголовок класса Snake
+#include "snake/snake_arena.h" // подключает заголовок змейки на большой арене
+#include "slab.h" // подключает распределитель блоков сессий
+#include "snapshot.h" // подключает формат снимка состояния
+#include "zobrist.h" // подключает ключи хэшей состояния
 
 namespace s21 { // начало пространства имён s21
 
@@ -17,66 +24,313 @@ void GameFabric::set_game(GameName name) { // метод установки те
 
 Game* GameFabric::get_game() { return current_game; } // возвращает указатель на текущую выбранную игру
 
+/**
+ * @brief Создаёт тетрис с набором фигур Pieces.
+ *
+ * Для стандартного размера 20x10 размеры поля — константы времени компиляции,
+ * для остальных — выбираются при создании сессии.
+ */
+template <class Pieces>
+Game* GameFabric::create_tetris(int height, int width) { // выбор политики поля для набора Pieces
+  Game* game = nullptr; // создаваемая сессия
+  if (height == WINDOW_HEIGHT && width == WINDOW_WIDTH) { // стандартный размер поля
+    game = new TetrisGame<StandardBoard, Pieces>(); // размеры поля — константы времени компиляции
+  } else { // нестандартный размер поля
+    game = new TetrisGame<RuntimeBoard, Pieces>(RuntimeBoard{height, width}); // размеры поля выбраны при создании
+  } // конец выбора политики поля
+  return game; // возвращаем созданную сессию
+} // конец метода create_tetris
+
+/**
+ * @brief Создаёт отдельную сессию игры с полем заданного размера.
+ *
+ * Для стандартного размера 20x10 создаётся движок с размерами поля времени компиляции,
+ * для остальных размеров — движок с размерами, выбранными при создании: RuntimeTetris
+ * или SnakeArena (арена не меньше окна вывода, до SNAKE_ARENA_MAX_CELLS клеток).
+ * Набор фигур pieces учитывается только тетрисом.
+ * Сессия не становится текущей игрой API и удаляется через destroy_game.
+ */
+Game* GameFabric::create_game(GameName name, int height, int width, PieceSet pieces) { // создание сессии с полем height x width
+  Game* game = nullptr; // создаваемая сессия
+  bool standard = (height == WINDOW_HEIGHT && width == WINDOW_WIDTH); // стандартный размер поля
+  if (height < BOARD_MIN_SIZE || width < BOARD_MIN_SIZE) { // поле не вмещает поворот фигуры
+    throw std::invalid_argument("Error: Board is too small"); // выбрасываем исключение о некорректном размере
+  } else if (name == GameName::Tetris && pieces == PieceSet::Pentomino) { // тетрис из пентамино
+    game = create_tetris<PentominoPieces>(height, width); // пять блоков в фигуре
+  } else if (name == GameName::Tetris && pieces == PieceSet::Training) { // тренировочный тетрис
+    game = create_tetris<TrainingPieces>(height, width); // только Hero и Smashboy
+  } else if (name == GameName::Tetris) { // стандартный набор фигур
+    game = create_tetris<StandardPieces>(height, width); // семь тетрамино
+  } else if (name == GameName::Snake && standard) { // стандартная змейка
+    game = new Snake(); // отдельный экземпляр змейки
+  } else if (name == GameName::Snake) { // змейка на большой арене
+    game = new SnakeArena(height, width); // проверяет размер арены и выбрасывает invalid_argument
+  } else { // неизвестная игра
+    throw std::invalid_argument("Error: There is no game with this name and board size"); // выбрасываем исключение
+  } // конец выбора движка
+  return game; // возвращаем созданную сессию
+} // конец метода create_game
+
+/**
+ * @brief Удаляет сессию, созданную create_game.
+ *
+ * Незавершённая партия сначала проходит состояние GameOver, чтобы движок
+ * освободил память, выделенную во время игры (фигуры тетриса).
+ */
+void GameFabric::destroy_game(Game* game) { // удаление сессии
+  if (game) { // сессия существует
+    game->flight_armed = false; // закрытие сессии — не поражение, дамп журнала не нужен
+    game->statemachine = Game::GameOver; // завершаем партию в любом состоянии
+    game->fsm(); // GameOver: движок освобождает ресурсы партии
+    delete game; // удаляем движок
+  } // конец проверки сессии
+} // конец метода destroy_game
+
+/**
+ * @brief Создаёт сессию из снимка, записанного Game::save.
+ *
+ * Тип движка, набор фигур и размеры поля берутся из заголовка снимка. Размеры проверяются до
+ * создания сессии: поле тетриса должно помещаться в снимок, змейка — иметь поле 20x10 (арена
+ * проверяет размер сама), поэтому повреждённый заголовок не выделяет огромное поле.
+ * \throw std::invalid_argument Если снимок повреждён или другой версии.
+ */
+Game* GameFabric::restore_game(const uint8_t* buf, size_t size) { // сессия из снимка
+  SnapshotHeader header{}; // заголовок снимка
+  if (size < sizeof(header)) throw std::invalid_argument("Error: Bad snapshot"); // снимок короче заголовка
+  memcpy(&header, buf, sizeof(header)); // копия заголовка
+  size_t cells = (size - sizeof(header)) / sizeof(int); // клеток, которые вмещает снимок
+  bool sized = header.magic == SNAPSHOT_MAGIC && header.version == SNAPSHOT_VERSION && header.size == size &&
+               header.height > 0 && header.width > 0; // заголовок этого формата
+  if (header.kind == SNAPSHOT_TETRIS) sized = sized && (uint64_t)header.height * (uint64_t)header.width <= cells; // поле тетриса целиком в снимке
+  if (header.kind == SNAPSHOT_SNAKE) sized = sized && header.height == WINDOW_HEIGHT && header.width == WINDOW_WIDTH; // поле змейки 20x10
+  if (!sized) throw std::invalid_argument("Error: Bad snapshot"); // размер поля не сходится со снимком — сессия не создаётся
+  Game* game = nullptr; // создаваемая сессия
+  if (header.kind == SNAPSHOT_TETRIS) { // тетрис
+    game = create_game(GameName::Tetris, header.height, header.width, PieceSet(header.pieces)); // набор и размер из снимка
+  } else if (header.kind == SNAPSHOT_SNAKE) { // стандартная змейка
+    game = new Snake(); // отдельный экземпляр змейки
+  } else if (header.kind == SNAPSHOT_SNAKE_ARENA) { // змейка на арене
+    game = new SnakeArena(header.height, header.width); // арена любого допустимого размера, в том числе 20x10
+  } else { // неизвестный движок
+    throw std::invalid_argument("Error: Bad snapshot"); // выбрасываем исключение
+  } // конец выбора движка
+  if (!game->restore(buf, size)) { // снимок не подошёл движку
+    destroy_game(game); // удаляем сессию
+    throw std::invalid_argument("Error: Bad snapshot"); // выбрасываем исключение
+  } // конец проверки восстановления
+  return game; // восстановленная сессия
+} // конец метода restore_game
+
 // ================= Game ==================
-Game::Game() { // конструктор базового класса Game
-  gameinfo.field = matrix_init(WINDOW_HEIGHT, WINDOW_WIDTH); // инициализирует игровое поле матрицей высоты и ширины окна
+Game::Game(int height, int width)
+    : gameinfo{},
+      action(Start),
+      statemachine(GameStart),
+      field_height(height),
+      field_width(width),
+      flight(FLIGHT_SESSION_RING),
+      flight_armed(true) { // конструктор базового класса Game обнуляет состояние
+  gameinfo.field = matrix_init(height, width); // инициализирует игровое поле матрицей заданных высоты и ширины
   gameinfo.next = matrix_init(NEXT_SIZE, NEXT_SIZE); // инициализирует матрицу для отображения следующей фигуры
 } // конец конструктора Game
 
 Game::~Game() { // деструктор базового класса Game
-  matrix_free(gameinfo.field, WINDOW_HEIGHT); // освобождает память основной матрицы поля
-  matrix_free(gameinfo.next, NEXT_SIZE); // освобождает память матрицы для следующей фигуры
+  matrix_free(gameinfo.field, field_height, field_width); // освобождает память основной матрицы поля
+  matrix_free(gameinfo.next, NEXT_SIZE, NEXT_SIZE); // освобождает память матрицы для следующей фигуры
 } // конец деструктора Game
 
-void Game::set_user_action(UserAction_t user_input) { action = user_input; } // устанавливает действие пользователя в поле action
+void Game::set_user_action(UserAction_t user_input) { // устанавливает действие пользователя в поле action
+  flight.record(FLIGHT_INPUT, statemachine, user_input); // ввод в журнал сессии
+  action = user_input; // действие обработает следующий шаг КА
+} // конец метода set_user_action
+
+bool Game::ghost(int* cells) const { // по умолчанию у игры нет тени фигуры
+  (void)cells; // буфер не заполняется
+  return false; // тени нет
+} // конец метода ghost
+
+int64_t Game::next_deadline() const { return -1; } // по умолчанию игра не ждёт таймера
+
+void Game::use_clock(const int64_t* clock_us) { (void)clock_us; } // по умолчанию у игры нет таймера
+
+/**
+ * @brief Хэш состояния полным пересчётом поля и области next.
+ *
+ * Движки, которые ведут хэш по ходу игры (тетрис), переопределяют метод и отвечают за O(1).
+ */
+uint64_t Game::state_hash() const { // хэш состояния
+  return zobrist_matrix(ZOBRIST_FIELD, gameinfo.field, field_height, field_width) ^
+         zobrist_matrix(ZOBRIST_NEXT, gameinfo.next, NEXT_SIZE, NEXT_SIZE); // поле и область next
+} // конец метода state_hash
 
 const GameInfo_t& Game::get_gameinfo() { return gameinfo; } // возвращает константную ссылку на структуру gameinfo
 
-int** Game::matrix_init(const int rows, const int cols) { // выделяет динамическую матрицу rows x cols
+int Game::get_field_height() const { return field_height; } // высота выделенного поля
+
+int Game::get_field_width() const { return field_width; } // ширина выделенного поля
+
+typedef struct { // общая часть состояния игры в снимке
+  int32_t statemachine; // состояние КА
+  int32_t action; // действие пользователя
+  int32_t score; // счёт
+  int32_t high_score; // рекорд
+  int32_t level; // уровень или код завершения
+  int32_t speed; // скорость
+  int32_t pause; // пауза
+} GameBlock; // имя типа — GameBlock
+
+size_t Game::snapshot_size() const { // размер снимка
+  return sizeof(SnapshotHeader) + sizeof(GameBlock) +
+         (field_height * field_width + NEXT_SIZE * NEXT_SIZE) * sizeof(int) + state_size(); // заголовок, поле и наследник
+} // конец метода snapshot_size
+
+/**
+ * @brief Записывает снимок состояния игры.
+ *
+ * Снимок — заголовок, общая часть (КА, счёт, поле, область next) и состояние наследника:
+ * фигуры, таймеры и генератор случайных чисел. Строки поля копируются memcpy.
+ * @return длина снимка или 0, если буфер меньше snapshot_size()
+ */
+size_t Game::save(uint8_t* buf, size_t size) const { // запись снимка
+  size_t length = snapshot_size(); // длина снимка
+  if (size < length) return 0; // буфер мал
+  SnapshotHeader header{}; // заголовок
+  snapshot_header(&header); // тип движка и размеры поля
+  header.magic = SNAPSHOT_MAGIC; // сигнатура
+  header.version = SNAPSHOT_VERSION; // версия формата
+  header.size = (uint32_t)length; // длина снимка
+  GameBlock block = {statemachine, action, gameinfo.score, gameinfo.high_score,
+                     gameinfo.level,  gameinfo.speed, gameinfo.pause}; // общая часть
+  SnapshotWriter out(buf); // запись в буфер
+  out.put(header); // заголовок
+  out.put(block); // общая часть
+  for (int i = 0; i < field_height; i++) out.put_bytes(gameinfo.field[i], field_width * sizeof(int)); // строки поля
+  for (int i = 0; i < NEXT_SIZE; i++) out.put_bytes(gameinfo.next[i], NEXT_SIZE * sizeof(int)); // строки next
+  save_state(out); // состояние наследника
+  return length; // длина снимка
+} // конец метода save
+
+/**
+ * @brief Восстанавливает состояние игры из снимка.
+ *
+ * Снимок должен быть записан движком того же типа, с тем же набором фигур и размером поля.
+ * Поле и next читаются в локальный буфер и меняются местами с живыми строками на время проверки
+ * наследника (его счётчики и хеш считаются по новому полю); если наследник отверг снимок,
+ * прежнее поле возвращается, и сессия остаётся без изменений. Общая часть применяется после
+ * того, как наследник принял своё состояние.
+ * @return false если снимок повреждён, другой версии или другого движка
+ */
+bool Game::restore(const uint8_t* buf, size_t size) { // восстановление снимка
+  SnapshotHeader header{}, own{}; // заголовок снимка и параметры этого движка
+  SnapshotReader in(buf, size); // чтение буфера
+  snapshot_header(&own); // тип движка и размеры поля
+  GameBlock block{}; // общая часть
+  bool res = in.get(&header) && header.magic == SNAPSHOT_MAGIC && header.version == SNAPSHOT_VERSION &&
+             header.kind == own.kind && header.pieces == own.pieces && header.height == own.height &&
+             header.width == own.width && header.size == size && in.get(&block) &&
+             block.statemachine >= GameStart && block.statemachine <= GameOver && block.action >= Start &&
+             block.action <= Action; // снимок этого движка
+  std::vector<int> cells(res ? ((size_t)field_height * field_width + NEXT_SIZE * NEXT_SIZE) : 0); // поле и next из снимка
+  res = res && in.get_bytes(cells.data(), cells.size() * sizeof(int)); // строки поля и next подряд
+  if (res) { // поле прочитано — на время проверки наследника оно живое
+    swap_rows(cells.data()); // поле и next из снимка
+    res = restore_state(in, (State_of_machine)block.statemachine); // наследник проверяет всё и только тогда меняется
+    if (!res) swap_rows(cells.data()); // наследник отверг снимок — прежние поле и next
+  } // конец проверки наследника
+  if (res) { // снимок принят
+    statemachine = (State_of_machine)block.statemachine; // состояние КА
+    action = (UserAction_t)block.action; // действие пользователя
+    gameinfo.score = block.score; // счёт
+    gameinfo.high_score = block.high_score; // рекорд
+    gameinfo.level = block.level; // уровень
+    gameinfo.speed = block.speed; // скорость
+    gameinfo.pause = block.pause; // пауза
+  } // конец применения общей части
+  return res; // результат восстановления
+} // конец метода restore
+
+void Game::swap_rows(int* cells) { // обмен поля и next с буфером
+  for (int i = 0; i < field_height; i++, cells += field_width) std::swap_ranges(cells, cells + field_width, gameinfo.field[i]); // строки поля (после мусора указатели переставлены)
+  for (int i = 0; i < NEXT_SIZE; i++, cells += NEXT_SIZE) std::swap_ranges(cells, cells + NEXT_SIZE, gameinfo.next[i]); // строки next
+} // конец метода swap_rows
+
+std::vector<uint8_t> Game::snapshot() const { // снимок в новом буфере
+  std::vector<uint8_t> buf(snapshot_size()); // буфер нужного размера
+  save(buf.data(), buf.size()); // запись снимка
+  return buf; // снимок
+} // конец метода snapshot
+
+void* Game::operator new(size_t size) { return SlabPool::allocate(size); } // блок сессии
+
+void Game::operator delete(void* block, size_t size) { SlabPool::deallocate(block, size); } // размер — динамического типа
+
+/**
+ * @brief Выделяет матрицу rows x cols одним блоком SlabPool.
+ *
+ * В начале блока — указатели на строки, за ними строки подряд, поэтому поле сессии
+ * занимает одно выделение вместо rows + 1 и читается последовательно.
+ */
+int** Game::matrix_init(const int rows, const int cols) { // выделяет матрицу rows x cols
   if (rows <= 0 || cols <= 0) // проверка валидности размеров
     throw std::invalid_argument("Error: Number of rows and columns must be greater than zero"); // выбрасывает исключение при некорректных размерах
-  int** matrix = new int*[rows]; // выделяет массив указателей на строки
-  for (int i = 0; i < rows; i++) { // цикл по каждой строке
-    matrix[i] = new int[cols](); // выделяет и инициализирует строку нулями
-  } // конец цикла выделения строк
+  size_t cells = (size_t)rows * cols; // клеток матрицы
+  int** matrix = (int**)SlabPool::allocate(rows * sizeof(int*) + cells * sizeof(int)); // указатели и строки
+  int* data = (int*)(matrix + rows); // первая строка сразу за указателями
+  memset(data, 0, cells * sizeof(int)); // все клетки пусты
+  for (int i = 0; i < rows; i++) matrix[i] = data + (size_t)i * cols; // указатель на строку
   return matrix; // возвращает указатель на выделенную матрицу
 } // конец метода matrix_init
 
-void Game::matrix_free(int** matrix, const int rows) { // освобождает память матрицы с заданным количеством строк
-  if (matrix) { // если матрица не равна NULL
-    for (int i = 0; i < rows; i++) delete[] matrix[i]; // освобождаем каждую строку
-    delete[] matrix; // освобождаем массив указателей на строки
-  } // конец проверки перед освобождением
+void Game::matrix_free(int** matrix, const int rows, const int cols) { // освобождает матрицу rows x cols
+  if (matrix) SlabPool::deallocate(matrix, rows * sizeof(int*) + (size_t)rows * cols * sizeof(int)); // блок целиком
 } // конец метода matrix_free
 
-void Game::fsm() { // метод обработки конечного автомата состояний игры
-  switch (this->statemachine) { // переключатель по текущему состоянию statemachine
-    case GameStart: this->starting_game(); break; // если GameStart — вызываем starting_game
-    case Spawn: this->spawn(); break; // если Spawn — вызываем spawn
-    case Moving: this->moving(); break; // если Moving — вызываем moving
-    case Shifting: this->shifting(); break; // если Shifting — вызываем shifting
-    case Attaching: this->attaching(); break; // если Attaching — вызываем attaching
-    case GameOver: this->game_over(); break; // если GameOver — вызываем game_over
-    default: break; // для прочих значений ничего не делаем
-  } // конец switch
-} // конец метода fsm
+void Game::fsm() { run_state(); } // шаг КА: один виртуальный вызов, состояние выбирает Engine<Rules>
+
+void Game::fsm_failed() { // исключение вышло из состояния
+  flight.record(FLIGHT_EXCEPTION, this->statemachine, 0); // событие в журнал
+  flight.dump(FLIGHT_REASON_EXCEPTION); // журнал в файл дампов
+} // конец метода fsm_failed
+
+void Game::fsm_finished(State_of_machine from, int level) { // переход КА и конец партии
+  if (this->statemachine != from) flight.record(FLIGHT_STATE, this->statemachine, from); // переход КА
+  if (from == GameOver && gameinfo.level == LOSE_LVL && level != LOSE_LVL) { // партия только что проиграна
+    flight.record(FLIGHT_GAME_OVER, from, gameinfo.level); // событие в журнал
+    if (flight_armed) flight.dump(FLIGHT_REASON_LOSE); // журнал в файл дампов
+  } // конец проверки поражения
+} // конец метода fsm_finished
 
 // ================= Timer ==================
-Timer::Timer() : start_time_(ClockType::now()) {} // конструктор Timer инициализирует время старта текущим моментом
+Timer::Timer() : start_time_(ClockType::now()), limits_{0, 0, 0}, intervals_us_{}, interval_us_(0), clock_us_(nullptr) {} // конструктор Timer инициализирует время старта текущим моментом
 
-void Timer::start() { start_time_ = ClockType::now(); } // сбрасывает время старта на текущий момент
+void Timer::start() { start_time_ = now(); } // сбрасывает время старта на текущий момент
 
+/**
+ * @brief Проверяет, наступил ли срок шага, и сдвигает срок на один интервал.
+ *
+ * Срок абсолютный: после срабатывания отсчёт продолжается от прошлого срока, а не от момента
+ * проверки, поэтому опоздание опроса не накапливается. Если проверка опоздала на несколько
+ * интервалов, следующие проверки срабатывают подряд, пока таймер не догонит время; отставание
+ * больше TIMER_MAX_CATCHUP интервалов (пауза, остановка процесса) даёт только один шаг.
+ */
 bool Timer::game_timer_check(int speed, int max_delay, int min_delay, int max_speed) { // проверяет, истёк ли интервал времени для шага
   bool res = false; // по умолчанию результат false
-  DurationMs delay = calculate_delay(speed, max_delay, min_delay, max_speed); // вычисляем задержку на основе скорости и лимитов
-  DurationMs elapsed_time = get_elapsed_time(); // получаем прошедшее время с момента старта
+  DurationUs delay(calculate_delay(speed, max_delay, min_delay, max_speed)); // интервал шага для текущей скорости
+  TimePoint moment = now(); // момент проверки
 
-  if (elapsed_time >= delay) { // если прошедшее время больше или равно требуемой задержке
+  if (moment - start_time_ >= delay) { // если срок шага наступил
+    if (moment - start_time_ >= delay * TIMER_MAX_CATCHUP) start_time_ = moment - delay; // отставание не догоняем
+    start_time_ += delay; // следующий срок — ровно через интервал после этого
     res = true; // помечаем, что таймер сработал
   } // конец проверки времени
   return res; // возвращаем результат проверки
 } // конец метода game_timer_check
 
+int64_t Timer::next_deadline() const { // микросекунд до следующего шага
+  int64_t left = interval_us_ - get_elapsed_us(); // остаток интервала последней проверки
+  return left > 0 ? left : 0; // срок прошёл — шаг нужен сразу
+} // конец метода next_deadline
+
 double Timer::get_miliseconds() const { // возвращает миллисекунды от прошедшего времени в пределах секунды
   return get_elapsed_time().count() % 1000; // берёт остаток миллисекунд от общего прошедшего времени
 } // конец метода get_miliseconds
@@ -89,13 +343,55 @@ int Timer::get_minutes() const { // возвращает количество м
   return get_elapsed_time().count() / 60000 % 60; // преобразует миллисекунды в минуты и берёт остаток по часу
 } // конец метода get_minutes
 
+int64_t Timer::get_elapsed_us() const { // прошедшее время в микросекундах
+  return std::chrono::duration_cast<DurationUs>(now() - start_time_).count(); // разница с временем старта
+} // конец метода get_elapsed_us
+
+void Timer::resume(int64_t elapsed_us) { // перезапуск с уже прошедшим временем
+  start_time_ = now() - std::chrono::duration_cast<ClockType::duration>(
+                                       DurationUs(elapsed_us)); // старт в прошлом
+} // конец метода resume
+
 Timer::DurationMs Timer::get_elapsed_time() const { // получает DurationMs, представляющее прошедшее время
-  return std::chrono::duration_cast<DurationMs>(ClockType::now() - start_time_); // разница между текущим моментом и временем старта
+  return std::chrono::duration_cast<DurationMs>(now() - start_time_); // разница между текущим моментом и временем старта
 } // конец метода get_elapsed_time
 
-Timer::DurationMs Timer::calculate_delay(int speed, int max_delay, int min_delay, int max_speed) const { // вычисляет задержку в зависимости от скорости
-  return DurationMs(max_delay -
-                    (speed - 1) * (max_delay - min_delay) / (max_speed - 1)); // линейная интерполяция задержки по скорости
+/**
+ * @brief Переключает таймер на внешние часы.
+ *
+ * Внешние часы — счётчик микросекунд, который двигает владелец (матч по сети шагает кадрами
+ * фиксированной длины): сроки шагов зависят только от номера кадра, а не от скорости машины,
+ * поэтому одинаковый ввод даёт одинаковую партию на обоих узлах и при повторном проходе.
+ */
+void Timer::set_clock(const int64_t* clock_us) { // выбор часов
+  clock_us_ = clock_us; // часы таймера
+  start(); // отсчёт — от текущего момента новых часов
+} // конец метода set_clock
+
+Timer::TimePoint Timer::now() const { // текущий момент
+  return clock_us_ ? TimePoint(std::chrono::duration_cast<ClockType::duration>(DurationUs(*clock_us_)))
+                   : ClockType::now(); // внешние часы или steady_clock
+} // конец метода now
+
+/**
+ * @brief Интервал шага для скорости: линейная интерполяция от max_delay до min_delay.
+ *
+ * Таблица всех скоростей строится один раз для набора лимитов, скорость вне таблицы
+ * приводится к ближайшей, скорость выше max_speed получает интервал min_delay.
+ */
+int64_t Timer::calculate_delay(int speed, int max_delay, int min_delay, int max_speed) { // интервал шага в микросекундах
+  if (limits_[0] != max_delay || limits_[1] != min_delay || limits_[2] != max_speed) { // лимиты сменились
+    for (int s = 0; s < TIMER_SPEEDS; s++) { // все скорости таблицы
+      int capped = s < max_speed ? s : max_speed; // выше max_speed интервал не уменьшается
+      intervals_us_[s] = (int32_t)(max_delay * 1000LL - (capped - 1) * (max_delay - min_delay) * 1000LL / (max_speed - 1)); // интервал скорости
+    } // конец построения таблицы
+    limits_[0] = max_delay; // лимиты таблицы
+    limits_[1] = min_delay;
+    limits_[2] = max_speed;
+  } // конец проверки лимитов
+  speed = speed < 0 ? 0 : speed >= TIMER_SPEEDS ? TIMER_SPEEDS - 1 : speed; // скорость в пределах таблицы
+  interval_us_ = intervals_us_[speed]; // интервал для next_deadline
+  return interval_us_; // интервал шага
 } // конец метода calculate_delay
 
 } // namespace s21 // конец пространства имён s21
@@ -127,3 +423,26 @@ GameInfo_t updateCurrentState() { // глобальная функция API д
   } // конец проверки наличия текущей игры
   return gameinfo; // возвращаем полученную структуру GameInfo_t
 } // конец функции updateCurrentState
+
+int64_t nextDeadline() { // глобальная функция API для ожидания фронтендов
+  int64_t res = -1; // по умолчанию шаг не ждёт таймера
+  s21::Game* current_game = s21::GameFabric::get_game(); // получаем указатель на текущую игру
+  if (current_game) { // если текущая игра установлена
+    res = current_game->next_deadline(); // срок шага текущей игры
+  } // конец проверки наличия текущей игры
+  return res; // микросекунд до шага или -1
+} // конец функции nextDeadline
+
+uint64_t stateHash() { // глобальная функция API для сверки состояния
+  s21::Game* current_game = s21::GameFabric::get_game(); // получаем указатель на текущую игру
+  return current_game ? current_game->state_hash() : 0; // хэш текущей игры
+} // конец функции stateHash
+
+bool getGhost(int* ghost) { // глобальная функция API для получения тени текущей фигуры
+  bool res = false; // по умолчанию тени нет
+  s21::Game* current_game = s21::GameFabric::get_game(); // получаем указатель на текущую игру
+  if (current_game) { // если текущая игра установлена
+    res = current_game->ghost(ghost); // игра заполняет координаты тени, если она есть
+  } // конец проверки наличия текущей игры
+  return res; // возвращаем признак наличия тени
+} // конец функции getGhost
@@ -3,11 +3,19 @@
 #include <stdexcept> // подключает исключения стандартной библиотеки (std::runtime_error и др.)
 #include <chrono> // подключает возможности работы со временем и таймерами
 #include <iostream> // подключает потоки ввода/вывода (std::cout, std::cerr и т.д.)
+#include <stdint.h> // подключает целые типы фиксированной ширины для снимков состояния
+#include <vector> // подключает std::vector для снимков состояния
+
+#include "flight.h" // подключает журнал последних событий сессии
 
 // --- defines.h ---
 #define WINDOW_HEIGHT 20 // высота игрового окна (число строк игрового поля)
 #define WINDOW_WIDTH 10 // ширина игрового окна (число столбцов игрового поля)
 #define NEXT_SIZE 7 // размер области отображения следующей фигуры (NEXT_SIZE x NEXT_SIZE)
+#define GHOST_SIZE 10 // размер описания тени фигуры: пять пар Y,X (у меньших фигур последняя пара повторяется)
+
+#define TIMER_SPEEDS 16 // размер таблицы интервалов шага (скорости 0..15)
+#define TIMER_MAX_CATCHUP 4 // отставание в интервалах, после которого пропущенные шаги не догоняются
 
 #define WIN_LVL 200 // код уровня/статуса для победы
 #define LOSE_LVL -1 // код уровня/статуса для поражения / выхода из игры
@@ -38,19 +46,41 @@ typedef struct { // структура для хранения информац
 namespace s21 { // начало пространства имён s21
 class Game; // предварительное объявление класса Game
 class GameFabric; // предварительное объявление класса GameFabric
+class SnapshotWriter; // предварительное объявление записи снимка (snapshot.h)
+class SnapshotReader; // предварительное объявление чтения снимка (snapshot.h)
+struct SnapshotHeader; // предварительное объявление заголовка снимка (snapshot.h)
 } // конец пространства имён s21
 
 void userInput(UserAction_t action, bool hold); // прототип глобальной функции API для передачи ввода пользователя
 GameInfo_t updateCurrentState(); // прототип глобальной функции API для обновления и получения текущего состояния игры
+bool getGhost(int* ghost); // прототип глобальной функции API для получения координат тени (места приземления) фигуры
+int64_t nextDeadline(); // прототип глобальной функции API: микросекунд до следующего шага по таймеру, -1 если шаг не ждёт таймера
+uint64_t stateHash(); // прототип глобальной функции API: хэш Zobrist поля и фигур для сверки реплик (0 — игры нет)
 
 // --- game.h ---
 namespace s21 { // начало пространства имён s21
 
 class Game { // объявление абстрактного базового класса Game
+  friend class GameFabric; // фабрика удаляет созданные ею сессии
+
  public:
   void set_user_action(UserAction_t user_input); // метод установки действия пользователя
   const GameInfo_t& get_gameinfo(); // метод получения константной ссылки на структуру gameinfo
+  int get_field_height() const; // высота матрицы gameinfo.field
+  int get_field_width() const; // ширина матрицы gameinfo.field
   void fsm(); // метод выполнения одного шага конечного автомата игры
+  virtual bool ghost(int* cells) const; // координаты тени фигуры (GHOST_SIZE чисел), false если тени нет
+  virtual int64_t next_deadline() const; // микросекунд до шага по таймеру, -1 если КА не ждёт таймера
+  virtual uint64_t state_hash() const; // хэш Zobrist занятых клеток поля, области next и падающей фигуры
+  virtual void use_clock(const int64_t* clock_us); // внешние часы шагов (nullptr — steady_clock) для воспроизводимых партий
+
+  size_t snapshot_size() const; // размер снимка текущего состояния в байтах
+  size_t save(uint8_t* buf, size_t size) const; // запись снимка в buf, возвращает длину или 0, если буфер мал
+  bool restore(const uint8_t* buf, size_t size); // восстановление из снимка, false если снимок другого движка
+  std::vector<uint8_t> snapshot() const; // снимок в новом буфере
+
+  static void* operator new(size_t size); // объект сессии — блок SlabPool
+  static void operator delete(void* block, size_t size); // возврат блока сессии в SlabPool
 
  protected:
   enum State_of_machine { GameStart = 0, Spawn, Moving, Shifting, Attaching, GameOver }; // перечисление состояний КА
@@ -59,19 +89,29 @@ class Game { // объявление абстрактного базового 
   UserAction_t action; // текущее действие пользователя, ожидаемое/обрабатываемое игрой
   State_of_machine statemachine; // текущее состояние конечного автомата
 
-  Game(); // защищённый конструктор базового класса
+  int field_height; // высота выделенного игрового поля
+  int field_width; // ширина выделенного игрового поля
+  FlightRecorder flight; // журнал последних событий сессии
+
+  Game(int height = WINDOW_HEIGHT, int width = WINDOW_WIDTH); // защищённый конструктор базового класса, выделяет поле height x width
   virtual ~Game(); // виртуальный защищённый деструктор базового класса
 
+  void fsm_failed(); // исключение вышло из шага КА: событие и дамп журнала
+  void fsm_finished(State_of_machine from, int level); // шаг КА сменил состояние или завершил партию: журнал
+
  private:
-  virtual void starting_game() = 0; // чисто виртуальная функция для обработки состояния GameStart
-  virtual void spawn() = 0; // чисто виртуальная функция для обработки состояния Spawn
-  virtual void moving() = 0; // чисто виртуальная функция для обработки состояния Moving
-  virtual void shifting() = 0; // чисто виртуальная функция для обработки состояния Shifting
-  virtual void attaching() = 0; // чисто виртуальная функция для обработки состояния Attaching
-  virtual void game_over() = 0; // чисто виртуальная функция для обработки состояния GameOver
-
-  int** matrix_init(const int rows, const int cols); // выделение и инициализация матрицы rows x cols
-  void matrix_free(int** matrix, const int rows); // освобождение памяти матрицы с указанным числом строк
+  virtual void run_state() = 0; // шаг КА наследника (Engine<Rules>::step, engine.h)
+
+  virtual void snapshot_header(SnapshotHeader* header) const = 0; // тип движка и размеры поля для снимка
+  virtual size_t state_size() const = 0; // размер состояния наследника в снимке
+  virtual void save_state(SnapshotWriter& out) const = 0; // запись состояния наследника
+  virtual bool restore_state(SnapshotReader& in, State_of_machine state) = 0; // чтение состояния наследника для состояния КА state; false при несовпадении, тогда наследник не меняется
+
+  bool flight_armed; // дамп журнала при поражении (фабрика выключает его при закрытии сессии)
+
+  void swap_rows(int* cells); // обмен строк поля и next с буфером того же размера (строки подряд)
+  int** matrix_init(const int rows, const int cols); // выделение и инициализация матрицы rows x cols одним блоком
+  void matrix_free(int** matrix, const int rows, const int cols); // освобождение матрицы rows x cols
 }; // конец объявления класса Game
 
 class GameFabric { // фабрика для выбора и хранения текущей игры
@@ -80,31 +120,50 @@ class GameFabric { // фабрика для выбора и хранения т
 
  public:
   enum class GameName { EmptyGame = 0, Tetris, Snake }; // перечисление доступных имён/типов игр в фабрике
+  enum class PieceSet { Standard = 0, Pentomino, Training }; // наборы фигур тетриса
 
   static void set_game(GameName name); // статический метод установки текущей игры по имени
   static Game* get_game(); // статический метод получения указателя на текущую игру
+  static Game* create_game(GameName name, int height, int width,
+                           PieceSet pieces = PieceSet::Standard); // создание отдельной сессии с полем height x width
+  static void destroy_game(Game* game); // удаление сессии, созданной create_game
+  static Game* restore_game(const uint8_t* buf, size_t size); // новая сессия из снимка Game::save
+
+ private:
+  template <class Pieces> // набор фигур
+  static Game* create_tetris(int height, int width); // тетрис с набором Pieces и полем height x width
 }; // конец объявления класса GameFabric
 
 class Timer { // класс-обёртка для замеров времени и расчёта задержек игрового шага
  private:
-  using ClockType = std::chrono::high_resolution_clock; // тип часов высокой точности
+  using ClockType = std::chrono::steady_clock; // монотонные часы: перевод системного времени не сдвигает шаги
   using TimePoint = std::chrono::time_point<ClockType>; // тип точки времени на основе выбранных часов
   using DurationMs = std::chrono::milliseconds; // тип длительности в миллисекундах
+  using DurationUs = std::chrono::microseconds; // тип длительности в микросекундах
 
-  TimePoint start_time_; // поле для хранения времени старта/перезапуска таймера
+  TimePoint start_time_; // время последнего шага (от него отсчитывается следующий срок)
+  int limits_[3]; // max_delay, min_delay и max_speed, по которым построена таблица интервалов
+  int32_t intervals_us_[TIMER_SPEEDS]; // интервал шага для каждой скорости в микросекундах (до 35 минут, 4 байта держат объект сессии в 512 байтах)
+  int64_t interval_us_; // интервал последней проверки (для next_deadline)
+  const int64_t* clock_us_; // внешние часы в микросекундах (nullptr — steady_clock)
 
  public:
   Timer(); // конструктор инициализирует start_time_
 
   void start(); // метод перезапуска таймера (установка текущего времени в start_time_)
   bool game_timer_check(int speed, int max_delay, int min_delay, int max_speed); // проверяет, истёк ли интервал для шага при данных параметрах
+  int64_t next_deadline() const; // микросекунд до срока следующего шага (0 — шаг уже должен быть сделан)
   double get_miliseconds() const; // возвращает миллисекунды из прошедшего времени в пределах секунды
   int get_seconds() const; // возвращает секунды из прошедшего времени в пределах минуты
   int get_minutes() const; // возвращает минуты из прошедшего времени в пределах часа
+  int64_t get_elapsed_us() const; // возвращает прошедшее время в микросекундах (для снимка)
+  void resume(int64_t elapsed_us); // перезапуск таймера так, будто прошло elapsed_us микросекунд
+  void set_clock(const int64_t* clock_us); // часы таймера: nullptr — steady_clock, иначе время по указателю
 
  private:
+  TimePoint now() const; // текущий момент выбранных часов
   DurationMs get_elapsed_time() const; // возвращает прошедшее время как DurationMs
-  DurationMs calculate_delay(int speed, int max_delay, int min_delay, int max_speed) const; // вычисляет задержку на основе скорости и лимитов
+  int64_t calculate_delay(int speed, int max_delay, int min_delay, int max_speed); // интервал шага из таблицы в микросекундах
 }; // конец объявления класса Timer
 
 }  // namespace s21 // конец пространства имён s21
@@ -0,0 +1,84 @@
+#ifndef ENGINE_H // защита от повторного включения заголовка: если ENGINE_H не определён
+#define ENGINE_H // определяет макрос ENGINE_H чтобы предотвратить повторное включение
+
+#include "brick_game_single.h" // подключает базовый класс Game и состояния КА
+#include "stats.h" // подключает замер шага КА (STATS_STATE_SCOPE)
+#include "trace.h" // подключает интервал шага КА (TRACE_SCOPE)
+
+namespace s21 { // начало пространства имён s21
+
+/**
+ * @brief Движок со статическим выбором состояния КА.
+ *
+ * Rules — конечный класс игры (CRTP) с шестью обработчиками состояний: starting_game,
+ * spawn, moving, shifting, attaching и game_over. Обработчики вызываются напрямую, без
+ * виртуальных вызовов, поэтому step вместе с правилами собирается в одну функцию.
+ * Экземпляр Engine<Rules> собирается явно в единице трансляции правил (там видны их тела),
+ * остальные единицы объявляют его через extern template.
+ *
+ * Game::fsm остаётся для фронтендов и сервера: один виртуальный вызов run_state на шаг.
+ * Пакетные пути, которым тип игры известен при компиляции, вызывают step напрямую.
+ */
+template <class Rules>
+class Engine : public Game { // объявление движка со статическим выбором состояния
+ public: // публичная секция класса
+  void step(); // шаг КА: замеры, журнал сессии и прямой вызов обработчика состояния
+  static void step_all(Rules* const* games, size_t count); // шаг каждой из count сессий
+
+ protected: // защищённая секция для наследника
+  explicit Engine(int height = WINDOW_HEIGHT, int width = WINDOW_WIDTH) : Game(height, width) {} // поле height x width
+
+ private: // приватная секция для адаптера Game
+  void run_state() final; // Game::fsm — тот же step
+  void dispatch(); // вызов обработчика текущего состояния
+}; // конец объявления класса Engine
+
+/**
+ * @brief Имя интервала трассировки состояния КА.
+ */
+inline const char* fsm_trace_name(unsigned state) { // имя интервала шага
+  static const char* const names[] = {"fsm.GameStart", "fsm.Spawn",     "fsm.Moving",
+                                      "fsm.Shifting",  "fsm.Attaching", "fsm.GameOver"}; // имена интервалов состояний
+  return state < sizeof(names) / sizeof(names[0]) ? names[state] : "fsm"; // неизвестное состояние — общее имя
+} // конец функции fsm_trace_name
+
+template <class Rules>
+void Engine<Rules>::dispatch() { // обработчик текущего состояния
+  Rules* rules = static_cast<Rules*>(this); // конечный класс игры
+  switch (this->statemachine) { // переключатель по текущему состоянию statemachine
+    case GameStart: rules->starting_game(); break; // если GameStart — вызываем starting_game
+    case Spawn: rules->spawn(); break; // если Spawn — вызываем spawn
+    case Moving: rules->moving(); break; // если Moving — вызываем moving
+    case Shifting: rules->shifting(); break; // если Shifting — вызываем shifting
+    case Attaching: rules->attaching(); break; // если Attaching — вызываем attaching
+    case GameOver: rules->game_over(); break; // если GameOver — вызываем game_over
+    default: break; // для прочих значений ничего не делаем
+  } // конец switch
+} // конец метода dispatch
+
+template <class Rules>
+void Engine<Rules>::step() { // шаг КА
+  STATS_STATE_SCOPE(this->statemachine); // время шага учитывается за состоянием, в котором он начался
+  TRACE_SCOPE(fsm_trace_name((unsigned)this->statemachine)); // интервал шага КА
+  State_of_machine from = this->statemachine; // состояние до шага, для журнала переходов
+  int level = this->gameinfo.level; // уровень до шага: дамп пишется один раз, при установке LOSE_LVL
+  try { // исключение движка сохраняет журнал и уходит дальше
+    dispatch(); // обработчик состояния
+  } catch (...) { // исключение вышло из состояния
+    this->fsm_failed(); // событие и дамп журнала
+    throw; // исключение обрабатывает вызывающий код
+  } // конец обработки исключения
+  if (this->statemachine != from || from == GameOver) this->fsm_finished(from, level); // переход КА или конец партии
+} // конец метода step
+
+template <class Rules>
+void Engine<Rules>::step_all(Rules* const* games, size_t count) { // пакетный шаг
+  for (size_t i = 0; i < count; i++) games[i]->step(); // шаги без виртуальных вызовов
+} // конец метода step_all
+
+template <class Rules>
+void Engine<Rules>::run_state() { step(); } // адаптер Game::fsm
+
+}  // namespace s21 // конец пространства имён s21
+
+#endif  // ENGINE_H // конец защиты от повторного включения заголовка
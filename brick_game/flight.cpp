@@ -0,0 +1,241 @@
+#include "flight.h" // подключает объявление журнала сессии и формат дампа
+#include "slab.h" // подключает распределитель блоков для кольца записей
+
+#include <fcntl.h> // подключает open для файла дампов
+#include <sched.h> // подключает sched_yield для ожидания обработчика сигнала
+#include <signal.h> // подключает sigaction и sigaltstack для дампа при падении
+#include <stdio.h> // подключает snprintf для текста декодера
+#include <string.h> // подключает memcpy и strlen
+#include <unistd.h> // подключает write и close
+
+#include <chrono> // подключает steady_clock для времени записей
+#include <stdexcept> // подключает std::invalid_argument для повреждённого дампа
+
+namespace s21 { // начало пространства имён s21
+
+static std::atomic<FlightRecorder*> live[FLIGHT_MAX_SESSIONS]; // журналы сессий для обработчика сигнала
+static std::atomic<uint64_t> unlisted{0}; // живых журналов без места в списке
+static std::atomic<uint64_t> sessions{0}; // номер последней созданной сессии
+static FlightRecorder* const busy = reinterpret_cast<FlightRecorder*>(uintptr_t(1)); // место читает обработчик сигнала
+static char alt_stack[FLIGHT_ALT_STACK]; // стек обработчика сигнала
+static char dump_path[FLIGHT_PATH_MAX]; // файл дампов (пустой — дампы не пишутся)
+
+static uint64_t flight_now_ns() { // монотонное время
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count(); // наносекунды
+} // конец функции flight_now_ns
+
+/**
+ * @brief Конструктор.
+ *
+ * Занимает свободное место списка журналов для дампа при падении; если мест нет, журнал
+ * учитывается в счётчике сессий без места (запись FLIGHT_REASON_OVERFLOW в дампе).
+ * @throw std::invalid_argument если capacity не степень двойки от 1 до FLIGHT_RING_SIZE
+ */
+FlightRecorder::FlightRecorder(uint32_t capacity)
+    : ring(nullptr), mask(capacity - 1), slot(-1), head(0), session(++sessions), origin_ns(flight_now_ns()) { // пустой журнал
+  if (capacity == 0 || capacity > FLIGHT_RING_SIZE || (capacity & (capacity - 1)) != 0) // размер кольца
+    throw std::invalid_argument("Error: flight ring capacity must be a power of two up to FLIGHT_RING_SIZE");
+  ring = (FlightRecord*)SlabPool::allocate(capacity * sizeof(FlightRecord)); // кольцо записей без malloc
+  memset(ring, 0, capacity * sizeof(FlightRecord)); // пустые записи
+  for (int i = 0; i < FLIGHT_MAX_SESSIONS && slot < 0; i++) { // поиск свободного места в списке
+    FlightRecorder* empty = nullptr; // ожидаемое значение свободного места
+    if (live[i].compare_exchange_strong(empty, this)) slot = i; // журнал виден обработчику сигнала
+  } // конец поиска
+  if (slot < 0) unlisted++; // мест нет: журнал пишется, при падении сохраняется только их число
+} // конец конструктора
+
+FlightRecorder::~FlightRecorder() { // сессия удаляется
+  if (slot < 0) unlisted--; // журнал без места
+  for (FlightRecorder* self = this; slot >= 0 && !live[slot].compare_exchange_weak(self, nullptr); self = this) // место освобождено
+    sched_yield(); // обработчик сигнала другого потока читает журнал — ждём, пока он вернёт место
+  SlabPool::deallocate(ring, (mask + 1) * sizeof(FlightRecord)); // кольцо записей
+} // конец деструктора
+
+void FlightRecorder::record(FlightKind_t kind, int state, int32_t value) { // запись события
+  uint64_t index = head.load(std::memory_order_relaxed); // номер записи (пишет только поток сессии)
+  FlightRecord& entry = ring[index & mask]; // место в кольце (старейшая запись вытесняется)
+  entry.ns = flight_now_ns() - origin_ns; // время от создания сессии
+  entry.kind = (uint16_t)kind; // вид события
+  entry.state = (uint16_t)state; // состояние КА
+  entry.value = value; // значение события
+  head.store(index + 1, std::memory_order_release); // публикация записи
+} // конец метода record
+
+size_t FlightRecorder::size() const { // записей в журнале
+  uint64_t count = head.load(std::memory_order_acquire); // записей за жизнь сессии
+  return count <= mask ? count : mask + 1; // не больше кольца
+} // конец метода size
+
+uint64_t FlightRecorder::total() const { return head.load(std::memory_order_acquire); } // записей за жизнь сессии
+uint32_t FlightRecorder::capacity() const { return mask + 1; } // ёмкость кольца
+bool FlightRecorder::registered() const { return slot >= 0; } // журнал в списке для дампа при падении
+
+/**
+ * @brief Записывает дамп журнала в buf: заголовок и записи по возрастанию времени.
+ *
+ * Не выделяет память и не вызывает небезопасных в обработчике сигнала функций.
+ * @return длина дампа в байтах (не больше FLIGHT_DUMP_MAX)
+ */
+size_t FlightRecorder::dump_bytes(uint8_t* buf, FlightReason_t reason, int signal) const { // дамп в память
+  uint64_t end = head.load(std::memory_order_acquire); // конец опубликованных записей
+  uint32_t count = (uint32_t)(end <= mask ? end : mask + 1); // записей в дампе
+  FlightDumpHeader header = {{'B', 'G', 'F', 'R'}, FLIGHT_VERSION, (uint16_t)reason, (uint32_t)signal, count, session,
+                             end}; // заголовок дампа
+  memcpy(buf, &header, sizeof(header)); // заголовок
+  size_t offset = sizeof(header); // позиция первой записи
+  for (uint64_t i = end - count; i < end; i++) { // записи от старейшей
+    memcpy(buf + offset, &ring[i & mask], sizeof(FlightRecord)); // запись
+    offset += sizeof(FlightRecord); // следующая позиция
+  } // конец цикла по записям
+  return offset; // длина дампа
+} // конец метода dump_bytes
+
+static bool append_dump(const FlightRecorder& recorder, int fd, FlightReason_t reason, int signal) { // дамп в открытый файл
+  uint8_t buf[FLIGHT_DUMP_MAX]; // дамп целиком, чтобы дописать его одной записью
+  size_t size = recorder.dump_bytes(buf, reason, signal); // дамп в память
+  return write(fd, buf, size) == (ssize_t)size; // O_APPEND: дампы разных сессий не перемешиваются
+} // конец функции append_dump
+
+/**
+ * @brief Дописывает журнал в файл flightInstall.
+ * @return false если файл дампов не задан или запись не удалась
+ */
+bool FlightRecorder::dump(FlightReason_t reason, int signal) const { // дамп в файл
+  bool res = false; // по умолчанию дамп не записан
+  if (dump_path[0] != '\0') { // файл дампов задан
+    int fd = open(dump_path, O_WRONLY | O_CREAT | O_APPEND, 0644); // файл дописывается
+    if (fd >= 0) { // файл открыт
+      res = append_dump(*this, fd, reason, signal); // дамп
+      close(fd); // закрываем файл
+    } // конец проверки открытия
+  } // конец проверки пути
+  return res; // результат записи
+} // конец метода dump
+
+/**
+ * @brief Обработчик SIGSEGV и SIGABRT: дописывает журналы всех живых сессий.
+ *
+ * Работает на стеке FLIGHT_ALT_STACK. Место списка на время дампа заменяется меткой busy,
+ * поэтому деструктор журнала в другом потоке не освободит кольцо, пока его читает обработчик.
+ */
+static void on_crash(int signal) { // обработчик SIGSEGV и SIGABRT
+  int fd = dump_path[0] != '\0' ? open(dump_path, O_WRONLY | O_CREAT | O_APPEND, 0644) : -1; // файл дампов
+  if (fd >= 0) { // файл открыт
+    for (int i = 0; i < FLIGHT_MAX_SESSIONS; i++) { // журналы всех сессий
+      FlightRecorder* recorder = live[i].exchange(busy, std::memory_order_acq_rel); // журнал сессии, место занято обработчиком
+      if (recorder && recorder != busy) append_dump(*recorder, fd, FLIGHT_REASON_SIGNAL, signal); // дамп сессии
+      if (recorder != busy) live[i].store(recorder, std::memory_order_release); // место возвращается журналу
+    } // конец цикла по журналам
+    uint64_t missing = unlisted.load(std::memory_order_acquire); // сессии без места в списке
+    if (missing > 0) { // их журналы не сохранены — в файле остаётся их число
+      FlightDumpHeader header = {{'B', 'G', 'F', 'R'}, FLIGHT_VERSION, FLIGHT_REASON_OVERFLOW, (uint32_t)signal, 0, 0,
+                                 missing}; // запись без журнала
+      ssize_t written = write(fd, &header, sizeof(header)); // запись о пропущенных журналах
+      (void)written; // при ошибке записи в обработчике сигнала сделать уже нечего
+    } // конец записи о сессиях без места
+    close(fd); // закрываем файл
+  } // конец проверки открытия
+  raise(signal); // обработчик уже сброшен (SA_RESETHAND): процесс завершается по сигналу
+} // конец функции on_crash
+
+static const char* const kind_names[FLIGHT_KIND_COUNT] = {"?",     "input",    "state",     "spawn",
+                                                          "lock",  "clear",    "deadline",  "game_over",
+                                                          "exception"}; // имена видов событий
+static const char* const state_names[] = {"GameStart", "Spawn", "Moving", "Shifting", "Attaching", "GameOver"}; // состояния КА
+static const char* const action_names[] = {"Start", "Pause", "Terminate", "Left", "Right", "Up", "Down", "Action"}; // ввод
+static const char* const reason_names[] = {"?", "lose", "exception", "signal", "manual", "overflow"}; // причины дампа
+
+const char* flight_kind_name(int kind) { // имя вида события
+  return (kind > 0 && kind < FLIGHT_KIND_COUNT) ? kind_names[kind] : kind_names[0]; // неизвестный вид — "?"
+} // конец функции flight_kind_name
+
+template <size_t N>
+static const char* name_of(const char* const (&names)[N], int index) { // имя из таблицы или "?"
+  return (index >= 0 && (size_t)index < N) ? names[index] : "?"; // проверка границ таблицы
+} // конец функции name_of
+
+/**
+ * @brief Текст дампов: заголовок каждой сессии и её записи по одной в строке.
+ *
+ * Файл может содержать несколько дампов подряд (каждый дописывается в конец).
+ * \throw std::invalid_argument Если дамп обрезан, другой версии или не является дампом.
+ */
+std::string flight_decode(const uint8_t* buf, size_t size) { // декодер дампов
+  std::string text; // результат
+  char line[160]; // строка результата
+  size_t offset = 0; // позиция текущего дампа
+  while (offset < size) { // дампы подряд
+    FlightDumpHeader header; // заголовок дампа
+    if (size - offset < sizeof(header)) throw std::invalid_argument("Error: Bad flight dump"); // обрезан заголовок
+    memcpy(&header, buf + offset, sizeof(header)); // копия заголовка
+    offset += sizeof(header); // записи дампа
+    if (memcmp(header.magic, "BGFR", 4) != 0 || header.version != FLIGHT_VERSION || header.count > FLIGHT_RING_SIZE ||
+        (size - offset) / sizeof(FlightRecord) < header.count) { // не дамп, другая версия или обрезаны записи
+      throw std::invalid_argument("Error: Bad flight dump"); // выбрасываем исключение
+    } // конец проверки заголовка
+    snprintf(line, sizeof(line), "session %llu: %s", (unsigned long long)header.session,
+             name_of(reason_names, header.reason)); // заголовок сессии
+    text += line; // строка заголовка
+    if (header.reason == FLIGHT_REASON_OVERFLOW) { // сессии без места в списке при падении
+      snprintf(line, sizeof(line), "%llu sessions without a crash slot were not saved (signal %u)\n",
+               (unsigned long long)header.total, header.signal); // число несохранённых журналов
+      text += line; // строка о пропущенных журналах
+      continue; // записей у этого заголовка нет
+    } // конец разбора записи о переполнении
+    if (header.reason == FLIGHT_REASON_SIGNAL) { // номер сигнала
+      snprintf(line, sizeof(line), " %u", header.signal); // сигнал
+      text += line; // номер сигнала
+    } // конец вывода сигнала
+    snprintf(line, sizeof(line), ", last %u of %llu records\n", header.count, (unsigned long long)header.total);
+    text += line; // число записей
+    for (uint32_t i = 0; i < header.count; i++) { // записи дампа
+      FlightRecord record; // запись
+      memcpy(&record, buf + offset, sizeof(record)); // копия записи
+      offset += sizeof(record); // следующая запись
+      const char* value = nullptr; // значение по имени (ввод и состояние)
+      if (record.kind == FLIGHT_INPUT) value = name_of(action_names, record.value); // действие игрока
+      if (record.kind == FLIGHT_STATE) value = name_of(state_names, record.value); // прежнее состояние
+      if (value) { // значение с именем
+        snprintf(line, sizeof(line), "  %12.3f ms  %-9s %-9s %s\n", record.ns / 1e6, flight_kind_name(record.kind),
+                 name_of(state_names, record.state), value); // запись
+      } else { // числовое значение
+        snprintf(line, sizeof(line), "  %12.3f ms  %-9s %-9s %d\n", record.ns / 1e6, flight_kind_name(record.kind),
+                 name_of(state_names, record.state), record.value); // запись
+      } // конец выбора вида значения
+      text += line; // строка записи
+    } // конец цикла по записям
+  } // конец цикла по дампам
+  return text; // текст дампов
+} // конец функции flight_decode
+
+}  // namespace s21 // конец пространства имён s21
+
+// ================= API ==================
+/**
+ * @brief Задаёт файл дампов и ставит обработчики SIGSEGV и SIGABRT.
+ *
+ * Без вызова журналы пишутся, но дампы не сохраняются. Обработчик дописывает журналы
+ * всех живых сессий и завершает процесс тем же сигналом. Он работает на отдельном стеке
+ * (sigaltstack), чтобы дамп записался и при переполнении стека; стек ставится потоку,
+ * вызвавшему flightInstall (фронтенды и сервер однопоточные). path == nullptr выключает дампы.
+ * @return false если дампы выключены или путь слишком длинный
+ */
+bool flightInstall(const char* path) { // глобальная функция API установки бортового самописца
+  if (!path) s21::dump_path[0] = '\0'; // дампы больше не пишутся
+  if (!path || path[0] == '\0' || strlen(path) >= FLIGHT_PATH_MAX) return false; // путь не задан или не помещается
+  memcpy(s21::dump_path, path, strlen(path) + 1); // путь вместе с завершающим нулём
+  struct sigaction action; // параметры обработчика
+  memset(&action, 0, sizeof(action)); // обнуляем параметры
+  stack_t stack; // стек обработчика
+  memset(&stack, 0, sizeof(stack)); // обнуляем параметры
+  stack.ss_sp = s21::alt_stack; // статический буфер: обработчику не нужна куча
+  stack.ss_size = sizeof(s21::alt_stack); // размер стека
+  sigaltstack(&stack, nullptr); // стек потока может быть исчерпан к моменту SIGSEGV
+  action.sa_handler = s21::on_crash; // дамп журналов
+  action.sa_flags = SA_RESETHAND | SA_ONSTACK; // повторный сигнал обрабатывается по умолчанию, обработчик — на своём стеке
+  sigemptyset(&action.sa_mask); // другие сигналы не блокируются
+  sigaction(SIGSEGV, &action, nullptr); // ошибка доступа к памяти
+  sigaction(SIGABRT, &action, nullptr); // abort, в том числе std::terminate при невыловленном исключении
+  return true; // самописец установлен
+} // конец функции flightInstall
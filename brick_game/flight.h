@@ -0,0 +1,103 @@
+#ifndef FLIGHT_H // защита от повторного включения заголовка: если FLIGHT_H не определён
+#define FLIGHT_H // определяет макрос FLIGHT_H чтобы предотвратить повторное включение
+
+#include <stdint.h> // подключает целые типы фиксированной ширины для записей журнала
+
+#include <atomic> // подключает счётчик записей, читаемый обработчиком сигнала
+#include <string> // подключает std::string для текста декодера
+
+#define FLIGHT_RING_SIZE 512 // записей в журнале сессии по умолчанию и наибольшая ёмкость кольца (степень двойки)
+#define FLIGHT_SESSION_RING 128 // записей в журнале игровой сессии: кольцо — отдельный блок SlabPool на 2 КБ
+#define FLIGHT_MAX_SESSIONS 256 // сессий, журналы которых сохраняются при падении процесса
+#define FLIGHT_PATH_MAX 256 // наибольшая длина пути файла дампов
+#define FLIGHT_ALT_STACK (64u << 10) // стек обработчика сигнала: дамп работает и при переполнении стека потока
+#define FLIGHT_VERSION 1 // версия формата дампа
+#define FLIGHT_DUMP_FILE "brickgame_flight.bin" // файл дампов фронтендов по умолчанию
+#define FLIGHT_ENV "BRICKGAME_FLIGHT" // переменная окружения с путём файла дампов
+
+typedef enum { // события журнала
+  FLIGHT_INPUT = 1, // ввод игрока: value — UserAction_t
+  FLIGHT_STATE, // переход КА: state — новое состояние, value — прежнее
+  FLIGHT_SPAWN, // появление фигуры (value — цвет) или яблока (value — номер клетки y * ширина + x)
+  FLIGHT_LOCK, // фигура легла: value — строка первого блока фигуры
+  FLIGHT_CLEAR, // удалены строки: value — их число
+  FLIGHT_DEADLINE, // сработал таймер падения или шага: value — скорость
+  FLIGHT_GAME_OVER, // партия окончена: value — код уровня
+  FLIGHT_EXCEPTION, // исключение вышло из шага КА
+  FLIGHT_KIND_COUNT // количество видов событий
+} FlightKind_t; // тип FlightKind_t — вид записи журнала
+
+typedef enum { // причина дампа
+  FLIGHT_REASON_LOSE = 1, // game_over с LOSE_LVL
+  FLIGHT_REASON_EXCEPTION, // исключение вышло из Game::fsm
+  FLIGHT_REASON_SIGNAL, // SIGSEGV или SIGABRT; в signal — номер сигнала
+  FLIGHT_REASON_MANUAL, // запрос программы (FlightRecorder::dump)
+  FLIGHT_REASON_OVERFLOW // при падении: total живых сессий без места в списке, их журналы не сохранены
+} FlightReason_t; // тип FlightReason_t — причина записи дампа
+
+typedef struct { // запись журнала (16 байт)
+  uint64_t ns; // время с создания сессии в наносекундах
+  uint16_t kind; // FlightKind_t
+  uint16_t state; // состояние КА в момент записи
+  int32_t value; // значение события
+} FlightRecord; // имя типа — FlightRecord
+
+typedef struct { // заголовок дампа одной сессии, за ним count записей по возрастанию времени
+  char magic[4]; // "BGFR"
+  uint16_t version; // FLIGHT_VERSION
+  uint16_t reason; // FlightReason_t
+  uint32_t signal; // номер сигнала для FLIGHT_REASON_SIGNAL
+  uint32_t count; // записей после заголовка
+  uint64_t session; // номер сессии в процессе
+  uint64_t total; // записей за жизнь сессии, включая вытесненные
+} FlightDumpHeader; // имя типа — FlightDumpHeader
+
+#define FLIGHT_DUMP_MAX (sizeof(FlightDumpHeader) + FLIGHT_RING_SIZE * sizeof(FlightRecord)) // наибольший дамп сессии
+
+bool flightInstall(const char* path); // прототип глобальной функции API: файл дампов, стек и обработчики SIGSEGV/SIGABRT (nullptr — дампы выключены)
+
+namespace s21 { // начало пространства имён s21
+
+/**
+ * @brief Журнал последних событий сессии («бортовой самописец»).
+ *
+ * Пишет только поток сессии: запись — копия 16 байт в кольцо и публикация счётчика,
+ * без блокировок и выделения памяти. Журнал всегда включён; дамп дописывается в файл
+ * flightInstall при поражении, вышедшем исключении или падении процесса. Запись дампа
+ * использует только open/write/close, поэтому вызывается и из обработчика сигнала.
+ *
+ * Для дампа при падении журнал занимает одно из FLIGHT_MAX_SESSIONS мест списка. Сессии
+ * сверх этого пишут журнал и сохраняют его при поражении и исключении, а при падении
+ * в файл попадает только запись FLIGHT_REASON_OVERFLOW с их числом. Обработчик сигнала
+ * занимает место списка на время дампа, и деструктор ждёт, пока он не освободит место.
+ */
+class FlightRecorder { // объявление журнала сессии
+ public: // публичная секция класса
+  explicit FlightRecorder(uint32_t capacity = FLIGHT_RING_SIZE); // кольцо capacity записей (степень двойки до FLIGHT_RING_SIZE), throw invalid_argument
+  ~FlightRecorder(); // снимает журнал с регистрации
+  FlightRecorder(const FlightRecorder&) = delete; // удалённый копирующий конструктор
+  FlightRecorder& operator=(const FlightRecorder&) = delete; // удалённый оператор присваивания
+
+  void record(FlightKind_t kind, int state, int32_t value); // запись события
+  bool dump(FlightReason_t reason, int signal = 0) const; // дописать журнал в файл дампов, false если файла нет
+  size_t dump_bytes(uint8_t* buf, FlightReason_t reason, int signal = 0) const; // дамп в buf на FLIGHT_DUMP_MAX байт, возвращает длину
+  size_t size() const; // записей в журнале
+  uint64_t total() const; // записей за жизнь сессии
+  uint32_t capacity() const; // ёмкость кольца
+  bool registered() const; // журнал сохраняется и при падении процесса
+
+ private: // приватная секция для данных журнала
+  FlightRecord* ring; // кольцо записей (блок SlabPool вне объекта сессии)
+  uint32_t mask; // ёмкость кольца минус один
+  int slot; // место в списке журналов для дампа при падении (-1 — мест не было)
+  std::atomic<uint64_t> head; // номер следующей записи
+  uint64_t session; // номер сессии в процессе
+  uint64_t origin_ns; // время создания сессии
+}; // конец объявления класса FlightRecorder
+
+const char* flight_kind_name(int kind); // имя вида события для декодера
+std::string flight_decode(const uint8_t* buf, size_t size); // текст дампов; \throw std::invalid_argument если дамп повреждён
+
+}  // namespace s21 // конец пространства имён s21
+
+#endif  // FLIGHT_H // конец защиты от повторного включения заголовка
@@ -0,0 +1,124 @@
+#include "pacing.h" // подключает объявление замеров кадров
+
+#include <stdio.h> // подключает fopen и fprintf для файла сводки
+#include <string.h> // подключает memset для обнуления гистограмм
+
+#include <chrono> // подключает steady_clock для времени кадров
+
+namespace s21 { // начало пространства имён s21
+
+static const char* const metric_names[PACING_METRIC_COUNT] = {"step", "render", "interval", "latency"}; // имена замеров
+
+FramePacer::FramePacer() : last_present(0), pending_input(0) { // пустые гистограммы
+  memset(series, 0, sizeof(series)); // все замеры обнулены
+} // конец конструктора
+
+uint64_t FramePacer::now_ns() { // монотонное время
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count(); // наносекунды
+} // конец метода now_ns
+
+void FramePacer::add(PacingMetric_t metric, uint64_t ns) { // значение замера
+  Series& s = series[metric]; // гистограммы замера
+  int slot = s.count & (PACING_WINDOW - 1); // место в кольце окна
+  if (s.count >= PACING_WINDOW) { // окно заполнено — вытесняем старейшее значение
+    s.window_buckets[stats_bucket(s.recent[slot])]--; // корзина вытесненного значения
+    s.window_sum_ns -= s.recent[slot]; // сумма окна
+  } // конец вытеснения
+  s.recent[slot] = ns; // новое значение окна
+  s.window_buckets[stats_bucket(ns)]++; // корзина окна
+  s.window_sum_ns += ns; // сумма окна
+  s.total_buckets[stats_bucket(ns)]++; // корзина за всё время
+  s.count++; // значений за всё время
+  s.sum_ns += ns; // сумма за всё время
+  if (ns > s.max_ns) s.max_ns = ns; // наибольшее значение
+} // конец метода add
+
+void FramePacer::input(uint64_t now) { // ввод игрока
+  if (pending_input == 0) pending_input = now; // задержка отсчитывается от первого ввода перед кадром
+} // конец метода input
+
+void FramePacer::presented(uint64_t now) { // кадр показан
+  if (last_present != 0) add(PACING_INTERVAL, now - last_present); // интервал от прошлого кадра
+  if (pending_input != 0) add(PACING_LATENCY, now - pending_input); // ввод виден на экране
+  last_present = now; // время кадра
+  pending_input = 0; // ввод обработан
+} // конец метода presented
+
+template <class Count>
+static uint64_t quantile_of(const Count* buckets, uint64_t count, double quantile) { // квантиль по корзинам
+  if (count == 0) return 0; // значений нет
+  uint64_t rank = (uint64_t)(quantile * count); // номер значения в порядке возрастания
+  if (rank >= count) rank = count - 1; // квантиль 1.0 — наибольшее
+  uint64_t seen = 0; // значений в просмотренных корзинах
+  int bucket = 0; // текущая корзина
+  for (; bucket < STATS_BUCKETS - 1; bucket++) { // корзины по возрастанию
+    seen += buckets[bucket]; // значения корзины
+    if (seen > rank) break; // значение с номером rank в этой корзине
+  } // конец перебора корзин
+  return stats_bucket_max(bucket); // верхняя граница корзины
+} // конец функции quantile_of
+
+PacingStats_t FramePacer::window(PacingMetric_t metric) const { // статистика окна
+  const Series& s = series[metric]; // гистограммы замера
+  uint64_t count = s.count < PACING_WINDOW ? s.count : PACING_WINDOW; // значений в окне
+  uint64_t max = 0; // наибольшее значение окна
+  for (uint64_t i = 0; i < count; i++) max = s.recent[i] > max ? s.recent[i] : max; // просмотр окна
+  PacingStats_t stats{}; // результат
+  stats.count = count; // значений
+  stats.mean_ms = count ? s.window_sum_ns / 1e6 / count : 0; // среднее
+  stats.p50_ms = quantile_of(s.window_buckets, count, 0.5) / 1e6; // медиана
+  stats.p99_ms = quantile_of(s.window_buckets, count, 0.99) / 1e6; // 99-й перцентиль
+  stats.max_ms = max / 1e6; // наибольшее
+  return stats; // статистика окна
+} // конец метода window
+
+PacingStats_t FramePacer::total(PacingMetric_t metric) const { // статистика за всё время
+  const Series& s = series[metric]; // гистограммы замера
+  PacingStats_t stats{}; // результат
+  stats.count = s.count; // значений
+  stats.mean_ms = s.count ? s.sum_ns / 1e6 / s.count : 0; // среднее
+  stats.p50_ms = quantile_of(s.total_buckets, s.count, 0.5) / 1e6; // медиана
+  stats.p99_ms = quantile_of(s.total_buckets, s.count, 0.99) / 1e6; // 99-й перцентиль
+  stats.max_ms = s.max_ns / 1e6; // наибольшее
+  return stats; // статистика за всё время
+} // конец метода total
+
+double FramePacer::fps() const { // кадров в секунду
+  PacingStats_t interval = window(PACING_INTERVAL); // интервалы последних кадров
+  return interval.mean_ms > 0 ? 1000.0 / interval.mean_ms : 0; // обратная величина среднего интервала
+} // конец метода fps
+
+/**
+ * @brief Строки оверлея по скользящему окну.
+ *
+ * Короткие (11 символов), чтобы поместиться в боковую панель консольного фронтенда.
+ */
+std::vector<std::string> FramePacer::overlay() const { // строки оверлея
+  char line[32]; // строка оверлея
+  std::vector<std::string> lines; // результат
+  snprintf(line, sizeof(line), "FPS %7.1f", fps()); // кадров в секунду
+  lines.push_back(line); // первая строка
+  snprintf(line, sizeof(line), "p99 %5.1fms", window(PACING_INTERVAL).p99_ms); // 99-й перцентиль времени кадра
+  lines.push_back(line); // вторая строка
+  snprintf(line, sizeof(line), "lag %5.1fms", window(PACING_LATENCY).p99_ms); // задержка от ввода до кадра
+  lines.push_back(line); // третья строка
+  return lines; // строки оверлея
+} // конец метода overlay
+
+bool FramePacer::write_summary(const char* path) const { // сводка в файл
+  FILE* file = fopen(path, "w"); // файл сводки (перезаписывается)
+  if (!file) return false; // файл не открылся
+  fprintf(file, "frames %llu, fps %.1f\n", (unsigned long long)(series[PACING_INTERVAL].count + (last_present != 0)),
+          total(PACING_INTERVAL).mean_ms > 0 ? 1000.0 / total(PACING_INTERVAL).mean_ms : 0); // кадров и средний FPS
+  fprintf(file, "%-9s %10s %9s %9s %9s %9s\n", "metric", "count", "mean_ms", "p50_ms", "p99_ms", "max_ms"); // заголовок
+  for (int m = 0; m < PACING_METRIC_COUNT; m++) { // замеры
+    PacingStats_t stats = total(PacingMetric_t(m)); // статистика за всё время
+    fprintf(file, "%-9s %10llu %9.3f %9.3f %9.3f %9.3f\n", metric_names[m], stats.count, stats.mean_ms, stats.p50_ms,
+            stats.p99_ms, stats.max_ms); // строка замера
+  } // конец цикла по замерам
+  fclose(file); // закрываем файл
+  return true; // сводка записана
+} // конец метода write_summary
+
+}  // namespace s21 // конец пространства имён s21
@@ -0,0 +1,75 @@
+#ifndef PACING_H // защита от повторного включения заголовка: если PACING_H не определён
+#define PACING_H // определяет макрос PACING_H чтобы предотвратить повторное включение
+
+#include <stdint.h> // подключает целые типы фиксированной ширины для замеров
+
+#include <string> // подключает std::string для строк оверлея
+#include <vector> // подключает std::vector для списка строк оверлея
+
+#include "stats.h" // подключает корзины гистограмм (stats_bucket)
+
+#define PACING_WINDOW 256 // кадров в скользящем окне оверлея (степень двойки)
+#define PACING_FILE "brickgame_pacing.txt" // файл сводки фронтендов по умолчанию
+#define PACING_ENV "BRICKGAME_PACING" // переменная окружения с путём файла сводки
+
+typedef enum { // замеры кадра
+  PACING_STEP = 0, // шаг движка (updateCurrentState)
+  PACING_RENDER, // отрисовка кадра
+  PACING_INTERVAL, // интервал между показанными кадрами
+  PACING_LATENCY, // от ввода до первого показанного после него кадра
+  PACING_METRIC_COUNT // количество замеров
+} PacingMetric_t; // тип PacingMetric_t — номер замера кадра
+
+typedef struct { // статистика одного замера
+  unsigned long long count; // замеров
+  double mean_ms; // среднее
+  double p50_ms; // медиана (верхняя граница корзины)
+  double p99_ms; // 99-й перцентиль (верхняя граница корзины)
+  double max_ms; // наибольшее значение
+} PacingStats_t; // имя типа — PacingStats_t
+
+namespace s21 { // начало пространства имён s21
+
+/**
+ * @brief Замеры темпа кадров фронтенда.
+ *
+ * Для каждого замера хранит гистограмму за всё время и скользящую гистограмму последних
+ * PACING_WINDOW значений: новое значение добавляется в корзину, вытесненное — вычитается,
+ * так что квантили окна считаются без сортировки. Корзины — те же, что у счётчиков
+ * состояний КА (stats_bucket). Время передаётся вызывающим, чтобы замеры были воспроизводимы.
+ */
+class FramePacer { // объявление замеров кадров
+ public: // публичная секция класса
+  FramePacer(); // пустые гистограммы
+
+  static uint64_t now_ns(); // монотонное время в наносекундах
+
+  void add(PacingMetric_t metric, uint64_t ns); // значение замера
+  void input(uint64_t now); // ввод игрока: задержка отсчитывается от первого ввода до показа кадра
+  void presented(uint64_t now); // кадр показан: интервал от прошлого кадра и задержка ввода
+
+  PacingStats_t window(PacingMetric_t metric) const; // статистика последних PACING_WINDOW значений
+  PacingStats_t total(PacingMetric_t metric) const; // статистика за всё время
+  double fps() const; // кадров в секунду по скользящему окну интервалов
+  std::vector<std::string> overlay() const; // строки оверлея: FPS, p99 кадра, задержка ввода
+  bool write_summary(const char* path) const; // сводка в текстовый файл, false если файл не открылся
+
+ private: // приватная секция для гистограмм
+  struct Series { // гистограммы одного замера
+    uint64_t recent[PACING_WINDOW]; // последние значения (кольцо)
+    uint32_t window_buckets[STATS_BUCKETS]; // гистограмма окна
+    uint64_t total_buckets[STATS_BUCKETS]; // гистограмма за всё время
+    uint64_t count; // значений за всё время
+    uint64_t sum_ns; // сумма за всё время
+    uint64_t max_ns; // наибольшее за всё время
+    uint64_t window_sum_ns; // сумма окна
+  }; // конец объявления Series
+
+  Series series[PACING_METRIC_COUNT]; // гистограммы замеров
+  uint64_t last_present; // время прошлого показанного кадра (0 — кадров не было)
+  uint64_t pending_input; // время первого ввода после прошлого кадра (0 — ввода не было)
+}; // конец объявления класса FramePacer
+
+}  // namespace s21 // конец пространства имён s21
+
+#endif  // PACING_H // конец защиты от повторного включения заголовка
@@ -0,0 +1,284 @@
+#include "replay.h" // подключает объявления записи и чтения повтора
+
+#include <fcntl.h> // подключает open для файла повтора
+#include <sys/mman.h> // подключает mmap для отображения файла
+#include <sys/stat.h> // подключает fstat для длины файла
+#include <unistd.h> // подключает close
+
+#include <algorithm> // подключает std::upper_bound для поиска тика по времени
+#include <chrono> // подключает steady_clock для времени тиков
+#include <memory> // подключает std::unique_ptr для записи повтора фронтенда
+#include <stdexcept> // подключает std::runtime_error для ошибок файла
+
+#include "rewind.h" // подключает XOR-разности снимков
+#include "snapshot.h" // подключает версию формата снимка
+
+namespace s21 { // начало пространства имён s21
+
+static int64_t replay_now_us() { // монотонное время в микросекундах
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count(); // от эпохи часов
+} // конец функции replay_now_us
+
+// ================= ReplayWriter ==================
+
+/**
+ * @brief Конструктор: создаёт файл и пишет заголовок.
+ * \throw std::runtime_error Если файл не создаётся.
+ * \throw std::invalid_argument Если интервал опорных снимков равен нулю.
+ */
+ReplayWriter::ReplayWriter(const char* path, size_t keyframe_interval)
+    : file(nullptr), offset(0), keyframe_interval(keyframe_interval), start_us(0), key_tick(0) { // пустой повтор
+  if (keyframe_interval == 0) throw std::invalid_argument("Error: Bad replay keyframe interval"); // опорный снимок нужен
+  file = fopen(path, "wb"); // файл повтора
+  if (!file) throw std::runtime_error("Error: Cannot create replay file"); // выбрасываем исключение
+  ReplayHeader header = {REPLAY_MAGIC, REPLAY_VERSION, 0, (uint32_t)keyframe_interval, SNAPSHOT_VERSION}; // заголовок
+  fwrite(&header, sizeof(header), 1, file); // заголовок в начало файла
+  offset = sizeof(header); // записи тиков идут следом
+} // конец конструктора
+
+ReplayWriter::~ReplayWriter() { finish(); } // индекс дописывается и при незавершённой записи
+
+size_t ReplayWriter::ticks() const { return index.size(); } // записанных тиков
+
+/**
+ * @brief Пишет тик: опорный снимок целиком или разность с опорным.
+ */
+void ReplayWriter::record(const Game& game) { // тик повтора
+  if (!file) return; // запись завершена
+  int64_t now = replay_now_us(); // время тика
+  if (index.empty()) start_us = now; // первый тик — начало отсчёта
+  scratch.resize(game.snapshot_size()); // снимок тика
+  game.save(scratch.data(), scratch.size()); // состояние сессии
+  bool need_key = key.size() != scratch.size() || index.size() - key_tick >= keyframe_interval; // пора делать опорный снимок или длина снимка изменилась
+  if (!need_key) { // разность с текущим опорным
+    delta_encode(key.data(), key.size(), scratch.data(), scratch.size(), &delta); // записи разности
+    need_key = delta.size() > scratch.size() / 2; // состояние изменилось почти целиком (новая партия)
+  } // конец кодирования разности
+  if (need_key) { // тик становится опорным
+    key = scratch; // копия снимка
+    key_tick = (uint32_t)index.size(); // номер опорного тика
+  } // конец создания опорного снимка
+  const std::vector<uint8_t>& payload = need_key ? scratch : delta; // запись тика
+  ReplayIndexEntry entry = {offset, now - start_us, (uint32_t)payload.size(), (uint32_t)scratch.size(), key_tick, 0}; // запись индекса
+  fwrite(payload.data(), 1, payload.size(), file); // запись тика в файл
+  offset += payload.size(); // следующая запись
+  index.push_back(entry); // индекс тиков
+} // конец метода record
+
+/**
+ * @brief Дописывает индекс и хвост, закрывает файл.
+ *
+ * Индекс выравнивается на 8 байт, чтобы читатель обращался к нему прямо в отображении.
+ * @return false если файл уже закрыт или запись не удалась
+ */
+bool ReplayWriter::finish() { // завершение файла
+  if (!file) return false; // файл уже закрыт
+  const uint8_t pad[8] = {0}; // выравнивание индекса
+  size_t gap = (8 - offset % 8) % 8; // байт до границы
+  fwrite(pad, 1, gap, file); // выравнивание
+  ReplayTrailer trailer = {offset + gap, index.size(), REPLAY_INDEX_MAGIC, 0}; // хвост файла
+  fwrite(index.data(), sizeof(ReplayIndexEntry), index.size(), file); // индекс тиков
+  fwrite(&trailer, sizeof(trailer), 1, file); // хвост
+  bool res = !ferror(file); // все записи удались
+  res = fclose(file) == 0 && res; // файл закрыт
+  file = nullptr; // запись завершена
+  return res; // результат записи
+} // конец метода finish
+
+// ================= ReplayReader ==================
+
+/**
+ * @brief Конструктор: отображает файл в память и проверяет заголовок, хвост и границы индекса.
+ *
+ * Записи тиков проверяются при обращении к ним, поэтому открытие не читает файл целиком.
+ * \throw std::runtime_error Если файла нет, он не дописан или повреждён.
+ */
+ReplayReader::ReplayReader(const char* path) : data(nullptr), size(0), header(nullptr), index(nullptr), count(0) { // пустое чтение
+  int fd = ::open(path, O_RDONLY); // файл повтора
+  if (fd < 0) throw std::runtime_error("Error: Cannot open replay file"); // файла нет
+  struct stat st; // сведения о файле
+  bool ok = fstat(fd, &st) == 0 && (size_t)st.st_size >= sizeof(ReplayHeader) + sizeof(ReplayTrailer); // длина файла
+  void* map = ok ? mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED; // отображение
+  ::close(fd); // отображение держит файл само
+  if (map == MAP_FAILED) throw std::runtime_error("Error: Bad replay file"); // короткий файл или ошибка отображения
+  data = (const uint8_t*)map; // начало отображения
+  size = (size_t)st.st_size; // длина отображения
+  madvise(map, size, MADV_RANDOM); // тики читаются вразброс — упреждающее чтение не нужно
+  header = (const ReplayHeader*)data; // заголовок в начале файла
+  const ReplayTrailer* trailer = (const ReplayTrailer*)(data + size - sizeof(ReplayTrailer)); // хвост в конце файла
+  ok = header->magic == REPLAY_MAGIC && header->version == REPLAY_VERSION && header->keyframe_interval > 0 &&
+       trailer->magic == REPLAY_INDEX_MAGIC && trailer->index_offset % 8 == 0 &&
+       trailer->index_offset >= sizeof(ReplayHeader) && trailer->index_offset <= size - sizeof(ReplayTrailer) &&
+       (size - sizeof(ReplayTrailer) - trailer->index_offset) % sizeof(ReplayIndexEntry) == 0 &&
+       trailer->ticks == (size - sizeof(ReplayTrailer) - trailer->index_offset) / sizeof(ReplayIndexEntry); // границы индекса без переполнения
+  if (!ok) { // не повтор или файл не дописан
+    munmap(map, size); // снимаем отображение
+    throw std::runtime_error("Error: Bad replay file"); // выбрасываем исключение
+  } // конец проверки файла
+  index = (const ReplayIndexEntry*)(data + trailer->index_offset); // индекс в отображении
+  count = (size_t)trailer->ticks; // тиков в файле
+} // конец конструктора
+
+ReplayReader::~ReplayReader() { munmap((void*)data, size); } // снимаем отображение
+
+size_t ReplayReader::ticks() const { return count; } // тиков в файле
+size_t ReplayReader::keyframe_interval() const { return header->keyframe_interval; } // интервал опорных снимков
+
+int64_t ReplayReader::time_us(size_t tick) const { // время тика
+  return tick < count ? index[tick].time_us : -1; // -1 — тика нет
+} // конец метода time_us
+
+/**
+ * @brief Последний тик не позже time_us — двоичный поиск по времени в индексе.
+ */
+size_t ReplayReader::tick_at(int64_t time_us) const { // тик по времени
+  const ReplayIndexEntry* found = std::upper_bound(index, index + count, time_us,
+      [](int64_t t, const ReplayIndexEntry& entry) { return t < entry.time_us; }); // первый тик позже time_us
+  return found == index ? 0 : (size_t)(found - index) - 1; // предыдущий тик
+} // конец метода tick_at
+
+/**
+ * @brief Снимок тика: копия опорного снимка и одна разность.
+ * @return false если тика нет, его записи выходят за индекс или разность повреждена
+ */
+bool ReplayReader::snapshot(size_t tick, std::vector<uint8_t>* out) const { // снимок тика
+  if (tick >= count) return false; // тика нет
+  const ReplayIndexEntry& entry = index[tick]; // запись тика
+  if (entry.key > tick) return false; // опорный снимок после тика — файл повреждён
+  const ReplayIndexEntry& key = index[entry.key]; // опорный снимок
+  const uint8_t* end = (const uint8_t*)index; // записи лежат до индекса
+  if (key.size != key.length || entry.length != key.length || key.offset > (size_t)(end - data) || key.size > (size_t)(end - data) - key.offset ||
+      entry.offset > (size_t)(end - data) || entry.size > (size_t)(end - data) - entry.offset) { // записи вне файла
+    return false; // файл повреждён
+  } // конец проверки границ
+  out->assign(data + key.offset, data + key.offset + key.size); // опорный снимок
+  if (entry.key != tick) return delta_apply(data + entry.offset, entry.size, out->data(), out->size()); // XOR с опорным, false если разность повреждена
+  return true; // снимок готов
+} // конец метода snapshot
+
+/**
+ * @brief Восстанавливает сессию на тик. Опорный тик восстанавливается прямо из отображения.
+ * @return false если тика нет или снимок другого движка
+ */
+bool ReplayReader::seek(Game* game, size_t tick) const { // сессия на тике
+  if (tick >= count) return false; // тика нет
+  const ReplayIndexEntry& entry = index[tick]; // запись тика
+  size_t records = (size_t)((const uint8_t*)index - data); // записи лежат до индекса
+  if (entry.key == tick && entry.size == entry.length && entry.offset <= records && entry.size <= records - entry.offset) { // опорный тик
+    return game->restore(data + entry.offset, entry.size); // без копирования
+  } // конец опорного тика
+  std::vector<uint8_t> buf; // снимок тика
+  return snapshot(tick, &buf) && game->restore(buf.data(), buf.size()); // опорный снимок и разность
+} // конец метода seek
+
+Game* ReplayReader::open(size_t tick) const { // новая сессия на тике
+  std::vector<uint8_t> buf; // снимок тика
+  if (!snapshot(tick, &buf)) return nullptr; // тика нет
+  try { // снимок мог быть повреждён
+    return GameFabric::restore_game(buf.data(), buf.size()); // сессия нужного движка
+  } catch (const std::invalid_argument&) { // неизвестный движок или неверный снимок
+    return nullptr; // сессии нет
+  } // конец обработки ошибки
+} // конец метода open
+
+// ================= ReplayPlayer ==================
+
+/**
+ * @brief Конструктор: открывает повтор и встаёт на первый тик.
+ * \throw std::runtime_error Если файл не открывается, пуст или первый тик не восстанавливается.
+ */
+ReplayPlayer::ReplayPlayer(const char* path)
+    : reader(path), game(nullptr), current(0), running(false), play_from_us(0), play_start_us(0) { // просмотр с начала
+  if (reader.ticks() == 0 || !show(0)) throw std::runtime_error("Error: Empty replay file"); // показывать нечего
+} // конец конструктора
+
+ReplayPlayer::~ReplayPlayer() { // удаление сессии просмотра
+  if (game) GameFabric::destroy_game(game); // сессия текущего тика
+} // конец деструктора
+
+/**
+ * @brief Восстанавливает сессию просмотра на тик.
+ *
+ * Если снимок принадлежит другому движку (в записи сменилась игра), сессия создаётся заново.
+ */
+bool ReplayPlayer::show(size_t tick) { // сессия на тике
+  if (game && reader.seek(game, tick)) { // тот же движок
+    current = tick; // текущий тик
+    return true; // тик показан
+  } // конец восстановления в ту же сессию
+  Game* next = reader.open(tick); // новая сессия
+  if (!next) return false; // тик не восстанавливается
+  if (game) GameFabric::destroy_game(game); // старая сессия
+  game = next; // сессия текущего тика
+  current = tick; // текущий тик
+  return true; // тик показан
+} // конец метода show
+
+bool ReplayPlayer::seek(size_t tick) { // переход на тик
+  running = false; // перемотка останавливает воспроизведение
+  return show(tick < reader.ticks() ? tick : reader.ticks() - 1); // тик или последний
+} // конец метода seek
+
+bool ReplayPlayer::seek_time(int64_t time_us) { return seek(reader.tick_at(time_us)); } // тик по времени
+
+void ReplayPlayer::toggle() { // воспроизведение или остановка
+  running = !running; // переключение
+  if (running && current + 1 >= reader.ticks()) show(0); // с конца воспроизведение начинается заново
+  play_from_us = reader.time_us(current); // время записи текущего тика
+  play_start_us = replay_now_us(); // момент начала
+} // конец метода toggle
+
+/**
+ * @brief Тик по времени воспроизведения: пропускает тики, если кадр опоздал.
+ */
+bool ReplayPlayer::update() { // шаг воспроизведения
+  if (!running) return false; // воспроизведение остановлено
+  size_t target = reader.tick_at(play_from_us + replay_now_us() - play_start_us); // тик текущего момента
+  if (target + 1 >= reader.ticks()) running = false; // повтор закончился
+  return target != current && show(target); // тик сменился
+} // конец метода update
+
+bool ReplayPlayer::playing() const { return running; } // идёт воспроизведение
+size_t ReplayPlayer::tick() const { return current; } // текущий тик
+size_t ReplayPlayer::ticks() const { return reader.ticks(); } // тиков в повторе
+int64_t ReplayPlayer::time_us() const { return reader.time_us(current); } // время текущего тика
+int64_t ReplayPlayer::duration_us() const { return reader.time_us(reader.ticks() - 1); } // время последнего тика
+const GameInfo_t& ReplayPlayer::gameinfo() const { return game->get_gameinfo(); } // состояние текущего тика
+
+}  // namespace s21 // конец пространства имён s21
+
+// ================= API ==================
+
+static std::unique_ptr<s21::ReplayWriter> replay_writer; // запись повтора фронтенда
+static int64_t replay_last[5]; // хэш и счётчики последнего записанного тика
+
+bool replayStart(const char* path) { // глобальная функция API для начала записи повтора
+  if (!path) return false; // путь не задан — запись выключена
+  try { // файл может не создаться
+    replay_writer.reset(new s21::ReplayWriter(path)); // новая запись
+  } catch (const std::runtime_error&) { // ошибка создания файла
+    return false; // повтор не пишется
+  } // конец обработки ошибки
+  return true; // запись начата
+} // конец функции replayStart
+
+/**
+ * @brief Тик повтора текущей игры: пишется, только если шаг изменил поле или счётчики.
+ *
+ * Фронтенды вызывают функцию после каждого updateCurrentState; шаги, ничего не изменившие
+ * (ожидание ввода), в повтор не попадают.
+ */
+void replayRecord() { // глобальная функция API для тика повтора
+  s21::Game* game = s21::GameFabric::get_game(); // текущая игра
+  if (!replay_writer || !game) return; // запись выключена или игры нет
+  const GameInfo_t& info = game->get_gameinfo(); // счётчики игры
+  int64_t state[5] = {(int64_t)game->state_hash(), info.score, info.level, info.speed, info.pause}; // признаки тика
+  if (replay_writer->ticks() > 0 && std::equal(state, state + 5, replay_last)) return; // состояние не изменилось
+  std::copy(state, state + 5, replay_last); // признаки записанного тика
+  replay_writer->record(*game); // тик в файл
+} // конец функции replayRecord
+
+void replayStop() { // глобальная функция API для завершения записи повтора
+  if (replay_writer) replay_writer->finish(); // индекс и хвост
+  replay_writer.reset(); // запись выключена
+} // конец функции replayStop
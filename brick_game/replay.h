@@ -0,0 +1,154 @@
+#ifndef REPLAY_H // защита от повторного включения заголовка: если REPLAY_H не определён
+#define REPLAY_H // определяет макрос REPLAY_H чтобы предотвратить повторное включение
+
+#include <stddef.h> // подключает size_t для номеров тиков
+#include <stdint.h> // подключает целые типы фиксированной ширины
+#include <stdio.h> // подключает FILE для записи файла повтора
+
+#include <vector> // подключает std::vector для снимков
+
+#include "brick_game_single.h" // подключает класс Game и его снимки
+
+#define REPLAY_MAGIC 0x50524742u // сигнатура файла повтора "BGRP"
+#define REPLAY_INDEX_MAGIC 0x58444952u // сигнатура хвоста с индексом "RIDX"
+#define REPLAY_VERSION 1 // версия формата файла повтора
+#define REPLAY_KEYFRAME_INTERVAL 256 // тиков между опорными снимками
+#define REPLAY_ENV "BRICKGAME_REPLAY" // переменная окружения с путём файла повтора для фронтендов
+
+bool replayStart(const char* path); // прототип глобальной функции API: начать запись повтора текущей игры в path (nullptr — ничего не делать)
+void replayRecord(); // прототип глобальной функции API: тик повтора после шага, если состояние изменилось
+void replayStop(); // прототип глобальной функции API: дописать индекс и закрыть файл повтора
+
+namespace s21 { // начало пространства имён s21
+
+/**
+ * @brief Заголовок файла повтора.
+ *
+ * Файл: заголовок, записи тиков, индекс из ticks записей ReplayIndexEntry и хвост
+ * ReplayTrailer в самом конце. Числа хранятся в порядке байтов машины, как и снимки.
+ */
+typedef struct ReplayHeader { // заголовок файла
+  uint32_t magic; // REPLAY_MAGIC
+  uint16_t version; // REPLAY_VERSION
+  uint16_t reserved; // выравнивание
+  uint32_t keyframe_interval; // тиков между опорными снимками
+  uint32_t snapshot_version; // SNAPSHOT_VERSION снимков файла
+} ReplayHeader; // имя типа — ReplayHeader
+
+typedef struct ReplayIndexEntry { // запись индекса — один тик
+  uint64_t offset; // смещение записи тика от начала файла
+  int64_t time_us; // микросекунд от первого тика
+  uint32_t size; // длина записи тика
+  uint32_t length; // длина снимка тика
+  uint32_t key; // номер тика опорного снимка (равен своему номеру — запись и есть снимок)
+  uint32_t reserved; // выравнивание
+} ReplayIndexEntry; // имя типа — ReplayIndexEntry
+
+typedef struct ReplayTrailer { // хвост файла
+  uint64_t index_offset; // смещение индекса от начала файла
+  uint64_t ticks; // тиков в файле
+  uint32_t magic; // REPLAY_INDEX_MAGIC
+  uint32_t reserved; // выравнивание
+} ReplayTrailer; // имя типа — ReplayTrailer
+
+/**
+ * @brief Запись повтора в файл.
+ *
+ * Каждый тик — снимок Game::save. Опорный снимок пишется целиком каждые keyframe_interval
+ * тиков, когда разность с прошлым опорным больше половины снимка (новая партия) или когда
+ * меняется длина снимка (змейка выросла) — разность всегда той же длины, что и опорный; остальные тики хранятся XOR-разностью с опорным (delta_encode, rewind.h) — десятки
+ * байт на тик. Индекс тиков копится в памяти и пишется в конец файла в finish.
+ */
+class ReplayWriter { // объявление записи повтора
+ public: // публичная секция класса
+  explicit ReplayWriter(const char* path, size_t keyframe_interval = REPLAY_KEYFRAME_INTERVAL); // throw runtime_error
+  ~ReplayWriter(); // дописывает индекс, если finish не вызывался
+  ReplayWriter(const ReplayWriter&) = delete; // удалённый копирующий конструктор
+  ReplayWriter& operator=(const ReplayWriter&) = delete; // удалённый оператор присваивания
+
+  void record(const Game& game); // тик: снимок сессии после шага
+  bool finish(); // индекс и хвост в файл, закрытие файла
+  size_t ticks() const; // записанных тиков
+
+ private: // приватная секция для внутренних данных
+  FILE* file; // файл повтора (nullptr после finish)
+  uint64_t offset; // позиция записи в файле
+  size_t keyframe_interval; // тиков между опорными снимками
+  int64_t start_us; // время первого тика
+  std::vector<ReplayIndexEntry> index; // индекс тиков
+  std::vector<uint8_t> key; // текущий опорный снимок
+  uint32_t key_tick; // номер тика опорного снимка
+  std::vector<uint8_t> scratch; // снимок тика
+  std::vector<uint8_t> delta; // разность тика с опорным
+}; // конец объявления класса ReplayWriter
+
+/**
+ * @brief Чтение повтора через mmap.
+ *
+ * Файл отображается в память целиком и только для чтения; индекс и записи тиков
+ * читаются прямо из отображения. Любой тик восстанавливается опорным снимком и одной
+ * разностью — время перехода не зависит от номера тика и длины записи, поэтому
+ * повтор можно листать и выбирать случайные тики без декодирования с начала.
+ */
+class ReplayReader { // объявление чтения повтора
+ public: // публичная секция класса
+  explicit ReplayReader(const char* path); // throw runtime_error, если файла нет или он повреждён
+  ~ReplayReader(); // снимает отображение файла
+  ReplayReader(const ReplayReader&) = delete; // удалённый копирующий конструктор
+  ReplayReader& operator=(const ReplayReader&) = delete; // удалённый оператор присваивания
+
+  size_t ticks() const; // тиков в файле
+  size_t keyframe_interval() const; // тиков между опорными снимками при записи
+  int64_t time_us(size_t tick) const; // микросекунд от первого тика до тика tick
+  size_t tick_at(int64_t time_us) const; // последний тик не позже time_us
+  bool snapshot(size_t tick, std::vector<uint8_t>* out) const; // снимок тика, false если тика нет
+  bool seek(Game* game, size_t tick) const; // восстановление сессии game на тик tick
+  Game* open(size_t tick) const; // новая сессия на тике tick (GameFabric::destroy_game), nullptr при ошибке
+
+ private: // приватная секция для внутренних данных
+  const uint8_t* data; // отображение файла
+  size_t size; // длина файла
+  const ReplayHeader* header; // заголовок файла
+  const ReplayIndexEntry* index; // индекс тиков в отображении
+  size_t count; // тиков в файле
+}; // конец объявления класса ReplayReader
+
+/**
+ * @brief Просмотр повтора для фронтендов: текущий тик, перемотка и воспроизведение.
+ *
+ * Держит сессию, восстановленную на текущий тик. При воспроизведении тик выбирается по
+ * времени записи, поэтому повтор идёт с той же скоростью, что и партия.
+ */
+class ReplayPlayer { // объявление просмотра повтора
+ public: // публичная секция класса
+  explicit ReplayPlayer(const char* path); // открывает файл и встаёт на первый тик, throw runtime_error
+  ~ReplayPlayer(); // удаляет сессию просмотра
+  ReplayPlayer(const ReplayPlayer&) = delete; // удалённый копирующий конструктор
+  ReplayPlayer& operator=(const ReplayPlayer&) = delete; // удалённый оператор присваивания
+
+  bool seek(size_t tick); // переход на тик (за пределами — на крайний), останавливает воспроизведение
+  bool seek_time(int64_t time_us); // переход на последний тик не позже time_us
+  void toggle(); // воспроизведение или остановка
+  bool update(); // тик по времени при воспроизведении, true если тик сменился
+  bool playing() const; // идёт воспроизведение
+
+  size_t tick() const; // текущий тик
+  size_t ticks() const; // тиков в повторе
+  int64_t time_us() const; // время текущего тика от начала записи
+  int64_t duration_us() const; // время последнего тика
+  const GameInfo_t& gameinfo() const; // состояние игры на текущем тике
+
+ private: // приватная секция для внутренних данных
+  bool show(size_t tick); // восстановление сессии на тик
+
+  ReplayReader reader; // файл повтора
+  Game* game; // сессия текущего тика
+  size_t current; // текущий тик
+  bool running; // идёт воспроизведение
+  int64_t play_from_us; // время записи, с которого начато воспроизведение
+  int64_t play_start_us; // момент начала воспроизведения
+}; // конец объявления класса ReplayPlayer
+
+}  // namespace s21 // конец пространства имён s21
+
+#endif  // REPLAY_H // конец защиты от повторного включения заголовка
@@ -0,0 +1,168 @@
+#include "rewind.h" // подключает объявление класса RewindBuffer
+
+#include <stdexcept> // подключает стандартные исключения
+
+namespace s21 { // начало пространства имён s21
+
+/**
+ * @brief Конструктор.
+ *
+ * Ячейки выделяются сразу, их буферы разностей растут только на первых кругах.
+ * \throw std::invalid_argument Если ёмкость или интервал опорных снимков равны нулю.
+ */
+RewindBuffer::RewindBuffer(size_t capacity, size_t keyframe_interval)
+    : ring(capacity), first(0), count(0), keyframe_interval(keyframe_interval), since_key(0) { // пустой буфер
+  if (capacity == 0 || keyframe_interval == 0) { // буфер не может хранить шаги
+    throw std::invalid_argument("Error: Empty rewind buffer"); // выбрасываем исключение о размере буфера
+  } // конец проверки размеров
+} // конец конструктора
+
+size_t RewindBuffer::size() const { return count; } // сохранённых шагов
+size_t RewindBuffer::capacity() const { return ring.size(); } // наибольшее число шагов
+
+size_t RewindBuffer::memory() const { // байт в разностях и опорных снимках
+  size_t total = 0; // сумма
+  const std::vector<uint8_t>* last = nullptr; // опорный снимок предыдущего шага
+  for (size_t i = 0; i < count; i++) { // шаги от старого к новому
+    const Entry& item = ring[(first + i) % ring.size()]; // шаг
+    total += item.delta.size(); // разность
+    if (item.key.get() != last) total += item.key->size(); // опорный снимок учитывается один раз
+    last = item.key.get(); // шаги одного опорного снимка идут подряд
+  } // конец цикла по шагам
+  return total; // байт
+} // конец метода memory
+
+const RewindBuffer::Entry& RewindBuffer::entry(size_t ticks_back) const { // шаг ticks_back назад
+  return ring[(first + count - 1 - ticks_back) % ring.size()]; // от последнего шага к старым
+} // конец метода entry
+
+/**
+ * @brief Сохраняет снимок сессии после шага.
+ *
+ * При заполненном буфере перезаписывается самый старый шаг.
+ */
+void RewindBuffer::record(const Game& game) { // сохранение шага
+  scratch.resize(game.snapshot_size()); // снимок шага
+  game.save(scratch.data(), scratch.size()); // состояние сессии
+  Entry* slot = nullptr; // ячейка шага
+  if (count < ring.size()) { // есть свободная ячейка
+    slot = &ring[(first + count) % ring.size()]; // следующая ячейка
+    count++; // шагов стало больше
+  } else { // буфер заполнен
+    slot = &ring[first]; // самый старый шаг
+    first = (first + 1) % ring.size(); // старым становится следующий
+  } // конец выбора ячейки
+  slot->length = (uint32_t)scratch.size(); // длина снимка
+  bool need_key = !key || since_key >= keyframe_interval; // пора делать опорный снимок
+  if (!need_key) { // разность с текущим опорным
+    encode(*key, slot); // записи разности
+    need_key = slot->delta.size() > scratch.size() / 2; // состояние изменилось почти целиком (новая партия)
+  } // конец кодирования разности
+  if (need_key) { // шаг становится опорным
+    key = std::make_shared<const std::vector<uint8_t>>(scratch); // копия снимка
+    slot->delta.clear(); // разность пуста
+    since_key = 0; // отсчёт до следующего опорного
+  } // конец создания опорного снимка
+  slot->key = key; // опорный снимок шага
+  since_key++; // шагов с опорного снимка
+} // конец метода record
+
+void RewindBuffer::encode(const std::vector<uint8_t>& base, Entry* out) const { // разность с опорным
+  delta_encode(base.data(), base.size(), scratch.data(), scratch.size(), &out->delta); // записи строятся заново, память ячейки сохраняется
+} // конец метода encode
+
+void RewindBuffer::decode(const Entry& in, std::vector<uint8_t>* snapshot) const { // снимок шага
+  snapshot->assign(in.key->begin(), in.key->end()); // опорный снимок
+  snapshot->resize(in.length, 0); // длина шага, новые байты нулевые
+  delta_apply(in.delta.data(), in.delta.size(), snapshot->data(), snapshot->size()); // XOR с опорным, разность своя и всегда верна
+} // конец метода decode
+
+/**
+ * @brief Снимок шага ticks_back назад (0 — последний сохранённый шаг).
+ * @return false если столько шагов в буфере нет
+ */
+bool RewindBuffer::peek(size_t ticks_back, std::vector<uint8_t>* snapshot) const { // снимок без отката
+  if (ticks_back >= count) return false; // шага нет в буфере
+  decode(entry(ticks_back), snapshot); // снимок шага
+  return true; // снимок готов
+} // конец метода peek
+
+/**
+ * @brief Откатывает сессию на ticks_back шагов назад.
+ *
+ * Шаги новее восстановленного удаляются, следующий record продолжает от него.
+ * @return false если шага нет в буфере или сессия не приняла снимок
+ */
+bool RewindBuffer::rewind(Game* game, size_t ticks_back) { // откат сессии
+  if (ticks_back >= count) return false; // шага нет в буфере
+  decode(entry(ticks_back), &scratch); // снимок шага
+  bool res = game->restore(scratch.data(), scratch.size()); // состояние сессии
+  if (res) { // откат выполнен
+    count -= ticks_back; // более поздние шаги удалены
+    key = entry(0).key; // опорный снимок восстановленного шага
+    since_key = 0; // шаги с этим опорным снимком
+    while (since_key < count && entry(since_key).key == key) since_key++; // подряд идущие шаги
+  } // конец учёта отката
+  return res; // результат отката
+} // конец метода rewind
+
+void RewindBuffer::clear() { // удаление всех шагов
+  for (Entry& item : ring) { // ячейки
+    item.key.reset(); // опорный снимок больше не нужен
+    item.delta.clear(); // разность
+  } // конец цикла по ячейкам
+  first = 0; // буфер пуст
+  count = 0; // шагов нет
+  since_key = 0; // опорного снимка нет
+  key.reset(); // опорный снимок освобождён
+} // конец метода clear
+
+/**
+ * @brief Кодирует XOR-разность снимка data с опорным снимком base.
+ *
+ * Байты за концом опорного снимка считаются нулевыми. Отличающиеся байты, разделённые
+ * менее чем REWIND_MERGE_GAP совпадающими, объединяются в одну запись.
+ */
+void delta_encode(const uint8_t* base, size_t base_size, const uint8_t* data, size_t size,
+                  std::vector<uint8_t>* out) { // разность с опорным
+  auto base_at = [&](size_t i) -> uint8_t { return i < base_size ? base[i] : 0; }; // байт опорного снимка
+  out->clear(); // записи строятся заново
+  size_t i = 0; // позиция после прошлой записи
+  while (i < size) { // поиск отличающихся байтов
+    size_t begin = i; // начало записи
+    while (begin < size && data[begin] == base_at(begin)) begin++; // совпадающие байты
+    if (begin == size) break; // отличий больше нет
+    size_t skip = begin - i; // пропуск до записи
+    while (skip > REWIND_MAX_RUN) { // пропуск длиннее поля u16
+      const uint8_t empty[REWIND_RECORD_HEAD] = {0xff, 0xff, 0, 0}; // запись без байтов
+      out->insert(out->end(), empty, empty + REWIND_RECORD_HEAD); // только пропуск
+      skip -= REWIND_MAX_RUN; // остаток пропуска
+    } // конец записи длинного пропуска
+    size_t end = begin; // конец отличающихся байтов
+    for (size_t k = begin; k < size && k - begin < REWIND_MAX_RUN && k - end < REWIND_MERGE_GAP; k++) { // запись
+      if (data[k] != base_at(k)) end = k + 1; // отличающийся байт продлевает запись
+    } // конец поиска конца записи
+    size_t run = end - begin; // длина записи
+    const uint8_t head[REWIND_RECORD_HEAD] = {(uint8_t)skip, (uint8_t)(skip >> 8), (uint8_t)run,
+                                              (uint8_t)(run >> 8)}; // заголовок записи
+    out->insert(out->end(), head, head + REWIND_RECORD_HEAD); // заголовок
+    for (size_t k = begin; k < end; k++) out->push_back(data[k] ^ base_at(k)); // XOR байтов
+    i = end; // продолжаем после записи
+  } // конец прохода по снимку
+} // конец функции delta_encode
+
+bool delta_apply(const uint8_t* delta, size_t size, uint8_t* snapshot, size_t snapshot_size) { // применение разности
+  size_t pos = 0; // позиция в снимке
+  const uint8_t* end = delta + size; // конец разности
+  while (delta + REWIND_RECORD_HEAD <= end) { // записи по порядку
+    size_t skip = delta[0] | (delta[1] << 8); // пропуск
+    size_t run = delta[2] | (delta[3] << 8); // длина записи
+    delta += REWIND_RECORD_HEAD; // байты записи
+    if (run > (size_t)(end - delta) || skip > snapshot_size - pos || run > snapshot_size - pos - skip) return false; // запись вне разности или снимка
+    pos += skip; // начало записи
+    for (size_t k = 0; k < run; k++) snapshot[pos++] ^= *delta++; // XOR с опорным
+  } // конец применения записей
+  return delta == end; // оборванный заголовок — разность повреждена
+} // конец функции delta_apply
+
+}  // namespace s21 // конец пространства имён s21
@@ -0,0 +1,75 @@
+#ifndef REWIND_H // защита от повторного включения заголовка: если REWIND_H не определён
+#define REWIND_H // определяет макрос REWIND_H чтобы предотвратить повторное включение
+
+#include <stddef.h> // подключает size_t для номеров шагов
+#include <stdint.h> // подключает целые типы фиксированной ширины
+
+#include <memory> // подключает std::shared_ptr для опорных снимков, общих для нескольких шагов
+#include <vector> // подключает std::vector для кольцевого буфера и разностей
+
+#include "brick_game_single.h" // подключает класс Game и его снимки
+
+#define REWIND_KEYFRAME_INTERVAL 64 // шагов между опорными снимками
+#define REWIND_MERGE_GAP 4 // совпадающих байт, которые выгоднее включить в разность, чем начинать новую запись
+#define REWIND_RECORD_HEAD 4 // длина заголовка записи разности {пропуск u16, длина u16}
+#define REWIND_MAX_RUN 65535 // наибольший пропуск или длина записи разности
+
+namespace s21 { // начало пространства имён s21
+
+void delta_encode(const uint8_t* base, size_t base_size, const uint8_t* data, size_t size,
+                  std::vector<uint8_t>* out); // XOR-разность снимка data с опорным base (записи {пропуск u16, длина u16, байты})
+bool delta_apply(const uint8_t* delta, size_t size, uint8_t* snapshot,
+                 size_t snapshot_size); // применение разности к копии опорного снимка длины шага, false если записи выходят за разность или снимок
+
+/**
+ * @brief Буфер отката последних шагов сессии.
+ *
+ * После каждого шага record сохраняет снимок Game::save как XOR-разность с последним
+ * опорным снимком: совпадающие байты пропускаются, отличающиеся хранятся записями
+ * {пропуск u16, длина u16, байты}. Шаг тетриса меняет несколько клеток поля и счётчики,
+ * поэтому разность занимает десятки байт вместо полного поля. Опорный снимок делается
+ * каждые keyframe_interval шагов или когда разность становится больше половины снимка.
+ * Любой из последних capacity шагов восстанавливается одной разностью без цепочки;
+ * опорный снимок живёт, пока на него ссылается хотя бы один шаг в буфере, поэтому память
+ * ограничена capacity разностями и capacity / keyframe_interval + 1 опорными снимками.
+ * Буфер разностей ячейки переиспользуется: после заполнения буфера record выделяет память
+ * только под новые опорные снимки.
+ */
+class RewindBuffer { // объявление буфера отката
+ public: // публичная секция класса
+  explicit RewindBuffer(size_t capacity, size_t keyframe_interval = REWIND_KEYFRAME_INTERVAL); // буфер на capacity шагов
+
+  void record(const Game& game); // сохранение состояния после шага
+  bool rewind(Game* game, size_t ticks_back); // откат сессии на ticks_back шагов назад, более поздние шаги удаляются
+  bool peek(size_t ticks_back, std::vector<uint8_t>* snapshot) const; // снимок шага без отката (разбор перед GameOver)
+  void clear(); // удаление всех шагов
+
+  size_t size() const; // сохранённых шагов
+  size_t capacity() const; // наибольшее число шагов
+  size_t memory() const; // байт в разностях и опорных снимках
+
+ private: // приватная секция для внутренних структур и данных
+  using Keyframe = std::shared_ptr<const std::vector<uint8_t>>; // опорный снимок, общий для шагов до следующего опорного
+
+  struct Entry { // сохранённый шаг
+    Keyframe key; // опорный снимок шага
+    std::vector<uint8_t> delta; // записи XOR-разности с опорным снимком
+    uint32_t length = 0; // длина снимка шага
+  }; // конец объявления Entry
+
+  const Entry& entry(size_t ticks_back) const; // шаг ticks_back назад
+  void encode(const std::vector<uint8_t>& base, Entry* out) const; // разность снимка scratch с опорным base
+  void decode(const Entry& in, std::vector<uint8_t>* snapshot) const; // снимок шага из опорного и разности
+
+  std::vector<Entry> ring; // кольцевой буфер шагов
+  size_t first; // ячейка самого старого шага
+  size_t count; // сохранённых шагов
+  size_t keyframe_interval; // шагов между опорными снимками
+  size_t since_key; // шагов с последнего опорного снимка
+  Keyframe key; // текущий опорный снимок
+  std::vector<uint8_t> scratch; // снимок текущего шага
+}; // конец объявления класса RewindBuffer
+
+}  // namespace s21 // конец пространства имён s21
+
+#endif  // REWIND_H // конец защиты от повторного включения заголовка
@@ -0,0 +1,99 @@
+#include "slab.h" // подключает объявление slab-распределителя
+
+#include <sys/mman.h> // подключает mmap и madvise для чанков
+
+#include <mutex> // подключает std::mutex для сессий, создаваемых из разных потоков
+#include <new> // подключает std::bad_alloc и operator new для больших блоков
+
+namespace s21 { // начало пространства имён s21
+
+static std::mutex slab_lock; // защита списков и текущего чанка
+static void* free_lists[SLAB_CLASSES]; // свободные блоки каждого класса (ссылка на следующий — в самом блоке)
+static char* cursor = nullptr; // начало ненарезанной части текущего чанка
+static char* limit = nullptr; // конец текущего чанка
+static size_t mapped_bytes = 0; // байт в чанках
+static size_t used_bytes = 0; // байт в выданных блоках
+static bool huge_pages = false; // чанки на больших страницах
+
+static void push_free(void* block, size_t size) { // блок в список своего класса
+  void** link = (void**)block; // ссылка на следующий свободный блок
+  *link = free_lists[size / SLAB_ALIGN - 1]; // прежний первый блок
+  free_lists[size / SLAB_ALIGN - 1] = block; // новый первый блок
+} // конец функции push_free
+
+/**
+ * @brief Получает новый чанк от системы.
+ *
+ * Остаток прежнего чанка раздаётся по спискам классов наибольшими блоками, поэтому
+ * память не теряется. Без больших страниц (или если они не настроены) чанк получается
+ * обычным mmap, а с ними — ещё и помечается madvise для прозрачных больших страниц.
+ */
+static void map_chunk() { // новый чанк
+  while (limit - cursor >= SLAB_ALIGN) { // остаток прежнего чанка
+    size_t rest = (size_t)(limit - cursor); // ненарезанные байты
+    size_t block = (rest < SLAB_MAX_BLOCK ? rest : SLAB_MAX_BLOCK) / SLAB_ALIGN * SLAB_ALIGN; // наибольший блок остатка
+    push_free(cursor, block); // блок в список класса
+    cursor += block; // остаток короче
+  } // конец раздачи остатка
+  void* chunk = MAP_FAILED; // новый чанк
+  if (huge_pages) chunk = mmap(nullptr, SLAB_CHUNK_SIZE, PROT_READ | PROT_WRITE,
+                               MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0); // заранее выделенные большие страницы
+  if (chunk == MAP_FAILED) { // большие страницы не нужны или не настроены
+    chunk = mmap(nullptr, SLAB_CHUNK_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0); // обычные страницы
+    if (chunk == MAP_FAILED) throw std::bad_alloc(); // память не выделена
+    if (huge_pages) madvise(chunk, SLAB_CHUNK_SIZE, MADV_HUGEPAGE); // прозрачные большие страницы, если ядро разрешает
+  } // конец получения чанка
+  cursor = (char*)chunk; // нарезка с начала чанка
+  limit = cursor + SLAB_CHUNK_SIZE; // конец чанка
+  mapped_bytes += SLAB_CHUNK_SIZE; // байт в чанках
+} // конец функции map_chunk
+
+size_t SlabPool::block_size(size_t size) { // размер блока
+  return size ? (size + SLAB_ALIGN - 1) / SLAB_ALIGN * SLAB_ALIGN : SLAB_ALIGN; // кратно строке кэша
+} // конец метода block_size
+
+void* SlabPool::allocate(size_t size) { // выделение блока
+  size_t block = block_size(size); // размер блока
+  if (block > SLAB_MAX_BLOCK) return ::operator new(size); // большой блок — обычным распределителем
+  std::lock_guard<std::mutex> guard(slab_lock); // списки общие для всех потоков
+  void*& head = free_lists[block / SLAB_ALIGN - 1]; // список класса
+  void* result = head; // первый свободный блок
+  if (result) { // блок из списка
+    head = *(void**)result; // следующий свободный блок
+  } else { // список пуст — блок из чанка
+    if ((size_t)(limit - cursor) < block) map_chunk(); // чанк кончился
+    result = cursor; // блок с начала ненарезанной части
+    cursor += block; // ненарезанная часть короче
+  } // конец выбора блока
+  used_bytes += block; // байт в выданных блоках
+  return result; // блок
+} // конец метода allocate
+
+void SlabPool::deallocate(void* block, size_t size) { // возврат блока
+  if (!block) return; // пустой указатель
+  size_t bytes = block_size(size); // размер блока
+  if (bytes > SLAB_MAX_BLOCK) { // большой блок
+    ::operator delete(block); // обычным распределителем
+    return; // в списки не попадает
+  } // конец проверки размера
+  std::lock_guard<std::mutex> guard(slab_lock); // списки общие для всех потоков
+  push_free(block, bytes); // блок в список класса
+  used_bytes -= bytes; // байт в выданных блоках
+} // конец метода deallocate
+
+void SlabPool::use_huge_pages(bool enable) { // большие страницы для новых чанков
+  std::lock_guard<std::mutex> guard(slab_lock); // флаг читается при получении чанка
+  huge_pages = enable; // полученные чанки не меняются
+} // конец метода use_huge_pages
+
+size_t SlabPool::mapped() { // байт в чанках
+  std::lock_guard<std::mutex> guard(slab_lock); // счётчик меняется под блокировкой
+  return mapped_bytes; // байт в чанках
+} // конец метода mapped
+
+size_t SlabPool::in_use() { // байт в выданных блоках
+  std::lock_guard<std::mutex> guard(slab_lock); // счётчик меняется под блокировкой
+  return used_bytes; // байт в выданных блоках
+} // конец метода in_use
+
+}  // namespace s21 // конец пространства имён s21
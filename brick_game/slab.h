@@ -0,0 +1,38 @@
+#ifndef SLAB_H // защита от повторного включения заголовка: если SLAB_H не определён
+#define SLAB_H // определяет макрос SLAB_H чтобы предотвратить повторное включение
+
+#include <stddef.h> // подключает size_t для размеров блоков
+
+#define SLAB_ALIGN 64 // выравнивание и шаг размеров блоков (строка кэша)
+#define SLAB_CHUNK_SIZE (2u << 20) // размер чанка, который slab получает от системы (одна большая страница)
+#define SLAB_MAX_BLOCK (64u << 10) // наибольший блок slab, большие запросы идут в operator new
+#define SLAB_CLASSES (SLAB_MAX_BLOCK / SLAB_ALIGN) // классов размеров блоков
+
+namespace s21 { // начало пространства имён s21
+
+/**
+ * @brief Slab-распределитель блоков сессий.
+ *
+ * Блоки выравнены по строке кэша и округляются вверх до SLAB_ALIGN, у каждого класса
+ * размеров свой список свободных блоков, который хранится в самих блоках. Новые блоки
+ * нарезаются подряд из чанков SLAB_CHUNK_SIZE, полученных через mmap, остаток чанка
+ * раздаётся по спискам классов. Выделение и освобождение стоят O(1) и не вызывают malloc;
+ * чанки не возвращаются системе до завершения процесса. Блоки больше SLAB_MAX_BLOCK
+ * (поле очень большой арены) выделяются обычным operator new.
+ *
+ * Сессия тетриса 20x10 занимает четыре блока: объект (512 Б), журнал полёта (2 КБ),
+ * поле со строками (960 Б) и область next (256 Б) — 3776 байт.
+ */
+class SlabPool { // объявление slab-распределителя
+ public: // публичная секция класса
+  static void* allocate(size_t size); // блок не меньше size байт, throw std::bad_alloc если память не выделена
+  static void deallocate(void* block, size_t size); // возврат блока, выделенного allocate(size)
+  static size_t block_size(size_t size); // размер блока, который выдаётся на запрос size
+  static void use_huge_pages(bool enable); // новые чанки на больших страницах (MAP_HUGETLB или madvise)
+  static size_t mapped(); // байт в полученных чанках
+  static size_t in_use(); // байт в выданных блоках slab
+}; // конец объявления класса SlabPool
+
+}  // namespace s21 // конец пространства имён s21
+
+#endif  // SLAB_H // конец защиты от повторного включения заголовка
@@ -1,4 +1,11 @@
 #include "snake.h"  // Подключение заголовочного файла с описанием класса Snake и зависимостями
+#include "snake_defines.h"  // Подключение общих констант змейки и арены
+
+#include <algorithm>  // Подключение std::copy для восстановления тела змейки
+
+#include "../snapshot.h"  // Подключение формата снимка состояния
+#include "../stats.h"  // Подключение счётчиков событий
+#include "../trace.h"  // Подключение интервалов трассировки
 
 // Определение координат центра игрового поля по вертикали и горизонтали
 #define MID_FIELD_Y ((WINDOW_HEIGHT / 2) - 1)
@@ -8,30 +15,11 @@
 #define START_Y 0
 #define START_X 0
 
-// Определение флагов состояния паузы
-#define PAUSE 1
-#define UNPAUSE 0
-
-// Максимальный и стартовый размер змейки, а также индекс головы
-#define SNAKE_MAX_SIZE 200
-#define SNAKE_START_SIZE 4
+// Индекс головы в массиве сегментов
 #define SNAKE_HEAD 0
 
-// Определение значений для отображения элементов на поле
-#define DESPAWN 0                 // Очистка ячейки
-#define SPAWN 1                   // Отрисовка тела змейки
-#define SPAWN_COLOR_APPLE 2       // Цвет яблока
-#define SPAWN_COLOR_SNAKE 3       // Цвет тела змейки
-#define SPAWN_COLOR_SNAKE_HEAD 4  // Цвет головы змейки
-
-// Настройки таймера (задержка и скорость)
-#define TIMER_MAX_DELAY 1000
-#define TIMER_MIN_DELAY 200
-#define TIMER_MAX_SPEED 10
-
-// Настройки уровней
-#define MAX_LEVEL 10
-#define POINTS_FOR_NEXT_LEVEL 5
+// Отрисовка тела змейки (остальные значения клеток — в snake_defines.h)
+#define SPAWN 1
 
 // Имя бинарного файла, где хранится рекорд игрока
 #define DATA_FILE_NAME "snake_data.bin"
@@ -42,33 +30,30 @@ namespace s21 {
 /**
  * @brief Конструктор.
  *
- * Выделяет память для хранения координат змейки.
+ * Координаты змейки хранятся внутри объекта, поэтому сессия — один блок памяти.
  */
-Snake::Snake() {                               // Определение конструктора класса Snake
-  snake_coords = new std::pair<int, int>[SNAKE_MAX_SIZE];  // Динамическое выделение массива координат
-}
+Snake::Snake()
+    : Engine<Snake>(), apple_coords(0, 0), curr_direction(Direction::Dir_Up), snake_size(0),
+      gen(std::random_device{}()) {}           // Определение конструктора класса Snake
 
 /**
  * @brief Деструктор.
  *
- * Очищает память массива с координатами змейки.
+ * Память сессии возвращает Game::operator delete.
  */
-Snake::~Snake() {              // Определение деструктора класса Snake
-  delete[] snake_coords;       // Освобождение динамически выделенной памяти
-}
+Snake::~Snake() {}             // Определение деструктора класса Snake
 
 
 /**
  * @brief Возвращает случайный индекс из диапазона доступных клеток.
  *
- * Использует стандартную библиотеку random для равномерного распределения.
+ * Использует генератор сессии gen (инициализирован random_device в конструкторе),
+ * поэтому последовательность яблок входит в снимок состояния.
  *
  * @param free_cells_size Количество доступных клеток.
  * @return Случайный индекс в диапазоне [0, free_cells_size - 1].
  */
-int Snake::get_random_index(const size_t free_cells_size) const {
-  std::random_device rd;              // Источник энтропии для инициализации генератора
-  std::mt19937 gen(rd());             // Генератор случайных чисел Mersenne Twister
+int Snake::get_random_index(const size_t free_cells_size) {
   std::uniform_int_distribution<> distrib(0, free_cells_size - 1);  // Равномерное распределение
   return distrib(gen);                // Возврат случайного индекса
 }
@@ -137,6 +122,11 @@ void Snake::spawn() {
   statemachine = Moving;              // Переход к движению
 }
 
+int64_t Snake::next_deadline() const {  // Срок шага змейки
+  return (statemachine == Moving && gameinfo.pause != PAUSE) ? timer.next_deadline() : -1;  // Таймер ждёт только в Moving без паузы
+}
+
+void Snake::use_clock(const int64_t* clock_us) { timer.set_clock(clock_us); }  // Часы таймера шагов
 
 /**
  * @brief Moving (состояние конечного автомата).
@@ -145,7 +135,7 @@ void Snake::spawn() {
  * Пауза не является состоянием конечного автомата (КА), а служит лишь условием для перехода к следующему состоянию.
  * Может перевести КА в состояние Shifting, формируя основной игровой цикл Moving <-> Shifting.
  * Может переключить КА в состояние GameOver, если выполнено соответствующее действие Terminate.
- * Переход в состояние Shifting инициируется по трём «флагам»: поворот, истечение таймера или действие action. В любом случае при этом происходит обнуление таймера и установка нового направления (или сохранение текущего).
+ * Переход в состояние Shifting инициируется по трём «флагам»: поворот, истечение таймера или действие action. Поворот и действие обнуляют таймер, срабатывание таймера сдвигает срок на интервал; направление устанавливается заново (или сохраняется текущее).
  */
 void Snake::moving() {
   if (action == Pause) {              // Игрок нажал паузу
@@ -155,11 +145,18 @@ void Snake::moving() {
   }
 
   if (gameinfo.pause != PAUSE) {      // Если не на паузе
+    if (check_rotate_head()) {        // Поворот головы допустим
+      STATS_EVENT(STAT_ROTATIONS, 1);
+    } else if (action == Left || action == Right || action == Up || action == Down) {  // Разворот или поворот в ту же сторону
+      STATS_EVENT(STAT_REJECTED_MOVES, 1);
+    }
+    bool deadline = timer.game_timer_check(gameinfo.speed, TIMER_MAX_DELAY, TIMER_MIN_DELAY,
+                                           TIMER_MAX_SPEED);  // Истёк ли таймер шага
+    if (deadline) flight.record(FLIGHT_DEADLINE, statemachine, gameinfo.speed);  // Срабатывание таймера в журнал
     if (check_rotate_head() ||        // Проверка поворота
-        timer.game_timer_check(gameinfo.speed, TIMER_MAX_DELAY, TIMER_MIN_DELAY,
-                               TIMER_MAX_SPEED) ||
+        deadline ||
         action == Action) {           // Или таймер / действие игрока
-      timer.start();                  // Обновляем таймер
+      if (!deadline) timer.start();   // Поворот или ускорение начинают отсчёт заново
       set_direction();                // Устанавливаем новое направление
       statemachine = Shifting;        // Переход к движению
     }
@@ -278,6 +275,7 @@ void Snake::update_level_speed() { // начало метода обновлен
  * @return Статус открытия файла.
  */
 bool Snake::read_record_file() { // начало метода чтения рекорда из файла
+  TRACE_SCOPE("snake.read_record_file"); // интервал чтения файла рекорда
   bool res = false; // результат успешности чтения файла по умолчанию false
   int number = 0; // временная переменная для хранения прочитанного числа (рекорда)
   std::ifstream input_file(DATA_FILE_NAME, std::ios::binary); // открывает входной бинарный файл с именем DATA_FILE_NAME
@@ -299,10 +297,12 @@ bool Snake::read_record_file() { // начало метода чтения ре
  * \throw std::runtime_error Если ошибка создания файла.
  */
 void Snake::write_record_file(const int number) { // начало метода записи рекорда в файл с передачей числа number
+  TRACE_SCOPE("snake.write_record_file"); // интервал записи файла рекорда
   std::ofstream output_file(DATA_FILE_NAME, std::ios::binary); // открывает выходной бинарный файл с именем DATA_FILE_NAME
   if (output_file.is_open()) { // проверяет, открыт ли файл для записи
     output_file.write(reinterpret_cast<const char*>(&number), sizeof(number)); // записывает число number в файл в бинарном виде
     output_file.close(); // закрывает файл после записи
+    STATS_EVENT(STAT_FILE_WRITES, 1); // учёт записи файла
   } else { // если файл не открылся
     throw std::runtime_error("Error creating file"); // выбрасывает исключение о невозможности создания файла
   } // конец проверки открытия файла
@@ -474,6 +474,7 @@ void Snake::spawn_apple() { // начало метода спавна яблок
   if (coord_valid_check(apple_coords)) { // проверяет корректность полученных координат яблока
     std::pair<int, int> random_cell = free_cells[random_index]; // сохраняет выбранную клетку в локальную переменную random_cell
     gameinfo.field[random_cell.first][random_cell.second] = SPAWN_COLOR_APPLE; // ставит на поле символ/цвет яблока в выбранной клетке
+    flight.record(FLIGHT_SPAWN, statemachine, random_cell.first * WINDOW_WIDTH + random_cell.second); // появление яблока в журнал сессии
   } else { // если координаты некорректны
     throw std::runtime_error("Error coordinate! Cant spawn apple"); // выбрасывает исключение о невозможности поставить яблоко
   } // конец проверки валидности координат
@@ -495,4 +496,62 @@ void Snake::game_over() { // начало метода обработки зав
   } // конец условия определения кода завершения
 } // конец метода game_over
 
+typedef struct { // состояние змейки в снимке, кроме тела (поля уложены без выравнивающих промежутков)
+  int64_t elapsed_us; // время с последнего шага таймера
+  int32_t snake_size; // длина змейки
+  int32_t direction; // направление движения
+  int32_t apple_y; // строка яблока
+  int32_t apple_x; // столбец яблока
+} SnakeBlock; // имя типа — SnakeBlock
+
+void Snake::snapshot_header(SnapshotHeader* header) const { // параметры движка для снимка
+  header->kind = SNAPSHOT_SNAKE; // стандартная змейка
+  header->pieces = 0; // набор фигур не используется
+  header->height = WINDOW_HEIGHT; // высота поля
+  header->width = WINDOW_WIDTH; // ширина поля
+} // конец метода snapshot_header
+
+size_t Snake::state_size() const { // размер состояния змейки
+  return sizeof(SnakeBlock) + sizeof(gen) + snake_size * sizeof(std::pair<int, int>); // занятая часть массива тела
+} // конец метода state_size
+
+/**
+ * @brief Записывает состояние змейки в снимок.
+ *
+ * Из массива координат записываются только snake_size занятых сегментов.
+ */
+void Snake::save_state(SnapshotWriter& out) const { // запись состояния змейки
+  SnakeBlock block = {timer.get_elapsed_us(), snake_size, (int32_t)curr_direction, apple_coords.first,
+                      apple_coords.second}; // скалярные поля
+  out.put(block); // скалярные поля
+  out.put(gen); // генератор яблок
+  out.put_bytes(snake_coords, snake_size * sizeof(std::pair<int, int>)); // сегменты тела
+} // конец метода save_state
+
+bool Snake::restore_state(SnapshotReader& in, State_of_machine state) { // чтение состояния змейки
+  SnakeBlock block{}; // скалярные поля
+  std::minstd_rand saved_gen; // генератор яблок
+  bool res = in.get(&block) && in.get(&saved_gen) && block.snake_size >= 0 &&
+             block.snake_size <= SNAKE_MAX_SIZE && block.direction >= (int)Direction::Dir_Left &&
+             block.direction <= (int)Direction::Dir_Down; // допустимые значения
+  std::vector<std::pair<int, int>> body(res ? block.snake_size : 0); // сегменты тела
+  if (res) res = in.get_bytes(body.data(), body.size() * sizeof(std::pair<int, int>)) && in.left() == 0; // сегменты тела и конец снимка
+  (void)state; // змейка хранит одно и то же во всех состояниях
+  body.push_back({block.apple_y, block.apple_x}); // яблоко проверяется вместе с телом
+  for (size_t i = 0; res && i < body.size(); i++) // клетки внутри поля
+    res = body[i].first >= 0 && body[i].first < WINDOW_HEIGHT && body[i].second >= 0 &&
+          body[i].second < WINDOW_WIDTH; // строка и столбец в пределах окна
+  if (res) { // снимок прочитан
+    std::copy(body.begin(), body.end() - 1, snake_coords); // сегменты тела
+    snake_size = block.snake_size; // длина змейки
+    curr_direction = (Direction)block.direction; // направление
+    apple_coords = {block.apple_y, block.apple_x}; // яблоко
+    timer.resume(block.elapsed_us); // таймер продолжает отсчёт
+    gen = saved_gen; // генератор яблок
+  } // конец применения состояния
+  return res; // результат чтения
+} // конец метода restore_state
+
+template class Engine<Snake>;  // Сборка шага КА змейки
+
 }  // namespace s21 // закрывает пространство имён s21
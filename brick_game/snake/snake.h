@@ -8,43 +8,58 @@
 #include <vector> // подключает заголовок для использования std::vector
 
 #include "../brick_game_single.h" // подключает общий заголовок с базовыми типами и абстрактным классом Game
+#include "../engine.h" // подключает движок со статическим выбором состояния КА
+
+#define SNAKE_MAX_SIZE 200 // наибольшая длина змейки (тело хранится внутри сессии)
 
 namespace s21 { // начало пространства имён s21
 
 /**
  * @brief Класс змейки.
  *
- * Наследуется от абстрактного класса Game.
+ * Наследуется от абстрактного класса Game через движок Engine.
  * Интерфейс представлен функцией get_instance(), которая дает доступ к единственному экземпляру класса.
  */
-class Snake : public Game { // объявление класса Snake, наследника Game
+class Snake final : public Engine<Snake> { // объявление класса Snake, наследника Game через Engine
+  friend class Engine<Snake>; // движок вызывает обработчики состояний
+  friend class SnakeBot; // автопилот читает координаты змейки, яблока и направление
+  friend class GameFabric; // фабрика создаёт отдельные сессии змейки
+
  private: // начало секции приватных членов класса
   Snake(); // приватный конструктор по умолчанию (скрывает создание извне)
   Snake(const Snake&) = delete; // удалённый копирующий конструктор, запрещает копирование
   Snake& operator=(const Snake&) = delete; // удалённый оператор присваивания, запрещает присваивание
   ~Snake(); // приватный деструктор
 
-  void starting_game() override; // метод инициализации состояния Start переопределённый от Game
-  void spawn() override; // метод появления начального состояния/объектов переопределённый
-  void moving() override; // метод обработки движения змейки переопределённый
-  void shifting() override; // метод сдвига состояния переопределённый
-  void attaching() override; // метод прикрепления/обработки столкновения переопределённый
-  void game_over() override; // метод обработки конца игры переопределённый
+  void starting_game(); // обработчик GameStart для Engine::step: инициализация змейки
+  void spawn(); // обработчик Spawn: появление яблока
+  void moving(); // обработчик Moving: ввод и таймер
+  void shifting(); // обработчик Shifting: шаг змейки
+  void attaching(); // обработчик Attaching: столкновение или съеденное яблоко
+  void game_over(); // обработчик GameOver: конец игры
+
+  void snapshot_header(SnapshotHeader* header) const override; // тип движка и размеры поля для снимка
+  size_t state_size() const override; // размер тела, яблока, таймера и генератора в снимке
+  void save_state(SnapshotWriter& out) const override; // запись состояния змейки
+  bool restore_state(SnapshotReader& in, State_of_machine state) override; // чтение состояния змейки
 
  public: // публичная секция класса
   static Snake* get_instance() { // статический метод доступа к единственному экземпляру (синглтон)
     static Snake instance; // локальный статический экземпляр, обеспечивающий единственность
     return &instance; // возвращает указатель на единственный экземпляр
   } // конец метода get_instance
+  int64_t next_deadline() const override; // микросекунд до шага змейки по таймеру
+  void use_clock(const int64_t* clock_us) override; // внешние часы таймера шагов
 
  private: // приватная секция для внутренних типов и полей
   enum class Direction { Dir_Left = 0, Dir_Right, Dir_Up, Dir_Down }; // перечисление направлений движения змейки
 
-  std::pair<int, int>* snake_coords; // указатель на динамический массив координат сегментов змейки (Y,X пары)
+  std::pair<int, int> snake_coords[SNAKE_MAX_SIZE]; // координаты сегментов змейки (Y,X пары) внутри сессии
   std::pair<int, int> apple_coords; // координаты текущего яблока (Y,X)
   Direction curr_direction; // текущее направление движения змейки
   Timer timer; // объект таймера для управления скоростью/периодом шагов
   int snake_size; // текущий размер змейки (количество сегментов)
+  std::minstd_rand gen; // генератор клеток яблока сессии (состояние — одно число, входит в снимок)
 
  private: // приватная секция методов вспомогательной логики
   void init_statistic(); // инициализация начальной статистики и стартовых параметров игры
@@ -62,11 +77,13 @@ class Snake : public Game { // объявление класса Snake, насл
   void pause_game(); // переключение состояния паузы игры
   void shift_to_head(); // сдвиг массивa координат змейки от хвоста к голове
   void get_free_cells(std::vector<std::pair<int, int>>& free_cells) const; // сбор всех свободных клеток поля в вектор
-  int get_random_index(const size_t free_cells_size) const; // получение случайного индекса в диапазоне размера вектора свободных клеток
+  int get_random_index(const size_t free_cells_size); // получение случайного индекса в диапазоне размера вектора свободных клеток
   void update_score_game(); // увеличение счёта и обновление рекорда при необходимости
   void update_level_speed(); // обновление уровня и скорости в зависимости от набранных очков
 }; // конец объявления класса Snake
 
+extern template class Engine<Snake>; // движок змейки собирается в snake.cpp
+
 }  // namespace s21 // конец пространства имён s21
 
 #endif  // SNAKE_H // конец защиты от повторного включения заголовка
\ No newline at end of file
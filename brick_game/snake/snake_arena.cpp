@@ -0,0 +1,383 @@
+#include "snake_arena.h" // подключает объявление класса SnakeArena
+#include "snake_defines.h" // подключает общие константы змейки и арены
+
+#include "../snapshot.h" // подключает формат снимка состояния
+#include "../stats.h" // подключает счётчики событий
+
+#include <algorithm> // подключает std::min, std::max и std::fill
+#include <stdexcept> // подключает стандартные исключения
+
+#define SNAKE_APPLE_ATTEMPTS 64 // число случайных попыток выбрать свободную клетку до перебора битовой карты
+
+namespace s21 { // начало пространства имён s21
+
+/**
+ * @brief Конструктор.
+ *
+ * Выделяет кольцевой буфер тела и битовую карту занятости один раз на всю сессию;
+ * gameinfo.field остаётся окном WINDOW_HEIGHT x WINDOW_WIDTH.
+ * \throw std::invalid_argument Если арена меньше окна вывода или слишком велика для 32-битных индексов.
+ */
+SnakeArena::SnakeArena(int height, int width)
+    : Engine<SnakeArena>(), height(height), width(width), cells(0), head_pos(0), size(0), growth(0), apple(0),
+      next_cell(0), crashed(false), direction(Direction::Dir_Up), gen(std::random_device{}()), view_y(0),
+      view_x(0) { // поля инициализируются нулями до старта игры
+  if (height < WINDOW_HEIGHT || width < WINDOW_WIDTH ||
+      (uint64_t)height * (uint64_t)width > SNAKE_ARENA_MAX_CELLS) { // арена не вмещает окно или индексы
+    throw std::invalid_argument("Error: Unsupported arena size"); // выбрасывает исключение о размере арены
+  } // конец проверки размеров
+  cells = this->height * this->width; // количество клеток
+  ring.assign(cells, 0); // кольцевой буфер на максимально возможную длину змейки
+  occupied.assign((cells + 63) / 64, 0); // по одному биту на клетку
+} // конец конструктора
+
+int SnakeArena::arena_height() const { return height; } // высота арены
+int SnakeArena::arena_width() const { return width; } // ширина арены
+int SnakeArena::viewport_y() const { return view_y; } // верхняя строка окна вывода
+int SnakeArena::viewport_x() const { return view_x; } // левый столбец окна вывода
+uint32_t SnakeArena::length() const { return size; } // текущая длина змейки
+
+int64_t SnakeArena::next_deadline() const { // срок шага змейки
+  return (statemachine == Moving && gameinfo.pause != PAUSE) ? timer.next_deadline() : -1; // таймер ждёт только в Moving без паузы
+} // конец метода next_deadline
+
+void SnakeArena::use_clock(const int64_t* clock_us) { timer.set_clock(clock_us); } // часы таймера шагов
+
+uint32_t SnakeArena::head() const { return ring[head_pos]; } // клетка головы
+
+bool SnakeArena::is_occupied(uint32_t cell) const { // занята ли клетка телом
+  return (occupied[cell / 64] >> (cell % 64)) & 1u; // бит клетки
+} // конец метода is_occupied
+
+void SnakeArena::set_occupied(uint32_t cell, bool value) { // отметка клетки в битовой карте
+  if (value) { // клетка занимается
+    occupied[cell / 64] |= 1ULL << (cell % 64); // устанавливаем бит
+  } else { // клетка освобождается
+    occupied[cell / 64] &= ~(1ULL << (cell % 64)); // сбрасываем бит
+  } // конец выбора действия
+} // конец метода set_occupied
+
+/**
+ * @brief GameStart (состояние конечного автомата).
+ *
+ * Ставит змейку длины SNAKE_START_SIZE в центр арены головой вверх.
+ */
+void SnakeArena::starting_game() { // инициализация новой партии
+  if (action == Start) { // игрок нажал "старт"
+    std::fill(occupied.begin(), occupied.end(), 0); // арена пуста
+    head_pos = 0; // голова в начале кольцевого буфера
+    size = SNAKE_START_SIZE; // стартовая длина
+    growth = 0; // рост не ожидается
+    direction = Direction::Dir_Up; // движение вверх
+    crashed = false; // столкновений нет
+    uint32_t mid_y = height / 2 - 1; // строка головы
+    uint32_t mid_x = width / 2 - 1; // столбец змейки
+    for (uint32_t i = 0; i < size; i++) { // сегменты от головы к хвосту
+      ring[i] = (mid_y + i) * width + mid_x; // сегмент под предыдущим
+      set_occupied(ring[i], true); // отмечаем клетку
+    } // конец цикла по сегментам
+    gameinfo.score = 0; // счёт
+    gameinfo.high_score = 0; // рекорд арены не сохраняется между сессиями
+    gameinfo.level = 1; // уровень
+    gameinfo.speed = 0; // скорость
+    gameinfo.pause = UNPAUSE; // пауза снята
+    statemachine = Spawn; // переход к появлению яблока
+  } else if (action == Terminate) { // игрок завершает игру
+    statemachine = GameOver; // завершение
+  } // конец обработки действия
+} // конец метода starting_game
+
+/**
+ * @brief Выбирает свободную клетку для яблока.
+ *
+ * Сначала SNAKE_APPLE_ATTEMPTS случайных попыток — при любой длине змейки меньше
+ * почти всей арены этого достаточно. Если все попытки попали в тело, битовая карта
+ * просматривается по 64 клетки за раз со случайного слова.
+ */
+void SnakeArena::spawn_apple() { // выбор клетки яблока
+  std::uniform_int_distribution<uint32_t> distrib(0, cells - 1); // равномерно по клеткам арены
+  bool found = false; // найдена ли свободная клетка
+  for (int attempt = 0; attempt < SNAKE_APPLE_ATTEMPTS && !found; attempt++) { // случайные попытки
+    uint32_t cell = distrib(gen); // случайная клетка
+    if (!is_occupied(cell)) { // клетка свободна
+      apple = cell; // ставим яблоко
+      found = true; // поиск окончен
+    } // конец проверки клетки
+  } // конец случайных попыток
+  size_t words = occupied.size(); // количество слов битовой карты
+  size_t start = distrib(gen) / 64; // случайное начальное слово
+  for (size_t i = 0; i < words && !found; i++) { // перебор слов по кругу
+    size_t word = (start + i) % words; // текущее слово
+    uint64_t free_bits = ~occupied[word]; // свободные клетки слова
+    uint32_t valid = cells - word * 64; // клеток в слове (последнее может быть неполным)
+    if (valid < 64) free_bits &= (1ULL << valid) - 1; // отбрасываем биты за концом арены
+    if (free_bits) { // в слове есть свободная клетка
+      apple = word * 64 + __builtin_ctzll(free_bits); // младшая свободная клетка
+      found = true; // поиск окончен
+    } // конец проверки слова
+  } // конец перебора слов
+  if (!found) throw std::runtime_error("Error coordinate! Cant spawn apple"); // свободных клеток нет
+  flight.record(FLIGHT_SPAWN, statemachine, (int32_t)apple); // появление яблока в журнал сессии (номер клетки y * ширина + x)
+} // конец метода spawn_apple
+
+/**
+ * @brief Spawn (состояние конечного автомата).
+ */
+void SnakeArena::spawn() { // появление яблока
+  spawn_apple(); // выбираем клетку яблока
+  draw_viewport(); // перерисовываем окно
+  statemachine = Moving; // переход к движению
+} // конец метода spawn
+
+/**
+ * @brief Moving (состояние конечного автомата).
+ *
+ * Повторяет обработку ввода Snake: пауза, завершение, поворот, шаг по таймеру или по Action.
+ */
+void SnakeArena::moving() { // обработка ввода
+  if (action == Pause) { // игрок нажал паузу
+    gameinfo.pause = (gameinfo.pause == UNPAUSE) ? PAUSE : UNPAUSE; // переключаем паузу
+  } else if (action == Terminate) { // игрок завершает игру
+    statemachine = GameOver; // завершение
+  } // конец обработки служебных действий
+  if (gameinfo.pause != PAUSE && statemachine == Moving) { // игра идёт
+    if (check_rotate_head()) { // поворот головы допустим
+      STATS_EVENT(STAT_ROTATIONS, 1); // учёт поворота
+    } else if (action == Left || action == Right || action == Up || action == Down) { // разворот или ход в ту же сторону
+      STATS_EVENT(STAT_REJECTED_MOVES, 1); // учёт отклонённого хода
+    } // конец учёта хода
+    bool deadline = timer.game_timer_check(gameinfo.speed, TIMER_MAX_DELAY, TIMER_MIN_DELAY, TIMER_MAX_SPEED); // истёк ли таймер шага
+    if (deadline) flight.record(FLIGHT_DEADLINE, statemachine, gameinfo.speed); // срабатывание таймера в журнал сессии
+    if (check_rotate_head() || deadline || action == Action) { // поворот, таймер или ускорение
+      if (!deadline) timer.start(); // поворот или ускорение начинают отсчёт заново
+      set_direction(); // новое направление
+      statemachine = Shifting; // шаг змейки
+    } // конец проверки шага
+  } // конец проверки паузы
+  action = Start; // сброс действия
+} // конец метода moving
+
+/**
+ * @brief Shifting (состояние конечного автомата).
+ *
+ * Шаг за O(1): хвост освобождается одним сбросом бита (если змейка не растёт),
+ * голова записывается в кольцевой буфер перед текущей, столкновение с телом — проверка одного бита.
+ */
+void SnakeArena::shifting() { // шаг змейки
+  uint32_t cell = head(); // клетка головы
+  uint32_t y = cell / width; // строка головы
+  uint32_t x = cell % width; // столбец головы
+  crashed = false; // столкновения пока нет
+  if (direction == Direction::Dir_Up) { // вверх
+    crashed = (y == 0); // верхняя стена
+    next_cell = cell - width; // клетка выше
+  } else if (direction == Direction::Dir_Down) { // вниз
+    crashed = (y + 1 == height); // нижняя стена
+    next_cell = cell + width; // клетка ниже
+  } else if (direction == Direction::Dir_Left) { // влево
+    crashed = (x == 0); // левая стена
+    next_cell = cell - 1; // клетка левее
+  } else { // вправо
+    crashed = (x + 1 == width); // правая стена
+    next_cell = cell + 1; // клетка правее
+  } // конец выбора направления
+  if (!crashed) { // голова осталась на арене
+    uint32_t tail = ring[(head_pos + size - 1) % cells]; // клетка хвоста
+    crashed = is_occupied(next_cell) && !(growth == 0 && next_cell == tail); // тело, кроме уходящего хвоста
+    if (!crashed) { // клетка свободна: карта меняется только при настоящем шаге
+      if (growth == 0) set_occupied(tail, false); // хвост уходит с клетки
+      head_pos = (head_pos + cells - 1) % cells; // новая голова перед текущей
+      ring[head_pos] = next_cell; // записываем клетку головы
+      set_occupied(next_cell, true); // отмечаем её
+      if (growth) { // змейка растёт: хвост остаётся на месте
+        growth--; // один шаг роста использован
+        size++; // длина увеличилась
+      } // конец обработки роста
+    } // конец проверки тела
+  } // конец проверки стены
+  if (crashed || next_cell == apple) { // столкновение или яблоко
+    statemachine = Attaching; // обработка события
+  } else { // обычный шаг
+    draw_viewport(); // перерисовываем окно
+    statemachine = Moving; // возврат к вводу
+  } // конец выбора состояния
+} // конец метода shifting
+
+/**
+ * @brief Attaching (состояние конечного автомата).
+ *
+ * Столкновение завершает игру, съеденное яблоко удлиняет змейку на следующем шаге.
+ * Когда змейка вместе с ожидаемым ростом занимает всю арену, игра завершается победой.
+ */
+void SnakeArena::attaching() { // обработка события шага
+  if (crashed) { // стена или тело
+    statemachine = GameOver; // поражение
+  } else { // съедено яблоко
+    growth++; // хвост задержится на один шаг
+    gameinfo.score++; // очко за яблоко
+    if (gameinfo.score > gameinfo.high_score) gameinfo.high_score = gameinfo.score; // рекорд сессии
+    update_level_speed(); // уровень и скорость
+    statemachine = (size + growth >= cells) ? GameOver : Spawn; // арена заполнена — победа
+  } // конец выбора события
+} // конец метода attaching
+
+/**
+ * @brief GameOver (состояние конечного автомата).
+ */
+void SnakeArena::game_over() { // код завершения
+  gameinfo.level = (size + growth >= cells) ? WIN_LVL : LOSE_LVL; // победа, если змейка заполнила арену
+} // конец метода game_over
+
+/**
+ * @brief Перерисовывает окно вывода вокруг головы.
+ *
+ * Окно WINDOW_HEIGHT x WINDOW_WIDTH центрируется на голове и прижимается к краям арены;
+ * стоимость перерисовки — размер окна, а не арены.
+ */
+void SnakeArena::draw_viewport() { // перерисовка окна
+  int head_y = head() / width; // строка головы
+  int head_x = head() % width; // столбец головы
+  view_y = std::min(std::max(head_y - WINDOW_HEIGHT / 2, 0), (int)height - WINDOW_HEIGHT); // верх окна
+  view_x = std::min(std::max(head_x - WINDOW_WIDTH / 2, 0), (int)width - WINDOW_WIDTH); // левый край окна
+  for (int i = 0; i < WINDOW_HEIGHT; i++) { // строки окна
+    uint32_t row = (view_y + i) * width + view_x; // первая клетка строки окна на арене
+    for (int j = 0; j < WINDOW_WIDTH; j++) { // столбцы окна
+      uint32_t cell = row + j; // клетка арены
+      int value = is_occupied(cell) ? SPAWN_COLOR_SNAKE : DESPAWN; // тело или пусто
+      if (cell == apple) value = SPAWN_COLOR_APPLE; // яблоко
+      if (cell == head()) value = SPAWN_COLOR_SNAKE_HEAD; // голова
+      gameinfo.field[i][j] = value; // записываем в окно
+    } // конец цикла по столбцам
+  } // конец цикла по строкам
+} // конец метода draw_viewport
+
+bool SnakeArena::check_rotate_head() const { // допустим ли поворот по действию
+  bool res = false; // по умолчанию поворота нет
+  if (direction == Direction::Dir_Up || direction == Direction::Dir_Down) { // движение по вертикали
+    res = (action == Left || action == Right); // поворот влево или вправо
+  } else { // движение по горизонтали
+    res = (action == Up || action == Down); // поворот вверх или вниз
+  } // конец проверки направления
+  return res; // результат
+} // конец метода check_rotate_head
+
+void SnakeArena::set_direction() { // смена направления
+  if (direction == Direction::Dir_Up || direction == Direction::Dir_Down) { // движение по вертикали
+    if (action == Left) direction = Direction::Dir_Left; // поворот влево
+    if (action == Right) direction = Direction::Dir_Right; // поворот вправо
+  } else { // движение по горизонтали
+    if (action == Up) direction = Direction::Dir_Up; // поворот вверх
+    if (action == Down) direction = Direction::Dir_Down; // поворот вниз
+  } // конец выбора направления
+} // конец метода set_direction
+
+void SnakeArena::update_level_speed() { // уровень и скорость по счёту
+  if (gameinfo.level < MAX_LEVEL && gameinfo.score % POINTS_FOR_NEXT_LEVEL == 0) { // очередной порог очков
+    gameinfo.speed++; // быстрее
+    gameinfo.level++; // следующий уровень
+  } // конец проверки порога
+} // конец метода update_level_speed
+
+typedef struct { // состояние арены в снимке, кроме тела (поля уложены без выравнивающих промежутков)
+  int64_t elapsed_us; // время с последнего шага таймера
+  uint32_t head_pos; // позиция головы в кольцевом буфере
+  uint32_t size; // длина змейки
+  uint32_t growth; // оставшийся рост
+  uint32_t apple; // клетка яблока
+  uint32_t next_cell; // клетка последнего шага головы
+  int32_t direction; // направление движения
+  int32_t view_y; // верхняя строка окна вывода
+  int32_t view_x; // левый столбец окна вывода
+  uint8_t crashed; // столкновение на последнем шаге
+  uint8_t reserved[7]; // выравнивание блока до 8 байт
+} ArenaBlock; // имя типа — ArenaBlock
+
+void SnakeArena::snapshot_header(SnapshotHeader* header) const { // параметры движка для снимка
+  header->kind = SNAPSHOT_SNAKE_ARENA; // змейка на большой арене
+  header->pieces = 0; // набор фигур не используется
+  header->height = height; // высота арены
+  header->width = width; // ширина арены
+} // конец метода snapshot_header
+
+size_t SnakeArena::state_size() const { // размер состояния арены
+  return sizeof(ArenaBlock) + sizeof(gen) + (size_t)size * sizeof(uint32_t); // тело без незанятой части кольца
+} // конец метода state_size
+
+/**
+ * @brief Записывает состояние арены в снимок.
+ *
+ * Тело записывается от головы к хвосту, поэтому размер снимка зависит от длины змейки,
+ * а не от площади арены; битовая карта занятости восстанавливается по телу.
+ */
+void SnakeArena::save_state(SnapshotWriter& out) const { // запись состояния арены
+  ArenaBlock block{}; // скалярные поля
+  block.elapsed_us = timer.get_elapsed_us(); // таймер шага
+  block.head_pos = head_pos; // позиция головы
+  block.size = size; // длина
+  block.growth = growth; // рост
+  block.apple = apple; // яблоко
+  block.next_cell = next_cell; // последний шаг
+  block.direction = (int32_t)direction; // направление
+  block.view_y = view_y; // окно вывода
+  block.view_x = view_x; // окно вывода
+  block.crashed = crashed; // столкновение
+  out.put(block); // скалярные поля
+  out.put(gen); // генератор яблок
+  uint32_t first = std::min(size, cells - head_pos); // сегменты до конца кольцевого буфера
+  out.put_bytes(&ring[head_pos], first * sizeof(uint32_t)); // тело от головы
+  out.put_bytes(ring.data(), (size - first) * sizeof(uint32_t)); // продолжение с начала буфера
+} // конец метода save_state
+
+/**
+ * @brief Читает состояние арены из снимка.
+ *
+ * Тело принимается, только если его сегменты лежат на арене, не повторяются и соседствуют
+ * по стороне клетки, а длина с ожидаемым ростом не больше арены; пустое тело — только до старта.
+ * @return false если снимок повреждён; тогда состояние арены не меняется
+ */
+bool SnakeArena::restore_state(SnapshotReader& in, State_of_machine state) { // чтение состояния арены
+  ArenaBlock block{}; // скалярные поля
+  std::mt19937 saved_gen; // генератор яблок
+  bool res = in.get(&block) && in.get(&saved_gen) && block.head_pos < cells && block.size <= cells &&
+             block.growth <= cells - block.size && (block.size > 0 || state == GameStart) && block.apple < cells && block.next_cell < cells && block.direction >= (int)Direction::Dir_Left &&
+             block.direction <= (int)Direction::Dir_Down && block.view_y >= 0 &&
+             block.view_y <= (int)height - WINDOW_HEIGHT && block.view_x >= 0 &&
+             block.view_x <= (int)width - WINDOW_WIDTH; // допустимые значения
+  std::vector<uint32_t> body(res ? block.size : 0); // тело от головы к хвосту
+  if (res) res = in.get_bytes(body.data(), body.size() * sizeof(uint32_t)) && in.left() == 0; // сегменты тела и конец снимка
+  std::vector<uint64_t> seen(res ? occupied.size() : 0, 0); // клетки, уже занятые телом из снимка
+  for (size_t i = 0; res && i < body.size(); i++) { // сегменты от головы
+    uint32_t cell = body[i]; // клетка сегмента
+    res = cell < cells && !((seen[cell / 64] >> (cell % 64)) & 1u); // внутри арены и не повторяется
+    if (res && i > 0) { // сегмент — сосед предыдущего по стороне клетки
+      uint32_t prev = body[i - 1]; // предыдущий сегмент
+      uint32_t dy = std::max(cell / width, prev / width) - std::min(cell / width, prev / width); // разница строк
+      uint32_t dx = std::max(cell % width, prev % width) - std::min(cell % width, prev % width); // разница столбцов
+      res = dy + dx == 1; // тело непрерывно и не переходит через край арены
+    } // конец проверки соседства
+    if (res) seen[cell / 64] |= 1ULL << (cell % 64); // отмечаем клетку
+  } // конец проверки тела
+  if (res) { // снимок прочитан
+    std::fill(occupied.begin(), occupied.end(), 0); // арена пуста
+    for (uint32_t i = 0; i < block.size; i++) { // сегменты от головы
+      ring[(block.head_pos + i) % cells] = body[i]; // позиция в кольцевом буфере
+      set_occupied(body[i], true); // отмечаем клетку
+    } // конец цикла по сегментам
+    head_pos = block.head_pos; // позиция головы
+    size = block.size; // длина
+    growth = block.growth; // рост
+    apple = block.apple; // яблоко
+    next_cell = block.next_cell; // последний шаг
+    direction = (Direction)block.direction; // направление
+    view_y = block.view_y; // окно вывода
+    view_x = block.view_x; // окно вывода
+    crashed = block.crashed; // столкновение
+    timer.resume(block.elapsed_us); // таймер продолжает отсчёт
+    gen = saved_gen; // генератор яблок
+  } // конец применения состояния
+  return res; // результат чтения
+} // конец метода restore_state
+
+template class Engine<SnakeArena>; // сборка шага КА арены
+
+}  // namespace s21 // конец пространства имён s21
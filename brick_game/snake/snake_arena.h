@@ -0,0 +1,94 @@
+#ifndef SNAKE_ARENA_H // защита от повторного включения заголовка: если SNAKE_ARENA_H не определён
+#define SNAKE_ARENA_H // определяет макрос SNAKE_ARENA_H чтобы избежать повторного включения
+
+#include <stdint.h> // подключает целочисленные типы фиксированной ширины (uint32_t, uint64_t)
+
+#include <random> // подключает генератор случайных чисел для выбора клетки яблока
+#include <vector> // подключает std::vector для кольцевого буфера тела и битовой карты занятости
+
+#include "../brick_game_single.h" // подключает общий заголовок с базовыми типами и абстрактным классом Game
+#include "../engine.h" // подключает движок со статическим выбором состояния КА
+
+#define SNAKE_ARENA_MAX_CELLS (1u << 31) // наибольшее число клеток арены: индексы и длина помещаются в uint32_t
+
+namespace s21 { // начало пространства имён s21
+
+/**
+ * @brief Змейка на большой арене.
+ *
+ * Правила совпадают с Snake, но размер арены задаётся при создании сессии
+ * (GameFabric::create_game) и может достигать миллионов клеток.
+ * Тело хранится кольцевым буфером 32-битных индексов клеток, занятость — битовой картой,
+ * поэтому шаг змейки стоит O(1) независимо от её длины. В gameinfo.field выводится
+ * только окно WINDOW_HEIGHT x WINDOW_WIDTH вокруг головы, его перерисовка тоже не зависит от размера арены.
+ * Рекорд арены в файл не записывается.
+ */
+class SnakeArena final : public Engine<SnakeArena> { // объявление класса змейки на большой арене, наследника Game через Engine
+  friend class Engine<SnakeArena>; // движок вызывает обработчики состояний
+  friend class GameFabric; // фабрика создаёт сессии арены выбранного размера
+
+ private: // начало секции приватных членов класса
+  SnakeArena(int height, int width); // приватный конструктор: арена height x width
+  ~SnakeArena() {} // приватный деструктор
+  SnakeArena(const SnakeArena&) = delete; // удалённый копирующий конструктор, запрещает копирование
+  SnakeArena& operator=(const SnakeArena&) = delete; // удалённый оператор присваивания, запрещает присваивание
+
+  void starting_game(); // инициализация змейки в центре арены
+  void spawn(); // появление яблока и перерисовка окна
+  void moving(); // обработка ввода и таймера
+  void shifting(); // шаг змейки на одну клетку
+  void attaching(); // обработка столкновения или съеденного яблока
+  void game_over(); // установка кода завершения
+
+  void snapshot_header(SnapshotHeader* header) const override; // тип движка и размеры арены для снимка
+  size_t state_size() const override; // размер тела, яблока, таймера и генератора в снимке
+  void save_state(SnapshotWriter& out) const override; // запись состояния арены
+  bool restore_state(SnapshotReader& in, State_of_machine state) override; // чтение состояния арены
+
+ public: // публичная секция класса
+  int arena_height() const; // высота арены
+  int arena_width() const; // ширина арены
+  int viewport_y() const; // строка арены, соответствующая верхней строке gameinfo.field
+  int viewport_x() const; // столбец арены, соответствующий левому столбцу gameinfo.field
+  uint32_t length() const; // текущая длина змейки
+  int64_t next_deadline() const override; // микросекунд до шага змейки по таймеру
+  void use_clock(const int64_t* clock_us) override; // внешние часы таймера шагов
+
+ private: // приватная секция для внутренних типов и полей
+  enum class Direction { Dir_Left = 0, Dir_Right, Dir_Up, Dir_Down }; // направления движения змейки
+
+  uint32_t height; // высота арены
+  uint32_t width; // ширина арены
+  uint32_t cells; // количество клеток арены
+
+  std::vector<uint32_t> ring; // кольцевой буфер индексов клеток тела, ёмкость — число клеток
+  uint32_t head_pos; // позиция головы в кольцевом буфере (тело идёт от неё по возрастанию позиций)
+  uint32_t size; // длина змейки
+  uint32_t growth; // сколько шагов подряд хвост ещё не сдвигается после съеденного яблока
+  std::vector<uint64_t> occupied; // битовая карта клеток, занятых телом
+
+  uint32_t apple; // клетка яблока
+  uint32_t next_cell; // клетка, в которую голова перешла на последнем шаге
+  bool crashed; // голова врезалась в стену или в тело на последнем шаге
+  Direction direction; // текущее направление движения
+  Timer timer; // таймер шага змейки
+  std::mt19937 gen; // генератор случайных клеток яблока (один на сессию)
+  int view_y; // верхняя строка окна вывода
+  int view_x; // левый столбец окна вывода
+
+ private: // приватная секция вспомогательных методов
+  uint32_t head() const; // клетка головы
+  bool is_occupied(uint32_t cell) const; // занята ли клетка телом
+  void set_occupied(uint32_t cell, bool value); // отметка клетки в битовой карте
+  void spawn_apple(); // выбор свободной клетки для яблока
+  void draw_viewport(); // перерисовка окна вокруг головы в gameinfo.field
+  bool check_rotate_head() const; // допустим ли поворот по текущему действию
+  void set_direction(); // смена направления по действию игрока
+  void update_level_speed(); // повышение уровня и скорости по счёту
+}; // конец объявления класса SnakeArena
+
+extern template class Engine<SnakeArena>; // движок арены собирается в snake_arena.cpp
+
+}  // namespace s21 // конец пространства имён s21
+
+#endif  // SNAKE_ARENA_H // конец защиты от повторного включения заголовка
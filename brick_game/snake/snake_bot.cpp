@@ -0,0 +1,248 @@
+#include "snake_bot.h" // подключает объявление класса SnakeBot
+
+#define SNAKE_HEAD 0 // индекс головы в массиве координат змейки
+
+namespace s21 { // начало пространства имён s21
+
+/**
+ * @brief Конструктор.
+ *
+ * Строит гамильтонов цикл по игровому полю и один раз выделяет все буферы поиска.
+ */
+SnakeBot::SnakeBot()
+    : height(WINDOW_HEIGHT), // высота поля берётся из общих настроек
+      width(WINDOW_WIDTH), // ширина поля берётся из общих настроек
+      cells(WINDOW_HEIGHT * WINDOW_WIDTH), // количество клеток поля
+      order(cells), // буфер номеров клеток в цикле
+      next(cells), // буфер следующих клеток цикла
+      dist(cells, SNAKE_BOT_INF), // поле расстояний изначально пустое
+      queue(cells), // очередь BFS никогда не бывает длиннее числа клеток
+      body(cells, 0), // маска тела изначально пустая
+      planned_apple(-1), // поле расстояний ещё не построено
+      planned_size(0), // змейка ещё не наблюдалась
+      planned_head(-1), // голова ещё не наблюдалась
+      planned_tail(-1) { // хвост ещё не наблюдался
+  build_cycle(); // строим гамильтонов цикл
+}
+
+/**
+ * @brief Строит гамильтонов цикл по полю.
+ *
+ * При чётной ширине цикл идёт по верхней строке вправо, а затем «змейкой» по столбцам
+ * справа налево через строки 1..height-1. При нечётной ширине и чётной высоте
+ * используется та же схема, повёрнутая на 90 градусов.
+ * \throw std::invalid_argument Если обе стороны поля нечётные (цикла не существует).
+ */
+void SnakeBot::build_cycle() {
+  std::vector<int> path; // клетки в порядке обхода цикла
+  path.reserve(cells); // резервируем память под все клетки
+  if (width % 2 == 0 && height > 1) { // чётная ширина — обход по столбцам
+    for (int x = 0; x < width; x++) path.push_back(x); // верхняя строка слева направо
+    for (int x = width - 1; x >= 0; x--) { // столбцы справа налево
+      bool down = ((width - 1 - x) % 2 == 0); // направление обхода текущего столбца
+      for (int i = 1; i < height; i++) { // строки 1..height-1
+        int y = down ? i : height - i; // строка с учётом направления
+        path.push_back(y * width + x); // добавляем клетку в обход
+      }
+    }
+  } else if (height % 2 == 0 && width > 1) { // чётная высота — обход по строкам
+    for (int y = 0; y < height; y++) path.push_back(y * width); // левый столбец сверху вниз
+    for (int y = height - 1; y >= 0; y--) { // строки снизу вверх
+      bool right = ((height - 1 - y) % 2 == 0); // направление обхода текущей строки
+      for (int i = 1; i < width; i++) { // столбцы 1..width-1
+        int x = right ? i : width - i; // столбец с учётом направления
+        path.push_back(y * width + x); // добавляем клетку в обход
+      }
+    }
+  } else { // обе стороны нечётные — гамильтонова цикла нет
+    throw std::invalid_argument("Error: Hamiltonian cycle needs an even board side");
+  }
+  for (int i = 0; i < cells; i++) { // раскладываем обход по таблицам
+    order[path[i]] = i; // номер клетки в цикле
+    next[path[i]] = path[(i + 1) % cells]; // следующая клетка с замыканием цикла
+  }
+}
+
+/**
+ * @brief Возвращает порядковый номер клетки в гамильтоновом цикле.
+ */
+int SnakeBot::cycle_index(int y, int x) const { return order[y * width + x]; }
+
+/**
+ * @brief Возвращает индекс клетки, следующей за (y, x) по циклу.
+ */
+int SnakeBot::cycle_next(int y, int x) const { return next[y * width + x]; }
+
+int SnakeBot::cell_of(const std::pair<int, int>& coords) const { // перевод координат в индекс клетки
+  return coords.first * width + coords.second; // индекс в построчной развёртке поля
+}
+
+int SnakeBot::forward(int from, int to) const { // расстояние вперёд по циклу
+  return (order[to] - order[from] + cells) % cells; // разность номеров по модулю длины цикла
+}
+
+/**
+ * @brief Полностью перестраивает маску тела и поле расстояний.
+ *
+ * Вызывается при появлении нового яблока или при рассинхронизации с игрой.
+ * Поле расстояний строится BFS от яблока по клеткам, свободным от тела.
+ */
+void SnakeBot::rebuild(const Snake& snake) {
+  std::fill(body.begin(), body.end(), 0); // очищаем маску тела
+  for (int i = SNAKE_HEAD; i < snake.snake_size; i++) { // отмечаем все сегменты
+    body[cell_of(snake.snake_coords[i])] = 1; // клетка занята телом
+  }
+  std::fill(dist.begin(), dist.end(), SNAKE_BOT_INF); // сбрасываем расстояния
+  int apple = cell_of(snake.apple_coords); // клетка яблока
+  int head = 0; // начало очереди
+  int tail = 0; // конец очереди
+  dist[apple] = 0; // яблоко — источник BFS
+  queue[tail++] = apple; // кладём яблоко в очередь
+  while (head < tail) { // пока очередь не пуста
+    int cell = queue[head++]; // извлекаем клетку
+    int y = cell / width; // строка клетки
+    int x = cell % width; // столбец клетки
+    const int around[4] = {y > 0 ? cell - width : -1, y + 1 < height ? cell + width : -1,
+                           x > 0 ? cell - 1 : -1, x + 1 < width ? cell + 1 : -1}; // соседи в пределах поля
+    for (int n : around) { // перебираем соседей
+      if (n >= 0 && !body[n] && dist[n] > dist[cell] + 1) { // свободный сосед с худшим расстоянием
+        dist[n] = dist[cell] + 1; // улучшаем расстояние
+        queue[tail++] = n; // продолжаем обход от соседа
+      }
+    }
+  }
+  planned_apple = apple; // запоминаем яблоко, для которого построено поле
+  planned_size = snake.snake_size; // запоминаем длину
+  planned_head = cell_of(snake.snake_coords[SNAKE_HEAD]); // запоминаем голову
+  planned_tail = cell_of(snake.snake_coords[snake.snake_size - 1]); // запоминаем хвост
+}
+
+/**
+ * @brief Досчитывает поле расстояний после освобождения клетки.
+ *
+ * Освободившаяся клетка получает расстояние через лучшего соседа, после чего
+ * улучшение распространяется волной. Клетки, занятые головой, не пересчитываются:
+ * их устаревшие расстояния лишь ухудшают выбор срезки, но не её безопасность,
+ * которую обеспечивает порядок гамильтонова цикла.
+ */
+void SnakeBot::relax(int cell) {
+  int head = 0; // начало очереди
+  int tail = 0; // конец очереди
+  int y = cell / width; // строка клетки
+  int x = cell % width; // столбец клетки
+  const int around[4] = {y > 0 ? cell - width : -1, y + 1 < height ? cell + width : -1,
+                         x > 0 ? cell - 1 : -1, x + 1 < width ? cell + 1 : -1}; // соседи клетки
+  for (int n : around) { // ищем лучшего свободного соседа
+    if (n >= 0 && !body[n] && dist[n] + 1 < dist[cell]) dist[cell] = dist[n] + 1; // улучшаем расстояние
+  }
+  if (dist[cell] < SNAKE_BOT_INF) queue[tail++] = cell; // клетка достижима — распространяем улучшение
+  while (head < tail) { // волна улучшений
+    int c = queue[head++]; // извлекаем клетку
+    int cy = c / width; // строка клетки
+    int cx = c % width; // столбец клетки
+    const int near[4] = {cy > 0 ? c - width : -1, cy + 1 < height ? c + width : -1,
+                         cx > 0 ? c - 1 : -1, cx + 1 < width ? c + 1 : -1}; // соседи клетки
+    for (int n : near) { // перебираем соседей
+      if (n >= 0 && !body[n] && dist[n] > dist[c] + 1 && tail < cells) { // сосед улучшается
+        dist[n] = dist[c] + 1; // записываем новое расстояние
+        queue[tail++] = n; // продолжаем волну
+      }
+    }
+  }
+}
+
+/**
+ * @brief Синхронизирует внутреннее состояние бота со змейкой.
+ *
+ * Если с прошлого вызова змейка сделала ровно один шаг без роста, маска тела
+ * обновляется по голове и хвосту, а поле расстояний досчитывается по освобождённой клетке.
+ * В остальных случаях (новое яблоко, рост, новая игра) всё строится заново.
+ */
+void SnakeBot::sync(const Snake& snake) {
+  int apple = cell_of(snake.apple_coords); // текущая клетка яблока
+  int head = cell_of(snake.snake_coords[SNAKE_HEAD]); // текущая голова
+  int tail = cell_of(snake.snake_coords[snake.snake_size - 1]); // текущий хвост
+  if (apple == planned_apple && snake.snake_size == planned_size && head == planned_head) { // ничего не изменилось
+    return; // повторный вызов без шага змейки
+  }
+  bool one_step = (apple == planned_apple && snake.snake_size == planned_size &&
+                   forward(planned_head, head) != 0 &&
+                   std::abs(head / width - planned_head / width) +
+                           std::abs(head % width - planned_head % width) == 1); // ровно один шаг без роста
+  if (!one_step) { // новое яблоко, рост или новая игра
+    rebuild(snake); // строим всё заново
+    return; // состояние синхронизировано
+  }
+  body[head] = 1; // голова заняла новую клетку
+  if (planned_tail != tail && planned_tail != head) { // хвост сдвинулся и голова не встала на его место
+    body[planned_tail] = 0; // снимаем отметку тела
+    relax(planned_tail); // досчитываем расстояния через освободившуюся клетку
+  }
+  planned_head = head; // запоминаем голову
+  planned_tail = tail; // запоминаем хвост
+}
+
+/**
+ * @brief Переводит соседнюю клетку в действие игрока.
+ *
+ * Продолжение движения в текущем направлении передаётся как Action (шаг вперёд),
+ * смена направления — соответствующей стрелкой.
+ */
+UserAction_t SnakeBot::action_to(const Snake& snake, int cell) const {
+  int dy = cell / width - snake.snake_coords[SNAKE_HEAD].first; // смещение по строкам
+  int dx = cell % width - snake.snake_coords[SNAKE_HEAD].second; // смещение по столбцам
+  Snake::Direction dir = Snake::Direction::Dir_Up; // направление, ведущее в клетку
+  UserAction_t turn = Up; // стрелка, задающая это направление
+  if (dy > 0) { // клетка ниже головы
+    dir = Snake::Direction::Dir_Down; // движение вниз
+    turn = Down; // стрелка вниз
+  } else if (dx < 0) { // клетка левее головы
+    dir = Snake::Direction::Dir_Left; // движение влево
+    turn = Left; // стрелка влево
+  } else if (dx > 0) { // клетка правее головы
+    dir = Snake::Direction::Dir_Right; // движение вправо
+    turn = Right; // стрелка вправо
+  }
+  return dir == snake.curr_direction ? Action : turn; // шаг вперёд или поворот
+}
+
+/**
+ * @brief Выбирает действие для следующего шага змейки.
+ *
+ * Вне состояния Moving возвращает Start (действие игнорируется КА).
+ * По умолчанию голова идёт в следующую клетку гамильтонова цикла. Срезка в соседнюю клетку
+ * допускается, пока змейка короче половины поля, клетка свободна, не перепрыгивает яблоко
+ * по циклу и оставляет до хвоста не меньше SNAKE_BOT_TAIL_GAP клеток; из допустимых
+ * выбирается клетка с наименьшим BFS-расстоянием до яблока.
+ *
+ * @return Действие для передачи в set_user_action().
+ */
+UserAction_t SnakeBot::next_action(const Snake& snake) {
+  if (snake.statemachine != Snake::Moving) return Start; // решение нужно только в состоянии Moving
+  sync(snake); // приводим маску тела и поле расстояний к текущему состоянию
+  int head = cell_of(snake.snake_coords[SNAKE_HEAD]); // клетка головы
+  int tail = cell_of(snake.snake_coords[snake.snake_size - 1]); // клетка хвоста
+  int apple = cell_of(snake.apple_coords); // клетка яблока
+  int best = next[head]; // по умолчанию — следующая клетка цикла
+  int best_dist = dist[best]; // её расстояние до яблока
+  if (snake.snake_size * SNAKE_BOT_SHORTCUT_LIMIT < cells) { // срезки разрешены только для короткой змейки
+    int to_tail = forward(head, tail); // свободный участок цикла до хвоста
+    int to_apple = forward(head, apple); // расстояние до яблока по циклу
+    int y = head / width; // строка головы
+    int x = head % width; // столбец головы
+    const int around[4] = {y > 0 ? head - width : -1, y + 1 < height ? head + width : -1,
+                           x > 0 ? head - 1 : -1, x + 1 < width ? head + 1 : -1}; // соседи головы
+    for (int n : around) { // перебираем соседей головы
+      if (n < 0 || body[n]) continue; // за границей поля или занята телом
+      int step = forward(head, n); // на сколько клеток цикла срезка уводит вперёд
+      if (step == 0 || step > to_apple || step + SNAKE_BOT_TAIL_GAP > to_tail) continue; // небезопасная срезка
+      if (dist[n] < best_dist) { // клетка ближе к яблоку
+        best = n; // запоминаем кандидата
+        best_dist = dist[n]; // и его расстояние
+      }
+    }
+  }
+  return action_to(snake, best); // переводим выбранную клетку в действие
+}
+
+}  // namespace s21 // конец пространства имён s21
@@ -0,0 +1,62 @@
+#ifndef SNAKE_BOT_H // защита от повторного включения заголовка: если SNAKE_BOT_H не определён
+#define SNAKE_BOT_H // определяет макрос SNAKE_BOT_H чтобы избежать повторного включения
+
+#include <algorithm> // подключает std::fill для сброса буферов поиска
+#include <cstdlib> // подключает std::abs для проверки соседства клеток
+#include <vector> // подключает заголовок для использования std::vector (буферы поиска)
+
+#include "snake.h" // подключает класс Snake, состояние которого читает автопилот
+
+#define SNAKE_BOT_INF 0x3fffffff // «бесконечное» расстояние для недостижимых клеток поля расстояний
+#define SNAKE_BOT_SHORTCUT_LIMIT 2 // срезки разрешены, пока змейка короче 1/SNAKE_BOT_SHORTCUT_LIMIT поля
+#define SNAKE_BOT_TAIL_GAP 2 // запас клеток между новой головой и хвостом при срезке
+
+namespace s21 { // начало пространства имён s21
+
+/**
+ * @brief Автопилот змейки.
+ *
+ * Ведёт змейку по заранее построенному гамильтонову циклу поля WINDOW_HEIGHT x WINDOW_WIDTH
+ * и срезает путь к яблоку по полю BFS-расстояний, если срезка не отрезает хвост.
+ * Пока тело лежит на отрезке цикла [хвост, голова], следование циклу всегда безопасно,
+ * поэтому бот гарантированно доводит игру до SNAKE_MAX_SIZE / WIN_LVL.
+ * Буферы поиска выделяются один раз, поле расстояний строится заново только при новом яблоке,
+ * а между яблоками досчитывается по клеткам, освобождённым хвостом.
+ */
+class SnakeBot { // объявление класса автопилота змейки
+ public: // публичная секция класса
+  SnakeBot(); // конструктор строит гамильтонов цикл и выделяет буферы поиска
+
+  UserAction_t next_action(const Snake& snake); // возвращает действие для следующего шага змейки
+  int cycle_index(int y, int x) const; // порядковый номер клетки (y, x) в гамильтоновом цикле
+  int cycle_next(int y, int x) const; // индекс клетки, следующей за (y, x) по циклу
+
+ private: // приватная секция полей
+  int height; // высота поля, по которому построен цикл
+  int width; // ширина поля, по которому построен цикл
+  int cells; // общее количество клеток поля
+
+  std::vector<int> order; // порядковый номер каждой клетки в гамильтоновом цикле
+  std::vector<int> next; // следующая по циклу клетка для каждой клетки
+  std::vector<int> dist; // поле BFS-расстояний от яблока по свободным клеткам
+  std::vector<int> queue; // переиспользуемый буфер очереди BFS
+  std::vector<unsigned char> body; // маска клеток, занятых телом змейки
+
+  int planned_apple; // клетка яблока, для которого построено поле расстояний (-1 — поле не построено)
+  int planned_size; // длина змейки при последнем обновлении
+  int planned_head; // голова змейки при последнем обновлении
+  int planned_tail; // хвост змейки при последнем обновлении
+
+ private: // приватная секция вспомогательных методов
+  void build_cycle(); // построение гамильтонова цикла по полю height x width
+  void sync(const Snake& snake); // синхронизация маски тела и поля расстояний с состоянием змейки
+  void rebuild(const Snake& snake); // полное построение маски тела и поля расстояний
+  void relax(int cell); // досчёт поля расстояний после освобождения клетки cell
+  int forward(int from, int to) const; // расстояние от клетки from до клетки to вперёд по циклу
+  int cell_of(const std::pair<int, int>& coords) const; // перевод пары (y, x) в индекс клетки
+  UserAction_t action_to(const Snake& snake, int cell) const; // действие, переводящее голову в соседнюю клетку cell
+}; // конец объявления класса SnakeBot
+
+}  // namespace s21 // конец пространства имён s21
+
+#endif  // SNAKE_BOT_H // конец защиты от повторного включения заголовка
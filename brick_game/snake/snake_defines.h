@@ -0,0 +1,28 @@
+#ifndef SNAKE_DEFINES_H // защита от повторного включения заголовка: если SNAKE_DEFINES_H не определён
+#define SNAKE_DEFINES_H // определяет макрос SNAKE_DEFINES_H чтобы избежать повторного включения
+
+// Общие константы змейки на стандартном поле (snake.cpp) и на большой арене (snake_arena.cpp)
+
+// Определение флагов состояния паузы
+#define PAUSE 1 // флаг паузы
+#define UNPAUSE 0 // флаг снятой паузы
+
+// Стартовый размер змейки (наибольший размер — SNAKE_MAX_SIZE в snake.h)
+#define SNAKE_START_SIZE 4 // стартовая длина змейки
+
+// Определение значений для отображения элементов на поле
+#define DESPAWN 0 // пустая клетка
+#define SPAWN_COLOR_APPLE 2 // цвет яблока
+#define SPAWN_COLOR_SNAKE 3 // цвет тела змейки
+#define SPAWN_COLOR_SNAKE_HEAD 4 // цвет головы змейки
+
+// Настройки таймера (задержка и скорость)
+#define TIMER_MAX_DELAY 1000 // максимальная задержка шага в миллисекундах
+#define TIMER_MIN_DELAY 200 // минимальная задержка шага в миллисекундах
+#define TIMER_MAX_SPEED 10 // максимальная скорость
+
+// Настройки уровней
+#define MAX_LEVEL 10 // максимальный уровень
+#define POINTS_FOR_NEXT_LEVEL 5 // очков на один уровень
+
+#endif  // SNAKE_DEFINES_H // конец защиты от повторного включения заголовка
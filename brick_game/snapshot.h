@@ -0,0 +1,96 @@
+#ifndef SNAPSHOT_H // защита от повторного включения заголовка: если SNAPSHOT_H не определён
+#define SNAPSHOT_H // определяет макрос SNAPSHOT_H чтобы предотвратить повторное включение
+
+#include <stddef.h> // подключает size_t для размеров снимка
+#include <stdint.h> // подключает целые типы фиксированной ширины
+#include <string.h> // подключает memcpy
+
+#include <type_traits> // подключает std::is_trivially_copyable для проверки копируемых типов
+
+#include "brick_game_single.h" // подключает класс Game
+
+#define SNAPSHOT_MAGIC 0x47313253u // сигнатура снимка "S21G"
+#define SNAPSHOT_VERSION 1 // версия формата снимка
+
+#define SNAPSHOT_TETRIS 1 // снимок тетриса
+#define SNAPSHOT_SNAKE 2 // снимок стандартной змейки
+#define SNAPSHOT_SNAKE_ARENA 3 // снимок змейки на большой арене
+
+namespace s21 { // начало пространства имён s21
+
+/**
+ * @brief Заголовок снимка состояния игры.
+ *
+ * По kind, pieces, height и width GameFabric::restore_game создаёт движок нужного типа.
+ * Данные после заголовка — копии памяти движка в порядке байтов машины, записавшей снимок.
+ */
+typedef struct SnapshotHeader { // заголовок снимка
+  uint32_t magic; // SNAPSHOT_MAGIC
+  uint16_t version; // SNAPSHOT_VERSION
+  uint8_t kind; // тип движка (SNAPSHOT_TETRIS, SNAPSHOT_SNAKE, SNAPSHOT_SNAKE_ARENA)
+  uint8_t pieces; // набор фигур тетриса (GameFabric::PieceSet)
+  uint32_t size; // полный размер снимка вместе с заголовком
+  int32_t height; // высота поля (для арены — высота арены)
+  int32_t width; // ширина поля (для арены — ширина арены)
+} SnapshotHeader; // имя типа — SnapshotHeader
+
+/**
+ * @brief Последовательная запись снимка в буфер.
+ *
+ * Значения копируются memcpy без преобразований; буфер заранее имеет размер snapshot_size.
+ */
+class SnapshotWriter { // запись снимка
+ public: // публичная секция класса
+  explicit SnapshotWriter(uint8_t* buf) : pos(buf) {} // запись с начала буфера
+
+  template <class T> // копируемый тип
+  void put(const T& value) { // запись значения
+    static_assert(std::is_trivially_copyable<T>::value, "snapshot stores raw memory"); // только копии памяти
+    put_bytes(&value, sizeof(T)); // байты значения
+  } // конец метода put
+
+  void put_bytes(const void* data, size_t size) { // запись блока памяти
+    memcpy(pos, data, size); // копирование
+    pos += size; // следующая запись
+  } // конец метода put_bytes
+
+ private: // приватная секция для данных
+  uint8_t* pos; // позиция записи
+}; // конец объявления класса SnapshotWriter
+
+/**
+ * @brief Последовательное чтение снимка из буфера.
+ *
+ * Чтение за концом буфера не выполняется и переводит ok() в false.
+ */
+class SnapshotReader { // чтение снимка
+ public: // публичная секция класса
+  SnapshotReader(const uint8_t* buf, size_t size) : pos(buf), end(buf + size), good(true) {} // чтение буфера
+
+  template <class T> // копируемый тип
+  bool get(T* value) { // чтение значения
+    static_assert(std::is_trivially_copyable<T>::value, "snapshot stores raw memory"); // только копии памяти
+    return get_bytes(value, sizeof(T)); // байты значения
+  } // конец метода get
+
+  bool get_bytes(void* data, size_t size) { // чтение блока памяти
+    good = good && (size_t)(end - pos) >= size; // данных достаточно
+    if (good) { // копируем только целый блок
+      memcpy(data, pos, size); // копирование
+      pos += size; // следующее чтение
+    } // конец проверки длины
+    return good; // результат чтения
+  } // конец метода get_bytes
+
+  bool ok() const { return good; } // все чтения были в пределах буфера
+  size_t left() const { return end - pos; } // непрочитанные байты
+
+ private: // приватная секция для данных
+  const uint8_t* pos; // позиция чтения
+  const uint8_t* end; // конец буфера
+  bool good; // чтения были в пределах буфера
+}; // конец объявления класса SnapshotReader
+
+}  // namespace s21 // конец пространства имён s21
+
+#endif  // SNAPSHOT_H // конец защиты от повторного включения заголовка
@@ -0,0 +1,192 @@
+#include "stats.h" // подключает объявление счётчиков и C API статистики
+
+#include <atomic> // подключает атомарные счётчики, которые читаются из другого потока
+#include <memory> // подключает std::unique_ptr для суммы счётчиков
+#include <mutex> // подключает std::mutex для списка потоков
+#include <vector> // подключает std::vector для списка счётчиков потоков
+
+namespace s21 { // начало пространства имён s21
+
+/**
+ * @brief Счётчики одного потока.
+ *
+ * Пишет только владелец (обычная запись без блокирующих инструкций), читатель суммирует
+ * счётчики всех потоков под мьютексом списка. Атомарность нужна лишь для того, чтобы
+ * чтение из другого потока не было гонкой данных.
+ */
+struct StatsShard { // счётчики потока
+  std::atomic<uint64_t> calls[STATS_STATE_COUNT]; // вызовов состояния
+  std::atomic<uint64_t> total_ns[STATS_STATE_COUNT]; // суммарное время состояния
+  std::atomic<uint64_t> max_ns[STATS_STATE_COUNT]; // наибольшее время состояния
+  std::atomic<uint64_t> latency[STATS_STATE_COUNT][STATS_BUCKETS]; // гистограммы времени состояний
+  std::atomic<uint64_t> events[STAT_EVENT_COUNT]; // счётчики событий
+}; // конец объявления StatsShard
+
+struct StatsRegistry { // счётчики всех потоков
+  std::mutex lock; // защищает список и счётчики завершившихся потоков
+  std::vector<StatsShard*> live; // счётчики работающих потоков
+  StatsShard retired{}; // сумма счётчиков завершившихся потоков
+}; // конец объявления StatsRegistry
+
+static StatsRegistry& registry() { // общий список (не разрушается: потоки могут завершаться после main)
+  static StatsRegistry* instance = new StatsRegistry(); // создаётся при первом обращении
+  return *instance; // список
+} // конец функции registry
+
+static inline void bump(std::atomic<uint64_t>& counter, uint64_t value) { // прибавление единственным писателем
+  counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed); // без lock-префикса
+} // конец функции bump
+
+static void merge(StatsShard* into, const StatsShard& from) { // прибавление счётчиков from к into
+  for (int s = 0; s < STATS_STATE_COUNT; s++) { // состояния
+    bump(into->calls[s], from.calls[s].load(std::memory_order_relaxed)); // вызовы
+    bump(into->total_ns[s], from.total_ns[s].load(std::memory_order_relaxed)); // время
+    uint64_t max = from.max_ns[s].load(std::memory_order_relaxed); // наибольшее время
+    if (max > into->max_ns[s].load(std::memory_order_relaxed)) into->max_ns[s].store(max, std::memory_order_relaxed);
+    for (int b = 0; b < STATS_BUCKETS; b++) bump(into->latency[s][b], from.latency[s][b].load(std::memory_order_relaxed));
+  } // конец цикла по состояниям
+  for (int e = 0; e < STAT_EVENT_COUNT; e++) bump(into->events[e], from.events[e].load(std::memory_order_relaxed));
+} // конец функции merge
+
+static void zero(StatsShard* shard) { // обнуление счётчиков
+  for (int s = 0; s < STATS_STATE_COUNT; s++) { // состояния
+    shard->calls[s].store(0, std::memory_order_relaxed); // вызовы
+    shard->total_ns[s].store(0, std::memory_order_relaxed); // время
+    shard->max_ns[s].store(0, std::memory_order_relaxed); // наибольшее время
+    for (int b = 0; b < STATS_BUCKETS; b++) shard->latency[s][b].store(0, std::memory_order_relaxed); // гистограмма
+  } // конец цикла по состояниям
+  for (int e = 0; e < STAT_EVENT_COUNT; e++) shard->events[e].store(0, std::memory_order_relaxed); // события
+} // конец функции zero
+
+/**
+ * @brief Владелец счётчиков потока.
+ *
+ * Регистрирует счётчики при первом событии потока и при завершении потока переносит
+ * их в сумму завершившихся.
+ */
+class ShardHandle { // счётчики текущего потока
+ public: // публичная секция класса
+  ShardHandle() : shard(new StatsShard()) { // счётчики нового потока
+    std::lock_guard<std::mutex> guard(registry().lock); // список потоков
+    registry().live.push_back(shard); // поток виден читателям
+  } // конец конструктора
+  ~ShardHandle() { // поток завершается
+    StatsRegistry& all = registry(); // список потоков
+    std::lock_guard<std::mutex> guard(all.lock); // список потоков
+    merge(&all.retired, *shard); // счётчики сохраняются в сумме
+    for (size_t i = 0; i < all.live.size(); i++) { // поиск потока в списке
+      if (all.live[i] == shard) { // нашли
+        all.live[i] = all.live.back(); // удаление перестановкой
+        all.live.pop_back(); // последний элемент
+        break; // поток один раз в списке
+      } // конец проверки
+    } // конец поиска
+    delete shard; // счётчики больше не нужны
+  } // конец деструктора
+
+  StatsShard* shard; // счётчики потока
+}; // конец объявления класса ShardHandle
+
+static StatsShard& local_shard() { // счётчики текущего потока
+  thread_local ShardHandle handle; // создаётся при первом обращении потока
+  return *handle.shard; // счётчики
+} // конец функции local_shard
+
+/**
+ * @brief Номер корзины гистограммы.
+ *
+ * Логарифмически-линейное деление, как в HDR Histogram: значения 0..7 — свои корзины,
+ * дальше каждая степень двойки делится на STATS_SUB_BUCKETS равных корзин, так что
+ * относительная погрешность не превышает 1/8 на всём диапазоне uint64_t.
+ */
+int stats_bucket(uint64_t value) { // номер корзины
+  if (value < STATS_SUB_BUCKETS) return (int)value; // малые значения точно
+  int msb = 63 - __builtin_clzll(value); // старший бит
+  int shift = msb - STATS_SUB_BITS; // отбрасываемые младшие биты
+  return (shift + 1) * STATS_SUB_BUCKETS + (int)((value >> shift) & (STATS_SUB_BUCKETS - 1)); // группа и мантисса
+} // конец функции stats_bucket
+
+uint64_t stats_bucket_max(int bucket) { // наибольшее значение корзины
+  if (bucket < STATS_SUB_BUCKETS) return bucket; // малые значения точно
+  int shift = bucket / STATS_SUB_BUCKETS - 1; // отброшенные младшие биты
+  uint64_t mantissa = STATS_SUB_BUCKETS + bucket % STATS_SUB_BUCKETS; // старшие биты с единицей
+  return ((mantissa + 1) << shift) - 1; // последнее значение корзины (для последней корзины — переполнение в UINT64_MAX)
+} // конец функции stats_bucket_max
+
+void stats_state(int state, uint64_t ns) { // учёт шага КА
+  if (state < 0 || state >= STATS_STATE_COUNT) return; // неизвестное состояние
+  StatsShard& shard = local_shard(); // счётчики потока
+  bump(shard.calls[state], 1); // вызов
+  bump(shard.total_ns[state], ns); // время
+  if (ns > shard.max_ns[state].load(std::memory_order_relaxed)) shard.max_ns[state].store(ns, std::memory_order_relaxed);
+  bump(shard.latency[state][stats_bucket(ns)], 1); // корзина гистограммы
+} // конец функции stats_state
+
+void stats_event(StatEvent_t event, uint64_t count) { // учёт события
+  bump(local_shard().events[event], count); // счётчик события
+} // конец функции stats_event
+
+static void collect(StatsShard* total) { // сумма счётчиков всех потоков
+  StatsRegistry& all = registry(); // список потоков
+  std::lock_guard<std::mutex> guard(all.lock); // список не меняется во время чтения
+  merge(total, all.retired); // завершившиеся потоки
+  for (StatsShard* shard : all.live) merge(total, *shard); // работающие потоки
+} // конец функции collect
+
+static uint64_t quantile_of(const std::atomic<uint64_t>* buckets, uint64_t calls, double quantile) { // квантиль
+  if (calls == 0) return 0; // вызовов не было
+  uint64_t rank = (uint64_t)(quantile * calls); // номер вызова в порядке возрастания времени
+  if (rank >= calls) rank = calls - 1; // квантиль 1.0 — наибольший
+  uint64_t seen = 0; // вызовов в просмотренных корзинах
+  int bucket = 0; // текущая корзина
+  for (; bucket < STATS_BUCKETS - 1; bucket++) { // корзины по возрастанию
+    seen += buckets[bucket].load(std::memory_order_relaxed); // вызовы корзины
+    if (seen > rank) break; // вызов с номером rank в этой корзине
+  } // конец перебора корзин
+  return stats_bucket_max(bucket); // верхняя граница корзины
+} // конец функции quantile_of
+
+}  // namespace s21 // конец пространства имён s21
+
+// ================= API ==================
+/**
+ * @brief Сумма счётчиков всех потоков процесса.
+ *
+ * Без флага GAME_STATS счётчики не растут, enabled равно 0.
+ */
+GameStats_t getGameStats() { // глобальная функция API статистики
+  GameStats_t stats{}; // результат
+#ifdef GAME_STATS
+  stats.enabled = 1; // счётчики собраны
+#endif
+  auto total = std::unique_ptr<s21::StatsShard>(new s21::StatsShard()); // сумма (гистограммы велики для стека)
+  s21::collect(total.get()); // счётчики всех потоков
+  for (int s = 0; s < STATS_STATE_COUNT; s++) { // состояния
+    stats.states[s].calls = total->calls[s].load(std::memory_order_relaxed); // вызовы
+    stats.states[s].total_ns = total->total_ns[s].load(std::memory_order_relaxed); // время
+    stats.states[s].max_ns = total->max_ns[s].load(std::memory_order_relaxed); // наибольшее время
+    stats.states[s].p50_ns = s21::quantile_of(total->latency[s], stats.states[s].calls, 0.5); // медиана
+    stats.states[s].p99_ns = s21::quantile_of(total->latency[s], stats.states[s].calls, 0.99); // 99-й перцентиль
+  } // конец цикла по состояниям
+  for (int e = 0; e < STAT_EVENT_COUNT; e++) stats.events[e] = total->events[e].load(std::memory_order_relaxed);
+  return stats; // статистика
+} // конец функции getGameStats
+
+unsigned long long getStateLatency(int state, double quantile) { // квантиль времени состояния
+  if (state < 0 || state >= STATS_STATE_COUNT) return 0; // неизвестное состояние
+  auto total = std::unique_ptr<s21::StatsShard>(new s21::StatsShard()); // сумма счётчиков
+  s21::collect(total.get()); // счётчики всех потоков
+  return s21::quantile_of(total->latency[state], total->calls[state].load(std::memory_order_relaxed), quantile);
+} // конец функции getStateLatency
+
+/**
+ * @brief Обнуляет счётчики всех потоков.
+ *
+ * Событие, учитываемое другим потоком во время сброса, может сохраниться.
+ */
+void resetGameStats() { // глобальная функция API сброса статистики
+  s21::StatsRegistry& all = s21::registry(); // список потоков
+  std::lock_guard<std::mutex> guard(all.lock); // список не меняется во время сброса
+  s21::zero(&all.retired); // завершившиеся потоки
+  for (s21::StatsShard* shard : all.live) s21::zero(shard); // работающие потоки
+} // конец функции resetGameStats
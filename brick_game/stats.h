@@ -0,0 +1,76 @@
+#ifndef STATS_H // защита от повторного включения заголовка: если STATS_H не определён
+#define STATS_H // определяет макрос STATS_H чтобы предотвратить повторное включение
+
+#include <stdint.h> // подключает целые типы фиксированной ширины для счётчиков
+
+#include <chrono> // подключает steady_clock для замера длительности шага КА
+
+#define STATS_STATE_COUNT 6 // состояний КА: GameStart, Spawn, Moving, Shifting, Attaching, GameOver
+#define STATS_SUB_BITS 3 // бит мантиссы в номере корзины гистограммы
+#define STATS_SUB_BUCKETS (1 << STATS_SUB_BITS) // корзин на одну степень двойки
+#define STATS_BUCKETS ((64 - STATS_SUB_BITS + 1) * STATS_SUB_BUCKETS) // корзин на весь диапазон uint64_t
+
+typedef enum { // события движков, которые считает статистика
+  STAT_LINES_CLEARED = 0, // удалённые строки тетриса
+  STAT_ROTATIONS, // выполненные повороты фигуры или головы змейки
+  STAT_REJECTED_MOVES, // запрошенный сдвиг или поворот не изменил положение
+  STAT_FILE_WRITES, // записи файла рекорда
+  STAT_EVENT_COUNT // количество событий
+} StatEvent_t; // тип StatEvent_t — номер счётчика события
+
+typedef struct { // статистика одного состояния КА
+  unsigned long long calls; // вызовов состояния
+  unsigned long long total_ns; // суммарное время в наносекундах
+  unsigned long long max_ns; // наибольшее время одного вызова
+  unsigned long long p50_ns; // медиана (верхняя граница корзины гистограммы)
+  unsigned long long p99_ns; // 99-й перцентиль (верхняя граница корзины гистограммы)
+} StateStats_t; // имя типа — StateStats_t
+
+typedef struct { // статистика всех сессий процесса
+  int enabled; // 1 если библиотека собрана со счётчиками (GAME_STATS)
+  StateStats_t states[STATS_STATE_COUNT]; // по состояниям КА в порядке Game::State_of_machine
+  unsigned long long events[STAT_EVENT_COUNT]; // счётчики событий по StatEvent_t
+} GameStats_t; // имя типа — GameStats_t
+
+GameStats_t getGameStats(); // прототип глобальной функции API: сумма счётчиков всех потоков
+unsigned long long getStateLatency(int state, double quantile); // прототип: квантиль времени состояния в наносекундах
+void resetGameStats(); // прототип глобальной функции API: обнуление счётчиков всех потоков
+
+namespace s21 { // начало пространства имён s21
+
+void stats_state(int state, uint64_t ns); // учёт вызова состояния КА длительностью ns в счётчиках потока
+void stats_event(StatEvent_t event, uint64_t count); // учёт события в счётчиках потока
+int stats_bucket(uint64_t value); // номер корзины гистограммы для значения
+uint64_t stats_bucket_max(int bucket); // наибольшее значение, попадающее в корзину
+
+/**
+ * @brief Замер одного шага КА: время от создания до разрушения объекта.
+ */
+class StateTimer { // объявление замера шага
+ public: // публичная секция класса
+  explicit StateTimer(int state) : state(state), start(std::chrono::steady_clock::now()) {} // начало замера
+  ~StateTimer() { // конец замера
+    stats_state(state, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start)
+                           .count()); // учёт вызова
+  } // конец деструктора
+
+ private: // приватная секция для данных замера
+  int state; // состояние КА
+  std::chrono::steady_clock::time_point start; // время начала шага
+}; // конец объявления класса StateTimer
+
+}  // namespace s21 // конец пространства имён s21
+
+/*
+ * Счётчики включаются флагом компиляции GAME_STATS (make STATS=1, по умолчанию).
+ * Без него макросы ничего не делают, а getGameStats возвращает нули и enabled = 0.
+ */
+#ifdef GAME_STATS
+#define STATS_STATE_SCOPE(state) s21::StateTimer stats_state_timer(state) // замер шага до конца блока
+#define STATS_EVENT(event, count) s21::stats_event(event, count) // учёт события
+#else
+#define STATS_STATE_SCOPE(state) ((void)0) // счётчики выключены
+#define STATS_EVENT(event, count) ((void)0) // счётчики выключены
+#endif
+
+#endif  // STATS_H // конец защиты от повторного включения заголовка
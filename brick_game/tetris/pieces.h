@@ -0,0 +1,201 @@
+#ifndef PIECES_H // защита от повторного включения заголовка: если PIECES_H не определён
+#define PIECES_H // определяет макрос PIECES_H чтобы предотвратить повторное включение
+
+#include <stdint.h> // подключает целочисленные типы фиксированной ширины (uint32_t для масок поворотов)
+
+#include "../brick_game_single.h" // подключает WINDOW_WIDTH стандартного поля
+
+#define PIECE_MAX_CELLS 5 // наибольшее число блоков фигуры (пентамино)
+#define PIECE_MAX_RADIUS 2 // наибольшее удаление блока от опорного по каждой оси
+#define ROTATE_MAX_SIZE (2 * PIECE_MAX_RADIUS + 1) // наибольший размер матрицы поворота (5 — для Hero и пентамино)
+#define PIECE_ROTATIONS 4 // число поворотов фигуры на 90 градусов
+
+namespace s21 { // начало пространства имён s21
+
+/**
+ * @brief Смещение блока фигуры относительно опорного блока.
+ */
+struct PieceCell { // смещение блока
+  int y; // смещение по строкам
+  int x; // смещение по столбцам
+}; // конец объявления PieceCell
+
+/**
+ * @brief Форма фигуры: первый блок — опорный (смещение {0, 0}), вокруг него фигура поворачивается.
+ */
+template <int Cells> // количество блоков фигуры
+struct PieceShape { // форма фигуры
+  PieceCell cells[Cells]; // смещения блоков, опорный блок первый
+}; // конец объявления PieceShape
+
+/**
+ * @brief Таблица набора фигур, вычисляемая при компиляции.
+ *
+ * По формам фигур constexpr-конструктор считает координаты появления (фигура
+ * прижата к верху и центрирована на поле стандартной ширины), размер матрицы поворота,
+ * признак поворота (фигура, совпадающая с собой после поворота на 90 градусов, не поворачивается)
+ * и маски всех четырёх поворотов. По маске движок за несколько сравнений узнаёт фигуру
+ * по координатам, не храня её номер рядом с массивом координат.
+ */
+template <int Cells, int Count> // количество блоков фигуры и количество фигур набора
+struct PieceTable { // таблица набора фигур
+  static_assert(Cells >= 1 && Cells <= PIECE_MAX_CELLS, "unsupported piece size"); // фигура от одного до пяти блоков
+
+  int spawn[Count][2 * Cells] = {}; // координаты появления (пары Y,X), порядок блоков как в форме
+  int rotate_size[Count] = {}; // размер матрицы поворота: 2 * радиус + 1
+  bool rotates[Count] = {}; // поворачивается ли фигура
+  uint32_t masks[Count][PIECE_ROTATIONS] = {}; // маски смещений блоков в каждом повороте
+  int max_radius = 0; // наибольший радиус фигуры набора
+  int max_height = 0; // наибольшая высота фигуры при появлении
+  int max_width = 0; // наибольшая ширина фигуры при появлении
+
+  constexpr explicit PieceTable(const PieceShape<Cells> (&shapes)[Count]) { // расчёт таблицы по формам
+    for (int p = 0; p < Count; p++) { // проход по фигурам набора
+      const PieceCell* cells = shapes[p].cells; // блоки фигуры
+      int min_y = 0, min_x = 0, max_y = 0, max_x = 0, radius = 0; // габариты относительно опорного блока
+      for (int c = 0; c < Cells; c++) { // проход по блокам
+        min_y = cells[c].y < min_y ? cells[c].y : min_y; // верхняя граница
+        min_x = cells[c].x < min_x ? cells[c].x : min_x; // левая граница
+        max_y = cells[c].y > max_y ? cells[c].y : max_y; // нижняя граница
+        max_x = cells[c].x > max_x ? cells[c].x : max_x; // правая граница
+        radius = distance(cells[c]) > radius ? distance(cells[c]) : radius; // удаление от опорного блока
+      } // конец прохода по блокам
+      int height = max_y - min_y + 1; // высота фигуры
+      int width = max_x - min_x + 1; // ширина фигуры
+      for (int c = 0; c < Cells; c++) { // координаты появления
+        spawn[p][2 * c] = cells[c].y - min_y; // фигура прижата к верхней строке
+        spawn[p][2 * c + 1] = cells[c].x - min_x + (WINDOW_WIDTH - width) / 2; // фигура по центру поля
+      } // конец расчёта координат появления
+      rotate_size[p] = 2 * radius + 1; // матрица поворота вмещает фигуру вокруг опорного блока
+      PieceCell state[Cells] = {}; // текущий поворот
+      for (int c = 0; c < Cells; c++) state[c] = cells[c]; // исходный поворот
+      for (int r = 0; r < PIECE_ROTATIONS; r++) { // маски четырёх поворотов
+        masks[p][r] = pivot_mask(state); // маска поворота
+        for (int c = 0; c < Cells; c++) state[c] = PieceCell{state[c].x, -state[c].y}; // поворот по часовой стрелке
+      } // конец расчёта масок
+      for (int c = 0; c < Cells; c++) state[c] = PieceCell{cells[c].x, -cells[c].y}; // поворот на 90 градусов
+      rotates[p] = shape_mask(state) != shape_mask(cells); // форма после поворота отличается
+      max_radius = radius > max_radius ? radius : max_radius; // наибольший радиус набора
+      max_height = height > max_height ? height : max_height; // наибольшая высота набора
+      max_width = width > max_width ? width : max_width; // наибольшая ширина набора
+    } // конец прохода по фигурам
+  } // конец конструктора
+
+  /**
+   * @brief Номер фигуры (с нуля) по координатам блоков в любом повороте.
+   *
+   * @param brick координаты фигуры (пары Y,X), опорный блок первый
+   * @return номер фигуры или -1, если координаты не соответствуют ни одной фигуре набора
+   */
+  constexpr int piece_of(const int* brick) const { // поиск фигуры по маске смещений
+    uint32_t mask = 0; // маска смещений блоков
+    for (int c = 0; c < Cells; c++) { // проход по блокам
+      PieceCell cell{brick[2 * c] - brick[0], brick[2 * c + 1] - brick[1]}; // смещение от опорного блока
+      if (distance(cell) > PIECE_MAX_RADIUS) return -1; // фигура не из набора
+      mask |= bit(cell); // отмечаем блок
+    } // конец прохода по блокам
+    int res = -1; // по умолчанию фигура не найдена
+    for (int p = 0; p < Count && res < 0; p++) // проход по фигурам
+      for (int r = 0; r < PIECE_ROTATIONS; r++) // проход по поворотам
+        if (masks[p][r] == mask) res = p; // фигура найдена
+    return res; // номер фигуры
+  } // конец метода piece_of
+
+ private: // вспомогательные функции расчёта
+  static constexpr int distance(const PieceCell& cell) { // удаление блока от опорного (по наибольшей оси)
+    int dy = cell.y < 0 ? -cell.y : cell.y; // модуль смещения по строкам
+    int dx = cell.x < 0 ? -cell.x : cell.x; // модуль смещения по столбцам
+    return dy > dx ? dy : dx; // наибольшее смещение
+  } // конец функции distance
+
+  static constexpr uint32_t bit(const PieceCell& cell) { // бит блока в матрице ROTATE_MAX_SIZE x ROTATE_MAX_SIZE
+    return 1u << ((cell.y + PIECE_MAX_RADIUS) * ROTATE_MAX_SIZE + cell.x + PIECE_MAX_RADIUS); // 25 бит на матрицу 5x5
+  } // конец функции bit
+
+  static constexpr uint32_t pivot_mask(const PieceCell* cells) { // маска блоков относительно опорного
+    uint32_t mask = 0; // маска
+    for (int c = 0; c < Cells; c++) mask |= bit(cells[c]); // отмечаем блоки
+    return mask; // маска поворота
+  } // конец функции pivot_mask
+
+  static constexpr uint32_t shape_mask(const PieceCell* cells) { // маска формы без учёта положения
+    int min_y = cells[0].y, min_x = cells[0].x; // левый верхний угол габарита
+    for (int c = 1; c < Cells; c++) { // проход по блокам
+      min_y = cells[c].y < min_y ? cells[c].y : min_y; // верхняя граница
+      min_x = cells[c].x < min_x ? cells[c].x : min_x; // левая граница
+    } // конец прохода по блокам
+    uint32_t mask = 0; // маска формы
+    for (int c = 0; c < Cells; c++) // отмечаем блоки от угла габарита
+      mask |= bit(PieceCell{cells[c].y - min_y - PIECE_MAX_RADIUS, cells[c].x - min_x - PIECE_MAX_RADIUS});
+    return mask; // маска формы
+  } // конец функции shape_mask
+}; // конец объявления PieceTable
+
+/**
+ * @brief Стандартные тетрамино: Teewee, Hero, Smashboy, Orange Ricky, Blue Ricky, Cleveland Z, Rhode Island Z.
+ */
+inline constexpr PieceShape<4> TETROMINO_SHAPES[] = {
+    {{{0, 0}, {0, -1}, {-1, 0}, {0, 1}}}, // Teewee
+    {{{0, 0}, {0, -1}, {0, -2}, {0, 1}}}, // Hero
+    {{{0, 0}, {0, 1}, {1, 0}, {1, 1}}}, // Smashboy
+    {{{0, 0}, {0, -1}, {0, 1}, {-1, 1}}}, // Orange Ricky
+    {{{0, 0}, {-1, -1}, {0, -1}, {0, 1}}}, // Blue Ricky
+    {{{0, 0}, {-1, -1}, {-1, 0}, {0, 1}}}, // Cleveland Z
+    {{{0, 0}, {0, -1}, {-1, 0}, {-1, 1}}}, // Rhode Island Z
+}; // конец набора тетрамино
+
+/**
+ * @brief Двенадцать пентамино (F, I, L, N, P, T, U, V, W, X, Y, Z).
+ *
+ * Длинные фигуры появляются вертикально, чтобы не выходить за окно следующей фигуры.
+ */
+inline constexpr PieceShape<5> PENTOMINO_SHAPES[] = {
+    {{{0, 0}, {-1, 0}, {-1, 1}, {0, -1}, {1, 0}}}, // F
+    {{{0, 0}, {-2, 0}, {-1, 0}, {1, 0}, {2, 0}}}, // I
+    {{{0, 0}, {-1, 0}, {1, 0}, {2, 0}, {2, 1}}}, // L
+    {{{0, 0}, {-1, 0}, {1, -1}, {1, 0}, {2, -1}}}, // N
+    {{{0, 0}, {-1, 0}, {-1, 1}, {0, 1}, {1, 0}}}, // P
+    {{{0, 0}, {-1, -1}, {-1, 0}, {-1, 1}, {1, 0}}}, // T
+    {{{0, 0}, {-1, -1}, {-1, 1}, {0, -1}, {0, 1}}}, // U
+    {{{0, 0}, {-1, 0}, {1, 0}, {1, 1}, {1, 2}}}, // V
+    {{{0, 0}, {-1, -1}, {0, -1}, {1, 0}, {1, 1}}}, // W
+    {{{0, 0}, {-1, 0}, {0, -1}, {0, 1}, {1, 0}}}, // X
+    {{{0, 0}, {-1, 0}, {0, -1}, {1, 0}, {2, 0}}}, // Y
+    {{{0, 0}, {-1, -1}, {-1, 0}, {1, 0}, {1, 1}}}, // Z
+}; // конец набора пентамино
+
+/**
+ * @brief Тренировочный набор: только Hero и Smashboy.
+ */
+inline constexpr PieceShape<4> TRAINING_SHAPES[] = {TETROMINO_SHAPES[1], TETROMINO_SHAPES[2]};
+
+/**
+ * @brief Набор фигур — параметр шаблона TetrisGame.
+ *
+ * cells — количество блоков фигуры, count — количество фигур, table — таблица,
+ * посчитанная при компиляции. Новый набор описывается так же, без изменений движка.
+ */
+struct StandardPieces { // стандартные тетрамино
+  static constexpr int id = 0; // номер набора в GameFabric::PieceSet
+  static constexpr int cells = 4; // блоков в фигуре
+  static constexpr int count = 7; // фигур в наборе
+  static constexpr PieceTable<cells, count> table{TETROMINO_SHAPES}; // таблица набора
+}; // конец объявления StandardPieces
+
+struct PentominoPieces { // пентамино
+  static constexpr int id = 1; // номер набора в GameFabric::PieceSet
+  static constexpr int cells = 5; // блоков в фигуре
+  static constexpr int count = 12; // фигур в наборе
+  static constexpr PieceTable<cells, count> table{PENTOMINO_SHAPES}; // таблица набора
+}; // конец объявления PentominoPieces
+
+struct TrainingPieces { // тренировочный набор
+  static constexpr int id = 2; // номер набора в GameFabric::PieceSet
+  static constexpr int cells = 4; // блоков в фигуре
+  static constexpr int count = 2; // фигур в наборе
+  static constexpr PieceTable<cells, count> table{TRAINING_SHAPES}; // таблица набора
+}; // конец объявления TrainingPieces
+
+}  // namespace s21 // конец пространства имён s21
+
+#endif  // PIECES_H // конец защиты от повторного включения заголовка
@@ -0,0 +1,216 @@
+#include "placement.h" // подключает объявление класса PlacementFinder
+
+#include <algorithm> // подключает std::fill, std::sort и std::equal для буферов поиска
+
+#define Y_CORDS 0 // индекс в массиве фигур, соответствующий координате Y
+#define DOWN 1 // смещение вниз (положительное по Y)
+#define SHAPE_OFFSET 4 // сдвиг относительных координат блока в неотрицательный диапазон
+#define SHAPE_BITS 4 // число бит на одну относительную координату в ключе формы
+
+namespace s21 { // начало пространства имён s21
+
+/**
+ * @brief Конструктор.
+ *
+ * Связывает перебор с сессией game: её проверки движения используются при поиске, а буферы
+ * выделяются под её поле (PLACEMENT_ROTATIONS поворотов на каждую клетку).
+ */
+template <class Engine>
+BasicPlacementFinder<Engine>::BasicPlacementFinder(Engine* game)
+    : rules(game), height(game->board.height()), width(game->board.width()), shapes_count(0), placements_count(0) { // результаты поиска изначально пусты
+  int total = states(); // число состояний поиска
+  visited.resize((total + 63) / 64); // 64 состояния на слово
+  parent.resize(total); // буферы обхода
+  via.resize(total);
+  depth.resize(total);
+  bricks.resize((size_t)total * size); // координаты фигуры каждого состояния
+  queue.resize(total);
+  placements.resize(total); // конечных положений не больше состояний
+  placement_cells.resize((size_t)total * cells); // клетки каждого положения
+} // конец конструктора
+
+template <class Engine>
+int BasicPlacementFinder<Engine>::states() const { return height * width * PLACEMENT_ROTATIONS; } // (y, x, поворот)
+
+/**
+ * @brief Вычисляет ключ формы фигуры.
+ *
+ * Координаты блоков берутся относительно опорного блока (brick[0], brick[1]), вокруг которого
+ * выполняется поворот, и упорядочиваются, поэтому ключ не зависит от порядка блоков в массиве.
+ */
+template <class Engine>
+uint32_t BasicPlacementFinder<Engine>::shape_key(const int* brick) const {
+  uint32_t codes[PIECE_MAX_CELLS - 1]; // коды неопорных блоков
+  int n = 0; // количество кодов
+  for (int i = 2; i < size; i += 2) { // проходим по неопорным блокам
+    uint32_t dy = brick[i] - brick[0] + SHAPE_OFFSET; // относительная строка
+    uint32_t dx = brick[i + 1] - brick[1] + SHAPE_OFFSET; // относительный столбец
+    codes[n++] = (dy << SHAPE_BITS) | dx; // код блока
+  }
+  for (int i = 1; i < n; i++) { // сортировка вставками (не больше четырёх элементов)
+    for (int j = i; j > 0 && codes[j - 1] > codes[j]; j--) { // сдвигаем больший код вправо
+      uint32_t t = codes[j]; // временное значение
+      codes[j] = codes[j - 1]; // обмен
+      codes[j - 1] = t; // обмен
+    }
+  }
+  uint32_t key = 0; // итоговый ключ
+  for (int i = 0; i < n; i++) key = (key << (2 * SHAPE_BITS)) | codes[i]; // склеиваем коды (8 бит на блок, до четырёх блоков)
+  return key; // возвращаем ключ формы
+}
+
+/**
+ * @brief Номера клеток, занятых фигурой.
+ *
+ * Номера y * ширина поля + x упорядочиваются, поэтому положения, отличающиеся только
+ * поворотом вокруг опорного блока, дают одинаковый набор.
+ */
+template <class Engine>
+void BasicPlacementFinder<Engine>::cells_of(const int* brick, int* out) const {
+  for (int i = 0; i < size; i += 2) out[i / 2] = brick[i] * width + brick[i + 1]; // номер клетки
+  std::sort(out, out + cells); // порядок блоков в массиве не важен
+}
+
+/**
+ * @brief Возвращает номер состояния для координат фигуры.
+ *
+ * Поворот определяется по ключу формы: новые формы получают следующий свободный номер.
+ * @return номер состояния или -1, если форм больше PLACEMENT_ROTATIONS
+ */
+template <class Engine>
+int BasicPlacementFinder<Engine>::state_of(const int* brick) {
+  uint32_t key = shape_key(brick); // ключ формы
+  int rotation = 0; // номер поворота
+  while (rotation < shapes_count && shapes[rotation] != key) rotation++; // ищем форму среди встреченных
+  if (rotation == shapes_count) { // форма встречена впервые
+    if (shapes_count == PLACEMENT_ROTATIONS) return -1; // такого не бывает для корректных фигур
+    shapes[shapes_count++] = key; // регистрируем новую форму
+  }
+  return (rotation * height + brick[0]) * width + brick[1]; // (поворот, y, x) в одно число
+}
+
+/**
+ * @brief Отмечает состояние посещённым и ставит его в очередь.
+ *
+ * @return true если состояние новое
+ */
+template <class Engine>
+bool BasicPlacementFinder<Engine>::visit(int state, const int* brick, int from, UserAction_t action) {
+  bool res = false; // по умолчанию состояние уже посещено
+  if (state >= 0 && !(visited[state / 64] & (1ULL << (state % 64)))) { // состояние ещё не встречалось
+    visited[state / 64] |= 1ULL << (state % 64); // отмечаем в битовом множестве
+    rules->brick_copy(&bricks[(size_t)state * size], brick); // сохраняем координаты
+    parent[state] = from; // запоминаем предыдущее состояние
+    via[state] = action; // и действие перехода
+    depth[state] = (from < 0) ? 0 : depth[from] + 1; // длина пути
+    res = true; // состояние новое
+  }
+  return res; // результат отметки
+}
+
+/**
+ * @brief Перебирает все достижимые конечные положения фигуры.
+ *
+ * Поле field не должно содержать саму фигуру. Переходы Left, Right и Action выполняются
+ * через Tetris::brick_move, переход Down — через Tetris::check_down, как в состоянии Shifting.
+ *
+ * @param field игровое поле без перемещаемой фигуры
+ * @param brick координаты фигуры в исходном положении
+ * @return количество найденных конечных положений
+ */
+template <class Engine>
+int BasicPlacementFinder<Engine>::find(int** field, const int* brick) {
+  static const UserAction_t moves[] = {Left, Right, Action, Down}; // допустимые переходы
+  std::fill(visited.begin(), visited.end(), 0); // сбрасываем посещённые состояния
+  shapes_count = 0; // формы определяются заново для каждой фигуры
+  placements_count = 0; // результаты прошлого поиска отбрасываются
+  int head = 0; // начало очереди
+  int tail = 0; // конец очереди
+  int start = state_of(brick); // исходное состояние
+  if (visit(start, brick, -1, Start)) queue[tail++] = start; // кладём исходное состояние в очередь
+  while (head < tail) { // обход в ширину
+    int state = queue[head++]; // текущее состояние
+    int* current = &bricks[(size_t)state * size]; // координаты фигуры в состоянии
+    for (UserAction_t move : moves) { // перебираем переходы
+      int next[2 * PIECE_MAX_CELLS]; // координаты после перехода
+      rules->brick_copy(next, current); // начинаем с текущих координат
+      if (move == Down) { // опускание на одну строку
+        if (!rules->check_down(field, next)) continue; // ниже опуститься нельзя
+        rules->coord_shift(next, Y_CORDS, DOWN); // сдвигаем фигуру вниз
+      } else { // сдвиг или поворот
+        rules->brick_move(next, move, field); // те же правила, что в состоянии Moving
+      }
+      int to = state_of(next); // номер нового состояния
+      if (to != state && visit(to, next, state, move)) queue[tail++] = to; // новое состояние — в очередь
+    }
+    if (!rules->check_down(field, current)) { // фигура лежит — конечное положение
+      int* occupied = &placement_cells[(size_t)placements_count * cells]; // клетки нового положения
+      cells_of(current, occupied); // занятые клетки
+      int same = 0; // индекс положения с теми же клетками
+      while (same < placements_count && !std::equal(occupied, occupied + cells, &placement_cells[(size_t)same * cells])) same++; // ищем совпадение
+      if (same < placements_count) continue; // уже найдено не более длинным путём (порядок обхода в ширину)
+      Placement& placement = placements[placements_count++]; // следующий слот результата
+      rules->brick_copy(placement.brick, current); // координаты положения
+      placement.rotation = state / (height * width); // номер поворота
+      placement.path_length = depth[state]; // длина кратчайшего пути
+      placement.state = state; // состояние для восстановления пути
+    }
+  }
+  return placements_count; // количество конечных положений
+}
+
+/**
+ * @brief Перебирает положения текущей фигуры сессии.
+ *
+ * Временно убирает текущую фигуру с поля, выполняет поиск и возвращает её на место.
+ * @return количество найденных положений или 0, если фигура сейчас не перемещается
+ */
+template <class Engine>
+int BasicPlacementFinder<Engine>::find_current() {
+  int res = 0; // по умолчанию положений нет
+  if (rules->statemachine == Engine::Moving || rules->statemachine == Engine::Shifting) { // фигура на поле
+    rules->despawn(rules->gameinfo.field, rules->current_brick, ZOBRIST_FIELD); // убираем фигуру с поля
+    res = find(rules->gameinfo.field, rules->current_brick); // перебираем положения
+    rules->spawn_brick(rules->gameinfo.field, rules->current_brick, rules->current_color, ZOBRIST_FIELD); // возвращаем фигуру
+  } else { // фигуры на поле нет
+    placements_count = 0; // результатов нет
+  }
+  return res; // количество положений
+}
+
+template <class Engine>
+int BasicPlacementFinder<Engine>::count() const { return placements_count; } // количество найденных положений
+
+template <class Engine>
+const typename BasicPlacementFinder<Engine>::Placement& BasicPlacementFinder<Engine>::get(int index) const { // конечное положение по индексу
+  return placements[index]; // ссылка на результат поиска
+}
+
+/**
+ * @brief Восстанавливает кратчайший путь ввода к положению.
+ *
+ * @param index индекс положения
+ * @param out буфер для действий (Left, Right, Action, Down)
+ * @param capacity размер буфера
+ * @return длина пути или -1, если буфер мал
+ */
+template <class Engine>
+int BasicPlacementFinder<Engine>::path(int index, UserAction_t* out, int capacity) const {
+  int state = placements[index].state; // конечное состояние
+  int length = depth[state]; // длина пути
+  if (length > capacity) return -1; // путь не помещается в буфер
+  for (int i = length - 1; i >= 0; i--) { // идём от конца пути к началу
+    out[i] = via[state]; // действие перехода в текущее состояние
+    state = parent[state]; // переходим к предыдущему состоянию
+  }
+  return length; // длина пути
+}
+
+template class BasicPlacementFinder<TetrisGame<StandardBoard, StandardPieces>>; // перебор стандартного тетриса
+template class BasicPlacementFinder<TetrisGame<RuntimeBoard, StandardPieces>>; // перебор на поле выбранного размера
+template class BasicPlacementFinder<TetrisGame<StandardBoard, PentominoPieces>>; // перебор пентамино
+template class BasicPlacementFinder<TetrisGame<RuntimeBoard, PentominoPieces>>; // перебор пентамино на поле выбранного размера
+template class BasicPlacementFinder<TetrisGame<StandardBoard, TrainingPieces>>; // перебор тренировочного набора
+template class BasicPlacementFinder<TetrisGame<RuntimeBoard, TrainingPieces>>; // перебор тренировочного набора на поле выбранного размера
+
+}  // namespace s21 // конец пространства имён s21
@@ -0,0 +1,87 @@
+#ifndef PLACEMENT_H // защита от повторного включения заголовка: если PLACEMENT_H не определён
+#define PLACEMENT_H // определяет макрос PLACEMENT_H чтобы предотвратить повторное включение
+
+#include <stdint.h> // подключает целочисленные типы фиксированной ширины (uint64_t для битового множества)
+
+#include <vector> // подключает std::vector для буферов поиска под размер поля игры
+
+#include "tetris.h" // подключает класс Tetris, правила движения которого использует перебор
+
+#define PLACEMENT_ROTATIONS 4 // наибольшее число различных поворотов фигуры
+#define PLACEMENT_STATES (WINDOW_HEIGHT * WINDOW_WIDTH * PLACEMENT_ROTATIONS) // число состояний (y, x, поворот) стандартного поля — буфер пути для него
+
+namespace s21 { // начало пространства имён s21
+
+/**
+ * @brief Перебор достижимых положений фигуры.
+ *
+ * По текущему полю и фигуре обходит в ширину состояния (y, x, поворот) с переходами
+ * Left, Right, Action и Down по тем же правилам, что Tetris::brick_move, Tetris::rotate
+ * и Tetris::check_down. Для каждого конечного положения (фигура не может опуститься ниже)
+ * хранится кратчайшая последовательность ввода, поэтому находятся и подсовывания
+ * под нависающие блоки, и провороты. Положения, занимающие одни и те же клетки разными
+ * поворотами (Hero, Smashboy и т.п.), возвращаются один раз — с самым коротким путём.
+ *
+ * Перебор привязан к сессии Engine: размеры поля и набор фигур берутся из неё, буферы
+ * выделяются один раз в конструкторе под её поле, поэтому поиск не выделяет память.
+ */
+template <class Engine> // сессия тетриса: политика поля и набор фигур
+class BasicPlacementFinder { // объявление класса перебора положений
+ public: // публичная секция класса
+  typedef struct { // описание одного конечного положения фигуры
+    int brick[2 * PIECE_MAX_CELLS]; // координаты фигуры в конечном положении (пары Y,X, Engine::brick_size чисел)
+    int rotation; // номер поворота в порядке обнаружения (0 — исходный)
+    int path_length; // длина кратчайшей последовательности ввода
+    int state; // номер состояния поиска, из которого восстанавливается путь
+  } Placement; // имя типа — Placement
+
+  explicit BasicPlacementFinder(Engine* game); // конструктор, связывает перебор с правилами и полем сессии game
+
+  int find(int** field, const int* brick); // перебор положений фигуры brick на поле field (размеров поля сессии) без самой фигуры
+  int find_current(); // перебор положений текущей фигуры сессии
+  int count() const; // количество найденных конечных положений
+  int states() const; // число состояний поиска (наибольшая длина пути)
+  const Placement& get(int index) const; // конечное положение по индексу
+  int path(int index, UserAction_t* out, int capacity) const; // запись пути ввода к положению index в out
+
+ private: // приватная секция полей
+  static constexpr int size = Engine::brick_size; // размер описания фигуры набора (пары Y,X)
+  static constexpr int cells = size / 2; // блоков в фигуре
+
+  Engine* rules; // сессия Tetris, чьи поле и проверки движения используются
+  int height; // высота поля сессии
+  int width; // ширина поля сессии
+
+  std::vector<uint64_t> visited; // битовое множество посещённых состояний
+  std::vector<int> parent; // предыдущее состояние на кратчайшем пути
+  std::vector<UserAction_t> via; // действие, которым достигнуто состояние
+  std::vector<int> depth; // длина кратчайшего пути до состояния
+  std::vector<int> bricks; // координаты фигуры в каждом состоянии (size чисел на состояние)
+  std::vector<int> queue; // очередь обхода в ширину
+
+  uint32_t shapes[PLACEMENT_ROTATIONS]; // ключи форм поворотов, встреченных в текущем поиске
+  int shapes_count; // количество встреченных форм
+
+  std::vector<Placement> placements; // найденные конечные положения
+  std::vector<int> placement_cells; // занятые клетки каждого положения по возрастанию, для отсева совпадающих
+  int placements_count; // количество найденных конечных положений
+
+ private: // приватная секция вспомогательных методов
+  int state_of(const int* brick); // номер состояния (поворот, y, x) для координат фигуры
+  uint32_t shape_key(const int* brick) const; // ключ формы фигуры относительно опорного блока
+  void cells_of(const int* brick, int* out) const; // номера клеток, занятых фигурой на поле, по возрастанию
+  bool visit(int state, const int* brick, int from, UserAction_t action); // отметка нового состояния
+}; // конец объявления класса BasicPlacementFinder
+
+using PlacementFinder = BasicPlacementFinder<Tetris>; // перебор для стандартного тетриса 20x10
+
+extern template class BasicPlacementFinder<TetrisGame<StandardBoard, StandardPieces>>; // перебор собирается в placement.cpp
+extern template class BasicPlacementFinder<TetrisGame<RuntimeBoard, StandardPieces>>;
+extern template class BasicPlacementFinder<TetrisGame<StandardBoard, PentominoPieces>>;
+extern template class BasicPlacementFinder<TetrisGame<RuntimeBoard, PentominoPieces>>;
+extern template class BasicPlacementFinder<TetrisGame<StandardBoard, TrainingPieces>>;
+extern template class BasicPlacementFinder<TetrisGame<RuntimeBoard, TrainingPieces>>;
+
+}  // namespace s21 // конец пространства имён s21
+
+#endif  // PLACEMENT_H // конец защиты от повторного включения заголовка
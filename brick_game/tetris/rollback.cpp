@@ -0,0 +1,290 @@
+#include "rollback.h" // подключает объявление классов LockstepMatch и RollbackSession
+
+#include <algorithm> // подключает std::min и std::max
+#include <chrono> // подключает steady_clock для времени откатов
+#include <stdexcept> // подключает std::invalid_argument для параметров сессии
+
+#include "versus.h" // подключает таблицу атаки и параметры мусорных строк
+
+namespace s21 { // начало пространства имён s21
+
+static uint64_t fnv1a(const uint8_t* data, size_t size) { // хэш FNV-1a байтов снимка
+  uint64_t hash = 14695981039346656037ull; // начальное значение
+  for (size_t i = 0; i < size; i++) hash = (hash ^ data[i]) * 1099511628211ull; // байт за байтом
+  return hash; // хэш снимка
+} // конец функции fnv1a
+
+// ================= LockstepMatch ==================
+/**
+ * @brief Конструктор.
+ *
+ * Поля получают общие часы матча и зёрна генераторов фигур, выведенные из seed, поэтому
+ * два матча с одинаковым зерном начинаются одинаково на разных машинах.
+ */
+LockstepMatch::LockstepMatch(unsigned seed) : state{}, games{} { // пустые счётчики
+  state.rng.seed(seed); // генератор дырок мусора
+  for (int i = 0; i < ROLLBACK_PLAYERS; i++) { // создание полей
+    games[i] = new Tetris(); // отдельный движок
+    games[i]->keep_record = false; // поля матча не пишут рекорд в файл
+    games[i]->use_clock(&state.clock_us); // таймер падения идёт по часам матча
+    games[i]->start_seed = seed * ROLLBACK_PLAYERS + i + 1; // зерно фигур поля (не 0 — иначе берётся rand)
+    games[i]->set_user_action(Start); // старт партии
+    games[i]->step(); // GameStart -> Spawn
+  } // конец создания полей
+} // конец конструктора
+
+LockstepMatch::~LockstepMatch() { // деструктор
+  for (int i = 0; i < ROLLBACK_PLAYERS; i++) delete games[i]; // удаляем движки
+} // конец деструктора
+
+/**
+ * @brief Один кадр матча.
+ *
+ * Часы матча сдвигаются на ROLLBACK_TICK_US, затем поля шагают по порядку номеров. Действие
+ * передаётся полю, только если фигура ждёт ввода (Moving); пауза и выход в сетевом матче
+ * не принимаются — они остановили бы одно поле.
+ */
+void LockstepMatch::step(const uint8_t* inputs) { // кадр матча
+  state.clock_us += ROLLBACK_TICK_US; // часы матча
+  state.frame++; // номер следующего кадра
+  for (int i = 0; i < ROLLBACK_PLAYERS; i++) { // поля по порядку
+    Tetris* game = games[i]; // движок поля
+    if (state.over[i]) continue; // проигравшее поле не шагает
+    if (game->statemachine == Tetris::Moving && inputs[i] >= Left && inputs[i] <= Action) { // фигура ждёт ввода
+      game->set_user_action((UserAction_t)inputs[i]); // действие игрока
+    } // конец передачи ввода
+    bool locking = (game->statemachine == Tetris::Attaching); // фигура прикрепляется
+    game->step(); // шаг КА без виртуального вызова
+    if (locking && game->statemachine == Tetris::Spawn) on_lock(i); // прикрепление завершено
+    if (game->statemachine == Tetris::GameOver) { // поле проиграло
+      state.over[i] = 1; // отмечаем поражение
+      game->step(); // GameOver: фигуры сняты, уровень -1
+    } // конец проверки поражения
+  } // конец прохода по полям
+} // конец метода step
+
+/**
+ * @brief Обработка прикрепления фигуры.
+ *
+ * Атака гасит ожидающий мусор поля, остаток сразу добавляется к ожидающему мусору соперника.
+ * Если фигура не удалила строк, вставляется до GARBAGE_INSERT_LIMIT строк с одной дыркой.
+ */
+void LockstepMatch::on_lock(int board) { // обработка прикрепления
+  Tetris* game = games[board]; // движок поля
+  int lines = game->lines_cleared - state.last_lines[board]; // строки, удалённые этой фигурой
+  state.last_lines[board] = game->lines_cleared; // запоминаем счётчик
+  int attack = ATTACK_TABLE[lines > 4 ? 4 : lines]; // строки атаки
+  int cancel = std::min(attack, (int)state.pending[board]); // погашено строк
+  state.pending[board] -= cancel; // остаток ожидающего мусора
+  attack -= cancel; // остаток атаки
+  state.pending[1 - board] += attack; // атака сопернику
+  state.sent[board] += attack; // учитываем отправленные строки
+  if (!lines && state.pending[board] > 0) { // вставка мусора
+    int rows = std::min((int)state.pending[board], GARBAGE_INSERT_LIMIT); // строк за этот раз
+    int hole = (int)(state.rng() % WINDOW_WIDTH); // столбец дырки (остаток, а не распределение — одинаково в любой libstdc++)
+    state.pending[board] -= rows; // остаток ожидающего мусора
+    if (!game->add_garbage(rows, hole, GARBAGE_COLOR)) game->statemachine = Tetris::GameOver; // поле переполнено
+  } // конец вставки мусора
+} // конец метода on_lock
+
+size_t LockstepMatch::state_size() const { // размер снимка матча
+  size_t res = sizeof(MatchBlock); // счётчики матча
+  for (int i = 0; i < ROLLBACK_PLAYERS; i++) res += sizeof(uint32_t) + games[i]->snapshot_size(); // длина и снимок поля
+  return res; // размер снимка
+} // конец метода state_size
+
+/**
+ * @brief Записывает снимок матча.
+ *
+ * Снимок: MatchBlock, затем для каждого поля длина u32 и снимок Game::save.
+ */
+size_t LockstepMatch::save(uint8_t* buf, size_t size) const { // запись снимка
+  size_t length = state_size(); // длина снимка
+  if (size < length) return 0; // буфер мал
+  memcpy(buf, &state, sizeof(state)); // счётчики матча
+  uint8_t* pos = buf + sizeof(state); // позиция записи
+  for (int i = 0; i < ROLLBACK_PLAYERS; i++) { // поля
+    uint32_t part = (uint32_t)games[i]->snapshot_size(); // длина снимка поля
+    memcpy(pos, &part, sizeof(part)); // длина
+    games[i]->save(pos + sizeof(part), part); // снимок поля
+    pos += sizeof(part) + part; // следующее поле
+  } // конец записи полей
+  return length; // длина снимка
+} // конец метода save
+
+/**
+ * @brief Восстанавливает матч из снимка.
+ *
+ * Часы матча восстанавливаются раньше полей: таймеры полей отсчитывают сохранённое время от них.
+ */
+bool LockstepMatch::restore(const uint8_t* buf, size_t size) { // восстановление из снимка
+  bool res = size >= sizeof(state); // счётчики матча помещаются
+  const uint8_t* part[ROLLBACK_PLAYERS] = {nullptr}; // снимки полей
+  uint32_t part_size[ROLLBACK_PLAYERS] = {0}; // длины снимков полей
+  size_t pos = sizeof(state); // позиция чтения
+  for (int i = 0; res && i < ROLLBACK_PLAYERS; i++) { // разбор длин полей
+    res = size - pos >= sizeof(uint32_t); // длина помещается
+    if (res) memcpy(&part_size[i], buf + pos, sizeof(uint32_t)); // длина снимка поля
+    pos += sizeof(uint32_t); // снимок поля
+    res = res && size - pos >= part_size[i]; // снимок помещается
+    part[i] = buf + pos; // начало снимка поля
+    pos += part_size[i]; // следующее поле
+  } // конец разбора
+  if (res) { // снимок целый
+    memcpy(&state, buf, sizeof(state)); // счётчики и часы матча
+    for (int i = 0; res && i < ROLLBACK_PLAYERS; i++) res = games[i]->restore(part[i], part_size[i]); // поля
+  } // конец применения снимка
+  return res; // результат восстановления
+} // конец метода restore
+
+uint64_t LockstepMatch::checksum() const { // контрольная сумма снимка
+  std::vector<uint8_t> buf(state_size()); // снимок матча
+  save(buf.data(), buf.size()); // запись снимка
+  return fnv1a(buf.data(), buf.size()); // хэш байтов
+} // конец метода checksum
+
+uint32_t LockstepMatch::frame() const { return state.frame; } // номер следующего кадра
+bool LockstepMatch::finished() const { return state.over[0] || state.over[1]; } // хотя бы одно поле проиграло
+int LockstepMatch::lines_sent(int board) const { return state.sent[board]; } // отправлено строк
+const GameInfo_t& LockstepMatch::board_info(int board) const { return games[board]->get_gameinfo(); } // поле
+
+int LockstepMatch::winner() const { // победитель
+  int res = -1; // по умолчанию матч идёт или ничья
+  if (state.over[0] && !state.over[1]) res = 1; // проиграло первое поле
+  if (state.over[1] && !state.over[0]) res = 0; // проиграло второе поле
+  return res; // номер победителя
+} // конец метода winner
+
+// ================= RollbackSession ==================
+/**
+ * @brief Конструктор.
+ *
+ * \throw std::invalid_argument Если номер поля вне матча или окно предсказания не помещается
+ * в четверть кольца (соперник может опережать узел на то же окно, а откат — отставать на него).
+ */
+RollbackSession::RollbackSession(int player, unsigned seed, int max_prediction)
+    : game(seed),
+      local(player),
+      max_prediction(max_prediction),
+      current(0),
+      remote_count(0),
+      rollback_from(ROLLBACK_NO_FRAME),
+      local_set(false),
+      local_inputs{},
+      remote_inputs{},
+      counters{} { // матч на кадре 0
+  if (player < 0 || player >= ROLLBACK_PLAYERS) { // нет такого поля
+    throw std::invalid_argument("Error: Bad player number"); // выбрасываем исключение о номере поля
+  } // конец проверки номера поля
+  if (max_prediction < 1 || max_prediction > ROLLBACK_MAX_FRAMES / 4) { // окно вне кольца
+    throw std::invalid_argument("Error: Bad prediction window"); // выбрасываем исключение об окне
+  } // конец проверки окна
+} // конец конструктора
+
+void RollbackSession::add_local_input(uint8_t input) { // свой ввод кадра current
+  local_inputs[current % ROLLBACK_MAX_FRAMES] = input; // ввод в кольцо
+  local_set = true; // ввод кадра задан
+} // конец метода add_local_input
+
+/**
+ * @brief Принимает ввод соперника.
+ *
+ * Ввод принимается строго по порядку кадров (транспорт повторяет неподтверждённые кадры).
+ * Если кадр уже посчитан и ввод отличается от предсказания, запоминается кадр отката.
+ */
+bool RollbackSession::add_remote_input(uint32_t frame, uint8_t input) { // ввод соперника
+  bool res = frame == remote_count && frame < current + ROLLBACK_MAX_FRAMES / 2; // следующий кадр в пределах кольца
+  if (res) { // кадр принят
+    remote_inputs[frame % ROLLBACK_MAX_FRAMES] = input; // ввод в кольцо
+    remote_count++; // известен ещё один кадр
+    if (frame < current && input != ROLLBACK_NO_INPUT) rollback_from = std::min(rollback_from, frame); // предсказание неверно
+  } // конец приёма
+  return res; // признак приёма
+} // конец метода add_remote_input
+
+/**
+ * @brief Откат и пересчёт.
+ *
+ * Матч восстанавливается из снимка первого кадра с неверным предсказанием и шагает до текущего
+ * кадра с уже известным вводом; снимки пересчитанных кадров заменяются в кольце.
+ */
+void RollbackSession::synchronize() { // откат
+  if (rollback_from != ROLLBACK_NO_FRAME) { // пришёл ввод, отличный от предсказания
+    auto start = std::chrono::steady_clock::now(); // начало отката
+    const std::vector<uint8_t>& saved = states[rollback_from % ROLLBACK_MAX_FRAMES]; // снимок кадра отката
+    game.restore(saved.data(), saved.size()); // состояние перед кадром
+    for (uint32_t f = rollback_from; f < current; f++) { // пересчёт кадров
+      if (f != rollback_from) save_frame(f); // снимок пересчитанного кадра
+      step_frame(f); // кадр с известным вводом
+    } // конец пересчёта
+    int64_t us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count(); // время отката
+    counters.rollbacks++; // учитываем откат
+    counters.resimulated += current - rollback_from; // пересчитанные кадры
+    counters.rollback_us += us; // время откатов
+    counters.max_rollback_us = std::max(counters.max_rollback_us, us); // самый долгий откат
+    rollback_from = ROLLBACK_NO_FRAME; // откат выполнен
+  } // конец проверки отката
+} // конец метода synchronize
+
+bool RollbackSession::advance() { // кадр узла
+  synchronize(); // состояние по всему известному вводу
+  bool res = current < remote_count + max_prediction; // опережение в пределах окна
+  if (res) { // кадр делается
+    if (!local_set) local_inputs[current % ROLLBACK_MAX_FRAMES] = ROLLBACK_NO_INPUT; // игрок ничего не нажал
+    save_frame(current); // снимок перед кадром
+    step_frame(current); // кадр
+    current++; // следующий кадр
+    local_set = false; // ввод следующего кадра ещё не задан
+  } else { // соперник отстал
+    counters.stalls++; // учитываем ожидание
+  } // конец проверки окна
+  return res; // признак кадра
+} // конец метода advance
+
+void RollbackSession::save_frame(uint32_t frame) { // снимок в кольцо
+  std::vector<uint8_t>& buf = states[frame % ROLLBACK_MAX_FRAMES]; // место кадра
+  buf.resize(game.state_size()); // память выделяется только при росте снимка
+  game.save(buf.data(), buf.size()); // снимок матча
+} // конец метода save_frame
+
+void RollbackSession::step_frame(uint32_t frame) { // кадр матча
+  uint8_t inputs[ROLLBACK_PLAYERS]; // ввод игроков
+  inputs[local] = local_inputs[frame % ROLLBACK_MAX_FRAMES]; // свой ввод
+  inputs[1 - local] = frame < remote_count ? remote_inputs[frame % ROLLBACK_MAX_FRAMES] : ROLLBACK_NO_INPUT; // ввод соперника или предсказание
+  game.step(inputs); // кадр
+} // конец метода step_frame
+
+int RollbackSession::player() const { return local; } // номер своего поля
+uint32_t RollbackSession::frame() const { return current; } // номер следующего кадра
+uint32_t RollbackSession::remote_frames() const { return remote_count; } // кадров с известным вводом соперника
+const RollbackStats& RollbackSession::stats() const { return counters; } // счётчики отката
+const LockstepMatch& RollbackSession::match() const { return game; } // матч
+
+uint32_t RollbackSession::confirmed_frame() const { // последний подтверждённый кадр
+  return std::min(std::min(current, remote_count), rollback_from); // кадры до отката посчитаны без ошибок
+} // конец метода confirmed_frame
+
+bool RollbackSession::local_input(uint32_t frame, uint8_t* input) const { // свой ввод прошлого кадра
+  bool res = frame < current && current - frame < ROLLBACK_MAX_FRAMES; // кадр ещё в кольце
+  if (res) *input = local_inputs[frame % ROLLBACK_MAX_FRAMES]; // ввод кадра
+  return res; // признак наличия
+} // конец метода local_input
+
+/**
+ * @brief Контрольная сумма состояния перед кадром frame.
+ *
+ * Сумма есть только у подтверждённых кадров (оба узла считают их одинаково), которые ещё в
+ * кольце; для текущего кадра считается по самому матчу.
+ */
+bool RollbackSession::checksum(uint32_t frame, uint64_t* sum) const { // контрольная сумма кадра
+  bool res = frame <= confirmed_frame() && frame + ROLLBACK_MAX_FRAMES >= current; // кадр подтверждён и в кольце
+  if (res && frame == current) { // текущее состояние
+    *sum = game.checksum(); // сумма матча
+  } else if (res) { // снимок кольца
+    const std::vector<uint8_t>& saved = states[frame % ROLLBACK_MAX_FRAMES]; // снимок перед кадром
+    *sum = fnv1a(saved.data(), saved.size()); // сумма снимка
+  } // конец выбора источника
+  return res; // признак наличия суммы
+} // конец метода checksum
+
+}  // namespace s21 // конец пространства имён s21
@@ -0,0 +1,129 @@
+#ifndef ROLLBACK_H // защита от повторного включения заголовка: если ROLLBACK_H не определён
+#define ROLLBACK_H // определяет макрос ROLLBACK_H чтобы предотвратить повторное включение
+
+#include <stddef.h> // подключает size_t для размеров снимков
+#include <stdint.h> // подключает целые типы фиксированной ширины для кадров и ввода
+
+#include <random> // подключает генератор дырок мусорных строк
+#include <vector> // подключает std::vector для кольца снимков
+
+#include "tetris.h" // подключает класс Tetris, поля которого соревнуются в матче
+
+#define ROLLBACK_PLAYERS 2 // полей в сетевом матче
+#define ROLLBACK_TICK_US 16667 // длительность кадра матча в микросекундах (60 кадров в секунду)
+#define ROLLBACK_MAX_FRAMES 64 // кадров в кольце снимков и ввода (степень двойки)
+#define ROLLBACK_MAX_PREDICTION 8 // кадров, на которые узел по умолчанию опережает подтверждённый ввод соперника
+#define ROLLBACK_NO_INPUT 0xff // кадр без действия игрока (и предсказание ввода соперника)
+#define ROLLBACK_NO_FRAME 0xffffffffu // номер кадра «нет»: откат не нужен
+
+namespace s21 { // начало пространства имён s21
+
+/**
+ * @brief Матч двух полей тетриса с шагом по кадрам.
+ *
+ * Состояние матча целиком определяется зерном и вводом обоих игроков по кадрам: таймеры
+ * полей идут по общим часам матча (Game::use_clock), которые сдвигаются на ROLLBACK_TICK_US
+ * за кадр, генераторы фигур и дырок мусора заданы зерном. Правила мусора — как в VersusMatch
+ * для двух полей: атака гасит ожидающий мусор, остаток уходит сопернику и вставляется после
+ * прикрепления фигуры, не удалившей строк. Снимок матча — его счётчики и снимки обоих полей
+ * (Game::save), поэтому откат — это restore и повторные step.
+ */
+class LockstepMatch { // объявление матча по кадрам
+ public: // публичная секция класса
+  explicit LockstepMatch(unsigned seed); // матч двух полей, партии начаты (GameStart -> Spawn)
+  ~LockstepMatch(); // деструктор: удаляет поля
+  LockstepMatch(const LockstepMatch&) = delete; // удалённый копирующий конструктор, запрет копирования
+  LockstepMatch& operator=(const LockstepMatch&) = delete; // удалённый оператор присваивания, запрет копирования
+
+  void step(const uint8_t* inputs); // кадр: ввод ROLLBACK_PLAYERS игроков (UserAction_t или ROLLBACK_NO_INPUT)
+  size_t state_size() const; // размер снимка матча в байтах
+  size_t save(uint8_t* buf, size_t size) const; // снимок в buf, возвращает длину или 0, если буфер мал
+  bool restore(const uint8_t* buf, size_t size); // восстановление из снимка, false если снимок повреждён
+  uint64_t checksum() const; // контрольная сумма снимка для сверки узлов
+
+  uint32_t frame() const; // номер следующего кадра
+  bool finished() const; // хотя бы одно поле проиграло
+  int winner() const; // номер победителя, -1 пока матч идёт или при ничьей
+  int lines_sent(int board) const; // строк мусора, отправленных полем
+  const GameInfo_t& board_info(int board) const; // состояние поля для отображения
+
+ private: // приватная секция для внутренних структур и данных
+  typedef struct { // счётчики матча в снимке (поля уложены без выравнивающих промежутков)
+    int64_t clock_us; // часы матча
+    uint32_t frame; // номер следующего кадра
+    int32_t pending[ROLLBACK_PLAYERS]; // принятый, но ещё не вставленный мусор поля
+    int32_t last_lines[ROLLBACK_PLAYERS]; // удалённые строки поля на момент прошлого прикрепления
+    int32_t sent[ROLLBACK_PLAYERS]; // отправлено строк
+    uint8_t over[ROLLBACK_PLAYERS]; // поле проиграло
+    uint8_t reserved[2]; // выравнивание до 8 байт
+    std::minstd_rand rng; // генератор дырок мусорных строк
+  } MatchBlock; // имя типа — MatchBlock
+
+  MatchBlock state; // счётчики матча
+  Tetris* games[ROLLBACK_PLAYERS]; // поля матча
+
+  void on_lock(int board); // прикрепление фигуры: атака, гашение и вставка мусора
+}; // конец объявления класса LockstepMatch
+
+/**
+ * @brief Счётчики отката сессии.
+ */
+typedef struct { // статистика отката
+  uint64_t rollbacks; // откатов
+  uint64_t resimulated; // кадров, пересчитанных после откатов
+  uint64_t stalls; // кадров, пропущенных из-за слишком большого опережения
+  int64_t rollback_us; // время всех откатов
+  int64_t max_rollback_us; // самый долгий откат
+} RollbackStats; // имя типа — RollbackStats
+
+/**
+ * @brief Сетевой матч с предсказанием ввода и откатом (в духе GGPO).
+ *
+ * Узел шагает свой кадр сразу, не дожидаясь ввода соперника: недостающий ввод предсказывается
+ * как «нет действия» (ввод тетриса событийный — повтор прошлого нажатия сдвигал бы фигуру
+ * лишний раз). Перед каждым кадром снимок матча кладётся в кольцо ROLLBACK_MAX_FRAMES кадров.
+ * Когда приходит ввод соперника для уже посчитанного кадра и он отличается от предсказания,
+ * ближайший synchronize восстанавливает снимок этого кадра и заново шагает до текущего.
+ * Опережение подтверждённого ввода соперника ограничено max_prediction кадрами: дальше advance
+ * ждёт (кадр пропускается), чтобы откат оставался в пределах кольца и одного кадра по времени.
+ */
+class RollbackSession { // объявление сессии с откатом
+ public: // публичная секция класса
+  RollbackSession(int player, unsigned seed, int max_prediction = ROLLBACK_MAX_PREDICTION); // throw invalid_argument
+  RollbackSession(const RollbackSession&) = delete; // удалённый копирующий конструктор, запрет копирования
+  RollbackSession& operator=(const RollbackSession&) = delete; // удалённый оператор присваивания, запрет копирования
+
+  void add_local_input(uint8_t input); // ввод своего игрока для кадра frame()
+  bool add_remote_input(uint32_t frame, uint8_t input); // ввод соперника по порядку кадров, false если кадр не следующий
+  void synchronize(); // откат и пересчёт, если пришёл ввод, отличный от предсказания
+  bool advance(); // synchronize и один кадр, false если узел слишком опережает соперника
+
+  int player() const; // номер своего поля
+  uint32_t frame() const; // номер следующего кадра
+  uint32_t remote_frames() const; // кадров с известным вводом соперника
+  uint32_t confirmed_frame() const; // последний кадр, состояние которого посчитано без предсказаний
+  bool local_input(uint32_t frame, uint8_t* input) const; // свой ввод прошлого кадра, false если он вне кольца
+  bool checksum(uint32_t frame, uint64_t* sum) const; // контрольная сумма подтверждённого кадра, false если её нет
+  const RollbackStats& stats() const; // счётчики отката
+  const LockstepMatch& match() const; // матч для отображения
+
+ private: // приватная секция для внутренних данных
+  void save_frame(uint32_t frame); // снимок перед кадром frame в кольцо
+  void step_frame(uint32_t frame); // кадр с известным или предсказанным вводом
+
+  LockstepMatch game; // матч узла
+  int local; // номер своего поля
+  int max_prediction; // наибольшее опережение в кадрах
+  uint32_t current; // номер следующего кадра
+  uint32_t remote_count; // кадров с известным вводом соперника
+  uint32_t rollback_from; // первый кадр с ошибочным предсказанием (ROLLBACK_NO_FRAME — нет)
+  bool local_set; // ввод кадра current уже задан
+  uint8_t local_inputs[ROLLBACK_MAX_FRAMES]; // свой ввод по кадрам
+  uint8_t remote_inputs[ROLLBACK_MAX_FRAMES]; // ввод соперника по кадрам
+  std::vector<uint8_t> states[ROLLBACK_MAX_FRAMES]; // снимки матча перед кадрами
+  RollbackStats counters; // счётчики отката
+}; // конец объявления класса RollbackSession
+
+}  // namespace s21 // конец пространства имён s21
+
+#endif  // ROLLBACK_H // конец защиты от повторного включения заголовка
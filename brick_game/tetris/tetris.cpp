@@ -1,14 +1,8 @@
 #include "tetris.h" // подключает заголовочный файл с объявлением класса Tetris и зависимостями
 
-// макрос, определяющий массив координат шаблона фигуры Teewee
-#define TEEWEE { 1, 4, 1, 3, 0, 4, 1, 5 } // значения Y,X пар для четырёх блоков фигуры Teewee
-// макрос, определяющий массив координат шаблона фигуры Hero
-#define HERO { 0, 5, 0, 4, 0, 3, 0, 6 } // значения Y,X пар для четырёх блоков фигуры Hero
-#define SMASHBOY { 0, 4, 0, 5, 1, 4, 1, 5 } // значения Y,X пар для четырёх блоков фигуры Smashboy
-#define ORANGE_RICKY { 1, 4, 1, 3, 1, 5, 0, 5 } // значения Y,X пар для четырёх блоков фигуры Orange Ricky
-#define BLUE_RICKY { 1, 4, 0, 3, 1, 3, 1, 5 } // значения Y,X пар для четырёх блоков фигуры Blue Ricky
-#define CLEVELAND_Z { 1, 4, 0, 3, 0, 4, 1, 5 } // значения Y,X пар для четырёх блоков фигуры Cleveland Z
-#define RHODE_ISLAND_Z { 1, 4, 1, 3, 0, 4, 0, 5 } // значения Y,X пар для четырёх блоков фигуры Rhode Island Z
+#include "../snapshot.h" // подключает формат снимка состояния
+#include "../stats.h" // подключает счётчики событий
+#include "../trace.h" // подключает интервалы трассировки
 
 #define DATA_FILE_NAME "tetris_data.bin" // имя бинарного файла для сохранения рекорда
 
@@ -26,21 +20,37 @@
 #define UP -1 // смещение вверх (отрицательное по Y)
 #define DOWN 1 // смещение вниз (положительное по Y)
 
-#define BRICK_RANDOMIZER (1 + rand() % 7) // выражение для генерации случайного номера фигуры от 1 до 7
-#define COLOR_RANDOMIZER (1 + rand() % 6) // выражение для генерации случайного цвета от 1 до 6
+#define BRICK_RANDOMIZER (1 + rng() % Pieces::count) // выражение для генерации случайного номера фигуры набора (с 1)
+#define COLOR_RANDOMIZER (1 + rng() % 6) // выражение для генерации случайного цвета от 1 до 6
 
 namespace s21 { // начало пространства имён s21
 
+/**
+ * @brief Конструктор.
+ *
+ * Выделяет игровое поле размером с поле политики Board и готовит счётчики строк и столбцов.
+ */
+template <class Board, class Pieces>
+TetrisGame<Board, Pieces>::TetrisGame(const Board& layout) // конструктор сессии тетриса
+    : Engine<TetrisGame>(layout.height(), layout.width()), current_brick(NULL), next_brick(NULL),
+      current_color(0), next_color(0), lines_cleared(0), keep_record(true), start_seed(0), board(layout), field_hash(0), next_hash(0) { // поле выделяет Game
+  board.prepare(row_fill, column_height); // счётчики по размерам поля
+} // конец конструктора
+
 
 /**
  * @brief GameStart (состояние конечного автомата).
  *
  * Инициализация начала игры.
  */
-void Tetris::starting_game() { // определение метода начальной логики состояния Start
+template <class Board, class Pieces>
+void TetrisGame<Board, Pieces>::starting_game() { // определение метода начальной логики состояния Start
   if (action == Start) { // если пришло действие старта игры
+    rng.seed(start_seed ? start_seed : rand()); // генератор партии: заданное зерно или продолжение последовательности srand
     stats_init(this); // инициализируем статистику и выделяем память для фигур
-    init_score(this); // инициализируем счёт и читаем рекорд из файла
+    counters_init(); // пересчитываем заполненность строк и высоты столбцов по текущему полю
+    hash_init(); // хэши поля и области next
+    if (keep_record) init_score(this); // читаем рекорд из файла (в матче рекорд не сохраняется)
     new_brick(next_brick, BRICK_RANDOMIZER); // генерируем случайную следующую фигуру
     gameinfo.level = 1; // устанавливаем начальный уровень в 1
     statemachine = Spawn; // переводим конечный автомат в состояние Spawn
@@ -50,40 +60,29 @@ void Tetris::starting_game() { // определение метода начал
 } // конец реализации starting_game
 
 /**
- * @brief Генерирует новую случайную фигуру для спауна.
- *
- * @param random номер фигуры от 1 до 7
- */
-void Tetris::new_brick(int* brick, int random) { // реализация генерации шаблона фигуры по номеру
-  Bricks bricks = {TEEWEE,     HERO,        SMASHBOY,      ORANGE_RICKY,
-                   BLUE_RICKY, CLEVELAND_Z, RHODE_ISLAND_Z}; // создаём локальную структуру со всеми шаблонами фигур
-  switch (random) { // выбираем шаблон по значению random
-    case 1: // если random == 1
-      brick_copy(brick, bricks.Teewee); // копируем шаблон Teewee в массив brick
-      break; // прерываем case 1
-    case 2: // если random == 2
-      brick_copy(brick, bricks.Hero); // копируем шаблон Hero
-      break; // прерываем case 2
-    case 3: // если random == 3
-      brick_copy(brick, bricks.Smashboy); // копируем шаблон Smashboy
-      break; // прерываем case 3
-    case 4: // если random == 4
-      brick_copy(brick, bricks.Orange_Ricky); // копируем шаблон Orange Ricky
-      break; // прерываем case 4
-    case 5: // если random == 5
-      brick_copy(brick, bricks.Blue_Ricky); // копируем шаблон Blue Ricky
-      break; // прерываем case 5
-    case 6: // если random == 6
-      brick_copy(brick, bricks.Cleveland_Z); // копируем шаблон Cleveland Z
-      break; // прерываем case 6
-    case 7: // если random == 7
-      brick_copy(brick, bricks.Rhode_Island_Z); // копируем шаблон Rhode Island Z
-      break; // прерываем case 7
-    default: // на случай некорректного номера
-      break; // ничего не делаем в блоке по умолчанию
-  } // конец switch
+ * @brief Генерирует новую фигуру для спауна.
+ *
+ * Координаты появления берутся из таблицы набора Pieces, посчитанной при компиляции.
+ * @param random номер фигуры от 1 до Pieces::count, иные значения не изменяют brick
+ */
+template <class Board, class Pieces>
+void TetrisGame<Board, Pieces>::new_brick(int* brick, int random) { // реализация генерации шаблона фигуры по номеру
+  if (random >= 1 && random <= Pieces::count) { // номер фигуры из набора
+    brick_copy(brick, Pieces::table.spawn[random - 1]); // копируем координаты появления фигуры
+  } // конец проверки номера
 } // конец функции new_brick
 
+/**
+ * @brief Сдвиг фигур по X при появлении.
+ *
+ * Шаблоны фигур заданы для поля стандартной ширины; на более широком поле
+ * фигура сдвигается к центру. Поле NEXT всегда рисуется без сдвига.
+ */
+template <class Board, class Pieces>
+int TetrisGame<Board, Pieces>::spawn_shift() const { // сдвиг шаблонов фигур к центру поля
+  return (board.width() - WINDOW_WIDTH) / 2; // для StandardBoard — константа 0
+} // конец метода spawn_shift
+
 /**
  * @brief Spawn (состояние конечного автомата).
  *
@@ -91,14 +90,18 @@ void Tetris::new_brick(int* brick, int random) { // реализация ген
  * на поле, копирует её в текущую, генерирует новую случайную фигуру для спауна
  * и обновляет поле следующей фигуры. Переводит конечный автомат в состояние Moving.
  */
-void Tetris::spawn() { // реализация состояния Spawn конечного автомата
+template <class Board, class Pieces>
+void TetrisGame<Board, Pieces>::spawn() { // реализация состояния Spawn конечного автомата
   current_color = next_color; // присваиваем текущему цвету значение следующего цвета
   next_color = COLOR_RANDOMIZER; // генерируем новый случайный цвет для следующей фигуры
-  spawn_brick(gameinfo.field, next_brick, current_color); // отображаем next_brick на основном поле с цветом current_color
   brick_copy(current_brick, next_brick); // копируем next_brick в current_brick (теперь текущая фигура — следующая)
+  coord_shift(current_brick, X_CORDS, spawn_shift()); // центрируем фигуру на поле нестандартной ширины
+  spawn_brick(gameinfo.field, current_brick, current_color, ZOBRIST_FIELD); // отображаем текущую фигуру на основном поле с цветом current_color
+  flight.record(FLIGHT_SPAWN, statemachine, current_color); // появление фигуры в журнал сессии
   new_brick(next_brick, BRICK_RANDOMIZER); // генерируем новый шаблон для next_brick
   fill_array_zero(gameinfo.next, NEXT_SIZE, NEXT_SIZE); // очищаем матрицу для отображения следующей фигуры
-  spawn_brick(gameinfo.next, next_brick, next_color); // отображаем next_brick в окне "следующая фигура" с цветом next_color
+  next_hash = 0; // область next пуста
+  spawn_brick(gameinfo.next, next_brick, next_color, ZOBRIST_NEXT); // отображаем next_brick в окне "следующая фигура" с цветом next_color
   statemachine = Moving; // переводим конечный автомат в состояние Moving
 } // конец метода spawn
 
@@ -106,10 +109,11 @@ void Tetris::spawn() { // реализация состояния Spawn коне
  * @brief Moving (состояние конечного автомата).
  * 
  * Основной игровой цикл перемещения фигуры.
- * Обрабатывает действия игрока (Pause, Terminate, Down),
+ * Обрабатывает действия игрока (Pause, Terminate, Down, Up — мгновенный сброс),
  * перемещает фигуру, проверяет таймер и переводит КА в состояние Shifting при необходимости.
  */
-void Tetris::moving() { // реализация состояния Moving
+template <class Board, class Pieces>
+void TetrisGame<Board, Pieces>::moving() { // реализация состояния Moving
   if (action == Pause && gameinfo.pause == 0) { // если пришло действие паузы и игра не на паузе
     gameinfo.pause = 1; // ставим игру на паузу
     action = Start; // сбрасываем действие в Start для предотвращения повторной обработки
@@ -119,14 +123,25 @@ void Tetris::moving() { // реализация состояния Moving
   } else if (action == Terminate) { // если пришло действие завершения игры
     statemachine = GameOver; // переводим КА в состояние GameOver
   } // конец обработки действий Pause/Terminate
-  if (gameinfo.pause != 1) { // если игра не на паузе (активна)
-    despawn(gameinfo.field, current_brick); // удаляем текущее отображение фигуры с поля перед перемещением
+  if (gameinfo.pause != 1 && action == Up) { // если игра активна и пришла команда мгновенного сброса
+    hard_drop(); // опускаем фигуру на место приземления за один шаг и прикрепляем её
+  } else if (gameinfo.pause != 1) { // если игра не на паузе (активна)
+    despawn(gameinfo.field, current_brick, ZOBRIST_FIELD); // удаляем текущее отображение фигуры с поля перед перемещением
+    int moved_from[brick_size]; // положение фигуры до хода, для счётчиков поворотов и отклонённых ходов
+    brick_copy(moved_from, current_brick); // копия координат
     brick_move(current_brick, action, gameinfo.field); // обрабатываем пользовательские действия и перемещаем фигуру
-    spawn_brick(gameinfo.field, current_brick, current_color); // повторно отображаем фигуру на поле после перемещения
-    if (time.game_timer_check(gameinfo.speed, TIMER_MAX_DELAY, TIMER_MIN_DELAY,
-                              TIMER_MAX_SPEED) || // если таймер сработал с учётом скорости и лимитов
-        action == Down) { // либо если пользователь запросил ускоренное падение вниз
-      time.start(); // перезапускаем таймер после срабатывания
+    bool moved = memcmp(moved_from, current_brick, sizeof(moved_from)) != 0; // фигура сдвинулась или повернулась
+    if (action == Action && moved) { // поворот выполнен
+      STATS_EVENT(STAT_ROTATIONS, 1); // учёт поворота
+    } else if ((action == Left || action == Right || action == Action) && !moved) { // ход упёрся в стену или блоки
+      STATS_EVENT(STAT_REJECTED_MOVES, 1); // учёт отклонённого хода
+    } // конец учёта хода
+    spawn_brick(gameinfo.field, current_brick, current_color, ZOBRIST_FIELD); // повторно отображаем фигуру на поле после перемещения
+    bool deadline = time.game_timer_check(gameinfo.speed, TIMER_MAX_DELAY, TIMER_MIN_DELAY,
+                                          TIMER_MAX_SPEED); // таймер сработал с учётом скорости и лимитов
+    if (deadline) flight.record(FLIGHT_DEADLINE, statemachine, gameinfo.speed); // срабатывание таймера в журнал сессии
+    if (deadline || action == Down) { // таймер сработал либо пользователь запросил ускоренное падение вниз
+      if (!deadline) time.start(); // ускоренное падение начинает отсчёт заново, срабатывание таймера уже сдвинуло срок
       statemachine = Shifting; // переводим КА в состояние Shifting для смещения фигуры вниз
     } else {
       action = Start; // сбрасываем действие в Start чтобы избежать повторного применения
@@ -134,6 +149,69 @@ void Tetris::moving() { // реализация состояния Moving
   } // конец проверки паузы
 } // конец метода moving
 
+template <class Board, class Pieces>
+int64_t TetrisGame<Board, Pieces>::next_deadline() const { // срок падения фигуры
+  return (statemachine == Moving && gameinfo.pause != 1) ? time.next_deadline() : -1; // таймер ждёт только в Moving без паузы
+} // конец метода next_deadline
+
+template <class Board, class Pieces>
+void TetrisGame<Board, Pieces>::use_clock(const int64_t* clock_us) { time.set_clock(clock_us); } // часы таймера падения
+
+/**
+ * @brief Хэш состояния: поле и область next ведутся по ходу игры, к ним добавляются клетки
+ * падающей фигуры, пока она не легла (ключи ZOBRIST_PIECE отличают её от лежащих блоков).
+ */
+template <class Board, class Pieces>
+uint64_t TetrisGame<Board, Pieces>::state_hash() const { // хэш состояния
+  uint64_t res = field_hash ^ next_hash; // поле и область next
+  if (current_brick && (statemachine == Moving || statemachine == Shifting || statemachine == Attaching)) { // фигура падает
+    for (int i = 0; i < brick_size; i += 2) // блоки фигуры
+      res ^= zobrist_key(ZOBRIST_PIECE, (uint64_t)current_brick[i] * board.width() + current_brick[i + 1]); // клетка фигуры
+  } // конец учёта фигуры
+  return res; // хэш состояния
+} // конец метода state_hash
+
+/**
+ * @brief Мгновенный сброс фигуры (действие Up).
+ *
+ * Опускает фигуру сразу на место приземления, найденное drop_distance,
+ * и переводит КА в состояние Attaching без промежуточных шагов Moving/Shifting.
+ */
+template <class Board, class Pieces>
+void TetrisGame<Board, Pieces>::hard_drop() { // реализация мгновенного сброса текущей фигуры
+  despawn(gameinfo.field, current_brick, ZOBRIST_FIELD); // убираем фигуру с поля, чтобы она не мешала поиску места приземления
+  coord_shift(current_brick, Y_CORDS, drop_distance(gameinfo.field, current_brick, true)); // опускаем фигуру до упора
+  spawn_brick(gameinfo.field, current_brick, current_color, ZOBRIST_FIELD); // отображаем фигуру на месте приземления
+  lock_brick(current_brick); // учитываем блоки фигуры в счётчиках строк и столбцов
+  action = Start; // сбрасываем действие, чтобы следующая фигура не была сброшена повторно
+  time.start(); // перезапускаем таймер падения для следующей фигуры
+  statemachine = Attaching; // фигура лежит — сразу переходим к прикреплению
+} // конец метода hard_drop
+
+/**
+ * @brief Возвращает координаты тени текущей фигуры.
+ *
+ * Тень — положение, в котором фигура окажется после мгновенного сброса.
+ * Буфер рассчитан на пять блоков; у фигур меньшего размера оставшиеся пары повторяют
+ * последний блок тени, поэтому фронтенды рисуют все GHOST_SIZE чисел без знания набора.
+ * @param cells буфер на GHOST_SIZE чисел (пары Y,X)
+ * @return true если фигура находится на поле и тень заполнена
+ */
+template <class Board, class Pieces>
+bool TetrisGame<Board, Pieces>::ghost(int* cells) const { // тень фигуры без изменения поля
+  bool res = false; // по умолчанию тени нет
+  if (statemachine == Moving || statemachine == Shifting) { // фигура на поле
+    brick_copy(cells, current_brick); // тень начинается с текущего положения фигуры
+    coord_shift(cells, Y_CORDS, drop_distance(gameinfo.field, current_brick, true)); // опускаем тень до упора (клетки фигуры не мешают)
+    for (int i = brick_size; i < GHOST_SIZE; i += 2) { // пары сверх размера фигуры
+      cells[i] = cells[brick_size - 2]; // повторяем последний блок
+      cells[i + 1] = cells[brick_size - 1];
+    } // конец заполнения буфера
+    res = true; // тень заполнена
+  } // конец проверки состояния
+  return res; // возвращаем признак наличия тени
+} // конец метода ghost
+
 /**
  * @brief Shifting (состояние конечного автомата).
  * 
@@ -141,33 +219,40 @@ void Tetris::moving() { // реализация состояния Moving
  * Если фигура может двигаться вниз, координаты Y сдвигаются,
  * иначе КА переходит в состояние Attaching. После сдвига фигура "спавнится" обратно на поле.
  */
-void Tetris::shifting() { // реализация состояния Shifting
-  despawn(gameinfo.field, current_brick); // удаляем текущее отображение фигуры перед сдвигом
+template <class Board, class Pieces>
+void TetrisGame<Board, Pieces>::shifting() { // реализация состояния Shifting
+  despawn(gameinfo.field, current_brick, ZOBRIST_FIELD); // удаляем текущее отображение фигуры перед сдвигом
   if (check_down(gameinfo.field, current_brick)) { // если можно опустить фигуру вниз
     coord_shift(current_brick, Y_CORDS, DOWN); // сдвигаем координаты Y всех блоков фигуры вниз на единицу
     statemachine = Moving; // возвращаемся в состояние Moving для дальнейшей обработки
   } else { // если нельзя опустить вниз (столкновение или дно)
+    lock_brick(current_brick); // фигура ложится — учитываем её блоки в счётчиках строк и столбцов
     statemachine = Attaching; // переводим КА в состояние Attaching для прикрепления фигуры к полю
   } // конец проверки возможности опускания
-  spawn_brick(gameinfo.field, current_brick, current_color); // отображаем фигуру снова на поле после сдвига/решения о прикреплении
+  spawn_brick(gameinfo.field, current_brick, current_color, ZOBRIST_FIELD); // отображаем фигуру снова на поле после сдвига/решения о прикреплении
 } // конец метода shifting
 
 /**
  * @brief Attaching (состояние конечного автомата).
  * 
  * Прикрепляет фигуру к полю и проверяет заполненные строки.
+ * Полнота строк определяется по счётчикам row_fill только для строк, которых касается фигура.
  * Считает полные строки и обновляет счёт,
  * проверяет условия окончания игры и переводит КА в следующее состояние.
  */
-void Tetris::attaching() { // реализация состояния Attaching
+template <class Board, class Pieces>
+void TetrisGame<Board, Pieces>::attaching() { // реализация состояния Attaching
   int full_rows_counter = 0; // счётчик полностью заполненных строк
-  full_rows_counter = check_full_row(gameinfo.field); // проверяем и получаем количество заполненных строк
+  full_rows_counter = clear_full_rows(); // удаляем заполненные строки, которых касается фигура
   if (action == Down) { // если пользователь нажал Down ранее
     action = Start; // сбрасываем действие в Start
   } // конец обработки действия Down
   if (check_gameover(current_brick)) { // проверяем условие поражения/конца игры
     statemachine = GameOver; // переводим КА в состояние GameOver при окончании игры
   } else if (full_rows_counter) { // если были полные строки
+    lines_cleared += full_rows_counter; // учитываем удалённые строки
+    flight.record(FLIGHT_CLEAR, statemachine, full_rows_counter); // удаление строк в журнал сессии
+    STATS_EVENT(STAT_LINES_CLEARED, full_rows_counter); // счётчик удалённых строк
     score_write(this, full_rows_counter); // обновляем счёт в зависимости от количества удалённых строк
     check_level(this); // проверяем и обновляем уровень при необходимости
   } else { // если полных строк нет и игра не окончена
@@ -178,13 +263,12 @@ void Tetris::attaching() { // реализация состояния Attaching
 /**
  * @brief Game_over (состояние конечного автомата).
  *
- * Освобождает память под текущую и следующую фигуры и устанавливает уровень в -1.
+ * Снимает указатели фигур и устанавливает уровень в -1.
  */
-void Tetris::game_over() { // реализация состояния GameOver
-  if (gameinfo.level > 0) { // если уровень положителен (игра началась и память была выделена)
-    free(current_brick); // освобождаем память, выделенную под текущую фигуру
-    free(next_brick); // освобождаем память, выделенную под следующую фигуру
-  } // конец проверки уровня перед освобождением памяти
+template <class Board, class Pieces>
+void TetrisGame<Board, Pieces>::game_over() { // реализация состояния GameOver
+  current_brick = NULL; // фигур нет до следующей партии
+  next_brick = NULL; // место фигур остаётся в сессии
   gameinfo.level = -1; // ставим уровень -1 как индикатор выхода/завершения игры
 } // конец метода game_over
 
@@ -196,7 +280,8 @@ void Tetris::game_over() { // реализация состояния GameOver
  * @param width ширина матрицы
  * @return указатель на выделенную матрицу или NULL при некорректных размерах
  */
-int** Tetris::init_matrix(int** matrix, int height, int width) { // выделение динамической матрицы height x width
+template <class Board, class Pieces>
+int** TetrisGame<Board, Pieces>::init_matrix(int** matrix, int height, int width) { // выделение динамической матрицы height x width
   if (height <= 0 || width <= 0) { // проверяем корректность размеров
     matrix = NULL; // если размеры некорректны, возвращаем NULL
   } else {
@@ -215,7 +300,8 @@ int** Tetris::init_matrix(int** matrix, int height, int width) { // выделе
  * @param matrix указатель на матрицу
  * @param size количество строк в матрице
  */
-void Tetris::free_memory_matrix(int** matrix, int size) { // освобождение памяти матрицы с заданным количеством строк
+template <class Board, class Pieces>
+void TetrisGame<Board, Pieces>::free_memory_matrix(int** matrix, int size) { // освобождение памяти матрицы с заданным количеством строк
   if (size <= 0) { // если размер некорректен
     matrix = NULL; // ничего не делаем, присваиваем NULL локальной переменной
   } else {
@@ -233,7 +319,8 @@ void Tetris::free_memory_matrix(int** matrix, int size) { // освобожде
  * @param height высота матрицы
  * @param width ширина матрицы
  */
-void Tetris::fill_array_zero(int** matrix, int height, int width) { // установка всех ячеек матрицы в 0
+template <class Board, class Pieces>
+void TetrisGame<Board, Pieces>::fill_array_zero(int** matrix, int height, int width) { // установка всех ячеек матрицы в 0
   for (int i = 0; i < height; i++) { // цикл по строкам
     for (int j = 0; j < width; j++) { // цикл по столбцам
       matrix[i][j] = 0; // присваиваем ячейке значение 0
@@ -249,10 +336,11 @@ void Tetris::fill_array_zero(int** matrix, int height, int width) { // уста
  * @param shift величина сдвига
  * @return 1 если можно двигаться, иначе 0
  */
-int Tetris::check_right(int** matrix, int* brick, int shift) { // проверка возможности движения вправо с учётом границ и занятых ячеек
+template <class Board, class Pieces>
+int TetrisGame<Board, Pieces>::check_right(int** matrix, int* brick, int shift) { // проверка возможности движения вправо с учётом границ и занятых ячеек
   int res = 1; // флаг доступности движения вправо, по умолчанию доступно
-  for (int i = 1; i < BRICK_SIZE; i += 2) { // проходим по индексам X в массиве координат (каждая вторая позиция)
-    if ((brick[i] + shift > WINDOW_WIDTH - 1) || // если после сдвига координата выйдет за правую границу
+  for (int i = 1; i < brick_size; i += 2) { // проходим по индексам X в массиве координат (каждая вторая позиция)
+    if ((brick[i] + shift > board.width() - 1) || // если после сдвига координата выйдет за правую границу
         (matrix[brick[i - 1]][brick[i] + shift])) { // либо целевая ячейка уже занята на поле
       res = 0; // движение вправо недоступно
     } // конец условия проверки для текущего блока фигуры
@@ -268,9 +356,10 @@ int Tetris::check_right(int** matrix, int* brick, int shift) { // проверк
  * @param shift величина сдвига
  * @return 1 если можно двигаться, иначе 0
  */
-int Tetris::check_left(int** matrix, int* brick, int shift) { // проверка возможности движения влево
+template <class Board, class Pieces>
+int TetrisGame<Board, Pieces>::check_left(int** matrix, int* brick, int shift) { // проверка возможности движения влево
   int res = 1; // по умолчанию движение доступно
-  for (int i = 1; i < BRICK_SIZE; i += 2) { // проходим по индексам X в массиве координат
+  for (int i = 1; i < brick_size; i += 2) { // проходим по индексам X в массиве координат
     if ((brick[i] - shift < 0) || (matrix[brick[i - 1]][brick[i] - shift])) { // если после сдвига выйдем за левую границу либо ячейка занята
       res = 0; // движение влево недоступно
     } // конец условия проверки для текущего блока
@@ -285,25 +374,65 @@ int Tetris::check_left(int** matrix, int* brick, int shift) { // проверк
  * @param brick массив координат фигуры
  * @return 1 если можно опускать, иначе 0
  */
-int Tetris::check_down(int** matrix, int* brick) { // проверка возможности опускания фигуры на одну строку вниз
+template <class Board, class Pieces>
+int TetrisGame<Board, Pieces>::check_down(int** matrix, int* brick) { // проверка возможности опускания фигуры на одну строку вниз
   int res = 1; // по умолчанию опускание доступно
-  for (int i = 0; i < BRICK_SIZE; i += 2) { // проходим по индексам Y в массиве координат (каждая вторая позиция начиная с 0)
-    if ((brick[i] + 1 >= WINDOW_HEIGHT) || matrix[brick[i] + 1][brick[i + 1]]) { // если после опускания выйдем за нижнюю границу либо ячейка занята
+  for (int i = 0; i < brick_size; i += 2) { // проходим по индексам Y в массиве координат (каждая вторая позиция начиная с 0)
+    if ((brick[i] + 1 >= board.height()) || matrix[brick[i] + 1][brick[i + 1]]) { // если после опускания выйдем за нижнюю границу либо ячейка занята
       res = 0; // опускание недоступно
     } // конец условия проверки для текущего блока
   } // конец цикла по блокам фигуры
   return res; // возвращаем результат проверки опускания
 } // конец метода check_down
 
+/**
+ * @brief Вычисляет, на сколько строк фигура может опуститься.
+ *
+ * Для каждого столбца берётся только нижний блок фигуры и расстояние от него
+ * до ближайшей занятой ячейки ниже; ответ — минимум по столбцам. На игровом поле
+ * расстояние до столбца, над которым висит блок, берётся из column_height без обхода ячеек.
+ * Клетки самой фигуры на поле не мешают: под нижним блоком столбца других её блоков нет,
+ * а column_height не учитывает падающую фигуру, поэтому поле можно не очищать.
+ *
+ * @param matrix игровое поле
+ * @param brick массив координат фигуры
+ * @param counted matrix — поле игры, для которого ведутся высоты столбцов; иначе столбцы обходятся по ячейкам
+ * @return число строк до места приземления
+ */
+template <class Board, class Pieces>
+int TetrisGame<Board, Pieces>::drop_distance(int** matrix, const int* brick, bool counted) const { // вычисление высоты мгновенного сброса за один проход по столбцам
+  int res = board.height(); // больше высоты поля фигура опуститься не может
+  for (int i = 0; i < brick_size; i += 2) { // проходим по блокам фигуры
+    int lowest = 1; // является ли блок нижним в своём столбце
+    for (int j = 0; j < brick_size; j += 2) { // сравниваем с остальными блоками
+      if (brick[j + 1] == brick[i + 1] && brick[j] > brick[i]) lowest = 0; // ниже в том же столбце есть блок фигуры
+    } // конец цикла сравнения блоков
+    int top = board.height() - column_height[brick[i + 1]]; // верхняя занятая строка столбца на игровом поле
+    if (lowest && counted && brick[i] < top) { // блок выше столбца — всё между ними свободно
+      if (top - brick[i] - 1 < res) res = top - brick[i] - 1; // расстояние по высоте столбца без обхода ячеек
+    } else if (lowest) { // блок под нависанием или высот столбцов нет — спускаемся по столбцу
+      int distance = 0; // свободные ячейки под блоком
+      while (brick[i] + distance + 1 < board.height() && !matrix[brick[i] + distance + 1][brick[i + 1]]) { // пока ниже свободно
+        distance++; // опускаемся ещё на одну строку
+      } // конец спуска по столбцу
+      if (distance < res) res = distance; // место приземления определяет самый близкий к опоре столбец
+    } // конец обработки нижнего блока
+  } // конец цикла по блокам фигуры
+  return res; // возвращаем высоту сброса
+} // конец метода drop_distance
+
 /**
  * @brief Размещает фигуру на игровом поле.
  *
  * @param matrix игровое поле
  * @param array массив координат фигуры
  * @param color цвет фигуры
+ * @param hashed пространство ключей хэша matrix (ZOBRIST_FIELD, ZOBRIST_NEXT) или ZOBRIST_NONE
  */
-void Tetris::spawn_brick(int** matrix, int* array, int color) { // отображение фигуры на поле, присвоение ячейкам значения цвета
-  for (int i = 0; i < BRICK_SIZE; i += 2) { // проходим по парам Y,X в массиве координат
+template <class Board, class Pieces>
+void TetrisGame<Board, Pieces>::spawn_brick(int** matrix, int* array, int color, int hashed) { // отображение фигуры на поле, присвоение ячейкам значения цвета
+  for (int i = 0; i < brick_size; i += 2) { // проходим по парам Y,X в массиве координат
+    if (!matrix[array[i]][array[i + 1]] && color) hash_cell(hashed, array[i], array[i + 1]); // клетка стала занятой
     matrix[array[i]][array[i + 1]] = color; // устанавливаем в поле значение color для соответствующей позиции
   } // конец цикла по блокам фигуры
 } // конец метода spawn_brick
@@ -311,17 +440,20 @@ void Tetris::spawn_brick(int** matrix, int* array, int color) { // отобра
 /**
  * @brief Инициализирует структуру Tetris перед началом игры.
  *
- * Выделяет память под текущую и следующую фигуры,
+ * Направляет указатели фигур на место внутри сессии,
  * обнуляет статистику, устанавливает случайные цвета.
  */
-void Tetris::stats_init(Tetris* tetris) { // инициализация полей структуры Tetris и выделение памяти для фигур
-  tetris->current_brick = (int*)malloc(sizeof(int) * BRICK_SIZE); // выделяем память под массив текущей фигуры
-  tetris->next_brick = (int*)malloc(sizeof(int) * BRICK_SIZE); // выделяем память под массив следующей фигуры
+template <class Board, class Pieces>
+void TetrisGame<Board, Pieces>::stats_init(TetrisGame* tetris) { // инициализация полей структуры Tetris и выделение памяти для фигур
+  tetris->current_brick = tetris->bricks; // текущая фигура в первой половине места фигур
+  tetris->next_brick = tetris->bricks + brick_size; // следующая фигура во второй половине
+  memset(tetris->bricks, 0, sizeof(tetris->bricks)); // остатки прошлой партии не попадают в снимок до первого появления фигуры
   tetris->gameinfo.level = 0; // обнуляем уровень
   tetris->gameinfo.pause = 0; // снимаем паузу
   tetris->gameinfo.speed = 0; // обнуляем скорость
   tetris->gameinfo.score = 0; // обнуляем счёт
   tetris->gameinfo.high_score = 0; // обнуляем локальное значение рекорда (будет перезаписано при чтении)
+  tetris->lines_cleared = 0; // строки ещё не удалялись
   tetris->current_color = COLOR_RANDOMIZER; // задаём случайный текущий цвет
   tetris->next_color = COLOR_RANDOMIZER; // задаём случайный следующий цвет
 } // конец метода stats_init
@@ -333,7 +465,9 @@ void Tetris::stats_init(Tetris* tetris) { // инициализация поле
  *
  * @return 0 при успешной инициализации, 1 при ошибке открытия/создания файла
  */
-int Tetris::init_score(Tetris* tetris) { // чтение/создание файла рекорда и установка значения high_score
+template <class Board, class Pieces>
+int TetrisGame<Board, Pieces>::init_score(TetrisGame* tetris) { // чтение/создание файла рекорда и установка значения high_score
+  TRACE_SCOPE("tetris.init_score"); // интервал чтения файла рекорда
   int record = 0; // временная переменная для хранения рекорда
   int res = 0; // переменная результата: 0 — успех, 1 — ошибка
   FILE* file; // указатель на файл
@@ -343,6 +477,7 @@ int Tetris::init_score(Tetris* tetris) { // чтение/создание фай
     file = fopen(filename, "wb"); // пробуем создать файл для записи в бинарном режиме
     if (file != NULL) { // если создание прошло успешно
       fwrite(&record, sizeof(int), 1, file); // записываем начальное значение рекорда (0) в файл
+      STATS_EVENT(STAT_FILE_WRITES, 1); // учёт записи файла
       fclose(file); // закрываем созданный файл
     } else { // если не удалось создать файл
       res = 1; // устанавливаем код ошибки
@@ -361,69 +496,197 @@ int Tetris::init_score(Tetris* tetris) { // чтение/создание фай
  * Удаляет полностью заполненные строки и сдвигает оставшиеся вниз.
  * @return количество заполненных строк
  */
-int Tetris::check_full_row(int** field) { // начало метода проверки и удаления полностью заполненных строк
-  int res = 0; // инициализация счётчика удалённых строк
-  for (int i = WINDOW_HEIGHT - 1; i > 1; i--) { // проход снизу вверх по строкам поля, пропуская верхние служебные строки
-    bool flag = true; // флаг, предполагающий что строка заполнена полностью
-    for (int j = 0; (j < WINDOW_WIDTH) && flag; j++) { // проверка каждой ячейки строки до выявления пустой
-      if (field[i][j] == 0) { // если найдена пустая ячейка
-        flag = false; // помечаем строку как незаполненную
-      } // конец проверки ячейки
+template <class Board, class Pieces>
+int TetrisGame<Board, Pieces>::check_full_row(int** field) { // начало метода проверки и удаления полностью заполненных строк
+  TRACE_SCOPE("tetris.check_full_row"); // интервал поиска заполненных строк
+  return remove_full_rows(field, NULL, false); // полнота строк определяется обходом ячеек
+} // конец метода check_full_row
+
+/**
+ * @brief Удаляет заполненные строки за один проход.
+ *
+ * Строки сдвигаются перестановкой указателей на строки, а не копированием ячеек:
+ * уцелевшие строки сохраняют порядок и опускаются вниз, очищенные строки переходят наверх.
+ * Перестановка выполняется на месте и не требует буфера размером с высоту поля.
+ * Строки 0 и 1 служебные и не удаляются.
+ *
+ * @param field игровое поле
+ * @param fill количество занятых ячеек в каждой строке (переставляется вместе со строками)
+ *             или NULL, тогда полнота строк проверяется обходом ячеек
+ * @param hashed field — поле игры, и его хэш field_hash обновляется вместе со строками
+ * @return количество удалённых строк
+ */
+template <class Board, class Pieces>
+int TetrisGame<Board, Pieces>::remove_full_rows(int** field, int* fill, bool hashed) { // удаление заполненных строк перестановкой указателей
+  int res = 0; // количество удалённых строк
+  int write = board.height() - 1; // позиция, куда опускается следующая уцелевшая строка
+  for (int read = board.height() - 1; read >= 1; read--) { // проход снизу вверх до служебной строки 1 включительно
+    int* row = field[read]; // текущая строка
+    int count = 0; // количество занятых ячеек строки
+    if (fill) { // счётчики известны
+      count = fill[read]; // берём готовое значение
+    } else { // счётчиков нет
+      while (count < board.width() && row[count]) count++; // считаем до первой пустой ячейки
+    } // конец подсчёта заполненности
+    if (read > 1 && count == board.width()) { // строка заполнена полностью
+      if (hashed) field_hash ^= zobrist_row(ZOBRIST_FIELD, row, read, board.width()); // клетки строки освобождаются
+      memset(row, 0, board.width() * sizeof(int)); // очищаем строку — она уйдёт наверх
+      if (fill) fill[read] = 0; // в ней нет занятых ячеек
+      res++; // считаем удалённую строку
+    } else { // строка остаётся
+      if (hashed && read != write) // строка опускается: её клетки переходят на новые ключи
+        field_hash ^= zobrist_row(ZOBRIST_FIELD, row, read, board.width()) ^ zobrist_row(ZOBRIST_FIELD, row, write, board.width());
+      field[read] = field[write]; // между read и write лежат только очищенные строки — одна из них поднимается
+      field[write] = row; // уцелевшая строка опускается на число удалённых под ней
+      if (fill) { // счётчики переезжают вместе со строками
+        fill[read] = fill[write]; // счётчик очищенной строки
+        fill[write] = count; // счётчик уцелевшей строки
+      } // конец перестановки счётчиков
+      write--; // следующая позиция выше
+    } // конец обработки строки
+  } // конец прохода по строкам
+  return res; // возвращаем количество удалённых строк
+} // конец метода remove_full_rows
+
+/**
+ * @brief Удаляет заполненные строки после прикрепления текущей фигуры.
+ *
+ * Заполненной может стать только строка, которой касается фигура, поэтому
+ * проверяются лишь они, по счётчикам row_fill. Высоты столбцов уменьшаются на число
+ * удалённых строк; столбец пересчитывается, только если удалена его верхняя строка.
+ *
+ * @return количество удалённых строк
+ */
+template <class Board, class Pieces>
+int TetrisGame<Board, Pieces>::clear_full_rows() { // удаление заполненных строк по счётчикам
+  TRACE_SCOPE("tetris.check_full_row"); // интервал проверки и удаления заполненных строк
+  int res = 0; // количество удалённых строк
+  int full = 0; // есть ли заполненные строки среди затронутых фигурой
+  for (int i = 0; i < brick_size; i += 2) { // проходим по строкам блоков фигуры
+    if (current_brick[i] > 1 && row_fill[current_brick[i]] == board.width()) full = 1; // строка заполнена
+  } // конец проверки строк фигуры
+  if (full) { // есть что удалять
+    for (int x = 0; x < board.width(); x++) { // проходим по столбцам
+      int top = board.height() - column_height[x]; // верхняя занятая строка столбца
+      if (column_height[x] > 0 && top > 1 && row_fill[top] == board.width()) { // верх столбца лежит в удаляемой строке
+        column_height[x] = -1; // помечаем столбец для пересчёта после удаления
+      } // конец проверки столбца
+    } // конец отметки столбцов
+    res = remove_full_rows(gameinfo.field, row_fill.data(), true); // удаляем строки перестановкой указателей
+    for (int x = 0; x < board.width(); x++) { // обновляем высоты столбцов
+      if (column_height[x] < 0) { // верх столбца удалён — ищем новый
+        int y = 0; // строка поиска
+        while (y < board.height() && !gameinfo.field[y][x]) y++; // спускаемся до первой занятой ячейки
+        column_height[x] = board.height() - y; // новая высота столбца
+      } else { // все удалённые строки лежали под верхом столбца
+        column_height[x] -= res; // столбец опустился на число удалённых строк
+      } // конец обновления столбца
     } // конец цикла по столбцам
-    if (flag) { // если строка полностью заполнена
-      res++; // увеличиваем счётчик удалённых строк
-      for (int k = i; k > 1; k--) { // сдвигаем все строки выше вниз на одну позицию, начиная с текущей строки
-        for (int m = 0; m < WINDOW_WIDTH; m++) { // проход по всем столбцам для копирования значений
-          field[k][m] = field[k - 1][m]; // переносим значение из строки выше в текущую
-        } // конец цикла по столбцам при сдвиге
-      } // конец цикла сдвига строк вниз
-      i++; // увеличиваем индекс, чтобы повторно проверить строку, которая сместилась на текущую позицию
-    } // конец обработки заполненной строки
-  } // конец цикла по строкам поля
+  } // конец удаления строк
   return res; // возвращаем количество удалённых строк
-} // конец метода check_full_row
+} // конец метода clear_full_rows
 
 /**
- * @brief Убирает фигуру с игрового поля.
+ * @brief Учитывает блоки легшей фигуры в счётчиках.
  *
- * @param matrix игровое поле
- * @param array массив координат фигуры
+ * @param brick массив координат фигуры
  */
-void Tetris::despawn(int** matrix, int* array) { // начало метода удаления фигуры с поля (обнуление её ячеек)
-  for (int i = 0; i < BRICK_SIZE; i += 2) { // проход по парам Y,X в массиве координат фигуры
-    matrix[array[i]][array[i + 1]] = 0; // устанавливаем соответствующую ячейку поля в 0 (удаляем блок)
+template <class Board, class Pieces>
+void TetrisGame<Board, Pieces>::lock_brick(int* brick) { // обновление счётчиков строк и высот столбцов при прикреплении фигуры
+  flight.record(FLIGHT_LOCK, statemachine, brick[0]); // фигура легла — событие в журнал сессии
+  for (int i = 0; i < brick_size; i += 2) { // проходим по блокам фигуры
+    row_fill[brick[i]]++; // в строке стало на одну занятую ячейку больше
+    if (board.height() - brick[i] > column_height[brick[i + 1]]) { // блок выше текущего верха столбца
+      column_height[brick[i + 1]] = board.height() - brick[i]; // столбец вырос
+    } // конец проверки высоты
   } // конец цикла по блокам фигуры
-} // конец метода despawn
+} // конец метода lock_brick
 
+/**
+ * @brief Пересчитывает счётчики строк и высоты столбцов по игровому полю.
+ */
+template <class Board, class Pieces>
+void TetrisGame<Board, Pieces>::counters_init() { // полный пересчёт счётчиков, выполняется один раз при старте игры
+  for (int x = 0; x < board.width(); x++) column_height[x] = 0; // столбцы пусты
+  for (int y = board.height() - 1; y >= 0; y--) { // проход снизу вверх
+    row_fill[y] = 0; // начинаем подсчёт строки
+    for (int x = 0; x < board.width(); x++) { // проход по столбцам
+      if (gameinfo.field[y][x]) { // ячейка занята
+        row_fill[y]++; // учитываем её в строке
+        column_height[x] = board.height() - y; // при проходе снизу вверх последняя занятая ячейка — верх столбца
+      } // конец проверки ячейки
+    } // конец цикла по столбцам
+  } // конец цикла по строкам
+} // конец метода counters_init
+
+template <class Board, class Pieces>
+void TetrisGame<Board, Pieces>::hash_cell(int domain, int y, int x) { // смена занятости клетки
+  if (domain == ZOBRIST_FIELD) field_hash ^= zobrist_key(ZOBRIST_FIELD, (uint64_t)y * board.width() + x); // клетка поля
+  else if (domain == ZOBRIST_NEXT) next_hash ^= zobrist_key(ZOBRIST_NEXT, (uint64_t)y * NEXT_SIZE + x); // клетка next
+} // конец метода hash_cell
+
+template <class Board, class Pieces>
+void TetrisGame<Board, Pieces>::hash_init() { // полный пересчёт хэшей
+  field_hash = zobrist_matrix(ZOBRIST_FIELD, gameinfo.field, board.height(), board.width()); // поле
+  next_hash = zobrist_matrix(ZOBRIST_NEXT, gameinfo.next, NEXT_SIZE, NEXT_SIZE); // область next
+} // конец метода hash_init
 
 /**
- * @brief Проверяет, является ли фигура квадратом.
+ * @brief Добавляет мусорные строки снизу поля (режим соперничества).
  *
- * @return 1 если фигура квадрат, иначе 0
+ * Поле поднимается на rows строк перестановкой указателей, снизу появляются строки,
+ * заполненные цветом color везде, кроме столбца hole. Счётчики строк, высоты столбцов и хэш
+ * обновляются без пересчёта поля: из хэша вычитаются и на новом месте добавляются только
+ * непустые по row_fill строки, затем добавляются строки мусора. Вызывается, когда текущей фигуры на поле нет
+ * (после прикрепления, до появления следующей).
+ *
+ * @return false если занятые клетки вытолкнуты за верх поля (игрок выбывает)
  */
-
-int Tetris::is_Smashboy(int* brick) { // начало метода определения квадрата (Smashboy)
-  int res = 0; // по умолчанию считаем, что фигура не квадрат
-  if (brick[4] == brick[0] + 1 && brick[6] == brick[2] + 1 && // проверяем расположение Y для правой колонки относительно левой
-      brick[3] == brick[1] + 1 && brick[7] == brick[5] + 1 && // проверяем расположение X для нижней строки относительно верхней
-      brick[1] == brick[5] && brick[3] == brick[7]) // проверяем выравнивание по X и Y для колонок/строк (равные координаты)
-    res = 1; // если все условия выполнены, помечаем как квадрат
-  return res; // возвращаем результат проверки
-} // конец метода is_Smashboy
+template <class Board, class Pieces>
+bool TetrisGame<Board, Pieces>::add_garbage(int rows, int hole, int color) { // вставка мусорных строк
+  bool res = true; // по умолчанию поле вмещает мусор
+  int height = board.height(); // высота поля
+  rows = rows > height ? height : rows; // не больше высоты поля
+  for (int y = 0; y < rows; y++) { // строки, уходящие за верх поля
+    if (row_fill[y]) res = false; // занятые клетки выталкиваются
+  } // конец проверки верхних строк
+  if (rows > 0) { // есть что вставлять
+    for (int y = 0; y < height; y++) { // строки до сдвига
+      if (!row_fill[y]) continue; // пустая строка в хэш не входит
+      field_hash ^= zobrist_row(ZOBRIST_FIELD, gameinfo.field[y], y, board.width()); // строка уходит со своего места
+      if (y >= rows) field_hash ^= zobrist_row(ZOBRIST_FIELD, gameinfo.field[y], y - rows, board.width()); // и встаёт на rows строк выше
+    } // конец сдвига хэша
+    std::rotate(gameinfo.field, gameinfo.field + rows, gameinfo.field + height); // поле поднимается, верхние строки уходят вниз
+    std::rotate(row_fill.begin(), row_fill.begin() + rows, row_fill.end()); // счётчики строк вместе с ними
+    for (int y = height - rows; y < height; y++) { // новые нижние строки
+      for (int x = 0; x < board.width(); x++) gameinfo.field[y][x] = (x == hole) ? 0 : color; // мусор с дыркой
+      row_fill[y] = board.width() - (hole >= 0 && hole < board.width()); // все клетки, кроме дырки
+      field_hash ^= zobrist_row(ZOBRIST_FIELD, gameinfo.field[y], y, board.width()); // строка мусора
+    } // конец заполнения нижних строк
+    for (int x = 0; x < board.width(); x++) { // высоты столбцов
+      if (x != hole || column_height[x] > 0) { // столбец стоит на мусоре или уже был занят
+        column_height[x] = column_height[x] + rows > height ? height : column_height[x] + rows; // столбец вырос
+      } // конец проверки столбца
+    } // конец обновления высот
+  } // конец вставки
+  return res; // признак того, что поле вместило мусор
+} // конец метода add_garbage
 
 /**
- * @brief Проверяет, является ли фигура типом "Hero".
+ * @brief Убирает фигуру с игрового поля.
  *
- * @return 1 если фигура Hero, иначе 0
+ * @param matrix игровое поле
+ * @param array массив координат фигуры
+ * @param hashed пространство ключей хэша matrix или ZOBRIST_NONE
  */
-int Tetris::is_Hero(int* brick) { // начало метода проверки линейной фигуры (Hero)
-  int res = 0; // по умолчанию не является Hero
-  if ((brick[0] == brick[2] && brick[2] == brick[4] && brick[4] == brick[6]) || // проверка одинаковых Y для всех блоков (вертикальная линия)
-      (brick[1] == brick[3] && brick[3] == brick[5] && brick[5] == brick[7])) { // проверка одинаковых X для всех блоков (горизонтальная линия)
-    res = 1; // если одно из условий выполнено — это Hero
-  } // конец условия проверки Hero
-  return res; // возвращаем результат проверки
-} // конец метода is_Hero
+template <class Board, class Pieces>
+void TetrisGame<Board, Pieces>::despawn(int** matrix, int* array, int hashed) { // начало метода удаления фигуры с поля (обнуление её ячеек)
+  for (int i = 0; i < brick_size; i += 2) { // проход по парам Y,X в массиве координат фигуры
+    if (matrix[array[i]][array[i + 1]]) hash_cell(hashed, array[i], array[i + 1]); // клетка освободилась
+    matrix[array[i]][array[i + 1]] = 0; // устанавливаем соответствующую ячейку поля в 0 (удаляем блок)
+  } // конец цикла по блокам фигуры
+} // конец метода despawn
+
 
 /**
  * @brief Сдвигает координаты фигуры по X или Y.
@@ -431,8 +694,9 @@ int Tetris::is_Hero(int* brick) { // начало метода проверки
  * @param cords 0 для Y координат, 1 для X координат
  * @param shift величина сдвига
  */
-void Tetris::coord_shift(int* brick, int cords, int shift) { // начало метода сдвига координат выбранного типа (Y или X)
-  for (int i = cords; i < BRICK_SIZE; i += 2) { // проход по соответствующим индексам (0,2,4,6 для Y или 1,3,5,7 для X)
+template <class Board, class Pieces>
+void TetrisGame<Board, Pieces>::coord_shift(int* brick, int cords, int shift) const { // начало метода сдвига координат выбранного типа (Y или X)
+  for (int i = cords; i < brick_size; i += 2) { // проход по соответствующим индексам (0,2,4,6 для Y или 1,3,5,7 для X)
     brick[i] += shift; // изменяем координату на указанное значение shift
   } // конец цикла сдвига координат
 } // конец метода coord_shift
@@ -442,7 +706,8 @@ void Tetris::coord_shift(int* brick, int cords, int shift) { // начало м
  *
  * @return 1 если возможно, иначе 0
  */
-int Tetris::check_attaching(int* brick, int** matrix) { // начало метода проверки прикрепления/опускания
+template <class Board, class Pieces>
+int TetrisGame<Board, Pieces>::check_attaching(int* brick, int** matrix) { // начало метода проверки прикрепления/опускания
   int res = 0; // по умолчанию считаем, что прикрепление требуется
   if (check_down(matrix, brick)) { // если можно опустить вниз (нет препятствий)
     coord_shift(brick, Y_CORDS, DOWN); // сдвигаем координаты Y фигуры вниз на 1
@@ -455,20 +720,21 @@ int Tetris::check_attaching(int* brick, int** matrix) { // начало мето
 /**
  * @brief Поворачивает фигуру на игровом поле.
  *
- * Создаёт временную матрицу и вычисляет новые координаты фигуры
- * с учётом типа фигуры и её положения.
+ * Раскладывает фигуру во временную матрицу на стеке и вычисляет новые координаты
+ * с учётом типа фигуры и её положения. Память в куче не выделяется, поэтому поворот
+ * можно вызывать в переборе положений (PlacementFinder) тысячи раз за кадр.
  */
-void Tetris::rotate(int** matrix, int* brick, int size) { // начало метода поворота фигуры с учётом размера шаблона size
-  int** temp = NULL; // указатель на временную матрицу для текущего положения фигуры
-  int** rotate = NULL; // указатель на матрицу для результата поворота
-  temp = init_matrix(temp, size, size); // выделяем временную матрицу размером size x size
-  rotate = init_matrix(rotate, size, size); // выделяем матрицу для результата поворота
-  int* temp_brick = (int*)malloc(sizeof(int) * BRICK_SIZE); // выделяем память для временного хранения координат фигуры
+template <class Board, class Pieces>
+void TetrisGame<Board, Pieces>::rotate(int** matrix, int* brick, int size) { // начало метода поворота фигуры с учётом размера шаблона size
+  TRACE_SCOPE("tetris.rotate"); // интервал поворота
+  int temp[ROTATE_MAX_SIZE][ROTATE_MAX_SIZE] = {{0}}; // временная матрица текущего положения фигуры
+  int rotate[ROTATE_MAX_SIZE][ROTATE_MAX_SIZE] = {{0}}; // матрица для результата поворота
+  int temp_brick[brick_size]; // временное хранилище координат фигуры
   brick_copy(temp_brick, brick); // копируем текущие координаты в temp_brick на случай отката поворота
-  int centre_cord = (size == 3) ? 1 : 2; // вычисляем центральную координату внутри матрицы (для центровки поворота)
+  int centre_cord = size / 2; // вычисляем центральную координату внутри матрицы (для центровки поворота)
   int min_Y = brick[0] - centre_cord; // определяем верхний Y угол для размещения фигуры в temp
   int min_X = brick[1] - centre_cord; // определяем левый X угол для размещения фигуры в temp
-  for (int i = 0; i < BRICK_SIZE; i += 2) { // проходим по всем блокам фигуры
+  for (int i = 0; i < brick_size; i += 2) { // проходим по всем блокам фигуры
     temp[brick[i] - min_Y][brick[i + 1] - min_X] = 1; // помечаем соответствующую ячейку в temp как занятую
   } // конец заполнения temp матрицы текущей фигурой
   for (int i = 0; i < size; i++) { // цикл по строкам матрицы размера size
@@ -492,9 +758,6 @@ void Tetris::rotate(int** matrix, int* brick, int size) { // начало мет
   if (!rotate_check_field(matrix, brick)) { // если после поворота есть пересечение с другими блоками поля
     brick_copy(brick, temp_brick); // откатываем изменения — восстанавливаем исходные координаты из temp_brick
   } // конец проверки соприкосновения с полем
-  free(temp_brick); // освобождаем временный буфер координат
-  free_memory_matrix(temp, size); // освобождаем временную матрицу temp
-  free_memory_matrix(rotate, size); // освобождаем матрицу rotate
 } // конец метода rotate
 
 /**
@@ -502,10 +765,11 @@ void Tetris::rotate(int** matrix, int* brick, int size) { // начало мет
  *
  * @return 1 если нет столкновения, иначе 0
  */
-int Tetris::rotate_check_down_wall(int* brick) { // начало метода проверки выхода за нижнюю границу
+template <class Board, class Pieces>
+int TetrisGame<Board, Pieces>::rotate_check_down_wall(int* brick) { // начало метода проверки выхода за нижнюю границу
   int res = 1; // по умолчанию считаем что выхода нет
-  for (int i = 0; i < BRICK_SIZE; i += 2) { // проходим по индексам Y в массиве координат
-    if (brick[i] >= WINDOW_HEIGHT) res = 0; // если хотя бы одна Y координата выходит за границу — помечаем как столкновение
+  for (int i = 0; i < brick_size; i += 2) { // проходим по индексам Y в массиве координат
+    if (brick[i] >= board.height()) res = 0; // если хотя бы одна Y координата выходит за границу — помечаем как столкновение
   } // конец цикла проверки Y координат
   return res; // возвращаем результат проверки
 } // конец метода rotate_check_down_wall
@@ -515,9 +779,10 @@ int Tetris::rotate_check_down_wall(int* brick) { // начало метода п
  *
  * @return 1 если нет столкновения, иначе 0
  */
-int Tetris::rotate_check_left_wall(int* brick) { // начало метода проверки выхода за левую границу
+template <class Board, class Pieces>
+int TetrisGame<Board, Pieces>::rotate_check_left_wall(int* brick) { // начало метода проверки выхода за левую границу
   int res = 1; // по умолчанию считаем что выхода нет
-  for (int i = 1; i < BRICK_SIZE; i += 2) { // проходим по индексам X в массиве координат
+  for (int i = 1; i < brick_size; i += 2) { // проходим по индексам X в массиве координат
     if ((brick[i] < 0)) { // если хотя бы одна X координата меньше 0 (вышла за левую границу)
       res = 0; // помечаем как столкновение
     } // конец условия проверки для текущего блока
@@ -530,10 +795,11 @@ int Tetris::rotate_check_left_wall(int* brick) { // начало метода п
  *
  * @return 1 если нет столкновения, иначе 0
  */
-int Tetris::rotate_check_right_wall(int* brick) { // начало метода проверки выхода за правую границу
+template <class Board, class Pieces>
+int TetrisGame<Board, Pieces>::rotate_check_right_wall(int* brick) { // начало метода проверки выхода за правую границу
   int res = 1; // предполагаем, что выхода не происходит
-  for (int i = 1; i < BRICK_SIZE; i += 2) { // проходим по индексам X в массиве координат
-    if ((brick[i] >= WINDOW_WIDTH)) { // если хотя бы одна X координата больше или равна ширине поля
+  for (int i = 1; i < brick_size; i += 2) { // проходим по индексам X в массиве координат
+    if ((brick[i] >= board.width())) { // если хотя бы одна X координата больше или равна ширине поля
       res = 0; // помечаем как столкновение с правой стенкой
     } // конец условия проверки для текущего блока
   } // конец цикла проверки правой границы
@@ -545,9 +811,10 @@ int Tetris::rotate_check_right_wall(int* brick) { // начало метода 
  *
  * @return 1 если нет столкновения, иначе 0
  */
-int Tetris::rotate_check_up_wall(int* brick) { // начало метода проверки выхода за верхнюю границу
+template <class Board, class Pieces>
+int TetrisGame<Board, Pieces>::rotate_check_up_wall(int* brick) { // начало метода проверки выхода за верхнюю границу
   int res = 1; // предполагаем отсутствие выхода за границы
-  for (int i = 0; i < BRICK_SIZE; i += 2) { // проходим по индексам Y в массиве координат
+  for (int i = 0; i < brick_size; i += 2) { // проходим по индексам Y в массиве координат
     if (brick[i] < 0) res = 0; // если хотя бы одна Y координата меньше 0 — отмечаем столкновение с верхней границей
   } // конец цикла проверки верхней границы
   return res; // возвращаем результат проверки
@@ -560,17 +827,17 @@ int Tetris::rotate_check_up_wall(int* brick) { // начало метода пр
  * Проверяет возможность смещения фигуры влево, вправо
  * или поворота, учитывая тип фигуры.
  */
-void Tetris::brick_move(int* brick, UserAction_t state, int** matrix) { // начало метода обработки пользовательского перемещения фигуры
+template <class Board, class Pieces>
+void TetrisGame<Board, Pieces>::brick_move(int* brick, UserAction_t state, int** matrix) { // начало метода обработки пользовательского перемещения фигуры
   if (state == Left && check_left(matrix, brick, 1)) { // если действие — влево и проверка позволяет сдвинуть
     coord_shift(brick, X_CORDS, LEFT); // сдвигаем фигуру влево по X
   } else if (state == Right && check_right(matrix, brick, 1)) { // если действие — вправо и проверка разрешает сдвиг
     coord_shift(brick, X_CORDS, RIGHT); // сдвигаем фигуру вправо по X
-  } else if (state == Action && !is_Smashboy(brick)) { // если действие — поворот и фигура не квадрат (Smashboy не поворачивается)
-    if (is_Hero(brick)) { // если фигура — Hero (линейная)
-      rotate(matrix, brick, 5); // поворачиваем с использованием центра в матрице размера 5
-    } else {
-      rotate(matrix, brick, 3); // поворачиваем с использованием центра в матрице размера 3
-    } // конец выбора размера поворота по типу фигуры
+  } else if (state == Action) { // если действие — поворот
+    int piece = Pieces::table.piece_of(brick); // узнаём фигуру по маске смещений блоков
+    if (piece >= 0 && Pieces::table.rotates[piece]) { // фигура из набора и не совпадает с собой после поворота
+      rotate(matrix, brick, Pieces::table.rotate_size[piece]); // поворачиваем в матрице размера, посчитанного при компиляции
+    } // конец проверки фигуры
   } // конец условий обработки перемещения/поворота
 } // конец метода brick_move
 
@@ -579,9 +846,10 @@ void Tetris::brick_move(int* brick, UserAction_t state, int** matrix) { // на
  *
  * @return 1 если свободно, иначе 0
  */
-int Tetris::rotate_check_field(int** matrix, int* brick) { // начало метода проверки пересечений фигуры с уже занятыми ячейками поля
+template <class Board, class Pieces>
+int TetrisGame<Board, Pieces>::rotate_check_field(int** matrix, int* brick) { // начало метода проверки пересечений фигуры с уже занятыми ячейками поля
   int res = 1; // по умолчанию считаем, что пересечений нет
-  for (int i = 0; i < BRICK_SIZE; i += 2) { // проходим по всем блокам фигуры (Y,X пары)
+  for (int i = 0; i < brick_size; i += 2) { // проходим по всем блокам фигуры (Y,X пары)
     if (matrix[brick[i]][brick[i + 1]]) { // если соответствующая ячейка поля ненулевая (занята)
       res = 0; // помечаем наличие пересечения
     } // конец условия проверки конкретной ячейки
@@ -592,7 +860,8 @@ int Tetris::rotate_check_field(int** matrix, int* brick) { // начало ме
 /**
  * @brief Корректирует координаты фигуры, чтобы она не выходила за границы поля.
  */
-void Tetris::fix_brick_coord(int* brick) { // начало метода корректировки координат фигуры по всем границам поля
+template <class Board, class Pieces>
+void TetrisGame<Board, Pieces>::fix_brick_coord(int* brick) { // начало метода корректировки координат фигуры по всем границам поля
   while (!rotate_check_right_wall(brick)) { // пока есть выход за правую границу
     coord_shift(brick, X_CORDS, LEFT); // сдвигаем фигуру влево до вхождения в поле
   } // конец цикла корректировки по правой границе
@@ -610,7 +879,8 @@ void Tetris::fix_brick_coord(int* brick) { // начало метода корр
 /**
  * @brief Проверяет уровень игрока и увеличивает скорость игры при необходимости.
  */
-void Tetris::check_level(Tetris* tetris) { // начало метода проверки и обновления уровня/скорости
+template <class Board, class Pieces>
+void TetrisGame<Board, Pieces>::check_level(TetrisGame* tetris) { // начало метода проверки и обновления уровня/скорости
   if (tetris->gameinfo.level < 10 && // если текущий уровень меньше 10
       (tetris->gameinfo.score - (tetris->gameinfo.level * 600) >= 0)) { // и набрано достаточно очков для перехода на следующий уровень
     tetris->gameinfo.level++; // увеличиваем уровень на 1
@@ -620,8 +890,9 @@ void Tetris::check_level(Tetris* tetris) { // начало метода пров
 /**
  * @brief Копирует координаты фигуры из одного массива в другой.
  */
-void Tetris::brick_copy(int* src, int* other) { // начало метода копирования массива координат фигуры
-  for (int i = 0; i < BRICK_SIZE; i++) { // цикл по всем элементам массива размером BRICK_SIZE
+template <class Board, class Pieces>
+void TetrisGame<Board, Pieces>::brick_copy(int* src, const int* other) const { // начало метода копирования массива координат фигуры
+  for (int i = 0; i < brick_size; i++) { // цикл по всем элементам массива координат фигуры
     src[i] = other[i]; // копируем значение из массива other в src
   } // конец цикла копирования
 } // конец метода brick_copy
@@ -631,9 +902,10 @@ void Tetris::brick_copy(int* src, int* other) { // начало метода к
  *
  * @return 1 если фигура достигла верхнего ряда, иначе 0
  */
-int Tetris::check_gameover(int* brick) { // начало метода проверки условия Game Over (достижение верха)
+template <class Board, class Pieces>
+int TetrisGame<Board, Pieces>::check_gameover(int* brick) { // начало метода проверки условия Game Over (достижение верха)
   int res = 0; // по умолчанию игра не окончена
-  for (int i = 0; i < BRICK_SIZE; i += 2) { // проходим по всем Y координатам блоков фигуры
+  for (int i = 0; i < brick_size; i += 2) { // проходим по всем Y координатам блоков фигуры
     if (brick[i] == 0) { // если любой блок находится в верхней строке (Y == 0)
       res = 1; // помечаем условие конца игры
     } // конец проверки конкретного блока
@@ -646,7 +918,8 @@ int Tetris::check_gameover(int* brick) { // начало метода прове
  *
  * @param full_rows_counter количество удалённых строк
  */
-void Tetris::score_write(Tetris* tetris, int full_rows_counter) { // начало метода обновления счёта и записи рекорда
+template <class Board, class Pieces>
+void TetrisGame<Board, Pieces>::score_write(TetrisGame* tetris, int full_rows_counter) { // начало метода обновления счёта и записи рекорда
   if (full_rows_counter == 1) { // один удалённый ряд
     tetris->gameinfo.score += 100; // начисляем 100 очков
   } else if (full_rows_counter == 2) { // два удалённых ряда
@@ -658,17 +931,122 @@ void Tetris::score_write(Tetris* tetris, int full_rows_counter) { // начал
   } // конец расчёта очков за удалённые строки
   if (tetris->gameinfo.score > tetris->gameinfo.high_score) { // если текущий счёт превысил рекорд
     tetris->gameinfo.high_score = tetris->gameinfo.score; // обновляем рекорд в структуре
-    FILE* file; // указатель на файл для записи рекорда
-    const char* filename = DATA_FILE_NAME; // имя файла с рекордом
-    int record = tetris->gameinfo.high_score; // локальная копия значения рекорда для записи
-    file = fopen(filename, "wb"); // открываем файл для записи в бинарном режиме (перезаписываем)
-    if (file != NULL) { // если файл открылся успешно
-      fwrite(&record, sizeof(int), 1, file); // записываем значение рекорда в файл
-      fclose(file); // закрываем файл после записи
-    } // конец проверки успешного открытия файла для записи
+    if (tetris->keep_record) { // рекорд сохраняется в файл (в матче соперничества — нет)
+      TRACE_SCOPE("tetris.score_write"); // интервал записи файла рекорда
+      FILE* file; // указатель на файл для записи рекорда
+      const char* filename = DATA_FILE_NAME; // имя файла с рекордом
+      int record = tetris->gameinfo.high_score; // локальная копия значения рекорда для записи
+      file = fopen(filename, "wb"); // открываем файл для записи в бинарном режиме (перезаписываем)
+      if (file != NULL) { // если файл открылся успешно
+        fwrite(&record, sizeof(int), 1, file); // записываем значение рекорда в файл
+        STATS_EVENT(STAT_FILE_WRITES, 1); // учёт записи файла
+        fclose(file); // закрываем файл после записи
+      } // конец проверки успешного открытия файла для записи
+    } // конец записи рекорда в файл
   } // конец условия обновления рекорда
 } // конец метода score_write
 
+typedef struct { // состояние тетриса в снимке, кроме массивов (поля уложены без выравнивающих промежутков)
+  int64_t elapsed_us; // время с последнего шага таймера
+  int32_t current_color; // цвет текущей фигуры
+  int32_t next_color; // цвет следующей фигуры
+  int32_t lines_cleared; // удалённые строки
+  uint8_t keep_record; // сохранение рекорда
+  uint8_t has_bricks; // фигуры выделены (партия идёт)
+  uint8_t reserved[2]; // выравнивание до 8 байт
+} TetrisBlock; // имя типа — TetrisBlock
+
+template <class Board, class Pieces>
+void TetrisGame<Board, Pieces>::snapshot_header(SnapshotHeader* header) const { // параметры движка для снимка
+  header->kind = SNAPSHOT_TETRIS; // тетрис
+  header->pieces = Pieces::id; // набор фигур
+  header->height = board.height(); // высота поля
+  header->width = board.width(); // ширина поля
+} // конец метода snapshot_header
+
+template <class Board, class Pieces>
+size_t TetrisGame<Board, Pieces>::state_size() const { // размер состояния тетриса
+  size_t bricks = playing(statemachine) ? 2 * brick_size * sizeof(int) : 0; // фигуры есть только во время партии
+  return sizeof(TetrisBlock) + sizeof(rng) + bricks + (board.height() + board.width()) * sizeof(int); // и счётчики
+} // конец метода state_size
+
+/**
+ * @brief Записывает состояние тетриса в снимок.
+ *
+ * Фигуры записываются только в состояниях партии (Spawn..Attaching): в GameStart и GameOver
+ * они не используются.
+ */
+template <class Board, class Pieces>
+void TetrisGame<Board, Pieces>::save_state(SnapshotWriter& out) const { // запись состояния тетриса
+  TetrisBlock block = {time.get_elapsed_us(), current_color, next_color, lines_cleared,
+                       keep_record,           playing(statemachine), {0, 0}}; // скалярные поля
+  out.put(block); // скалярные поля
+  out.put(rng); // генератор фигур
+  if (block.has_bricks) { // партия идёт
+    out.put_bytes(current_brick, brick_size * sizeof(int)); // текущая фигура
+    out.put_bytes(next_brick, brick_size * sizeof(int)); // следующая фигура
+  } // конец записи фигур
+  out.put_bytes(row_fill.data(), board.height() * sizeof(int)); // заполненность строк
+  out.put_bytes(column_height.data(), board.width() * sizeof(int)); // высоты столбцов
+} // конец метода save_state
+
+/**
+ * @brief Читает состояние тетриса из снимка.
+ *
+ * Снимок приходит из файлов повтора и пакетов сетевого матча, поэтому всё читается в локальные
+ * копии и проверяется до изменения сессии: фигуры есть ровно в состояниях партии, клетки текущей
+ * фигуры лежат на поле, следующей — в области NEXT, счётчики строк и столбцов — в пределах
+ * ширины и высоты поля. Поле к этому моменту уже прочитано Game::restore.
+ * @param state состояние КА из снимка
+ */
+template <class Board, class Pieces>
+bool TetrisGame<Board, Pieces>::restore_state(SnapshotReader& in, State_of_machine state) { // чтение состояния тетриса
+  TetrisBlock block{}; // скалярные поля
+  std::minstd_rand saved_rng; // генератор фигур
+  int saved_bricks[2 * brick_size] = {0}; // текущая и следующая фигуры
+  typename Board::Fills fills = row_fill; // заполненность строк из снимка (размер — как у поля)
+  typename Board::Heights heights = column_height; // высоты столбцов из снимка
+  bool res = in.get(&block) && in.get(&saved_rng) && block.has_bricks == playing(state); // фигуры ровно во время партии
+  if (res && block.has_bricks) res = in.get_bytes(saved_bricks, sizeof(saved_bricks)); // фигуры партии
+  res = res && in.get_bytes(fills.data(), board.height() * sizeof(int)) &&
+        in.get_bytes(heights.data(), board.width() * sizeof(int)) && in.left() == 0; // счётчики поля и конец снимка
+  for (int i = 0; res && block.has_bricks && i < brick_size; i += 2) { // клетки фигур
+    res = saved_bricks[i] >= 0 && saved_bricks[i] < board.height() && saved_bricks[i + 1] >= 0 &&
+          saved_bricks[i + 1] < board.width() && saved_bricks[brick_size + i] >= 0 &&
+          saved_bricks[brick_size + i] < NEXT_SIZE && saved_bricks[brick_size + i + 1] >= 0 &&
+          saved_bricks[brick_size + i + 1] < NEXT_SIZE; // текущая на поле, следующая в области NEXT
+  } // конец проверки фигур
+  for (int y = 0; res && y < board.height(); y++) res = fills[y] >= 0 && fills[y] <= board.width(); // занятые клетки строки
+  for (int x = 0; res && x < board.width(); x++) res = heights[x] >= 0 && heights[x] <= board.height(); // высота столбца
+  if (res) { // снимок прочитан и проверен
+    current_brick = block.has_bricks ? bricks : NULL; // текущая фигура, если в снимке идёт партия
+    next_brick = block.has_bricks ? bricks + brick_size : NULL; // следующая фигура
+    if (block.has_bricks) memcpy(bricks, saved_bricks, sizeof(bricks)); // копируем фигуры
+    row_fill = fills; // заполненность строк
+    column_height = heights; // высоты столбцов
+    current_color = block.current_color; // цвет текущей фигуры
+    next_color = block.next_color; // цвет следующей фигуры
+    lines_cleared = block.lines_cleared; // удалённые строки
+    keep_record = block.keep_record; // сохранение рекорда
+    time.resume(block.elapsed_us); // таймер продолжает отсчёт
+    rng = saved_rng; // генератор фигур
+    hash_init(); // хэши по прочитанным полю и области next
+  } // конец применения состояния
+  return res; // результат чтения
+} // конец метода restore_state
 
-}  // namespace s21 // конец пространства имён s21
 
+template class Engine<TetrisGame<StandardBoard, StandardPieces>>; // шаг КА стандартного тетриса
+template class Engine<TetrisGame<RuntimeBoard, StandardPieces>>; // шаг КА на поле выбранного размера
+template class Engine<TetrisGame<StandardBoard, PentominoPieces>>; // шаг КА пентамино
+template class Engine<TetrisGame<RuntimeBoard, PentominoPieces>>; // шаг КА пентамино на поле выбранного размера
+template class Engine<TetrisGame<StandardBoard, TrainingPieces>>; // шаг КА тренировочного набора
+template class Engine<TetrisGame<RuntimeBoard, TrainingPieces>>; // шаг КА тренировочного набора на поле выбранного размера
+template class TetrisGame<StandardBoard, StandardPieces>; // стандартное поле 20x10
+template class TetrisGame<RuntimeBoard, StandardPieces>; // поле размера, выбранного при создании сессии
+template class TetrisGame<StandardBoard, PentominoPieces>; // пентамино на стандартном поле
+template class TetrisGame<RuntimeBoard, PentominoPieces>; // пентамино на поле выбранного размера
+template class TetrisGame<StandardBoard, TrainingPieces>; // тренировочный набор на стандартном поле
+template class TetrisGame<RuntimeBoard, TrainingPieces>; // тренировочный набор на поле выбранного размера
+
+}  // namespace s21 // конец пространства имён s21
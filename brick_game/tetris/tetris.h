@@ -1,95 +1,172 @@
 #ifndef TETRIS_H // защита от повторного включения заголовка: если TETRIS_H не определён
 #define TETRIS_H // определяет макрос TETRIS_H чтобы предотвратить повторное включение
 
+#include <algorithm> // подключает std::rotate для перестановки строк поля
 #include <chrono> // подключает заголовок для работы со временем и таймерами
 #include <iostream> // подключает заголовок для ввода/вывода в потоках
+#include <random> // подключает генератор фигур и цветов сессии
 #include <stdbool.h> // подключает стандартный заголовок для типа bool в C-стиле
 #include <stdio.h> // подключает стандартный C-заголовок для ввода/вывода файлов и консоли
 #include <string.h> // подключает заголовок для работы со строками C (memcpy, memset и т.д.)
 #include <unistd.h> // подключает POSIX-заголовок для системных вызовов и функций (sleep, usleep и т.д.)
 
+#include "../board.h" // подключает политики размеров поля (StandardBoard, RuntimeBoard)
 #include "../brick_game_single.h" // подключает общий заголовок с базовыми типами и абстрактным классом Game
+#include "../engine.h" // подключает движок со статическим выбором состояния КА
+#include "../zobrist.h" // подключает ключи хэшей состояния
+#include "pieces.h" // подключает наборы фигур, посчитанные при компиляции
 
-#define BRICK_SIZE 8 // задаёт размер описания фигуры в массиве (количество строк/строчек в шаблоне)
+#define BRICK_SIZE 8 // размер описания фигуры стандартного набора: четыре пары Y,X
 
 namespace s21 { // начало пространства имён s21
 
+template <class Engine> class BasicPlacementFinder; // перебор положений фигуры (placement.h)
+
 /**
  * @brief Класс тетриса.
  *
- * Наследуется от абстрактного класса Game.
+ * Наследуется от абстрактного класса Game через движок Engine, который вызывает обработчики состояний напрямую.
  * Интерфейс представлен функцией get_instance(), которая дает доступ к единственному экземпляру класса.
+ * Размер поля задаётся политикой Board: для StandardBoard размеры — константы времени компиляции,
+ * для RuntimeBoard они выбираются при создании сессии через GameFabric::create_game.
+ * Набор фигур задаётся политикой Pieces: формы, координаты появления и повороты
+ * посчитаны при компиляции, код столкновений от набора не зависит.
  */
-class Tetris : public Game { // объявление класса Tetris, наследника Game
+template <class Board, class Pieces = StandardPieces> // политика размеров поля и набор фигур
+class TetrisGame final : public Engine<TetrisGame<Board, Pieces>> { // объявление класса TetrisGame, наследника Game через Engine
+  static_assert(Pieces::table.max_radius <= PIECE_MAX_RADIUS, "piece does not fit the rotation matrix"); // поворот в матрице 5x5
+  static_assert(Pieces::table.max_height <= NEXT_SIZE &&
+                    (WINDOW_WIDTH - Pieces::table.max_width) / 2 + Pieces::table.max_width <= NEXT_SIZE,
+                "piece does not fit the next window"); // координаты появления помещаются в матрицу gameinfo.next
+  static_assert(2 * Pieces::cells <= GHOST_SIZE, "ghost does not fit the API buffer"); // тень любой фигуры набора помещается в буфер getGhost
+
+  friend class Engine<TetrisGame>; // движок вызывает обработчики состояний
+  friend class BasicPlacementFinder<TetrisGame>; // перебор положений использует те же правила движения, что и игра
+  friend class GameFabric; // фабрика создаёт сессии с полем выбранного размера
+  friend class VersusMatch; // матч соперничества обменивается мусорными строками между полями
+  friend class LockstepMatch; // сетевой матч двух полей с откатом состояния
+
+ protected: // члены Game: база Engine зависит от параметров шаблона, поэтому они объявляются явно
+  using Game::action; // текущее действие игрока
+  using Game::flight; // журнал событий сессии
+  using Game::gameinfo; // поле и счёт
+  using Game::statemachine; // текущее состояние КА
+  using Game::GameStart; // состояния КА
+  using Game::Spawn; // состояние КА
+  using Game::Moving; // состояние КА
+  using Game::Shifting; // состояние КА
+  using Game::Attaching; // состояние КА
+  using Game::GameOver; // состояние КА
+  typedef Game::State_of_machine State_of_machine; // тип состояния КА
+
  private: // начало секции приватных членов класса
-  Tetris() = default; // приватный конструктор по умолчанию, предотвращает прямое создание извне
-  ~Tetris() {} // приватный деструктор по умолчанию
-  Tetris(const Tetris&) = delete; // удалённый копирующий конструктор, запрет копирования
-  Tetris& operator=(const Tetris&) = delete; // удалённый оператор присваивания, запрет копирования
-
-  void starting_game() override; // переопределённый метод начальной установки игры
-  void spawn() override; // переопределённый метод появления новой кирпичной фигуры
-  void moving() override; // переопределённый метод обработки движения фигуры
-  void shifting() override; // переопределённый метод сдвига / обновления состояния
-  void attaching() override; // переопределённый метод прикрепления фигуры к полю
-  void game_over() override; // переопределённый метод обработки завершения игры
+  explicit TetrisGame(const Board& layout = Board()); // приватный конструктор, предотвращает прямое создание извне
+  ~TetrisGame() {} // приватный деструктор по умолчанию
+  TetrisGame(const TetrisGame&) = delete; // удалённый копирующий конструктор, запрет копирования
+  TetrisGame& operator=(const TetrisGame&) = delete; // удалённый оператор присваивания, запрет копирования
+
+  void starting_game(); // обработчик GameStart для Engine::step: начальная установка игры
+  void spawn(); // обработчик Spawn: появление новой кирпичной фигуры
+  void moving(); // обработчик Moving: движение фигуры
+  void shifting(); // обработчик Shifting: сдвиг фигуры вниз по таймеру
+  void attaching(); // обработчик Attaching: прикрепление фигуры к полю
+  void game_over(); // обработчик GameOver: завершение игры
+  void hard_drop(); // мгновенный сброс фигуры на место приземления (действие Up)
+
+  void snapshot_header(SnapshotHeader* header) const override; // тип движка, набор фигур и размеры поля
+  size_t state_size() const override; // размер фигур, таймера, генератора и счётчиков в снимке
+  void save_state(SnapshotWriter& out) const override; // запись состояния тетриса
+  bool restore_state(SnapshotReader& in, State_of_machine state) override; // чтение и проверка состояния тетриса
+  static bool playing(State_of_machine state) { return state >= Spawn && state <= Attaching; } // фигуры нужны только в состояниях партии
 
  public: // начало секции публичных членов класса
-  static Tetris* get_instance() { // статический метод доступа к единственному экземпляру (синглтон)
-    static Tetris instance; // локальный статический экземпляр класса, обеспечивающий единственность
+  static TetrisGame* get_instance() { // статический метод доступа к единственному экземпляру (синглтон)
+    static TetrisGame instance; // локальный статический экземпляр класса, обеспечивающий единственность
     return &instance; // возвращает указатель на единственный экземпляр
   } // конец метода get_instance
+  bool ghost(int* cells) const override; // координаты тени (места приземления) текущей фигуры
+  int64_t next_deadline() const override; // микросекунд до падения фигуры по таймеру
+  uint64_t state_hash() const override; // хэш поля, области next и падающей фигуры за O(размер фигуры)
+  void use_clock(const int64_t* clock_us) override; // внешние часы таймера падения
 
  private: // приватная секция для внутренних структур и данных
-  typedef struct { // определение структуры содержащей шаблоны всех фигур тетриса
-    int Teewee[BRICK_SIZE]; // шаблон фигуры Teewee в массиве размером BRICK_SIZE
-    int Hero[BRICK_SIZE]; // шаблон фигуры Hero
-    int Smashboy[BRICK_SIZE]; // шаблон фигуры Smashboy
-    int Orange_Ricky[BRICK_SIZE]; // шаблон фигуры Orange Ricky
-    int Blue_Ricky[BRICK_SIZE]; // шаблон фигуры Blue Ricky
-    int Cleveland_Z[BRICK_SIZE]; // шаблон фигуры Cleveland Z
-    int Rhode_Island_Z[BRICK_SIZE]; // шаблон фигуры Rhode Island Z
-  } Bricks; // имя типа структуры — Bricks
+  static constexpr int brick_size = 2 * Pieces::cells; // размер описания фигуры набора (пары Y,X)
 
   int* current_brick; // указатель на массив/шаблон текущей фигуры
   int* next_brick; // указатель на массив/шаблон следующей фигуры
+  int bricks[2 * brick_size]; // место текущей и следующей фигур внутри сессии (без выделения памяти на партию)
 
   int current_color; // цвет/идентификатор цвета текущей фигуры
   int next_color; // цвет следующей фигуры
 
   Timer time; // объект таймера для отсчёта времени игры/скорости падения
+  int lines_cleared; // количество удалённых строк за партию
+  bool keep_record; // сохранять ли рекорд в файл (в матче соперничества — нет)
+  std::minstd_rand rng; // генератор фигур и цветов сессии (состояние — одно число, входит в снимок)
+  unsigned start_seed; // зерно генератора при старте партии (0 — продолжение последовательности srand)
+
+  Board board; // размеры поля
+  typename Board::Fills row_fill{}; // количество занятых ячеек в каждой строке игрового поля (без текущей фигуры)
+  typename Board::Heights column_height{}; // высота каждого столбца: высота поля минус верхняя занятая строка
+  uint64_t field_hash; // хэш Zobrist занятых клеток игрового поля, ведётся при каждом изменении клетки
+  uint64_t next_hash; // хэш Zobrist занятых клеток области next
 
  private: // приватная секция для вспомогательных методов
   int** init_matrix(int** matrix, int height, int width); // инициализация матрицы игрового поля
   void free_memory_matrix(int** matrix, int size); // освобождение памяти матрицы размером size
   void fill_array_zero(int** matrix, int height, int width); // заполнение матрицы нулями по заданным размерам
-  void stats_init(Tetris* tetris); // инициализация статистики для переданного экземпляра Tetris
-  int init_score(Tetris* tetris); // инициализация счёта и возвращение стартового значения
+  void stats_init(TetrisGame* tetris); // инициализация статистики для переданного экземпляра Tetris
+  int init_score(TetrisGame* tetris); // инициализация счёта и возвращение стартового значения
   int rotate_check_down_wall(int* brick); // проверка поворота относительно нижней границы
   int rotate_check_up_wall(int* brick); // проверка поворота относительно верхней границы
   int rotate_check_right_wall(int* brick); // проверка поворота относительно правой границы
   int rotate_check_left_wall(int* brick); // проверка поворота относительно левой границы
   int rotate_check_field(int** matrix, int* brick); // проверка поворота относительно занятых ячеек поля
   void new_brick(int* brick, int random); // наполнение массива brick шаблоном на основе случайного индекса
-  void brick_copy(int* src, int* other); // копирование данных одной фигуры в другую
-  void spawn_brick(int** matrix, int* array, int color); // размещение фигуры array на поле matrix с цветом color
-  void despawn(int** matrix, int* array); // удаление отображения фигуры array с поля matrix
+  int spawn_shift() const; // сдвиг фигур по X, центрирующий их на поле нестандартной ширины
+  void brick_copy(int* src, const int* other) const; // копирование данных одной фигуры в другую
+  void spawn_brick(int** matrix, int* array, int color, int hashed = ZOBRIST_NONE); // размещение фигуры array на поле matrix с цветом color, клетки учитываются в хэше hashed
+  void despawn(int** matrix, int* array, int hashed = ZOBRIST_NONE); // удаление отображения фигуры array с поля matrix и из хэша hashed
   void brick_move(int* brick, UserAction_t state, int** matrix); // обработка перемещения/действия над фигурой в зависимости от состояния игрока
   int check_right(int** matrix, int* brick, int shift); // проверка возможности сдвига фигуры вправо с учётом сдвига shift
   int check_left(int** matrix, int* brick, int shift); // проверка возможности сдвига фигуры влево с учётом сдвига shift
   int check_down(int** matrix, int* brick); // проверка возможности опускания фигуры вниз
-  int is_Smashboy(int* brick); // проверка, соответствует ли фигура шаблону Smashboy
+  int drop_distance(int** matrix, const int* brick, bool counted = false) const; // число строк, на которое фигура опустится при мгновенном сбросе (counted — по высотам столбцов поля игры)
   int check_gameover(int* brick); // проверка условия окончания игры для текущей фигуры
   int check_attaching(int* brick, int** matrix); // проверка необходимости прикрепления фигуры к полю
-  int is_Hero(int* brick); // проверка, соответствует ли фигура шаблону Hero
-  void coord_shift(int* brick, int cords, int shift); // сдвиг координат фигуры в массиве brick на значение shift по индексу cords
+  void coord_shift(int* brick, int cords, int shift) const; // сдвиг координат фигуры в массиве brick на значение shift по индексу cords
   void rotate(int** matrix, int* brick, int size); // выполнение поворота фигуры размером size с учётом матрицы поля
   void fix_brick_coord(int* brick); // корректировка координат фигуры после операций (поворот/сдвиг)
   int check_full_row(int** field); // проверка поля на заполненные строки и возвращение их количества
-  void score_write(Tetris* tetris, int full_rows_counter); // обновление счёта в зависимости от количества удалённых строк
-  void check_level(Tetris* tetris); // проверка и обновление уровня игры для указанного экземпляра
+  int remove_full_rows(int** field, int* fill, bool hashed); // удаление заполненных строк перестановкой указателей за один проход (hashed — с обновлением field_hash)
+  int clear_full_rows(); // удаление заполненных строк, которых касается текущая фигура, по счётчикам
+  void lock_brick(int* brick); // учёт блоков легшей фигуры в счётчиках строк и высотах столбцов
+  void counters_init(); // пересчёт счётчиков строк и высот столбцов по игровому полю
+  void hash_cell(int domain, int y, int x); // смена занятости клетки в хэше поля (ZOBRIST_FIELD) или области next (ZOBRIST_NEXT)
+  void hash_init(); // пересчёт хэшей поля и области next
+  bool add_garbage(int rows, int hole, int color); // мусорные строки снизу поля, false если поле переполнено
+  void score_write(TetrisGame* tetris, int full_rows_counter); // обновление счёта в зависимости от количества удалённых строк
+  void check_level(TetrisGame* tetris); // проверка и обновление уровня игры для указанного экземпляра
+
+}; // конец объявления класса TetrisGame
+
+static_assert(2 * StandardPieces::cells == BRICK_SIZE, "BRICK_SIZE describes the standard set"); // согласованность с API
+
+using Tetris = TetrisGame<StandardBoard>; // стандартный тетрис 20x10 с размерами поля времени компиляции
+using RuntimeTetris = TetrisGame<RuntimeBoard>; // тетрис с размерами поля, заданными при создании сессии
 
-}; // конец объявления класса Tetris
+extern template class Engine<TetrisGame<StandardBoard, StandardPieces>>; // движки собираются в tetris.cpp
+extern template class Engine<TetrisGame<RuntimeBoard, StandardPieces>>; // движки собираются в tetris.cpp
+extern template class Engine<TetrisGame<StandardBoard, PentominoPieces>>; // движки собираются в tetris.cpp
+extern template class Engine<TetrisGame<RuntimeBoard, PentominoPieces>>; // движки собираются в tetris.cpp
+extern template class Engine<TetrisGame<StandardBoard, TrainingPieces>>; // движки собираются в tetris.cpp
+extern template class Engine<TetrisGame<RuntimeBoard, TrainingPieces>>; // движки собираются в tetris.cpp
+extern template class TetrisGame<StandardBoard, StandardPieces>; // экземпляры шаблона собираются в tetris.cpp
+extern template class TetrisGame<RuntimeBoard, StandardPieces>; // экземпляры шаблона собираются в tetris.cpp
+extern template class TetrisGame<StandardBoard, PentominoPieces>; // экземпляры шаблона собираются в tetris.cpp
+extern template class TetrisGame<RuntimeBoard, PentominoPieces>; // экземпляры шаблона собираются в tetris.cpp
+extern template class TetrisGame<StandardBoard, TrainingPieces>; // экземпляры шаблона собираются в tetris.cpp
+extern template class TetrisGame<RuntimeBoard, TrainingPieces>; // экземпляры шаблона собираются в tetris.cpp
 
 }  // namespace s21 // конец пространства имён s21
 
@@ -0,0 +1,267 @@
+#include "versus.h" // подключает объявление классов GarbageInbox и VersusMatch
+
+#include <thread> // подключает std::thread для шагов полей в нескольких потоках
+
+namespace s21 { // начало пространства имён s21
+
+// ================= GarbageInbox ==================
+GarbageInbox::GarbageInbox() : enqueue_pos(0), dequeue_pos(0) { // конструктор пустой очереди
+  for (size_t i = 0; i < GARBAGE_QUEUE_SIZE; i++) { // проход по ячейкам
+    cells[i].sequence.store(i, std::memory_order_relaxed); // ячейка i готова к записи с номером i
+  } // конец цикла по ячейкам
+} // конец конструктора
+
+/**
+ * @brief Добавляет пакет в очередь.
+ *
+ * Писатель занимает номер записи сравнением с обменом и публикует пакет,
+ * сдвигая поколение ячейки; блокировок нет, ожидание — только повтор CAS.
+ */
+bool GarbageInbox::push(const GarbagePacket& packet) { // добавление пакета
+  bool res = false; // по умолчанию очередь заполнена
+  size_t pos = enqueue_pos.load(std::memory_order_relaxed); // номер записи
+  for (;;) { // попытки занять ячейку
+    Cell& cell = cells[pos & (GARBAGE_QUEUE_SIZE - 1)]; // ячейка для номера pos
+    size_t seq = cell.sequence.load(std::memory_order_acquire); // поколение ячейки
+    long diff = (long)seq - (long)pos; // 0 — ячейка свободна, < 0 — очередь заполнена
+    if (diff == 0) { // ячейка готова к записи
+      if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) { // номер занят
+        cell.packet = packet; // записываем пакет
+        cell.sequence.store(pos + 1, std::memory_order_release); // публикуем пакет для читателя
+        res = true; // пакет добавлен
+        break; // выходим из цикла попыток
+      } // конец попытки занять номер (при неудаче pos обновлён CAS)
+    } else if (diff < 0) { // читатель ещё не освободил ячейку
+      break; // очередь заполнена
+    } else { // другой писатель занял номер раньше
+      pos = enqueue_pos.load(std::memory_order_relaxed); // перечитываем номер записи
+    } // конец выбора по поколению
+  } // конец цикла попыток
+  return res; // признак добавления
+} // конец метода push
+
+bool GarbageInbox::pop(GarbagePacket* packet) { // извлечение пакета
+  bool res = false; // по умолчанию очередь пуста
+  size_t pos = dequeue_pos.load(std::memory_order_relaxed); // номер чтения
+  for (;;) { // попытки занять ячейку
+    Cell& cell = cells[pos & (GARBAGE_QUEUE_SIZE - 1)]; // ячейка для номера pos
+    size_t seq = cell.sequence.load(std::memory_order_acquire); // поколение ячейки
+    long diff = (long)seq - (long)(pos + 1); // 0 — пакет опубликован, < 0 — очередь пуста
+    if (diff == 0) { // пакет готов к чтению
+      if (dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) { // номер занят
+        *packet = cell.packet; // читаем пакет
+        cell.sequence.store(pos + GARBAGE_QUEUE_SIZE, std::memory_order_release); // ячейка свободна для следующего круга
+        res = true; // пакет извлечён
+        break; // выходим из цикла попыток
+      } // конец попытки занять номер
+    } else if (diff < 0) { // писатель ещё не опубликовал пакет
+      break; // очередь пуста
+    } else { // другой читатель занял номер раньше
+      pos = dequeue_pos.load(std::memory_order_relaxed); // перечитываем номер чтения
+    } // конец выбора по поколению
+  } // конец цикла попыток
+  return res; // признак извлечения
+} // конец метода pop
+
+// ================= VersusMatch ==================
+/**
+ * @brief Конструктор.
+ *
+ * Создаёт boards полей и запускает на каждом партию (GameStart -> Spawn). Генераторы мусора
+ * и фигур полей получают зёрна, выведенные из seed, поэтому матчи с одинаковым зерном
+ * получают одинаковые последовательности фигур, как и LockstepMatch.
+ * \throw std::invalid_argument Если полей меньше двух или больше VERSUS_MAX_BOARDS.
+ */
+VersusMatch::VersusMatch(int boards, Targeting targeting, unsigned seed)
+    : targeting(targeting), alive_count(boards) { // все поля в игре
+  if (boards < 2 || boards > VERSUS_MAX_BOARDS) { // некорректное количество полей
+    throw std::invalid_argument("Error: Unsupported number of boards"); // выбрасываем исключение о количестве полей
+  } // конец проверки количества полей
+  for (int i = 0; i < boards; i++) { // создание полей
+    board_list.emplace_back(new Board()); // состояние поля
+    Board& b = *board_list.back(); // созданное поле
+    b.game = new Tetris(); // отдельный движок
+    b.game->keep_record = false; // поля матча не пишут рекорд в файл
+    b.gen.seed(seed + i); // воспроизводимый генератор поля
+    b.game->start_seed = seed * VERSUS_MAX_BOARDS + i + 1; // зерно фигур поля (не 0 — иначе берётся rand)
+    b.next_target = (i + 1) % boards; // Cyclic начинает со следующего поля
+    b.game->set_user_action(Start); // старт партии
+    b.game->fsm(); // GameStart -> Spawn
+  } // конец создания полей
+} // конец конструктора
+
+VersusMatch::~VersusMatch() { // деструктор
+  for (auto& b : board_list) { // проход по полям
+    if (b->game->statemachine != Tetris::GameOver) { // фигуры поля ещё не освобождены
+      b->game->statemachine = Tetris::GameOver; // завершаем партию
+      b->game->fsm(); // GameOver: освобождение фигур
+    } // конец проверки состояния
+    delete b->game; // удаляем движок
+  } // конец прохода по полям
+} // конец деструктора
+
+void VersusMatch::set_input(int board, UserAction_t input) { board_list[board]->input = input; } // действие на следующий шаг
+
+/**
+ * @brief Один шаг КА поля.
+ *
+ * В состоянии Moving движку передаётся действие игрока (без действия — Down, поле падает
+ * каждый шаг без ожидания таймера). Вызывается из одного потока для каждого поля.
+ */
+bool VersusMatch::step(int board) { // шаг поля
+  Board& b = *board_list[board]; // поле
+  if (!b.place.load(std::memory_order_relaxed)) { // поле в игре
+    Tetris* game = b.game; // движок поля
+    if (game->statemachine == Tetris::Moving) { // фигура ждёт ввода
+      game->set_user_action(b.input); // действие игрока
+      b.input = Down; // следующий шаг по умолчанию — падение
+    } // конец передачи ввода
+    bool locking = (game->statemachine == Tetris::Attaching); // фигура прикрепляется
+    game->step(); // шаг КА без виртуального вызова: тип движка известен
+    if (locking && game->statemachine == Tetris::Spawn) on_lock(board); // прикрепление завершено
+    if (game->statemachine == Tetris::GameOver) eliminate(board); // поле выбыло
+  } // конец проверки поля
+  return !b.place.load(std::memory_order_relaxed); // признак того, что поле в игре
+} // конец метода step
+
+/**
+ * @brief Обработка прикрепления фигуры.
+ *
+ * Принимает пакеты из входящей очереди, гасит ожидающий мусор атакой, отправляет остаток
+ * и, если строки не удалялись, вставляет ожидающий мусор снизу поля.
+ */
+void VersusMatch::on_lock(int board) { // обработка прикрепления
+  Board& b = *board_list[board]; // поле
+  Tetris* game = b.game; // движок поля
+  int lines = game->lines_cleared - b.last_lines; // строки, удалённые этой фигурой
+  b.last_lines = game->lines_cleared; // запоминаем счётчик
+  GarbagePacket packet; // принимаемый пакет
+  while (b.inbox.pop(&packet)) b.pending.push_back(packet); // входящий мусор — в очередь ожидания
+  int attack = ATTACK_TABLE[lines > 4 ? 4 : lines]; // строки атаки
+  while (attack > 0 && !b.pending.empty()) { // гашение ожидающего мусора
+    int cancel = std::min(attack, b.pending.front().rows); // погашено строк
+    attack -= cancel; // остаток атаки
+    b.pending.front().rows -= cancel; // остаток пакета
+    if (!b.pending.front().rows) b.pending.pop_front(); // пакет погашен полностью
+  } // конец гашения
+  send(board, attack); // отправка остатка и повтор неотправленных атак
+  bool topped = false; // мусор вытолкнул блоки за верх поля
+  for (int budget = GARBAGE_INSERT_LIMIT; !lines && budget > 0 && !b.pending.empty();) { // вставка мусора
+    GarbagePacket& front = b.pending.front(); // старейший пакет
+    int rows = std::min(front.rows, budget); // строк за этот раз
+    if (!game->add_garbage(rows, front.hole, GARBAGE_COLOR)) topped = true; // поле переполнено
+    b.received += rows; // учитываем вставленные строки
+    budget -= rows; // остаток лимита
+    front.rows -= rows; // остаток пакета
+    if (!front.rows) b.pending.pop_front(); // пакет вставлен полностью
+  } // конец вставки мусора
+  int height = 0; // высота стопки
+  for (int x = 0; x < WINDOW_WIDTH; x++) height = std::max(height, game->column_height[x]); // самый высокий столбец
+  b.height.store(height, std::memory_order_relaxed); // публикуем высоту для политики Tallest
+  if (topped) game->statemachine = Tetris::GameOver; // поле выбывает
+} // конец метода on_lock
+
+void VersusMatch::send(int board, int rows) { // отправка атаки
+  Board& b = *board_list[board]; // поле-отправитель
+  if (rows > 0) { // есть что отправить
+    std::uniform_int_distribution<int> hole(0, WINDOW_WIDTH - 1); // столбец дырки
+    b.outbox.push_back(GarbagePacket{rows, hole(b.gen), board}); // новая атака в конец очереди отправки
+  } // конец формирования атаки
+  size_t kept = 0; // атаки, оставшиеся неотправленными
+  for (size_t i = 0; i < b.outbox.size(); i++) { // проход по атакам
+    int target = choose_target(board); // цель
+    if (target >= 0 && !board_list[target]->inbox.push(b.outbox[i])) { // очередь цели заполнена
+      b.outbox[kept++] = b.outbox[i]; // повторим при следующем прикреплении
+    } else if (target >= 0) { // атака отправлена
+      b.sent += b.outbox[i].rows; // учитываем отправленные строки
+    } // конец проверки отправки (без цели атака пропадает)
+  } // конец прохода по атакам
+  b.outbox.resize(kept); // оставляем только неотправленные
+} // конец метода send
+
+/**
+ * @brief Выбор цели по политике.
+ *
+ * @return номер поля в игре, отличного от board, или -1, если соперников не осталось
+ */
+int VersusMatch::choose_target(int board) { // выбор цели
+  Board& b = *board_list[board]; // поле-отправитель
+  int count = boards(); // количество полей
+  int res = -1; // по умолчанию цели нет
+  if (targeting == Targeting::Random) { // случайная цель
+    int start = std::uniform_int_distribution<int>(0, count - 1)(b.gen); // случайное начало обхода
+    for (int k = 0; k < count && res < 0; k++) { // первое поле в игре от случайного начала
+      int i = (start + k) % count; // номер поля
+      if (i != board && !board_list[i]->place.load(std::memory_order_relaxed)) res = i; // соперник в игре
+    } // конец обхода
+  } else if (targeting == Targeting::Cyclic) { // цели по кругу
+    for (int k = 0; k < count && res < 0; k++) { // первое поле в игре от следующей цели
+      int i = (b.next_target + k) % count; // номер поля
+      if (i != board && !board_list[i]->place.load(std::memory_order_relaxed)) res = i; // соперник в игре
+    } // конец обхода
+    if (res >= 0) b.next_target = (res + 1) % count; // следующая атака — следующему полю
+  } else { // самое высокое поле
+    int best = -1; // наибольшая высота
+    for (int i = 0; i < count; i++) { // проход по полям
+      int height = board_list[i]->height.load(std::memory_order_relaxed); // высота стопки
+      if (i != board && !board_list[i]->place.load(std::memory_order_relaxed) && height > best) { // выше прежних
+        best = height; // новая наибольшая высота
+        res = i; // новая цель
+      } // конец проверки поля
+    } // конец прохода по полям
+  } // конец выбора по политике
+  return res; // номер цели
+} // конец метода choose_target
+
+void VersusMatch::eliminate(int board) { // выбывание поля
+  Board& b = *board_list[board]; // поле
+  b.place.store(alive_count.fetch_sub(1), std::memory_order_relaxed); // место — число полей, остававшихся в игре
+  b.game->fsm(); // GameOver: освобождение фигур
+} // конец метода eliminate
+
+void VersusMatch::random_input(int board) { // случайное действие
+  static const UserAction_t moves[] = {Left, Right, Action, Down, Down, Up}; // действия со смещением к падению
+  Board& b = *board_list[board]; // поле
+  b.input = moves[std::uniform_int_distribution<int>(0, 5)(b.gen)]; // случайное действие
+} // конец метода random_input
+
+/**
+ * @brief Матч без фронтенда.
+ *
+ * Поля делятся между threads потоками (поле i шагает в потоке i % threads), на каждом
+ * шаге поле получает случайное действие. Матч идёт, пока в игре больше одного поля,
+ * но не дольше max_ticks шагов каждого поля.
+ */
+void VersusMatch::run(int threads, long max_ticks) { // матч без фронтенда
+  auto worker = [this, threads, max_ticks](int first) { // шаги полей одного потока
+    for (long tick = 0; tick < max_ticks && alive() > 1; tick++) { // шаги матча
+      for (int i = first; i < boards(); i += threads) { // поля потока
+        random_input(i); // случайное действие
+        step(i); // шаг поля
+      } // конец прохода по полям
+    } // конец шагов
+  }; // конец описания потока
+  threads = std::max(1, std::min(threads, boards())); // от одного потока до потока на поле
+  std::vector<std::thread> pool; // дополнительные потоки
+  for (int k = 1; k < threads; k++) pool.emplace_back(worker, k); // запуск потоков
+  worker(0); // первая группа полей — в вызывающем потоке
+  for (auto& thread : pool) thread.join(); // ожидание потоков
+} // конец метода run
+
+int VersusMatch::boards() const { return (int)board_list.size(); } // количество полей
+int VersusMatch::alive() const { return alive_count.load(std::memory_order_relaxed); } // количество полей в игре
+int VersusMatch::place(int board) const { return board_list[board]->place.load(std::memory_order_relaxed); } // место
+int VersusMatch::lines_sent(int board) const { return board_list[board]->sent; } // отправлено строк
+int VersusMatch::lines_received(int board) const { return board_list[board]->received; } // вставлено строк
+const GameInfo_t& VersusMatch::board_info(int board) const { return board_list[board]->game->get_gameinfo(); } // поле
+
+int VersusMatch::winner() const { // победитель
+  int res = -1; // по умолчанию матч не окончен
+  for (int i = 0; i < boards(); i++) { // проход по полям
+    if (alive() == 1 && !place(i)) res = i; // единственное поле в игре
+    if (alive() == 0 && place(i) == 1) res = i; // последние поля выбыли одновременно в разных потоках — побеждает выбывшее последним
+  } // конец прохода по полям
+  return res; // номер победителя
+} // конец метода winner
+
+}  // namespace s21 // конец пространства имён s21
@@ -0,0 +1,122 @@
+#ifndef VERSUS_H // защита от повторного включения заголовка: если VERSUS_H не определён
+#define VERSUS_H // определяет макрос VERSUS_H чтобы предотвратить повторное включение
+
+#include <stddef.h> // подключает size_t для номеров ячеек очереди
+
+#include <atomic> // подключает атомарные переменные для обмена между потоками без блокировок
+#include <deque> // подключает std::deque для очереди мусора, ожидающего вставки
+#include <memory> // подключает std::unique_ptr для полей матча
+#include <random> // подключает генератор случайных чисел для дырок и выбора цели
+#include <vector> // подключает std::vector для списка полей
+
+#include "tetris.h" // подключает класс Tetris, поля которого соревнуются в матче
+
+#define VERSUS_MAX_BOARDS 128 // наибольшее число полей в матче
+#define GARBAGE_QUEUE_SIZE 64 // ёмкость входящей очереди поля (степень двойки)
+#define GARBAGE_INSERT_LIMIT 8 // наибольшее число мусорных строк, вставляемых за одно прикрепление
+#define GARBAGE_COLOR 7 // цвет мусорных строк
+
+namespace s21 { // начало пространства имён s21
+
+inline constexpr int ATTACK_TABLE[] = {0, 0, 1, 2, 4}; // строки атаки за 0, 1, 2, 3 и 4 удалённые строки
+
+/**
+ * @brief Пакет мусорных строк, отправленный одним полем другому.
+ */
+typedef struct { // описание атаки
+  int rows; // количество мусорных строк
+  int hole; // столбец дырки во всех строках пакета
+  int sender; // номер поля-отправителя
+} GarbagePacket; // имя типа — GarbagePacket
+
+/**
+ * @brief Входящая очередь мусора поля.
+ *
+ * Ограниченная очередь без блокировок (кольцевой буфер с номером поколения в каждой ячейке):
+ * в неё одновременно пишут поля, шагающие в разных потоках, а читает поле-получатель.
+ * Память выделена внутри объекта, push при заполненной очереди возвращает false.
+ */
+class GarbageInbox { // объявление входящей очереди
+ public: // публичная секция класса
+  GarbageInbox(); // конструктор: пустая очередь
+  GarbageInbox(const GarbageInbox&) = delete; // удалённый копирующий конструктор, запрет копирования
+  GarbageInbox& operator=(const GarbageInbox&) = delete; // удалённый оператор присваивания, запрет копирования
+
+  bool push(const GarbagePacket& packet); // добавление пакета из любого потока, false если очередь заполнена
+  bool pop(GarbagePacket* packet); // извлечение пакета, false если очередь пуста
+
+ private: // приватная секция для внутренних структур и данных
+  struct Cell { // ячейка очереди
+    std::atomic<size_t> sequence; // поколение ячейки: готова к записи (pos) или к чтению (pos + 1)
+    GarbagePacket packet; // данные пакета
+  }; // конец объявления Cell
+
+  Cell cells[GARBAGE_QUEUE_SIZE]; // кольцевой буфер
+  alignas(64) std::atomic<size_t> enqueue_pos; // номер следующей записи (отдельная строка кэша)
+  alignas(64) std::atomic<size_t> dequeue_pos; // номер следующего чтения (отдельная строка кэша)
+}; // конец объявления класса GarbageInbox
+
+/**
+ * @brief Матч соперничества нескольких полей тетриса в одном процессе.
+ *
+ * Каждое поле — отдельный экземпляр Tetris без записи рекорда. После прикрепления фигуры
+ * удалённые строки превращаются в атаку (2 строки — 1, 3 — 2, 4 — 4), которая сначала гасит
+ * ожидающий мусор поля, а остаток отправляется сопернику, выбранному политикой Targeting.
+ * Если фигура не удалила ни одной строки, ожидающий мусор вставляется снизу поля
+ * (не больше GARBAGE_INSERT_LIMIT строк за раз). Поле выбывает, когда срабатывает
+ * check_gameover или мусор выталкивает блоки за верх поля; место выбывшего — число полей,
+ * остававшихся в игре. Поля связаны только очередями GarbageInbox и атомарными
+ * переменными, поэтому разные поля можно шагать в разных потоках (run).
+ */
+class VersusMatch { // объявление матча соперничества
+ public: // публичная секция класса
+  enum class Targeting { Random = 0, Cyclic, Tallest }; // политика выбора цели: случайная, по кругу, самое высокое поле
+
+  explicit VersusMatch(int boards, Targeting targeting = Targeting::Random, unsigned seed = 0); // матч на boards полей
+  ~VersusMatch(); // деструктор: удаляет поля
+  VersusMatch(const VersusMatch&) = delete; // удалённый копирующий конструктор, запрет копирования
+  VersusMatch& operator=(const VersusMatch&) = delete; // удалённый оператор присваивания, запрет копирования
+
+  void set_input(int board, UserAction_t input); // действие игрока для следующего шага поля
+  bool step(int board); // один шаг КА поля, false если поле выбыло
+  void run(int threads, long max_ticks); // шаги всех полей без фронтенда со случайным вводом до одного оставшегося
+
+  int boards() const; // количество полей
+  int alive() const; // количество полей в игре
+  int place(int board) const; // место выбывшего поля (0 — ещё в игре)
+  int winner() const; // номер победителя или -1, если матч не окончен
+  int lines_sent(int board) const; // строк мусора, отправленных полем
+  int lines_received(int board) const; // строк мусора, вставленных в поле
+  const GameInfo_t& board_info(int board) const; // состояние поля для отображения
+
+ private: // приватная секция для внутренних структур и данных
+  struct Board { // состояние одного поля матча
+    Tetris* game = nullptr; // движок поля
+    GarbageInbox inbox; // входящий мусор от соперников
+    std::deque<GarbagePacket> pending; // принятый, но ещё не вставленный мусор
+    std::vector<GarbagePacket> outbox; // атаки, не поместившиеся в очередь цели
+    std::mt19937 gen; // генератор дырок, целей и случайного ввода
+    UserAction_t input = Down; // действие для следующего шага (по умолчанию — падение)
+    int last_lines = 0; // удалённые строки на момент прошлого прикрепления
+    int next_target = 0; // следующая цель политики Cyclic
+    int sent = 0; // отправлено строк
+    int received = 0; // вставлено строк
+    std::atomic<int> height{0}; // высота стопки, публикуемая для политики Tallest
+    std::atomic<int> place{0}; // место выбывшего поля, 0 — в игре
+  }; // конец объявления Board
+
+  std::vector<std::unique_ptr<Board>> board_list; // поля матча
+  Targeting targeting; // политика выбора цели
+  std::atomic<int> alive_count; // количество полей в игре
+
+ private: // приватная секция для вспомогательных методов
+  void on_lock(int board); // обработка прикрепления фигуры: атака, гашение и вставка мусора
+  void send(int board, int rows); // отправка атаки цели
+  int choose_target(int board); // выбор цели по политике
+  void eliminate(int board); // выбывание поля
+  void random_input(int board); // случайное действие для run
+}; // конец объявления класса VersusMatch
+
+}  // namespace s21 // конец пространства имён s21
+
+#endif  // VERSUS_H // конец защиты от повторного включения заголовка
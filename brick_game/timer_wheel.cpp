@@ -0,0 +1,217 @@
+#include "timer_wheel.h" // подключает объявление колеса таймеров
+
+namespace s21 { // начало пространства имён s21
+
+TimerWheel::TimerWheel(uint64_t now_us, uint64_t tick_us)
+    : tick_us(tick_us ? tick_us : 1), origin_us(now_us), now_tick(0), free_list(WHEEL_NONE), scheduled(0) { // пустое колесо
+  for (uint32_t& head : heads) head = WHEEL_NONE; // все слоты пусты
+  for (size_t& count : level_count) count = 0; // все уровни пусты
+} // конец конструктора
+
+uint32_t TimerWheel::create(uint32_t tag) { // новый таймер
+  uint32_t timer = free_list; // свободный номер
+  if (timer == WHEEL_NONE) { // свободных нет
+    timer = (uint32_t)nodes.size(); // номер в конце
+    nodes.push_back(Node()); // новый узел
+  } else { // номер переиспользуется
+    free_list = nodes[timer].next; // следующий свободный
+  } // конец выбора номера
+  Node& node = nodes[timer]; // узел таймера
+  node.deadline = 0; // срока нет
+  node.prev = node.next = WHEEL_NONE; // вне слотов
+  node.tag = tag; // значение хозяина
+  node.slot = 0; // слота нет
+  node.where = IDLE; // без срока
+  return timer; // номер таймера
+} // конец метода create
+
+void TimerWheel::release(uint32_t timer) { // удаление таймера
+  cancel(timer); // срок снимается
+  nodes[timer].where = FREE; // узел свободен
+  nodes[timer].next = free_list; // в начало свободного списка
+  free_list = timer; // номер переиспользуется
+} // конец метода release
+
+/**
+ * @brief Задаёт срок таймера.
+ *
+ * Срок округляется вверх до тика, поэтому таймер не срабатывает раньше deadline_us.
+ */
+void TimerWheel::schedule(uint32_t timer, uint64_t deadline_us) { // срок таймера
+  cancel(timer); // прежний срок снимается
+  Node& node = nodes[timer]; // узел таймера
+  node.deadline = deadline_us > origin_us ? (deadline_us - origin_us + tick_us - 1) / tick_us : 0; // срок в тиках
+  scheduled++; // таймеров со сроком стало больше
+  link(timer); // в слот или сразу в очередь готовых
+} // конец метода schedule
+
+void TimerWheel::cancel(uint32_t timer) { // снятие срока
+  Node& node = nodes[timer]; // узел таймера
+  if (node.where == WHEEL) unlink(timer); // удаление из слота
+  if (node.where == READY) heap_remove(node.slot); // удаление из очереди готовых
+  if (node.where == WHEEL || node.where == READY) scheduled--; // таймеров со сроком стало меньше
+  if (node.where != FREE) node.where = IDLE; // срока нет
+} // конец метода cancel
+
+bool TimerWheel::pending(uint32_t timer) const { // есть ли срок
+  return nodes[timer].where == WHEEL || nodes[timer].where == READY; // в колесе или в очереди готовых
+} // конец метода pending
+
+/**
+ * @brief Вставляет таймер в слот по сроку.
+ *
+ * Уровень — младший, на котором номер блока срока отличается от номера блока текущего
+ * тика меньше чем на WHEEL_SLOTS: тогда слот срока не совпадает с текущим и будет
+ * разложен по младшим уровням ровно в начале своего блока. Срок дальше старшего уровня
+ * ставится в его последний слот и переставляется при раскладке.
+ */
+void TimerWheel::link(uint32_t timer) { // вставка в слот
+  Node& node = nodes[timer]; // узел таймера
+  if (node.deadline <= now_tick) { // срок уже прошёл
+    heap_push(timer); // сразу в очередь готовых
+    return; // в колесо не попадает
+  } // конец проверки срока
+  int level = 0; // уровень колеса
+  while (level < WHEEL_LEVELS - 1 && (node.deadline >> (WHEEL_BITS * level)) - (now_tick >> (WHEEL_BITS * level)) >= WHEEL_SLOTS)
+    level++; // срок дальше, чем охватывает уровень
+  uint64_t block = node.deadline >> (WHEEL_BITS * level); // номер блока срока
+  uint64_t current = now_tick >> (WHEEL_BITS * level); // номер блока текущего тика
+  if (block - current >= WHEEL_SLOTS) block = current + WHEEL_SLOTS - 1; // срок дальше колеса — последний слот
+  uint32_t slot = level * WHEEL_SLOTS + (uint32_t)(block & (WHEEL_SLOTS - 1)); // слот уровня
+  node.slot = slot; // слот узла
+  node.where = WHEEL; // таймер в колесе
+  level_count[level]++; // таймеров на уровне стало больше
+  node.prev = WHEEL_NONE; // узел становится первым в слоте
+  node.next = heads[slot]; // прежний первый узел
+  if (node.next != WHEEL_NONE) nodes[node.next].prev = timer; // обратная ссылка
+  heads[slot] = timer; // новый первый узел
+} // конец метода link
+
+void TimerWheel::unlink(uint32_t timer) { // удаление из слота
+  Node& node = nodes[timer]; // узел таймера
+  if (node.prev != WHEEL_NONE) nodes[node.prev].next = node.next; // предыдущий ссылается на следующий
+  else heads[node.slot] = node.next; // узел был первым в слоте
+  if (node.next != WHEEL_NONE) nodes[node.next].prev = node.prev; // следующий ссылается на предыдущий
+  node.prev = node.next = WHEEL_NONE; // узел вне слотов
+  level_count[node.slot / WHEEL_SLOTS]--; // таймеров на уровне стало меньше
+} // конец метода unlink
+
+void TimerWheel::cascade(int level) { // раскладка слота уровня level
+  uint32_t slot = level * WHEEL_SLOTS + (uint32_t)((now_tick >> (WHEEL_BITS * level)) & (WHEEL_SLOTS - 1)); // текущий слот уровня
+  uint32_t timer = heads[slot]; // первый узел слота
+  heads[slot] = WHEEL_NONE; // слот пуст
+  while (timer != WHEEL_NONE) { // все узлы слота
+    uint32_t next = nodes[timer].next; // следующий узел до перестановки
+    level_count[level]--; // таймер уходит с уровня
+    link(timer); // срок ближе — младший уровень или очередь готовых
+    timer = next; // следующий узел
+  } // конец обхода слота
+} // конец метода cascade
+
+void TimerWheel::expire_slot(uint32_t slot) { // срабатывание слота уровня 0
+  uint32_t timer = heads[slot]; // первый узел слота
+  heads[slot] = WHEEL_NONE; // слот пуст
+  while (timer != WHEEL_NONE) { // все узлы слота
+    uint32_t next = nodes[timer].next; // следующий узел до переноса
+    level_count[0]--; // таймер уходит с уровня 0
+    heap_push(timer); // в очередь готовых
+    timer = next; // следующий узел
+  } // конец обхода слота
+} // конец метода expire_slot
+
+/**
+ * @brief Проходит колесо до тика now_us.
+ *
+ * Обходит по одному слоту уровня 0 на тик и раскладывает старшие уровни на границах
+ * их блоков. Тики, на которых ничего не происходит (младшие уровни пусты), пропускаются
+ * до ближайшей границы блока непустого уровня; пустое колесо переводится сразу.
+ */
+size_t TimerWheel::advance(uint64_t now_us) { // проход колеса
+  uint64_t target = now_us > origin_us ? (now_us - origin_us) / tick_us : 0; // тик now_us
+  while (now_tick < target) { // тики до now_us
+    int lowest = 0; // младший непустой уровень
+    while (lowest < WHEEL_LEVELS && level_count[lowest] == 0) lowest++; // пустые уровни
+    if (lowest == WHEEL_LEVELS) { // колесо пусто
+      now_tick = target; // время переводится сразу
+      break; // обходить нечего
+    } // конец проверки пустого колеса
+    if (lowest > 0) { // до границы блока уровня lowest тики пустые
+      uint64_t block = 1ULL << (WHEEL_BITS * lowest); // длина блока уровня в тиках
+      uint64_t skip = (now_tick | (block - 1)); // последний тик перед границей
+      now_tick = skip < target ? skip : target; // пропуск пустых тиков
+      if (now_tick == target) break; // граница дальше now_us
+    } // конец пропуска
+    now_tick++; // следующий тик
+    int top = 0; // старший уровень, блок которого начинается на этом тике
+    while (top < WHEEL_LEVELS - 1 && (now_tick & ((1ULL << (WHEEL_BITS * (top + 1))) - 1)) == 0) top++; // границы блоков
+    for (int level = top; level > 0; level--) cascade(level); // старшие уровни раскладываются первыми
+    expire_slot((uint32_t)(now_tick & (WHEEL_SLOTS - 1))); // сроки этого тика
+  } // конец прохода по тикам
+  return heap.size(); // готовых таймеров
+} // конец метода advance
+
+bool TimerWheel::pop(uint32_t* tag, uint64_t* deadline_us) { // самый ранний готовый таймер
+  if (heap.empty()) return false; // готовых нет
+  uint32_t timer = heap[0]; // вершина очереди
+  heap_remove(0); // удаление вершины
+  nodes[timer].where = IDLE; // срок снят
+  scheduled--; // таймеров со сроком стало меньше
+  *tag = nodes[timer].tag; // значение хозяина
+  if (deadline_us) *deadline_us = origin_us + nodes[timer].deadline * tick_us; // срок в микросекундах
+  return true; // таймер выдан
+} // конец метода pop
+
+size_t TimerWheel::ready() const { return heap.size(); } // готовых таймеров
+
+size_t TimerWheel::size() const { return scheduled; } // таймеров со сроком
+
+bool TimerWheel::heap_less(uint32_t a, uint32_t b) const { // порядок очереди готовых
+  return nodes[a].deadline != nodes[b].deadline ? nodes[a].deadline < nodes[b].deadline : a < b; // срок, затем номер
+} // конец метода heap_less
+
+void TimerWheel::heap_set(uint32_t pos, uint32_t timer) { // запись в позицию очереди
+  heap[pos] = timer; // таймер в позиции
+  nodes[timer].slot = pos; // позиция узла
+} // конец метода heap_set
+
+void TimerWheel::heap_push(uint32_t timer) { // вставка в очередь готовых
+  nodes[timer].where = READY; // таймер готов
+  heap.push_back(timer); // в конец кучи
+  heap_set((uint32_t)heap.size() - 1, timer); // позиция узла
+  heap_up((uint32_t)heap.size() - 1); // просеивание вверх
+} // конец метода heap_push
+
+void TimerWheel::heap_remove(uint32_t pos) { // удаление из очереди готовых
+  uint32_t last = heap.back(); // последний элемент кучи
+  heap.pop_back(); // куча короче
+  if (pos < heap.size()) { // удалялся не последний
+    heap_set(pos, last); // последний на место удалённого
+    heap_up(pos); // восстановление порядка вверх
+    heap_down(nodes[last].slot); // или вниз
+  } // конец проверки позиции
+} // конец метода heap_remove
+
+void TimerWheel::heap_up(uint32_t pos) { // просеивание вверх
+  uint32_t timer = heap[pos]; // поднимаемый таймер
+  while (pos > 0 && heap_less(timer, heap[(pos - 1) / 2])) { // родитель позже
+    heap_set(pos, heap[(pos - 1) / 2]); // родитель вниз
+    pos = (pos - 1) / 2; // позиция родителя
+  } // конец подъёма
+  heap_set(pos, timer); // таймер на место
+} // конец метода heap_up
+
+void TimerWheel::heap_down(uint32_t pos) { // просеивание вниз
+  uint32_t timer = heap[pos]; // опускаемый таймер
+  uint32_t size = (uint32_t)heap.size(); // размер кучи
+  for (;;) { // до листа
+    uint32_t child = 2 * pos + 1; // левый потомок
+    if (child >= size) break; // потомков нет
+    if (child + 1 < size && heap_less(heap[child + 1], heap[child])) child++; // ранний из потомков
+    if (!heap_less(heap[child], timer)) break; // порядок восстановлен
+    heap_set(pos, heap[child]); // потомок вверх
+    pos = child; // позиция потомка
+  } // конец спуска
+  heap_set(pos, timer); // таймер на место
+} // конец метода heap_down
+
+}  // namespace s21 // конец пространства имён s21
@@ -0,0 +1,79 @@
+#ifndef TIMER_WHEEL_H // защита от повторного включения заголовка: если TIMER_WHEEL_H не определён
+#define TIMER_WHEEL_H // определяет макрос TIMER_WHEEL_H чтобы предотвратить повторное включение
+
+#include <stddef.h> // подключает size_t для количества таймеров
+#include <stdint.h> // подключает целые типы фиксированной ширины
+
+#include <vector> // подключает std::vector для слотов, узлов и очереди готовых таймеров
+
+#define WHEEL_BITS 6 // бит номера слота одного уровня
+#define WHEEL_SLOTS (1 << WHEEL_BITS) // слотов на уровне
+#define WHEEL_LEVELS 4 // уровней колеса: 64 тика, 4096, 262144 и 16777216 тиков
+#define WHEEL_NONE 0xFFFFFFFFu // нет узла (конец списка слота)
+
+namespace s21 { // начало пространства имён s21
+
+/**
+ * @brief Иерархическое колесо таймеров для сроков шагов многих сессий.
+ *
+ * Срок хранится в слоте уровня по его расстоянию от текущего тика: уровень 0 — ближайшие
+ * WHEEL_SLOTS тиков, каждый следующий в WHEEL_SLOTS раз грубее. Когда младший уровень
+ * проходит полный оборот, слот старшего уровня раскладывается по младшим, поэтому
+ * вставка, отмена и срабатывание стоят O(1), а advance обходит только слоты прошедших
+ * тиков. Сработавшие таймеры попадают в очередь готовых, откуда pop выдаёт их
+ * по возрастанию срока: если хозяин не успевает обслужить все, первыми идут самые
+ * просроченные, а остальные ждут следующего вызова. Таймер — номер из create, у каждого
+ * не больше одного срока: повторный schedule переносит его.
+ */
+class TimerWheel { // объявление колеса таймеров
+ public: // публичная секция класса
+  explicit TimerWheel(uint64_t now_us, uint64_t tick_us = 1000); // колесо с тиком tick_us, текущее время now_us
+
+  uint32_t create(uint32_t tag); // новый таймер без срока, tag возвращается из pop
+  void release(uint32_t timer); // удаление таймера (номер переиспользуется)
+  void schedule(uint32_t timer, uint64_t deadline_us); // срок таймера (прошедший — срабатывает при ближайшем advance)
+  void cancel(uint32_t timer); // снятие срока
+  bool pending(uint32_t timer) const; // у таймера есть срок или он ждёт в очереди готовых
+
+  size_t advance(uint64_t now_us); // проход колеса до now_us, возвращает число готовых таймеров
+  bool pop(uint32_t* tag, uint64_t* deadline_us = nullptr); // самый ранний готовый таймер, false если готовых нет
+  size_t ready() const; // готовых таймеров
+  size_t size() const; // таймеров со сроком (в колесе и в очереди готовых)
+
+ private: // приватная секция для внутренних структур и данных
+  enum Where : uint8_t { IDLE = 0, WHEEL, READY, FREE }; // где находится таймер
+
+  struct Node { // таймер
+    uint64_t deadline; // срок в тиках
+    uint32_t prev; // предыдущий узел слота
+    uint32_t next; // следующий узел слота (или свободного списка)
+    uint32_t tag; // значение хозяина
+    uint32_t slot; // слот колеса (уровень * WHEEL_SLOTS + номер) или позиция в очереди готовых
+    Where where; // колесо, очередь готовых, без срока или свободен
+  }; // конец объявления Node
+
+  void link(uint32_t timer); // вставка в слот по сроку
+  void unlink(uint32_t timer); // удаление из слота
+  void cascade(int level); // раскладка текущего слота уровня level по младшим уровням
+  void expire_slot(uint32_t slot); // перенос всех таймеров слота уровня 0 в очередь готовых
+  void heap_push(uint32_t timer); // вставка в очередь готовых
+  void heap_remove(uint32_t pos); // удаление из очереди готовых по позиции
+  void heap_up(uint32_t pos); // просеивание вверх
+  void heap_down(uint32_t pos); // просеивание вниз
+  bool heap_less(uint32_t a, uint32_t b) const; // порядок очереди: срок, затем номер таймера
+  void heap_set(uint32_t pos, uint32_t timer); // запись таймера в позицию очереди
+
+  uint64_t tick_us; // длительность тика
+  uint64_t origin_us; // время нулевого тика
+  uint64_t now_tick; // текущий тик (все сроки до него включительно обработаны)
+  std::vector<Node> nodes; // таймеры по номерам
+  uint32_t free_list; // первый свободный номер
+  uint32_t heads[WHEEL_LEVELS * WHEEL_SLOTS]; // первые узлы слотов
+  size_t level_count[WHEEL_LEVELS]; // таймеров на каждом уровне
+  std::vector<uint32_t> heap; // очередь готовых (двоичная куча по сроку)
+  size_t scheduled; // таймеров со сроком
+}; // конец объявления класса TimerWheel
+
+}  // namespace s21 // конец пространства имён s21
+
+#endif  // TIMER_WHEEL_H // конец защиты от повторного включения заголовка
@@ -0,0 +1,203 @@
+#include "trace.h" // подключает объявление интервалов и C API трассировки
+
+#include <stdio.h> // подключает FILE и fprintf для записи JSON
+#include <unistd.h> // подключает getpid для поля pid событий
+
+#include <chrono> // подключает steady_clock для меток времени
+#include <condition_variable> // подключает ожидание фонового потока записи
+#include <mutex> // подключает std::mutex для списка буферов
+#include <thread> // подключает фоновый поток записи
+#include <vector> // подключает std::vector для списка буферов потоков
+
+namespace s21 { // начало пространства имён s21
+
+std::atomic<bool> trace_enabled{false}; // трассировка выключена до traceStart
+
+typedef struct { // событие-интервал
+  const char* name; // имя интервала (строковый литерал)
+  uint64_t begin_ns; // начало
+  uint64_t end_ns; // конец
+} TraceEvent; // имя типа — TraceEvent
+
+/**
+ * @brief Кольцевой буфер событий одного потока.
+ *
+ * Один писатель (поток-владелец) и один читатель (поток записи): писатель публикует
+ * событие сдвигом head, читатель освобождает место сдвигом tail. При заполненном буфере
+ * событие отбрасывается и учитывается в dropped — поток игры никогда не ждёт диск.
+ */
+struct TraceRing { // буфер потока
+  TraceEvent events[TRACE_RING_SIZE]; // события, выделены один раз
+  std::atomic<uint64_t> head{0}; // номер следующего записываемого события
+  std::atomic<uint64_t> tail{0}; // номер следующего читаемого события
+  std::atomic<uint64_t> dropped{0}; // отброшенных событий
+  uint32_t tid = 0; // номер потока в трассе
+  bool retired = false; // поток завершился, буфер удаляется после записи
+}; // конец объявления TraceRing
+
+struct TraceWriter { // общий список буферов и поток записи
+  std::mutex lock; // защищает список, файл и флаги
+  std::condition_variable wake; // пробуждение потока записи при остановке
+  std::vector<TraceRing*> rings; // буферы потоков
+  std::thread flusher; // фоновый поток записи
+  FILE* file = nullptr; // файл трассы
+  bool running = false; // запись идёт
+  bool stop = false; // поток записи должен завершиться
+  bool first = true; // в файле ещё нет событий (без запятой)
+  uint32_t next_tid = 1; // номер следующего потока
+  uint64_t origin_ns = 0; // время начала трассы
+  uint64_t retired_dropped = 0; // отброшенные события завершившихся потоков
+}; // конец объявления TraceWriter
+
+static TraceWriter& writer() { // общий список (не разрушается: потоки могут завершаться после main)
+  static TraceWriter* instance = new TraceWriter(); // создаётся при первом обращении
+  return *instance; // список
+} // конец функции writer
+
+/**
+ * @brief Владелец буфера потока.
+ *
+ * Буфер выделяется при первом событии потока; при завершении потока он помечается
+ * завершившимся и удаляется потоком записи после того, как его события записаны.
+ */
+class RingHandle { // буфер текущего потока
+ public: // публичная секция класса
+  RingHandle() : ring(new TraceRing()) { // буфер нового потока
+    TraceWriter& all = writer(); // общий список
+    std::lock_guard<std::mutex> guard(all.lock); // список буферов
+    ring->tid = all.next_tid++; // номер потока
+    all.rings.push_back(ring); // буфер виден потоку записи
+  } // конец конструктора
+  ~RingHandle() { // поток завершается
+    TraceWriter& all = writer(); // общий список
+    std::lock_guard<std::mutex> guard(all.lock); // список буферов
+    ring->retired = true; // удаление при следующей записи
+    if (!all.running) { // записи нет — удаляем сразу
+      for (size_t i = 0; i < all.rings.size(); i++) { // поиск буфера
+        if (all.rings[i] == ring) { // нашли
+          all.rings[i] = all.rings.back(); // удаление перестановкой
+          all.rings.pop_back(); // последний элемент
+          break; // буфер один раз в списке
+        } // конец проверки
+      } // конец поиска
+      all.retired_dropped += ring->dropped.load(std::memory_order_relaxed); // отброшенные события сохраняются
+      delete ring; // буфер больше не нужен
+    } // конец удаления
+  } // конец деструктора
+
+  TraceRing* ring; // буфер потока
+}; // конец объявления класса RingHandle
+
+uint64_t trace_now_ns() { // монотонное время
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count(); // наносекунды
+} // конец функции trace_now_ns
+
+void trace_span(const char* name, uint64_t begin_ns, uint64_t end_ns) { // событие в буфер потока
+  if (!trace_enabled.load(std::memory_order_relaxed)) return; // запись остановлена во время интервала
+  thread_local RingHandle handle; // буфер потока, создаётся при первом событии
+  TraceRing* ring = handle.ring; // буфер
+  uint64_t head = ring->head.load(std::memory_order_relaxed); // номер события
+  if (head - ring->tail.load(std::memory_order_acquire) >= TRACE_RING_SIZE) { // буфер заполнен
+    ring->dropped.store(ring->dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed); // учёт потери
+    return; // событие отброшено
+  } // конец проверки места
+  ring->events[head & (TRACE_RING_SIZE - 1)] = {name, begin_ns, end_ns}; // запись события
+  ring->head.store(head + 1, std::memory_order_release); // публикация события
+} // конец функции trace_span
+
+/**
+ * @brief Записывает накопленные события всех буферов в файл. Вызывается под writer().lock.
+ */
+static void drain(TraceWriter& all) { // запись буферов
+  int pid = (int)getpid(); // номер процесса
+  for (size_t i = 0; i < all.rings.size();) { // буферы потоков
+    TraceRing* ring = all.rings[i]; // буфер
+    uint64_t tail = ring->tail.load(std::memory_order_relaxed); // первое непрочитанное
+    uint64_t head = ring->head.load(std::memory_order_acquire); // конец опубликованных
+    for (; tail != head; tail++) { // события буфера
+      const TraceEvent& event = ring->events[tail & (TRACE_RING_SIZE - 1)]; // событие
+      double ts = (event.begin_ns - all.origin_ns) / 1000.0; // начало в микросекундах от начала трассы
+      double dur = (event.end_ns - event.begin_ns) / 1000.0; // длительность в микросекундах
+      fprintf(all.file, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":%d,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+              all.first ? "" : ",\n", event.name, pid, ring->tid, ts, dur); // событие trace_event
+      all.first = false; // следующие события через запятую
+    } // конец цикла по событиям
+    ring->tail.store(tail, std::memory_order_release); // место освобождено
+    if (ring->retired) { // поток завершился
+      all.retired_dropped += ring->dropped.load(std::memory_order_relaxed); // отброшенные события сохраняются
+      all.rings[i] = all.rings.back(); // удаление перестановкой
+      all.rings.pop_back(); // последний элемент
+      delete ring; // буфер больше не нужен
+    } else { // поток работает
+      i++; // следующий буфер
+    } // конец проверки завершения
+  } // конец цикла по буферам
+  fflush(all.file); // данные на диск
+} // конец функции drain
+
+static void flush_loop() { // фоновый поток записи
+  TraceWriter& all = writer(); // общий список
+  std::unique_lock<std::mutex> guard(all.lock); // список буферов
+  while (!all.stop) { // до остановки
+    all.wake.wait_for(guard, std::chrono::milliseconds(TRACE_FLUSH_MS)); // период записи
+    drain(all); // запись буферов
+  } // конец цикла записи
+} // конец функции flush_loop
+
+}  // namespace s21 // конец пространства имён s21
+
+// ================= API ==================
+/**
+ * @brief Начинает запись трассы в формате Chrome trace_event (JSON Object Format).
+ *
+ * Файл открывается в Perfetto или chrome://tracing. Интервалы пишутся событиями "X".
+ * @return false если path пуст, файл не открылся или запись уже идёт
+ */
+bool traceStart(const char* path) { // глобальная функция API начала трассировки
+  s21::TraceWriter& all = s21::writer(); // общий список
+  std::lock_guard<std::mutex> guard(all.lock); // флаги и файл
+  if (!path || all.running) return false; // трасса не нужна или уже пишется
+  all.file = fopen(path, "w"); // файл трассы
+  if (!all.file) return false; // файл не открылся
+  fprintf(all.file, "{\"traceEvents\":[\n"); // начало массива событий
+  all.first = true; // событий ещё нет
+  all.stop = false; // поток записи работает
+  all.running = true; // запись идёт
+  all.origin_ns = s21::trace_now_ns(); // отсчёт меток времени
+  for (s21::TraceRing* ring : all.rings) ring->tail.store(ring->head.load()); // события прошлой трассы не пишутся
+  all.flusher = std::thread(s21::flush_loop); // фоновый поток записи
+  s21::trace_enabled.store(true); // интервалы начинают записываться
+  return true; // запись начата
+} // конец функции traceStart
+
+/**
+ * @brief Останавливает запись: дописывает буферы всех потоков и закрывает файл.
+ */
+void traceStop() { // глобальная функция API остановки трассировки
+  s21::TraceWriter& all = s21::writer(); // общий список
+  s21::trace_enabled.store(false); // новые интервалы не записываются
+  std::thread flusher; // поток записи
+  { // область блокировки
+    std::lock_guard<std::mutex> guard(all.lock); // флаги
+    if (!all.running) return; // запись не идёт
+    all.stop = true; // поток записи завершается
+    flusher = std::move(all.flusher); // поток ждём без блокировки
+  } // конец области блокировки
+  all.wake.notify_all(); // будим поток записи
+  flusher.join(); // поток записал остаток буферов
+  std::lock_guard<std::mutex> guard(all.lock); // файл
+  s21::drain(all); // события, завершившиеся после последней записи
+  fprintf(all.file, "\n],\"displayTimeUnit\":\"ms\"}\n"); // конец JSON
+  fclose(all.file); // файл закрыт
+  all.file = nullptr; // файла нет
+  all.running = false; // запись окончена
+} // конец функции traceStop
+
+unsigned long long traceDropped() { // отброшенные события
+  s21::TraceWriter& all = s21::writer(); // общий список
+  std::lock_guard<std::mutex> guard(all.lock); // список буферов
+  unsigned long long total = all.retired_dropped; // завершившиеся потоки
+  for (s21::TraceRing* ring : all.rings) total += ring->dropped.load(std::memory_order_relaxed); // работающие потоки
+  return total; // событий
+} // конец функции traceDropped
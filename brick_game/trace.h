@@ -0,0 +1,51 @@
+#ifndef TRACE_H // защита от повторного включения заголовка: если TRACE_H не определён
+#define TRACE_H // определяет макрос TRACE_H чтобы предотвратить повторное включение
+
+#include <stdint.h> // подключает целые типы фиксированной ширины для меток времени
+
+#include <atomic> // подключает флаг включения трассировки, читаемый из всех потоков
+
+#define TRACE_RING_SIZE 8192 // событий в кольцевом буфере потока (степень двойки)
+#define TRACE_FLUSH_MS 50 // период записи буферов фоновым потоком
+#define TRACE_ENV "BRICKGAME_TRACE" // переменная окружения с путём файла трассы для фронтендов
+
+bool traceStart(const char* path); // прототип глобальной функции API: начать запись трассы в path (nullptr — ничего не делать)
+void traceStop(); // прототип глобальной функции API: дописать буферы и закрыть файл трассы
+unsigned long long traceDropped(); // прототип: событий, не поместившихся в буферы потоков
+
+namespace s21 { // начало пространства имён s21
+
+extern std::atomic<bool> trace_enabled; // трассировка включена
+
+uint64_t trace_now_ns(); // монотонное время трассы в наносекундах
+void trace_span(const char* name, uint64_t begin_ns, uint64_t end_ns); // событие-интервал в буфер потока
+
+/**
+ * @brief Интервал трассы: от создания до разрушения объекта.
+ *
+ * При выключенной трассировке стоит одно чтение атомарного флага. Имя должно жить
+ * до конца записи трассы (строковый литерал).
+ */
+class TraceSpan { // объявление интервала трассы
+ public: // публичная секция класса
+  explicit TraceSpan(const char* name)
+      : name(trace_enabled.load(std::memory_order_relaxed) ? name : nullptr),
+        begin(this->name ? trace_now_ns() : 0) {} // начало интервала
+  ~TraceSpan() { // конец интервала
+    if (name) trace_span(name, begin, trace_now_ns()); // событие в буфер потока
+  } // конец деструктора
+  TraceSpan(const TraceSpan&) = delete; // удалённый копирующий конструктор
+  TraceSpan& operator=(const TraceSpan&) = delete; // удалённый оператор присваивания
+
+ private: // приватная секция для данных интервала
+  const char* name; // имя интервала или nullptr, если трассировка выключена
+  uint64_t begin; // время начала
+}; // конец объявления класса TraceSpan
+
+}  // namespace s21 // конец пространства имён s21
+
+#define TRACE_CONCAT_INNER(a, b) a##b // склейка имён для уникальной переменной
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b) // склейка после подстановки __LINE__
+#define TRACE_SCOPE(name) s21::TraceSpan TRACE_CONCAT(trace_span_, __LINE__)(name) // интервал до конца блока
+
+#endif  // TRACE_H // конец защиты от повторного включения заголовка
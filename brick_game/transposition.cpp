@@ -0,0 +1,45 @@
+#include "transposition.h" // подключает объявление таблицы транспозиций
+
+#include <stdexcept> // подключает std::invalid_argument для размера таблицы
+
+namespace s21 { // начало пространства имён s21
+
+TranspositionTable::TranspositionTable(int bits) : mask(0) { // пустая таблица
+  if (bits < 0 || bits > TT_MAX_BITS) throw std::invalid_argument("Error: Bad transposition table size"); // размер вне пределов
+  entries.reset(new Entry[(size_t)1 << bits]); // записи
+  mask = ((uint64_t)1 << bits) - 1; // маска номера слота
+  clear(); // все записи пусты
+} // конец конструктора
+
+/**
+ * @brief Ищет значение по ключу.
+ *
+ * Слот выбирается по ключу, свёрнутому из двух половин. Проверочное слово хранится
+ * инвертированным, поэтому пустой слот (оба слова нулевые) совпадает только с ключом ~0,
+ * а не с хэшем пустого поля 0.
+ */
+bool TranspositionTable::probe(uint64_t key, uint64_t* value) const { // чтение записи
+  const Entry& entry = entries[(key >> 32 ^ key) & mask]; // слот ключа
+  uint64_t data = entry.value.load(std::memory_order_relaxed); // значение
+  uint64_t check = entry.check.load(std::memory_order_relaxed); // ключ XOR значение, инвертированные
+  if (~(check ^ data) != key) return false; // другой ключ или разорванная запись
+  *value = data; // значение записи
+  return true; // запись найдена
+} // конец метода probe
+
+void TranspositionTable::store(uint64_t key, uint64_t value) { // запись значения
+  Entry& entry = entries[(key >> 32 ^ key) & mask]; // слот ключа
+  entry.check.store(~(key ^ value), std::memory_order_relaxed); // ключ XOR значение, инвертированные
+  entry.value.store(value, std::memory_order_relaxed); // значение
+} // конец метода store
+
+void TranspositionTable::clear() { // удаление записей
+  for (uint64_t i = 0; i <= mask; i++) { // все слоты
+    entries[i].check.store(0, std::memory_order_relaxed); // пустой ключ
+    entries[i].value.store(0, std::memory_order_relaxed); // пустое значение
+  } // конец цикла по слотам
+} // конец метода clear
+
+size_t TranspositionTable::capacity() const { return (size_t)mask + 1; } // записей в таблице
+
+}  // namespace s21 // конец пространства имён s21
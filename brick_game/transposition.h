@@ -0,0 +1,47 @@
+#ifndef TRANSPOSITION_H // защита от повторного включения заголовка: если TRANSPOSITION_H не определён
+#define TRANSPOSITION_H // определяет макрос TRANSPOSITION_H чтобы предотвратить повторное включение
+
+#include <stddef.h> // подключает size_t для числа записей
+#include <stdint.h> // подключает uint64_t для ключей и значений
+
+#include <atomic> // подключает атомарные слова записей
+#include <memory> // подключает std::unique_ptr для массива записей
+
+#define TT_DEFAULT_BITS 16 // записей в таблице по умолчанию: 2^16
+#define TT_MAX_BITS 30 // наибольший размер таблицы: 2^30 записей
+
+namespace s21 { // начало пространства имён s21
+
+/**
+ * @brief Таблица транспозиций фиксированного размера без блокировок.
+ *
+ * Ключ — хэш состояния (Game::state_hash), значение — 64 бита оценки, которую хозяин
+ * упаковывает сам. Запись хранит значение и ключ, сложенный с ним по XOR: чтение
+ * проверяет, что ключ восстанавливается, поэтому запись, разорванная одновременной
+ * записью другого потока, выглядит как промах, а не как чужая оценка. Новая запись
+ * всегда замещает старую в своём слоте. Читать и писать можно из любого числа потоков.
+ */
+class TranspositionTable { // объявление таблицы транспозиций
+ public: // публичная секция класса
+  explicit TranspositionTable(int bits = TT_DEFAULT_BITS); // таблица на 2^bits записей, throw invalid_argument
+  TranspositionTable(const TranspositionTable&) = delete; // удалённый копирующий конструктор
+  TranspositionTable& operator=(const TranspositionTable&) = delete; // удалённый оператор присваивания
+
+  bool probe(uint64_t key, uint64_t* value) const; // значение по ключу, false если записи нет
+  void store(uint64_t key, uint64_t value); // запись значения по ключу
+  void clear(); // удаление всех записей
+  size_t capacity() const; // записей в таблице
+
+ private: // приватная секция для внутренних структур и данных
+  struct Entry { // запись таблицы
+    std::atomic<uint64_t> check; // ~(ключ XOR значение)
+    std::atomic<uint64_t> value; // значение
+  }; // конец объявления Entry
+
+  std::unique_ptr<Entry[]> entries; // записи
+  uint64_t mask; // маска номера слота
+}; // конец объявления класса TranspositionTable
+
+}  // namespace s21 // конец пространства имён s21
+
+#endif  // TRANSPOSITION_H // конец защиты от повторного включения заголовка
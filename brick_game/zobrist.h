@@ -0,0 +1,49 @@
+#ifndef ZOBRIST_H // защита от повторного включения заголовка: если ZOBRIST_H не определён
+#define ZOBRIST_H // определяет макрос ZOBRIST_H чтобы предотвратить повторное включение
+
+#include <stdint.h> // подключает uint64_t для ключей
+
+#define ZOBRIST_SEED 0x9E3779B97F4A7C15ULL // начальное значение ключей (одинаково во всех процессах)
+#define ZOBRIST_FIELD 0 // пространство ключей клеток игрового поля
+#define ZOBRIST_NEXT 1 // пространство ключей клеток области next
+#define ZOBRIST_PIECE 2 // пространство ключей клеток падающей фигуры
+#define ZOBRIST_NONE -1 // клетки вне хэша (матрицы, не принадлежащие сессии)
+
+namespace s21 { // начало пространства имён s21
+
+/**
+ * @brief Ключ Zobrist клетки index пространства domain.
+ *
+ * Ключи не хранятся таблицей, а получаются перемешиванием номера клетки (финализатор
+ * splitmix64): они одинаковы в любом процессе и для поля любого размера, поэтому
+ * хэши состояний можно сравнивать между репликами, записями и узлами сети.
+ */
+inline uint64_t zobrist_key(int domain, uint64_t index) { // ключ клетки
+  uint64_t x = ZOBRIST_SEED * (uint64_t)(domain + 1) + index; // номер клетки в своём пространстве
+  x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL; // первое перемешивание
+  x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL; // второе перемешивание
+  return x ^ (x >> 31); // ключ
+} // конец функции zobrist_key
+
+/**
+ * @brief Хэш занятых клеток строки y матрицы шириной width.
+ */
+inline uint64_t zobrist_row(int domain, const int* row, int y, int width) { // хэш строки
+  uint64_t hash = 0; // пустая строка
+  for (int x = 0; x < width; x++) // клетки строки
+    if (row[x]) hash ^= zobrist_key(domain, (uint64_t)y * width + x); // занятая клетка
+  return hash; // хэш строки
+} // конец функции zobrist_row
+
+/**
+ * @brief Хэш занятых клеток матрицы height x width — полный пересчёт.
+ */
+inline uint64_t zobrist_matrix(int domain, int** matrix, int height, int width) { // хэш матрицы
+  uint64_t hash = 0; // пустая матрица
+  for (int y = 0; y < height; y++) hash ^= zobrist_row(domain, matrix[y], y, width); // строки
+  return hash; // хэш матрицы
+} // конец функции zobrist_matrix
+
+}  // namespace s21 // конец пространства имён s21
+
+#endif  // ZOBRIST_H // конец защиты от повторного включения заголовка
@@ -0,0 +1,197 @@
+#include "ansi_renderer.h" // подключает объявление класса AnsiRenderer
+
+#include <stdio.h> // подключает snprintf для чисел панели
+#include <string.h> // подключает strlen и memcpy
+#include <unistd.h> // подключает write
+
+#include <stdexcept> // подключает std::invalid_argument для неверного размера экрана
+
+namespace s21 { // начало пространства имён s21
+
+static const char* const ansi_glyphs[] = {"", "─", "│", "┌", "┐", "└", "┘", "←", "→", "↓"}; // символы рамки и стрелок в UTF-8
+static const AnsiCell ansi_blank = {' ', 0, 0}; // пустая ячейка
+
+/**
+ * @brief Конструктор.
+ *
+ * Буфер вывода выделяется сразу под кадр, в котором меняется каждая ячейка, поэтому
+ * сборка кадра не выделяет память.
+ * @throw std::invalid_argument если размер экрана не положительный или больше 999x999
+ */
+AnsiRenderer::AnsiRenderer(int rows, int cols, int fd)
+    : height(rows), width(cols), fd(fd), full(true), length(0), counters{} { // первый кадр рисуется целиком
+  if (rows <= 0 || cols <= 0 || rows > 999 || cols > 999) throw std::invalid_argument("Error: ansi screen size"); // переход курсора — до трёх цифр
+  back.assign((size_t)rows * cols, ansi_blank); // пустой кадр
+  front.assign((size_t)rows * cols, ansi_blank); // показанный кадр
+  buffer.resize((size_t)rows * cols * ANSI_CELL_BYTES + sizeof(ANSI_SYNC_BEGIN "\x1b[0m\x1b[2J\x1b[0m" ANSI_SYNC_END)); // худший случай
+} // конец конструктора
+
+void AnsiRenderer::blank() { back.assign(back.size(), ansi_blank); } // пустой кадр
+
+void AnsiRenderer::put(int row, int col, char glyph, uint8_t fg, uint8_t bg) { // ячейка кадра
+  if (row < 0 || col < 0 || row >= height || col >= width) return; // вне экрана
+  back[(size_t)row * width + col] = AnsiCell{glyph, (uint8_t)(fg % ANSI_PALETTE), (uint8_t)(bg % ANSI_PALETTE)}; // символ и цвета
+} // конец метода put
+
+void AnsiRenderer::text(int row, int col, const char* str, uint8_t fg) { // строка кадра
+  for (int i = 0; str[i]; i++) put(row, col + i, str[i], fg); // символ за символом
+} // конец метода text
+
+void AnsiRenderer::frame(int top, int left, int rows, int cols) { // рамка
+  horizontal(top, left + 1, cols - 2); // верх
+  horizontal(top + rows - 1, left + 1, cols - 2); // низ
+  vertical(top + 1, left, rows - 2); // левый край
+  vertical(top + 1, left + cols - 1, rows - 2); // правый край
+  put(top, left, ANSI_ULCORNER); // углы
+  put(top, left + cols - 1, ANSI_URCORNER);
+  put(top + rows - 1, left, ANSI_LLCORNER);
+  put(top + rows - 1, left + cols - 1, ANSI_LRCORNER);
+} // конец метода frame
+
+void AnsiRenderer::horizontal(int row, int col, int count) { for (int i = 0; i < count; i++) put(row, col + i, ANSI_HLINE); } // горизонтальная линия
+void AnsiRenderer::vertical(int row, int col, int count) { for (int i = 0; i < count; i++) put(row + i, col, ANSI_VLINE); } // вертикальная линия
+void AnsiRenderer::invalidate() { full = true; } // следующий кадр целиком
+
+void AnsiRenderer::append(const char* str) { // строка в буфер
+  size_t n = strlen(str); // длина строки
+  memcpy(buffer.data() + length, str, n); // место есть: буфер под худший случай
+  length += n; // длина кадра
+} // конец метода append
+
+void AnsiRenderer::append_number(int value) { // число в буфер без snprintf
+  char digits[4]; // до трёх цифр (экран не больше 999x999)
+  int n = 0; // цифр
+  do digits[n++] = (char)('0' + value % 10); while ((value /= 10) > 0); // цифры с младшей
+  while (n > 0) buffer[length++] = digits[--n]; // цифры со старшей
+} // конец метода append_number
+
+/**
+ * @brief Собирает вывод кадра.
+ *
+ * Проходит ячейки по строкам и выводит только изменившиеся (или все после invalidate).
+ * Курсор после символа стоит в следующей ячейке, поэтому подряд идущие изменения выводятся
+ * без переходов; цвета (SGR) выводятся, только когда отличаются от последних выведенных.
+ */
+size_t AnsiRenderer::compose() { // сборка кадра
+  length = 0; // пустой вывод
+  append(ANSI_SYNC_BEGIN); // кадр показывается целиком
+  if (full) append("\x1b[0m\x1b[2J"); // чистый экран перед полной перерисовкой
+  size_t head = length; // вывод без ячеек
+  int row = -1, col = -1; // позиция курсора неизвестна
+  int fg = -1, bg = -1; // цвета терминала неизвестны
+  for (int r = 0; r < height; r++) { // строки экрана
+    for (int c = 0; c < width; c++) { // столбцы экрана
+      AnsiCell& cell = back[(size_t)r * width + c]; // рисуемая ячейка
+      AnsiCell& shown = front[(size_t)r * width + c]; // показанная ячейка
+      if (!full && cell.glyph == shown.glyph && cell.fg == shown.fg && cell.bg == shown.bg) continue; // не изменилась
+      if (r != row || c != col) { // курсор не в этой ячейке
+        append("\x1b["); // переход курсора: CSI строка ; столбец H
+        append_number(r + 1);
+        buffer[length++] = ';';
+        append_number(c + 1);
+        buffer[length++] = 'H';
+      } // конец перехода курсора
+      if (cell.fg != fg || cell.bg != bg) { // другие цвета
+        append("\x1b[0"); // сброс цветов: CSI 0 ; 3x ; 4x m
+        if (cell.fg) { // цвет символа
+          append(";3");
+          buffer[length++] = (char)('0' + cell.fg); // палитра 1..7 — красный, зелёный, жёлтый, синий, пурпурный, голубой, белый
+        } // конец цвета символа
+        if (cell.bg) { // цвет фона
+          append(";4");
+          buffer[length++] = (char)('0' + cell.bg);
+        } // конец цвета фона
+        buffer[length++] = 'm';
+        fg = cell.fg; // выведенные цвета
+        bg = cell.bg;
+      } // конец смены цветов
+      if ((unsigned char)cell.glyph < sizeof(ansi_glyphs) / sizeof(ansi_glyphs[0])) append(ansi_glyphs[(int)cell.glyph]); // рамка или стрелка
+      else buffer[length++] = cell.glyph; // символ ASCII
+      shown = cell; // ячейка показана
+      row = r; // курсор сдвинулся на следующую ячейку
+      col = c + 1;
+    } // конец цикла по столбцам
+  } // конец цикла по строкам
+  if (length == head && !full) return length = 0; // изменений нет — кадр не выводится
+  if (fg > 0 || bg > 0) append("\x1b[0m"); // цвета терминала вне кадра
+  append(ANSI_SYNC_END); // терминал показывает кадр
+  full = false; // экран совпадает с front
+  return length; // длина кадра
+} // конец метода compose
+
+const char* AnsiRenderer::data() const { return buffer.data(); } // собранный кадр
+size_t AnsiRenderer::size() const { return length; } // длина собранного кадра
+
+bool AnsiRenderer::present() { // показ кадра
+  if (compose() == 0) return true; // изменений нет — ни одного вызова write
+  counters.frames++; // кадр с изменениями
+  counters.bytes += length; // байты кадров
+  counters.last_bytes = length; // байты последнего кадра
+  if (fd < 0) return true; // кадр отправляет владелец
+  counters.writes++; // один вызов на кадр
+  if (write(fd, buffer.data(), length) == (ssize_t)length) return true; // терминал принял кадр
+  invalidate(); // часть кадра потеряна — следующий перерисует всё
+  return false; // кадр не показан целиком
+} // конец метода present
+
+const AnsiStats& AnsiRenderer::stats() const { return counters; } // счётчики кадров
+int AnsiRenderer::rows() const { return height; } // строк экрана
+int AnsiRenderer::cols() const { return width; } // столбцов экрана
+
+/**
+ * @brief Рисует окно игры.
+ *
+ * Раскладка совпадает с окном консольного фронтенда на ncurses: поле слева, SCORE, HI-SCORE,
+ * NEXT, SPEED и LEVEL справа, подсказки клавиш внизу. Ячейки поля и NEXT окрашиваются по
+ * значению клетки (цвет фигуры тетриса, яблоко, тело и голова змейки).
+ */
+void ansi_draw_game(AnsiRenderer* screen, const GameInfo_t& stats, const int* ghost, int top, int left) { // окно игры
+  char number[16]; // число панели
+  screen->frame(top, left, 2 + WINDOW_HEIGHT + 5, 3 + WINDOW_WIDTH * 2 + 11); // рамка окна
+  screen->vertical(top + 1, left + 21, 20); // раздел поля и панели
+  screen->horizontal(top + 21, left + 1, 32); // раздел подсказок
+  screen->text(top + 2, left + 25, "SCORE"); // подписи панели
+  screen->text(top + 5, left + 23, "HI- SCORE");
+  screen->text(top + 8, left + 25, "NEXT");
+  screen->text(top + 12, left + 25, "SPEED");
+  screen->text(top + 15, left + 25, "LEVEL");
+  screen->text(top + 22, left + 2, "SPACE  ACTION"); // подсказки клавиш
+  screen->text(top + 23, left + 2, "P      PAUSE");
+  screen->text(top + 24, left + 2, "ESC    QUIT");
+  screen->text(top + 25, left + 2, "UP     DROP");
+  screen->put(top + 22, left + 24, ANSI_LARROW); // стрелки
+  screen->put(top + 22, left + 26, ANSI_DARROW);
+  screen->put(top + 22, left + 28, ANSI_RARROW);
+  if (!stats.field) return; // игры ещё нет — только рамка
+  for (int i = 0; i < WINDOW_HEIGHT; i++) { // строки поля
+    for (int j = 0; j < WINDOW_WIDTH; j++) { // столбцы поля (ячейка — два символа)
+      uint8_t color = (uint8_t)(stats.field[i][j] ? 1 + (unsigned)(stats.field[i][j] - 1) % (ANSI_PALETTE - 1) : 0); // цвет по значению клетки
+      screen->put(top + i + 1, left + j * 2 + 1, ' ', 0, color); // левая половина
+      screen->put(top + i + 1, left + j * 2 + 2, ' ', 0, color); // правая половина
+    } // конец цикла по столбцам
+  } // конец цикла по строкам
+  for (int i = 0; ghost && i < GHOST_SIZE; i += 2) { // тень фигуры
+    if (stats.field[ghost[i]][ghost[i + 1]] == 0) { // только в пустых клетках
+      screen->put(top + ghost[i] + 1, left + ghost[i + 1] * 2 + 1, '[', 7); // левая половина тени
+      screen->put(top + ghost[i] + 1, left + ghost[i + 1] * 2 + 2, ']', 7); // правая половина тени
+    } // конец проверки клетки
+  } // конец цикла по тени
+  for (int i = 0; stats.next && i < 2; i++) { // две строки NEXT
+    for (int j = 3; j < 7; j++) { // столбцы фигуры
+      uint8_t color = (uint8_t)(stats.next[i][j] ? 1 + (unsigned)(stats.next[i][j] - 1) % (ANSI_PALETTE - 1) : 0); // цвет по значению клетки
+      screen->put(top + i + 9, left + j * 2 + 19, ' ', 0, color); // левая половина
+      screen->put(top + i + 9, left + j * 2 + 20, ' ', 0, color); // правая половина
+    } // конец цикла по столбцам
+  } // конец цикла по строкам
+  if (stats.pause == 1) screen->text(top + (WINDOW_HEIGHT + 2) / 2, left + (WINDOW_WIDTH * 2 + 3) / 2 - 2, "PAUSE"); // пауза
+  snprintf(number, sizeof(number), "%07d", stats.score % 10000000); // счёт в семь цифр
+  screen->text(top + 3, left + 24, number);
+  snprintf(number, sizeof(number), "%07d", stats.high_score % 10000000); // рекорд в семь цифр
+  screen->text(top + 6, left + 24, number);
+  snprintf(number, sizeof(number), "%d", stats.speed); // скорость
+  screen->text(top + 13, left + 27, number);
+  snprintf(number, sizeof(number), "%d", stats.level); // уровень
+  screen->text(top + 16, left + 27, number);
+} // конец функции ansi_draw_game
+
+}  // namespace s21 // конец пространства имён s21
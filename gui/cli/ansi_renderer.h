@@ -0,0 +1,100 @@
+#ifndef ANSI_RENDERER_H // защита от повторного включения заголовка: если ANSI_RENDERER_H не определён
+#define ANSI_RENDERER_H // определяет макрос ANSI_RENDERER_H чтобы предотвратить повторное включение
+
+#include <stddef.h> // подключает size_t для длины кадра
+#include <stdint.h> // подключает целые типы фиксированной ширины для ячеек и счётчиков
+
+#include <vector> // подключает std::vector для буферов кадра
+
+#include "../../brick_game/brick_game_single.h" // подключает GameInfo_t, WINDOW_HEIGHT и WINDOW_WIDTH
+
+#define ANSI_CELL_BYTES 24 // наибольший вывод одной ячейки: переход курсора, цвет и символ UTF-8
+#define ANSI_SYNC_BEGIN "\x1b[?2026h" // начало синхронного обновления: терминал не показывает кадр наполовину
+#define ANSI_SYNC_END "\x1b[?2026l" // конец синхронного обновления
+#define ANSI_ENTER "\x1b[?1049h\x1b[?25l\x1b[2J" // второй экран терминала без курсора
+#define ANSI_LEAVE "\x1b[0m\x1b[?25h\x1b[?1049l" // прежний экран терминала с курсором
+#define ANSI_PALETTE 8 // цветов ячеек: 0 — цвет терминала, 1..7 — значения клеток поля
+
+#define ANSI_HLINE '\x01' // горизонтальная линия рамки
+#define ANSI_VLINE '\x02' // вертикальная линия рамки
+#define ANSI_ULCORNER '\x03' // левый верхний угол рамки
+#define ANSI_URCORNER '\x04' // правый верхний угол рамки
+#define ANSI_LLCORNER '\x05' // левый нижний угол рамки
+#define ANSI_LRCORNER '\x06' // правый нижний угол рамки
+#define ANSI_LARROW '\x07' // стрелка влево
+#define ANSI_RARROW '\x08' // стрелка вправо
+#define ANSI_DARROW '\x09' // стрелка вниз
+
+namespace s21 { // начало пространства имён s21
+
+/**
+ * @brief Ячейка экрана.
+ */
+typedef struct { // символ и цвета ячейки
+  char glyph; // символ ASCII или ANSI_HLINE..ANSI_DARROW
+  uint8_t fg; // цвет символа: 0 — цвет терминала, иначе номер палитры
+  uint8_t bg; // цвет фона: 0 — цвет терминала, иначе номер палитры
+} AnsiCell; // имя типа — AnsiCell
+
+/**
+ * @brief Счётчики вывода кадров.
+ */
+typedef struct { // статистика кадров
+  uint64_t frames; // кадров с изменениями
+  uint64_t writes; // вызовов write
+  uint64_t bytes; // байт всех кадров
+  uint64_t last_bytes; // байт последнего кадра
+} AnsiStats; // имя типа — AnsiStats
+
+/**
+ * @brief Отрисовка в терминал управляющими последовательностями ANSI без ncurses.
+ *
+ * Кадр рисуется в свой буфер ячеек (back) и сравнивается с тем, что уже показано (front):
+ * в вывод попадают только изменившиеся ячейки, переход курсора — только при разрыве, цвет —
+ * только при смене. Весь кадр собирается в буфер, выделенный один раз под худший случай, и
+ * отправляется одним write внутри синхронного обновления (CSI ?2026h/l). Без дескриптора
+ * (fd < 0) кадр только собирается: сессия сервера отправляет data() своей очередью.
+ */
+class AnsiRenderer { // объявление отрисовки ANSI
+ public: // публичная секция класса
+  AnsiRenderer(int rows, int cols, int fd = -1); // экран rows x cols, вывод в fd, throw invalid_argument
+  AnsiRenderer(const AnsiRenderer&) = delete; // удалённый копирующий конструктор, запрет копирования
+  AnsiRenderer& operator=(const AnsiRenderer&) = delete; // удалённый оператор присваивания, запрет копирования
+
+  void blank(); // пустой кадр
+  void put(int row, int col, char glyph, uint8_t fg = 0, uint8_t bg = 0); // ячейка кадра (вне экрана — пропускается)
+  void text(int row, int col, const char* str, uint8_t fg = 0); // строка кадра
+  void frame(int top, int left, int height, int width); // рамка
+  void horizontal(int row, int col, int length); // горизонтальная линия
+  void vertical(int row, int col, int length); // вертикальная линия
+  void invalidate(); // следующий кадр перерисовывает весь экран (новый терминал или сбой вывода)
+
+  size_t compose(); // разница кадра с показанным в буфер, возвращает длину (0 — изменений нет)
+  const char* data() const; // собранный кадр
+  size_t size() const; // длина собранного кадра
+  bool present(); // compose и один write в fd, false если терминал принял кадр не целиком
+  const AnsiStats& stats() const; // счётчики кадров
+
+  int rows() const; // строк экрана
+  int cols() const; // столбцов экрана
+
+ private: // приватная секция для внутренних данных
+  void append(const char* str); // строка в буфер кадра
+  void append_number(int value); // десятичное число в буфер кадра
+
+  int height; // строк экрана
+  int width; // столбцов экрана
+  int fd; // дескриптор терминала (-1 — только сборка кадра)
+  bool full; // следующий кадр перерисовывает весь экран
+  std::vector<AnsiCell> back; // рисуемый кадр
+  std::vector<AnsiCell> front; // показанный кадр
+  std::vector<char> buffer; // вывод кадра (выделен под худший случай)
+  size_t length; // длина вывода кадра
+  AnsiStats counters; // счётчики кадров
+}; // конец объявления класса AnsiRenderer
+
+void ansi_draw_game(AnsiRenderer* screen, const GameInfo_t& stats, const int* ghost, int top, int left); // окно игры как в консольном фронтенде, ghost — тень фигуры или nullptr
+
+}  // namespace s21 // конец пространства имён s21
+
+#endif  // ANSI_RENDERER_H // конец защиты от повторного включения заголовка
@@ -1,21 +1,75 @@
 #include "frontend.h" // подключает заголовок с прототипами функций фронтенда и ncurses
 
-int main(void) { // точка входа в программу
+#include <errno.h> // подключает errno, который обработчик сигнала сохраняет
+#include <poll.h> // подключает poll для ожидания ввода без ncurses
+#include <signal.h> // подключает sigaction и raise для восстановления терминала при сигнале
+#include <sys/ioctl.h> // подключает TIOCGWINSZ для размера терминала
+#include <termios.h> // подключает режим ввода терминала
+
+static s21::TerminalOutput* terminal = nullptr; // вывод ncurses через канал (nullptr — ncurses пишет в терминал сам)
+static struct termios saved_input; // режим ввода терминала до запуска
+static volatile sig_atomic_t ansi_active = 0; // второй экран ANSI и сырой ввод включены
+static const int ansi_signals[] = {SIGINT, SIGTERM, SIGHUP, SIGQUIT, SIGSEGV, SIGABRT}; // сигналы, завершающие процесс
+static struct sigaction ansi_previous[sizeof(ansi_signals) / sizeof(ansi_signals[0])]; // прежние обработчики сигналов
+
+int main(int argc, char** argv) { // точка входа в программу: без аргументов — игра, -r файл — просмотр повтора, -a — игра без ncurses
   WINDOW* my_win; // указатель на окно ncurses
+  const char* replay = (argc == 3 && strcmp(argv[1], "-r") == 0) ? argv[2] : nullptr; // файл повтора для просмотра
 
+  traceStart(getenv(TRACE_ENV)); // трасса пишется, если задан путь файла
+  const char* flight = getenv(FLIGHT_ENV); // файл дампов журнала сессии
+  flightInstall(flight ? flight : FLIGHT_DUMP_FILE); // дампы при поражении, исключении и падении
+  if (argc == 2 && strcmp(argv[1], "-a") == 0) { // отрисовка ANSI
+    srand(time(NULL)); // инициализируем генератор случайных чисел текущим временем
+    replayStart(getenv(REPLAY_ENV)); // повтор пишется, если задан путь файла
+    ansi_loop(); // игра без ncurses
+    replayStop(); // дописываем индекс и закрываем файл повтора
+    traceStop(); // дописываем и закрываем файл трассы
+    return 0; // возвращаем код успешного завершения
+  } // конец проверки ключа -a
   ncurses_init(); // инициализируем ncurses и настройки терминала
   my_win = create_new_window(); // создаём новое окно для интерфейса
   print_interface(my_win); // рисуем статическую часть интерфейса
-  game_loop(my_win); // запускаем главный игровой цикл
+  if (replay) { // просмотр записанной партии
+    replay_loop(my_win, replay); // цикл просмотра
+  } else { // игра
+    replayStart(getenv(REPLAY_ENV)); // повтор пишется, если задан путь файла
+    game_loop(my_win); // запускаем главный игровой цикл
+    replayStop(); // дописываем индекс и закрываем файл повтора
+  } // конец выбора режима
   destroy_win(my_win); // удаляем созданное окно
-  endwin(); // завершаем работу ncurses и возвращаем терминал в нормальный режим
+  ncurses_close(); // завершаем работу ncurses и возвращаем терминал в нормальный режим
+  traceStop(); // дописываем и закрываем файл трассы
 
   return 0; // возвращаем код успешного завершения
 } // конец main
 
 void ncurses_init() { // инициализация ncurses и базовых параметров интерфейса
   srand(time(NULL)); // инициализируем генератор случайных чисел текущим временем
-  initscr(); // инициализируем экран ncurses
+  struct winsize size; // размер терминала
+  if (isatty(STDIN_FILENO) && ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) == 0 && size.ws_row > 0) { // вывод в терминал
+    try { // канал может не создаться
+      terminal = new s21::TerminalOutput(STDOUT_FILENO); // ncurses пишет в канал, цикл игры — в терминал
+    } catch (const std::runtime_error&) { // канала нет
+      terminal = nullptr; // ncurses пишет в терминал сам
+    } // конец обработки ошибки
+  } // конец проверки терминала
+  if (terminal) { // вывод через канал
+    char number[16]; // размер строкой
+    snprintf(number, sizeof(number), "%d", size.ws_row); // строк терминала
+    setenv("LINES", number, 0); // канал не сообщает размер — ncurses берёт его из окружения
+    snprintf(number, sizeof(number), "%d", size.ws_col); // столбцов терминала
+    setenv("COLUMNS", number, 0); // столбцов терминала
+    tcgetattr(STDIN_FILENO, &saved_input); // режим ввода до запуска
+    struct termios raw = saved_input; // режим ввода игры
+    raw.c_lflag &= ~(ICANON | ECHO); // ввод без строки и эха (cbreak и noecho ncurses настраивают дескриптор вывода)
+    raw.c_cc[VMIN] = 1; // чтение по одному символу
+    raw.c_cc[VTIME] = 0; // без межсимвольного таймаута
+    tcsetattr(STDIN_FILENO, TCSANOW, &raw); // режим ввода игры
+    newterm(nullptr, terminal->stream(), stdin); // экран ncurses с выводом в канал
+  } else { // вывод не в терминал
+    initscr(); // инициализируем экран ncurses
+  } // конец выбора вывода
   if (!has_colors()) { // если терминал не поддерживает цвета
     printf("not found color"); // печатаем сообщение в stdout (вне ncurses)
   } // конец проверки поддержки цвета
@@ -26,9 +80,42 @@ void ncurses_init() { // инициализация ncurses и базовых п
   keypad(stdscr, TRUE); // включаем обработку функциональных клавиш (стрелки и т.д.)
   init_pair(0, COLOR_BLACK, COLOR_BLACK); // инициализируем пару цветов 0 — черный на черном
   init_pair(2, COLOR_RED, COLOR_RED); // инициализируем пару цветов 2 — красный на красном
+  init_pair(3, COLOR_WHITE, COLOR_BLACK); // инициализируем пару цветов 3 — белый на черном (тень фигуры)
   timeout(1); // устанавливаем неблокирующий режим getch с таймаутом 1 миллисекунда
 } // конец ncurses_init
 
+void ncurses_close() { // завершение ncurses
+  endwin(); // завершаем работу ncurses и возвращаем терминал в нормальный режим
+  if (terminal) { // вывод через канал
+    delete terminal; // досылаем вывод и возвращаем терминалу режим записи
+    terminal = nullptr; // канала больше нет
+    tcsetattr(STDIN_FILENO, TCSANOW, &saved_input); // режим ввода до запуска
+  } // конец проверки канала
+} // конец ncurses_close
+
+/**
+ * @brief Показывает кадр игры, если терминал успевает.
+ *
+ * Пока терминал не принял прошлые кадры, doupdate не вызывается: изменения окна копятся в
+ * виртуальном экране ncurses, и следующий показанный кадр отправит разницу с последним
+ * показанным — терминал получает последнее состояние, промежуточные пропускаются.
+ */
+bool show_frame(WINDOW* local_win) { // показ кадра игры
+  wnoutrefresh(local_win); // окно в виртуальный экран без вывода
+  if (terminal && !terminal->ready()) { // терминал не успевает
+    terminal->skipped(); // кадр пропущен
+    return false; // кадр не показан
+  } // конец проверки терминала
+  doupdate(); // вывод разницы с показанным экраном
+  if (terminal) terminal->presented(); // учёт байт кадра и отправка
+  return true; // кадр показан
+} // конец show_frame
+
+void present(WINDOW* local_win) { // показ окна вне игрового цикла (меню, сообщения)
+  wrefresh(local_win); // перерисовываем окно ncurses
+  if (terminal) terminal->flush(OUTPUT_DRAIN_MS); // сообщение должно дойти до терминала до паузы
+} // конец present
+
 void score_to_string(char* str, int score) { // форматирование целочисленного счёта в 7-символьную строку
   int number = 0; // временная переменная для цифры
   if (score <= 9999999) { // если счёт помещается в 7 цифр
@@ -46,30 +133,264 @@ void game_loop(WINDOW* my_win) { // главный цикл игры, обраб
   int game = selection_game(my_win); // меню выбора игры возвращает выбранный идентификатор
   userInput((UserAction_t)game, false); // передаём выбор игры через API как вход пользователя
 
+  s21::FramePacer pacer; // замеры темпа кадров
+  bool overlay = false; // показывать оверлей темпа кадров
+  bool stale = false; // последний кадр пропущен и ещё не показан
   while (!is_end(stats)) { // пока игра не завершена
-    set_user_action(); // считываем пользовательский ввод и преобразуем в действие
+    int64_t deadline = nextDeadline(); // микросекунд до шага по таймеру
+    int wait_ms = deadline < 0 ? 1 : (int)((deadline + 999) / 1000); // ждём ввода не дольше срока шага (клавиша прерывает ожидание)
+    if (stale && wait_ms > OUTPUT_RETRY_MS) wait_ms = OUTPUT_RETRY_MS; // пропущенный кадр показывается, как только терминал успеет
+    timeout(wait_ms); // срок ожидания ввода
+    int key = set_user_action(); // считываем пользовательский ввод и преобразуем в действие
+    if (key == 'f' || key == 'F') { // переключение оверлея
+      overlay = !overlay; // показать или скрыть
+    } else if (key != ERR) { // ввод игрока
+      pacer.input(s21::FramePacer::now_ns()); // задержка отсчитывается до показа кадра
+    } // конец обработки клавиши
+    uint64_t step_begin = s21::FramePacer::now_ns(); // начало шага движка
     stats = updateCurrentState(); // обновляем состояние игры (один шаг КА) и получаем gameinfo
+    replayRecord(); // тик повтора, если шаг изменил состояние
+    uint64_t render_begin = s21::FramePacer::now_ns(); // конец шага, начало отрисовки
+    pacer.add(PACING_STEP, render_begin - step_begin); // время шага движка
     if (!is_end(stats)) { // если после шага игра ещё не завершена
       update_screen(stats, my_win); // обновляем содержимое экрана на основе stats
+      print_pacing(pacer, overlay, my_win); // оверлей темпа кадров
+      print_output(overlay, my_win); // байт на кадр и пропущенные кадры
     } // конец проверки состояния перед отрисовкой
-    wrefresh(my_win); // перерисовываем окно ncurses
+    stale = !show_frame(my_win); // перерисовываем окно ncurses, если терминал успевает
+    uint64_t presented = s21::FramePacer::now_ns(); // кадр показан
+    pacer.add(PACING_RENDER, presented - render_begin); // время отрисовки
+    if (!stale) pacer.presented(presented); // интервал кадров и задержка ввода считаются по показанным кадрам
   } // конец основного игрового цикла
+  const char* summary = getenv(PACING_ENV); // файл сводки темпа кадров
+  pacer.write_summary(summary ? summary : PACING_FILE); // сводка за партию
+  if (terminal) terminal->append_summary(summary ? summary : PACING_FILE); // байты кадров и пропуски
 
   if (stats.level == LOSE_LVL) { // если игра завершилась проигрышем
     print_end(my_win); // показываем сообщение GAME OVER
   } else if (stats.level == WIN_LVL) { // если игра завершилась победой
     print_win(my_win); // показываем сообщение YOU WIN!
   } // конец проверки результатов игры
-  wrefresh(my_win); // перерисовываем окно чтобы отобразить финальное сообщение
+  present(my_win); // перерисовываем окно чтобы отобразить финальное сообщение
   sleep(1); // даём пользователю секунду, чтобы увидеть сообщение перед выходом
 } // конец game_loop
 
+void replay_loop(WINDOW* my_win, const char* path) { // просмотр повтора: стрелки листают, пробел воспроизводит, ESC выходит
+  s21::ReplayPlayer* player = nullptr; // просмотр файла
+  try { // файла может не быть или он повреждён
+    player = new s21::ReplayPlayer(path); // открываем повтор на первом тике
+  } catch (const std::runtime_error&) { // файл не открылся
+    mvwaddstr(my_win, (WINDOW_HEIGHT + 2) / 2, 2, "BAD REPLAY FILE"); // сообщение на поле
+    present(my_win); // показываем сообщение
+    sleep(1); // даём пользователю прочитать
+    return; // просмотра нет
+  } // конец обработки ошибки
+  timeout(REPLAY_FRAME_MS); // кадры воспроизведения идут и без ввода
+  int key = 0; // код клавиши
+  while (key != 27 && key != 'q') { // до ESC или q
+    key = getch(); // ввод или ERR по таймауту
+    if (key == KEY_LEFT) { // тик назад
+      player->seek(player->tick() > 0 ? player->tick() - 1 : 0); // не раньше первого
+    } else if (key == KEY_RIGHT) { // тик вперёд
+      player->seek(player->tick() + 1); // не дальше последнего
+    } else if (key == KEY_DOWN) { // перемотка назад
+      player->seek_time(player->time_us() - REPLAY_JUMP_US); // на REPLAY_JUMP_US раньше
+    } else if (key == KEY_UP) { // перемотка вперёд
+      player->seek_time(player->time_us() + REPLAY_JUMP_US); // на REPLAY_JUMP_US позже
+    } else if (key == KEY_HOME) { // начало записи
+      player->seek(0); // первый тик
+    } else if (key == KEY_END) { // конец записи
+      player->seek(player->ticks()); // последний тик
+    } else if (key == ' ') { // воспроизведение
+      player->toggle(); // старт или остановка
+    } // конец обработки клавиши
+    player->update(); // тик по времени при воспроизведении
+    update_screen(player->gameinfo(), my_win); // поле и счётчики тика
+    print_replay(*player, my_win); // номер тика и время
+    show_frame(my_win); // перерисовываем окно, если терминал успевает
+  } // конец цикла просмотра
+  delete player; // закрываем файл повтора
+} // конец replay_loop
+
+/**
+ * @brief Читает клавишу из stdin без ncurses.
+ *
+ * Стрелки, Home и End (CSI и SS3 последовательности) возвращаются кодами KEY_* ncurses,
+ * чтобы ввод обрабатывал тот же send_key. Клавиши, пришедшие одним чтением, возвращаются
+ * по одной в следующих вызовах.
+ */
+int ansi_read_key(int timeout_ms) { // клавиша или ERR, если за timeout_ms ввода не было
+  static unsigned char pending[32]; // прочитанный, но не разобранный ввод
+  static size_t count = 0; // байт в pending
+  if (count == 0) { // разбирать нечего
+    pollfd item = {STDIN_FILENO, POLLIN, 0}; // ожидание ввода
+    if (poll(&item, 1, timeout_ms) <= 0) return ERR; // ввода нет
+    ssize_t n = read(STDIN_FILENO, pending, sizeof(pending)); // всё, что пришло
+    if (n <= 0) return ERR; // терминал закрыт
+    count = (size_t)n; // байт для разбора
+  } // конец чтения
+  int key = pending[0]; // обычная клавиша
+  size_t used = 1; // байт клавиши
+  if (key == 27 && count >= 3 && (pending[1] == '[' || pending[1] == 'O')) { // стрелка или Home/End
+    const char* codes = "ABCDHF"; // последние байты последовательностей
+    const int keys[] = {KEY_UP, KEY_DOWN, KEY_RIGHT, KEY_LEFT, KEY_HOME, KEY_END}; // коды ncurses
+    const char* found = pending[2] ? strchr(codes, pending[2]) : nullptr; // известная последовательность
+    key = found ? keys[found - codes] : ERR; // неизвестная пропускается
+    used = 3; // байт последовательности
+  } else if (key == '\r') { // Enter в сыром режиме
+    key = '\n'; // как у ncurses
+  } // конец разбора
+  count -= used; // разобранный ввод
+  memmove(pending, pending + used, count); // остаток в начало
+  return key; // код клавиши
+} // конец ansi_read_key
+
+/**
+ * @brief Возвращает терминалу прежний экран, курсор и режим ввода.
+ *
+ * Вызывается при выходе из ansi_loop, из exit (atexit) и из обработчика сигнала, поэтому
+ * использует только async-signal-safe вызовы и срабатывает один раз. Ошибку записи некуда
+ * сообщить: терминал закрыт, и восстанавливать на нём нечего.
+ */
+static void ansi_restore() { // восстановление терминала
+  if (!ansi_active) return; // терминал уже восстановлен
+  ansi_active = 0; // повторный вызов ничего не делает
+  const char* leave = ANSI_LEAVE; // прежний экран с курсором
+  size_t left = sizeof(ANSI_LEAVE) - 1; // длина без завершающего нуля
+  while (left > 0) { // запись может быть частичной
+    ssize_t n = write(STDOUT_FILENO, leave, left); // часть последовательности
+    if (n < 0 && errno == EINTR) continue; // прервана сигналом — повторяем
+    if (n <= 0) break; // терминал закрыт
+    leave += n; // записанная часть
+    left -= (size_t)n;
+  } // конец записи
+  tcsetattr(STDIN_FILENO, TCSANOW, &saved_input); // режим ввода до запуска
+} // конец ansi_restore
+
+static void ansi_on_signal(int signal) { // завершающий сигнал во время игры ANSI
+  int saved_errno = errno; // errno прерванного кода
+  ansi_restore(); // терминал — до завершения процесса
+  for (size_t i = 0; i < sizeof(ansi_signals) / sizeof(ansi_signals[0]); i++) { // прежний обработчик сигнала
+    if (ansi_signals[i] == signal) sigaction(signal, &ansi_previous[i], nullptr); // например, дамп бортового самописца
+  } // конец поиска сигнала
+  errno = saved_errno; // errno не меняется
+  raise(signal); // сигнал доставляется прежнему обработчику после выхода из этого
+} // конец ansi_on_signal
+
+/**
+ * @brief Включает второй экран и сырой ввод с восстановлением при любом выходе.
+ *
+ * Терминал восстанавливается и при exit (atexit), и при завершающих сигналах; после
+ * восстановления сигнал передаётся прежнему обработчику (дамп самописца, действие по умолчанию).
+ * @return false если второй экран не включился (терминал уже восстановлен)
+ */
+static bool ansi_enter() { // второй экран ANSI
+  static bool registered = false; // atexit вызывается один раз за процесс
+  if (!registered) registered = atexit(ansi_restore) == 0; // восстановление при exit
+  tcgetattr(STDIN_FILENO, &saved_input); // режим ввода до запуска
+  struct sigaction action; // обработчик завершающих сигналов
+  memset(&action, 0, sizeof(action)); // обнуляем параметры
+  action.sa_handler = ansi_on_signal; // восстановление терминала
+  action.sa_flags = SA_ONSTACK; // на стеке самописца, если он поставлен
+  sigemptyset(&action.sa_mask); // другие сигналы не блокируются
+  for (size_t i = 0; i < sizeof(ansi_signals) / sizeof(ansi_signals[0]); i++) sigaction(ansi_signals[i], &action, &ansi_previous[i]); // прежние обработчики сохраняются
+  struct termios raw = saved_input; // режим ввода игры
+  raw.c_lflag &= ~(ICANON | ECHO); // ввод без строки и эха
+  ansi_active = 1; // с этого момента терминал нужно восстанавливать
+  tcsetattr(STDIN_FILENO, TCSANOW, &raw); // режим ввода игры
+  bool res = write(STDOUT_FILENO, ANSI_ENTER, strlen(ANSI_ENTER)) == (ssize_t)strlen(ANSI_ENTER); // второй экран без курсора
+  if (!res) ansi_restore(); // терминал не принял — возвращаем режим ввода
+  return res; // признак включения второго экрана
+} // конец ansi_enter
+
+static void ansi_leave() { // прежний экран и прежние обработчики сигналов
+  ansi_restore(); // экран, курсор и режим ввода
+  for (size_t i = 0; i < sizeof(ansi_signals) / sizeof(ansi_signals[0]); i++) sigaction(ansi_signals[i], &ansi_previous[i], nullptr); // обработчики до ansi_enter
+} // конец ansi_leave
+
+/**
+ * @brief Игра с отрисовкой ANSI вместо ncurses (ключ -a).
+ *
+ * Экран рисует AnsiRenderer: кадр собирается в одном буфере и выводится одним write, только
+ * изменившиеся ячейки, внутри синхронного обновления. terminfo не загружается, ввод читается
+ * из stdin в сыром режиме.
+ */
+void ansi_loop() { // игра без ncurses
+  s21::AnsiRenderer screen(ANSI_TOP + 2 + WINDOW_HEIGHT + 5, ANSI_LEFT + 3 + WINDOW_WIDTH * 2 + 11, STDOUT_FILENO); // экран под окно игры
+  GameInfo_t stats = {}; // игры ещё нет — только рамка
+  if (!ansi_enter()) { // второй экран не включился
+    ansi_leave(); // прежние обработчики сигналов
+    return; // рисовать некуда
+  } // конец проверки терминала
+
+  int game = Tetris, key = ERR; // по умолчанию выбираем Tetris
+  while (key != 'a' && key != 'q' && key != 's') { // меню выбора игры до завершающих клавиш
+    if (key == KEY_UP || key == KEY_DOWN) game = (game == Tetris ? Snake : Tetris); // переключаем выбранную игру
+    screen.blank(); // кадр меню
+    s21::ansi_draw_game(&screen, stats, nullptr, ANSI_TOP, ANSI_LEFT); // рамка и подписи
+    screen.put(ANSI_TOP + (game == Tetris ? 10 : 11), ANSI_LEFT + 8, '>'); // указатель
+    screen.text(ANSI_TOP + 10, ANSI_LEFT + 9, "Tetris"); // пункты меню
+    screen.text(ANSI_TOP + 11, ANSI_LEFT + 9, "Snake");
+    screen.present(); // вывод изменений
+    key = ansi_read_key(-1); // ждём клавишу
+  } // конец меню
+  screen.blank(); // заголовок игры
+  s21::ansi_draw_game(&screen, stats, nullptr, ANSI_TOP, ANSI_LEFT); // рамка и подписи
+  screen.text(ANSI_TOP + (WINDOW_HEIGHT + 2) / 2, ANSI_LEFT + 9, game == Tetris ? "TETRIS" : "SNAKE"); // как print_tetris и print_snake
+  screen.present(); // вывод заголовка
+  sleep(1); // небольшая пауза перед стартом игры
+  userInput((UserAction_t)game, false); // передаём выбор игры через API как вход пользователя
+
+  s21::FramePacer pacer; // замеры темпа кадров
+  bool overlay = false; // показывать оверлей темпа кадров
+  while (!is_end(stats)) { // пока игра не завершена
+    int64_t deadline = nextDeadline(); // микросекунд до шага по таймеру
+    key = send_key(ansi_read_key(deadline < 0 ? 1 : (int)((deadline + 999) / 1000))); // ждём ввода не дольше срока шага
+    if (key == 'f' || key == 'F') { // переключение оверлея
+      overlay = !overlay; // показать или скрыть
+    } else if (key != ERR) { // ввод игрока
+      pacer.input(s21::FramePacer::now_ns()); // задержка отсчитывается до показа кадра
+    } // конец обработки клавиши
+    uint64_t step_begin = s21::FramePacer::now_ns(); // начало шага движка
+    stats = updateCurrentState(); // обновляем состояние игры (один шаг КА) и получаем gameinfo
+    replayRecord(); // тик повтора, если шаг изменил состояние
+    uint64_t render_begin = s21::FramePacer::now_ns(); // конец шага, начало отрисовки
+    pacer.add(PACING_STEP, render_begin - step_begin); // время шага движка
+    if (is_end(stats)) break; // поле после конца игры не рисуется
+    int ghost[GHOST_SIZE]; // координаты тени фигуры
+    screen.blank(); // кадр игры
+    s21::ansi_draw_game(&screen, stats, getGhost(ghost) ? ghost : nullptr, ANSI_TOP, ANSI_LEFT); // поле и панель
+    std::vector<std::string> lines = pacer.overlay(); // FPS, p99 кадра, задержка ввода
+    for (size_t i = 0; overlay && i < lines.size(); i++) screen.text(ANSI_TOP + 18 + i, ANSI_LEFT + 22, lines[i].substr(0, 11).c_str()); // оверлей как print_pacing
+    screen.present(); // изменения кадра одним write
+    uint64_t presented = s21::FramePacer::now_ns(); // кадр показан
+    pacer.add(PACING_RENDER, presented - render_begin); // время отрисовки
+    pacer.presented(presented); // интервал кадров и задержка ввода
+  } // конец основного игрового цикла
+  const char* summary = getenv(PACING_ENV); // файл сводки темпа кадров
+  pacer.write_summary(summary ? summary : PACING_FILE); // сводка за партию
+  FILE* file = fopen(summary ? summary : PACING_FILE, "a"); // байты и вызовы write отрисовки ANSI
+  if (file) { // файл открылся
+    const s21::AnsiStats& counters = screen.stats(); // счётчики кадров
+    fprintf(file, "ansi frames %llu, writes %llu, bytes/frame mean %.1f\n", (unsigned long long)counters.frames,
+            (unsigned long long)counters.writes, counters.frames ? (double)counters.bytes / counters.frames : 0.0); // кадры, вызовы, байты
+    fclose(file); // закрываем файл
+  } // конец проверки файла
+
+  const char* text = stats.level == LOSE_LVL ? "GAME OVER" : stats.level == WIN_LVL ? "YOU WIN!" : nullptr; // сообщение как print_end и print_win
+  if (text) screen.text(ANSI_TOP + (WINDOW_HEIGHT + 2) / 2, ANSI_LEFT + (WINDOW_WIDTH * 2 + 3) / 2 - (int)strlen(text) / 2, text); // по центру поля
+  screen.present(); // финальное сообщение
+  sleep(1); // даём пользователю секунду, чтобы увидеть сообщение перед выходом
+  ansi_leave(); // прежний экран с курсором и режим ввода
+} // конец ansi_loop
+
 bool is_end(GameInfo_t stats) { // проверяет, достигнуто ли конечное состояние игры
   return (stats.level == LOSE_LVL || stats.level == WIN_LVL) ? true : false; // возвращает true если уровень соответствует коду конца
 } // конец is_end
 
-void set_user_action() { // читает нажатия клавиш и отправляет соответствующие действия в движок
-    int ch = getch(); // неблокирующее чтение символа из ncurses
+int set_user_action() { return send_key(getch()); } // неблокирующее чтение символа из ncurses и действие в движок
+
+int send_key(int ch) { // отправляет действие, соответствующее клавише, в движок
     switch (ch) { // сопоставление кода клавиши с действием пользователя
         case KEY_LEFT: // стрелка влево
             userInput(Left, false); // передаём действие Left
@@ -97,10 +418,11 @@ void set_user_action() { // читает нажатия клавиш и отпр
         case 'S': // или заглавная S
             userInput(Start, false); // передаём действие Start
             break;
-        default: // прочие клавиши
+        default: // прочие клавиши (в том числе F — оверлей темпа кадров, его обрабатывает game_loop)
             break; // игнорируем
     } // конец switch
-} // конец set_user_action
+    return ch; // код клавиши или ERR, если ввода не было
+} // конец send_key
 
 WINDOW* create_new_window() { // создаёт и возвращает новое окно ncurses под игровой интерфейс
   WINDOW* local_win; // локальный указатель на окно
@@ -128,18 +450,18 @@ int selection_game(WINDOW* local_win) { // меню выбора игры (Tetri
       mvwaddch(local_win, 10 + switch_flag, 8, ' '); // очищаем символ указателя на старой позиции
       mvwaddch(local_win, 11 - switch_flag, 8, '>'); // рисуем символ указателя на новой позиции
     } // конец обработки стрелок
-    wrefresh(local_win); // обновляем окно чтобы отобразить изменения
+    present(local_win); // обновляем окно чтобы отобразить изменения
     input = getch(); // читаем следующий ввод
   } // конец цикла выбора игры
   mvwaddstr(local_win, 9, 8, "          "); // очищаем строку меню (заменяем пробелами)
   mvwaddstr(local_win, 10, 8, "          "); // очищаем следующую строку меню
-  wrefresh(local_win); // обновляем окно после очистки текста
+  present(local_win); // обновляем окно после очистки текста
   if (game == Tetris) { // если выбрали Tetris
     print_tetris(local_win); // показываем заголовок Tetris
   } else if (game == Snake) { // если выбрали Snake
     print_snake(local_win); // показываем заголовок Snake
   } // конец выбора заголовка
-  wrefresh(local_win); // обновляем окно чтобы отобразить заголовок
+  present(local_win); // обновляем окно чтобы отобразить заголовок
   sleep(1); // небольшая пауза перед стартом игры
   return game; // возвращаем код выбранной игры
 } // конец selection_game
@@ -157,6 +479,7 @@ void print_interface(WINDOW* local_win) { // рисует статическую
   mvwaddstr(local_win, 22, 2, "SPACE  ACTION"); // эта строка перекрывает предыдущую, но оставлена в коде
   mvwaddstr(local_win, 23, 2, "P      PAUSE"); // подсказка P для паузы
   mvwaddstr(local_win, 24, 2, "ESC    QUIT"); // подсказка ESC для выхода
+  mvwaddstr(local_win, 25, 2, "UP     DROP"); // подсказка стрелки вверх для мгновенного сброса
   mvwaddch(local_win, 22, 26, ACS_UARROW); // размещение символа стрелки вверх (декоративно)
   mvwaddch(local_win, 22, 24, ACS_LARROW); // символ стрелки влево
   mvwaddch(local_win, 22, 28, ACS_RARROW); // символ стрелки вправо
@@ -185,6 +508,7 @@ void print_pause(WINDOW* local_win) { // выводит надпись PAUSE п
 } // конец print_pause
 
 void update_screen(GameInfo_t stats, WINDOW* local_win) { // обновляет экран на основе текущего состояния игры
+    TRACE_SCOPE("cli.update_screen"); // интервал отрисовки кадра
     char score_str[8] = {0}; // буфер для форматированной строки счёта (7 символов + терминатор)
     char high_score_str[8] = {0}; // буфер для рекорда
     score_str[7] = '\0'; // явно устанавливаем терминатор в конце буфера
@@ -193,6 +517,7 @@ void update_screen(GameInfo_t stats, WINDOW* local_win) { // обновляет
     score_to_string(high_score_str, stats.high_score); // форматируем рекорд в строку
 
     print_stats_field(stats, local_win); // отрисовываем основное игровое поле
+    print_ghost(stats, local_win); // отрисовываем тень фигуры поверх пустых ячеек поля
     print_stats_next(stats, local_win); // отрисовываем окно следующей фигуры
 
     if (stats.pause == 1) { // если игра на паузе
@@ -206,6 +531,7 @@ void update_screen(GameInfo_t stats, WINDOW* local_win) { // обновляет
 
 
 void print_stats_field(GameInfo_t stats, WINDOW* local_win) { // отрисовка основного поля игры в окне
+    TRACE_SCOPE("cli.print_stats_field"); // интервал отрисовки поля
     int k = 1; // смещение по колонкам для отрисовки с учётом двойной ширины ячейки
     for (int i = 0; i < WINDOW_HEIGHT; i++) { // цикл по строкам игрового поля
         for (int j = 0; j < WINDOW_WIDTH; j++) { // цикл по столбцам игрового поля
@@ -218,6 +544,41 @@ void print_stats_field(GameInfo_t stats, WINDOW* local_win) { // отрисов
     } // конец внешнего цикла по строкам
 } // конец print_stats_field
 
+void print_pacing(const s21::FramePacer& pacer, bool overlay, WINDOW* local_win) { // оверлей темпа кадров под панелью LEVEL
+    std::vector<std::string> lines = pacer.overlay(); // FPS, p99 кадра, задержка ввода
+    for (size_t i = 0; i < lines.size(); i++) { // строки оверлея
+        mvwprintw(local_win, 18 + i, 22, "%-11.11s", overlay ? lines[i].c_str() : ""); // строка или пробелы
+    } // конец цикла по строкам
+} // конец print_pacing
+
+void print_output(bool overlay, WINDOW* local_win) { // байт на кадр и пропущенные кадры под подсказками оверлея
+    std::vector<std::string> lines; // строки оверлея
+    if (terminal) lines = terminal->overlay(); // вывод через канал
+    for (size_t i = 0; i < lines.size(); i++) { // строки оверлея
+        mvwprintw(local_win, 23 + i, 22, "%-11.11s", overlay ? lines[i].c_str() : ""); // строка или пробелы
+    } // конец цикла по строкам
+} // конец print_output
+
+void print_replay(const s21::ReplayPlayer& player, WINDOW* local_win) { // тик и время повтора под панелью LEVEL
+    int now = (int)(player.time_us() / 1000000); // секунд от начала записи
+    int total = (int)(player.duration_us() / 1000000); // секунд в записи
+    mvwprintw(local_win, 18, 22, "T %-9zu", player.tick()); // номер тика
+    mvwprintw(local_win, 19, 22, "%02d:%02d/%02d:%02d", now / 60 % 100, now % 60, total / 60 % 100, total % 60); // время тика и длина записи
+    mvwprintw(local_win, 20, 22, "%-11s", player.playing() ? "PLAY" : "STOP"); // воспроизведение
+} // конец print_replay
+
+void print_ghost(GameInfo_t stats, WINDOW* local_win) { // отрисовка тени фигуры в пустых ячейках поля
+    int ghost[GHOST_SIZE]; // координаты тени (пары Y,X)
+    if (getGhost(ghost)) { // если у игры есть тень фигуры
+        for (int i = 0; i < GHOST_SIZE; i += 2) { // проходим по блокам тени
+            if (stats.field[ghost[i]][ghost[i + 1]] == 0) { // тень рисуем только там, где нет самой фигуры
+                mvwaddch(local_win, ghost[i] + 1, ghost[i + 1] * 2 + 1, '[' | COLOR_PAIR(3)); // левая половина ячейки тени
+                mvwaddch(local_win, ghost[i] + 1, ghost[i + 1] * 2 + 2, ']' | COLOR_PAIR(3)); // правая половина ячейки тени
+            } // конец проверки пустой ячейки
+        } // конец цикла по блокам тени
+    } // конец проверки наличия тени
+} // конец print_ghost
+
 void print_stats_next(GameInfo_t stats, WINDOW* local_win) { // отрисовка окна "NEXT" (слева от метки NEXT)
     int k = 1; // вспомогательное смещение по колонкам внутри области NEXT
     for (int i = 0; i < 2; i++) { // фиксированно отрисовываем только две строки области next (верхняя часть)
@@ -233,7 +594,7 @@ void print_stats_next(GameInfo_t stats, WINDOW* local_win) { // отрисовк
 
 void destroy_win(WINDOW* local_win) { // удаляет окно и очищает его границы
   wborder(local_win, ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' '); // очищаем рамку окна пробелами
-  wrefresh(local_win); // обновляем окно чтобы отобразить очищение
+  present(local_win); // обновляем окно чтобы отобразить очищение
   delwin(local_win); // удаляем объект окна
 } // конец destroy_win
 
@@ -8,13 +8,30 @@
 #include <string.h> // подключаем функции работы со строками C (strlen, memcpy и т.д.)
 
 #include "../../brick_game/brick_game_single.h" // подключаем общий заголовок с игровыми структурами и константами
+#include "../../brick_game/trace.h" // подключаем интервалы трассировки
+#include "../../brick_game/pacing.h" // подключаем замеры темпа кадров
+#include "../../brick_game/replay.h" // подключаем запись и просмотр повтора
+#include "terminal_output.h" // подключаем неблокирующий вывод в терминал
+#include "ansi_renderer.h" // подключаем отрисовку ANSI без ncurses
 
 #define Tetris 1 // макрос-код для выбора игры Tetris
 #define Snake 2 // макрос-код для выбора игры Snake
+#define REPLAY_FRAME_MS 16 // период кадров просмотра повтора в миллисекундах
+#define REPLAY_JUMP_US 10000000 // перемотка повтора стрелками вверх/вниз в микросекундах
+#define ANSI_TOP 2 // строка окна игры при отрисовке ANSI (как у окна ncurses)
+#define ANSI_LEFT 4 // столбец окна игры при отрисовке ANSI
+#define OUTPUT_RETRY_MS 10 // ожидание ввода, пока пропущенный кадр ждёт медленный терминал
 
 void ncurses_init(); // прототип функции инициализации ncurses и базовых настроек терминала
+void ncurses_close(); // прототип функции завершения ncurses, досылки вывода и восстановления терминала
+bool show_frame(WINDOW* local_win); // прототип функции показа кадра игры, false если терминал не успевает и кадр пропущен
+void present(WINDOW* local_win); // прототип функции показа окна вне игрового цикла с досылкой вывода
 void game_loop(WINDOW* my_win); // прототип главного игрового цикла, принимает окно ncurses
-void set_user_action(); // прототип функции обработки ввода пользователя и преобразования в действия
+void replay_loop(WINDOW* my_win, const char* path); // прототип цикла просмотра повтора из файла path
+void ansi_loop(); // прототип игрового цикла с отрисовкой ANSI без ncurses
+int ansi_read_key(int timeout_ms); // прототип функции чтения клавиши из stdin без ncurses, возвращает код клавиши или ERR
+int set_user_action(); // прототип функции обработки ввода пользователя, возвращает код клавиши или ERR
+int send_key(int ch); // прототип функции отправки действия по коду клавиши в движок, возвращает ch
 bool is_end(GameInfo_t stats); // прототип функции проверки состояния завершения игры по gameinfo
 void update_screen(GameInfo_t stats, WINDOW* local_win); // прототип функции обновления экрана на основе gameinfo
 void score_to_string(char* str, int score); // прототип функции форматирования числа в строку фиксированной длины
@@ -31,5 +48,9 @@ void print_end(WINDOW* local_win); // прототип функции вывод
 void print_win(WINDOW* local_win); // прототип функции вывода текста YOU WIN в окне
 void print_stats_field(GameInfo_t stats, WINDOW* local_win); // прототип функции отрисовки основного игрового поля в окне
 void print_stats_next(GameInfo_t stats, WINDOW* local_win); // прототип функции отрисовки области NEXT в окне
+void print_ghost(GameInfo_t stats, WINDOW* local_win); // прототип функции отрисовки тени фигуры (места приземления)
+void print_pacing(const s21::FramePacer& pacer, bool overlay, WINDOW* local_win); // прототип функции отрисовки оверлея темпа кадров
+void print_output(bool overlay, WINDOW* local_win); // прототип функции отрисовки байт на кадр и пропущенных кадров
+void print_replay(const s21::ReplayPlayer& player, WINDOW* local_win); // прототип функции отрисовки тика и времени повтора
 
 #endif  // FRONTEND_H // конец защиты от повторного включения заголовка
\ No newline at end of file
@@ -0,0 +1,210 @@
+#include "terminal_output.h" // подключает объявление класса TerminalOutput
+
+#include <errno.h> // подключает errno для описания ошибок канала
+#include <fcntl.h> // подключает fcntl и O_NONBLOCK
+#include <limits.h> // подключает PIPE_BUF для записи без ожидания
+#include <poll.h> // подключает poll для ожидания терминала
+#include <string.h> // подключает strerror
+#include <sys/ioctl.h> // подключает TIOCOUTQ и FIONREAD для длины очереди терминала
+#include <sys/stat.h> // подключает fstat для типа дескриптора терминала
+#include <unistd.h> // подключает pipe, read, write и close
+
+#include <algorithm> // подключает std::max
+#include <chrono> // подключает steady_clock для срока досылки
+#include <stdexcept> // подключает std::runtime_error для ошибок канала
+
+namespace s21 { // начало пространства имён s21
+
+/**
+ * @brief Открывает терминал ещё раз с O_NONBLOCK.
+ *
+ * Новое описание файла не меняет режим записи stdout, общий с оболочкой. Открываются только
+ * tty (по ttyname) и каналы (через /proc/self/fd): обычный файл открылся бы заново с начала.
+ * @return дескриптор или -1, если открыть не удалось
+ */
+static int reopen_nonblocking(int fd) { // отдельное описание терминала
+  struct stat info; // тип дескриптора
+  char path[32]; // путь канала в /proc
+  const char* name = isatty(fd) ? ttyname(fd) : nullptr; // имя терминала
+  if (!name && fstat(fd, &info) == 0 && S_ISFIFO(info.st_mode)) { // канал (тесты, перенаправление в программу)
+    snprintf(path, sizeof(path), "/proc/self/fd/%d", fd); // тот же канал, новое описание
+    name = path;
+  } // конец выбора пути
+  return name ? open(name, O_WRONLY | O_NOCTTY | O_NONBLOCK | O_CLOEXEC) : -1; // неблокирующее описание
+} // конец функции reopen_nonblocking
+
+/**
+ * @brief Конструктор.
+ *
+ * Создаёт канал для вывода ncurses и отдельное неблокирующее описание терминала. Конец канала
+ * для записи остаётся блокирующим и вычитывается только между кадрами тем же потоком: если кадр
+ * не поместится в канал, write внутри doupdate не вернётся никогда. Ёмкость канала задаётся
+ * OUTPUT_PIPE_SIZE, если система позволяет, иначе остаётся по умолчанию (64 КБ в Linux), и
+ * сравнивается с верхней границей полной перерисовки: OUTPUT_CELL_BYTES на каждую клетку
+ * терминала (TIOCGWINSZ, для канала — OUTPUT_DEFAULT_ROWS x OUTPUT_DEFAULT_COLS). Окна игры
+ * фиксированного размера, поэтому увеличенный позже терминал не удлиняет кадр.
+ * @throw std::runtime_error если канал не удалось создать или перерисовка в него не помещается
+ */
+TerminalOutput::TerminalOutput(int sink, size_t watermark)
+    : sink(sink),
+      writer(reopen_nonblocking(sink)),
+      sink_tty(isatty(sink)),
+      source(-1),
+      out(nullptr),
+      pipe_size(0),
+      watermark(watermark),
+      queue_pos(0),
+      frame_bytes(0),
+      counters{} { // пустая очередь
+  int fds[2]; // концы канала
+  if (pipe(fds) < 0) throw std::runtime_error(std::string("Error: pipe: ") + strerror(errno)); // канала нет
+  source = fds[0]; // чтение вывода ncurses
+  fcntl(source, F_SETFL, O_NONBLOCK); // чтение без ожидания
+  fcntl(fds[0], F_SETFD, FD_CLOEXEC); // канал не наследуется дочерними процессами
+  fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+#ifdef F_SETPIPE_SZ
+  int size = fcntl(fds[1], F_SETPIPE_SZ, OUTPUT_PIPE_SIZE); // ёмкость канала (ограничена /proc/sys/fs/pipe-max-size)
+  if (size < 0) size = fcntl(fds[1], F_GETPIPE_SZ); // ёмкость не изменилась
+  pipe_size = size > 0 ? (size_t)size : 0; // ёмкость канала
+#endif
+  if (pipe_size == 0) pipe_size = 65536; // ёмкость канала по умолчанию в Linux (в других системах не меньше PIPE_BUF)
+  struct winsize screen = {OUTPUT_DEFAULT_ROWS, OUTPUT_DEFAULT_COLS, 0, 0}; // размер терминала
+  if (ioctl(sink, TIOCGWINSZ, &screen) < 0 || screen.ws_row == 0 || screen.ws_col == 0) { // размер неизвестен
+    screen.ws_row = OUTPUT_DEFAULT_ROWS;
+    screen.ws_col = OUTPUT_DEFAULT_COLS;
+  } // конец определения размера
+  size_t redraw = (size_t)screen.ws_row * screen.ws_col * OUTPUT_CELL_BYTES; // граница полной перерисовки
+  out = redraw <= pipe_size ? fdopen(fds[1], "w") : nullptr; // поток ncurses
+  if (!out) { // поток не создан или кадр может не поместиться в канал
+    close(fds[0]); // закрываем канал
+    close(fds[1]);
+    if (writer >= 0) close(writer); // описание терминала
+    throw std::runtime_error(redraw > pipe_size ? "Error: output pipe is smaller than a full redraw"
+                                                : "Error: fdopen output pipe"); // сообщаем об ошибке
+  } // конец проверки потока
+} // конец конструктора
+
+TerminalOutput::~TerminalOutput() { // досылка и закрытие канала
+  fflush(out); // остаток буфера потока
+  flush(OUTPUT_DRAIN_MS); // вывод, ещё не принятый терминалом
+  if (writer >= 0) close(writer); // отдельное описание терминала
+  fclose(out); // конец канала для записи
+  close(source); // конец канала для чтения
+} // конец деструктора
+
+FILE* TerminalOutput::stream() const { return out; } // поток вывода для newterm
+
+size_t TerminalOutput::collect() { // чтение канала
+  size_t total = 0; // прочитано байт
+  uint8_t buf[OUTPUT_CHUNK]; // блок вывода
+  ssize_t n; // длина блока
+  while ((n = read(source, buf, sizeof(buf))) > 0) { // всё, что ncurses записал в канал
+    queue.insert(queue.end(), buf, buf + n); // в конец очереди
+    total += n; // учитываем байты
+  } // конец чтения
+  frame_bytes += total; // байты текущего кадра
+  return total; // прочитано байт
+} // конец метода collect
+
+/**
+ * @brief Пишет в терминал без ожидания.
+ *
+ * Через отдельное неблокирующее описание пишется сколько примет терминал (EAGAIN — занят).
+ * Без него дескриптор блокирующий, и пишется не больше PIPE_BUF байт и только после poll,
+ * сообщившего о готовности: такая запись не ждёт.
+ */
+ssize_t TerminalOutput::write_some(const uint8_t* data, size_t size) { // запись без ожидания
+  if (writer >= 0) return write(writer, data, size); // неблокирующее описание
+  pollfd item = {sink, POLLOUT, 0}; // готовность терминала
+  if (poll(&item, 1, 0) <= 0 || !(item.revents & POLLOUT)) return 0; // терминал занят
+  return write(sink, data, std::min<size_t>(size, PIPE_BUF)); // часть, которая не блокирует
+} // конец метода write_some
+
+/**
+ * @brief Перекладывает вывод в терминал.
+ *
+ * Пишет из очереди, пока терминал принимает.
+ */
+void TerminalOutput::pump() { // перекладка вывода
+  collect(); // новый вывод ncurses
+  while (queue_pos < queue.size()) { // есть что отправить
+    ssize_t n = write_some(queue.data() + queue_pos, queue.size() - queue_pos); // сколько терминал примет
+    if (n <= 0) break; // терминал занят или закрыт
+    queue_pos += n; // отправленная часть
+  } // конец записи
+  if (queue_pos == queue.size()) { // очередь отправлена целиком
+    queue.clear(); // память остаётся для следующих кадров
+    queue_pos = 0; // очередь пуста
+  } // конец проверки очереди
+  counters.max_queued = std::max<uint64_t>(counters.max_queued, queued() + terminal_queued()); // наибольшая очередь
+} // конец метода pump
+
+bool TerminalOutput::ready() { // можно ли показать кадр
+  pump(); // отправляем, что терминал примет
+  return queued() == 0 && terminal_queued() <= watermark; // прошлые кадры почти приняты
+} // конец метода ready
+
+void TerminalOutput::presented() { // кадр выведен
+  collect(); // вывод кадра
+  counters.frames++; // учитываем кадр
+  counters.bytes += frame_bytes; // байты всех кадров
+  counters.last_bytes = frame_bytes; // байты последнего кадра
+  counters.max_bytes = std::max(counters.max_bytes, frame_bytes); // самый длинный кадр
+  frame_bytes = 0; // следующий кадр
+  pump(); // отправка кадра
+} // конец метода presented
+
+void TerminalOutput::skipped() { counters.skipped++; } // кадр пропущен
+
+/**
+ * @brief Досылает очередь с ожиданием.
+ *
+ * Для экранов вне игрового цикла (меню, сообщения, выход): ждёт готовности терминала к записи,
+ * но не дольше timeout_ms, чтобы отключившийся терминал не задержал выход.
+ */
+bool TerminalOutput::flush(int timeout_ms) { // досылка очереди
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms); // срок досылки
+  pump(); // всё, что терминал примет сразу
+  while (queued() > 0) { // очередь не отправлена
+    int left = (int)std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count(); // до срока
+    pollfd item = {sink, POLLOUT, 0}; // ожидание терминала
+    if (left <= 0 || poll(&item, 1, left) <= 0 || (item.revents & (POLLERR | POLLHUP))) break; // срок вышел или терминал закрыт
+    pump(); // следующая часть очереди
+  } // конец досылки
+  return queued() == 0; // очередь отправлена
+} // конец метода flush
+
+size_t TerminalOutput::queued() const { return queue.size() - queue_pos; } // байт в своей очереди
+
+size_t TerminalOutput::capacity() const { return pipe_size; } // ёмкость канала ncurses
+
+size_t TerminalOutput::terminal_queued() const { // очередь терминала
+  int pending = 0; // байт в очереди
+  if (ioctl(sink, sink_tty ? TIOCOUTQ : FIONREAD, &pending) < 0) pending = 0; // ядро не сообщает длину
+  return (size_t)pending; // байт в очереди терминала
+} // конец метода terminal_queued
+
+const OutputStats& TerminalOutput::stats() const { return counters; } // счётчики вывода
+
+std::vector<std::string> TerminalOutput::overlay() const { // строки оверлея
+  char line[32]; // строка оверлея
+  std::vector<std::string> lines; // результат
+  snprintf(line, sizeof(line), "B/F %7llu", (unsigned long long)counters.last_bytes); // байт последнего кадра
+  lines.push_back(line); // первая строка
+  snprintf(line, sizeof(line), "skip %6llu", (unsigned long long)counters.skipped); // пропущенные кадры
+  lines.push_back(line); // вторая строка
+  return lines; // строки оверлея
+} // конец метода overlay
+
+bool TerminalOutput::append_summary(const char* path) const { // сводка вывода
+  FILE* file = fopen(path, "a"); // файл сводки (дописывается после сводки темпа кадров)
+  if (!file) return false; // файл не открылся
+  fprintf(file, "output frames %llu, skipped %llu, bytes/frame mean %.1f max %llu, queue max %llu\n",
+          (unsigned long long)counters.frames, (unsigned long long)counters.skipped,
+          counters.frames ? (double)counters.bytes / counters.frames : 0.0, (unsigned long long)counters.max_bytes,
+          (unsigned long long)counters.max_queued); // кадры, пропуски, байты и очередь
+  fclose(file); // закрываем файл
+  return true; // сводка записана
+} // конец метода append_summary
+
+}  // namespace s21 // конец пространства имён s21
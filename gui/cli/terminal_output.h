@@ -0,0 +1,93 @@
+#ifndef TERMINAL_OUTPUT_H // защита от повторного включения заголовка: если TERMINAL_OUTPUT_H не определён
+#define TERMINAL_OUTPUT_H // определяет макрос TERMINAL_OUTPUT_H чтобы предотвратить повторное включение
+
+#include <stddef.h> // подключает size_t для длин очередей
+#include <stdint.h> // подключает целые типы фиксированной ширины для счётчиков
+#include <stdio.h> // подключает FILE для потока вывода ncurses
+
+#include <string> // подключает std::string для строк оверлея
+#include <vector> // подключает std::vector для очереди вывода
+
+#define OUTPUT_CHUNK 4096 // блок чтения вывода ncurses из канала
+#define OUTPUT_PIPE_SIZE (1 << 20) // желаемая ёмкость канала (F_SETPIPE_SZ); если система не позволяет, остаётся ёмкость по умолчанию
+#define OUTPUT_CELL_BYTES 32 // верхняя граница байт на клетку экрана при полной перерисовке (перемещение курсора, атрибуты, символ UTF-8)
+#define OUTPUT_DEFAULT_ROWS 24 // строк экрана, если размер терминала неизвестен
+#define OUTPUT_DEFAULT_COLS 80 // столбцов экрана, если размер терминала неизвестен
+#define OUTPUT_WATERMARK 128 // байт в очереди терминала, при которых новый кадр ещё отправляется
+#define OUTPUT_DRAIN_MS 1000 // наибольшее ожидание досылки вывода вне игрового цикла
+
+namespace s21 { // начало пространства имён s21
+
+/**
+ * @brief Счётчики вывода в терминал.
+ */
+typedef struct { // статистика вывода
+  uint64_t frames; // показанных кадров
+  uint64_t skipped; // кадров, пропущенных, пока терминал не принял прошлые
+  uint64_t bytes; // байт вывода всех кадров
+  uint64_t last_bytes; // байт последнего кадра
+  uint64_t max_bytes; // самый длинный кадр
+  uint64_t max_queued; // наибольшая очередь (своя и терминала)
+} OutputStats; // имя типа — OutputStats
+
+/**
+ * @brief Вывод ncurses в терминал без блокировок.
+ *
+ * ncurses пишет кадр в канал (stream() передаётся в newterm), а цикл игры перекладывает байты
+ * из канала в свою очередь и дальше в терминал неблокирующей записью (pump). Так запись на
+ * медленный терминал (SSH, последовательная консоль) никогда не останавливает шаги движка и
+ * чтение ввода. Новый кадр показывается (doupdate), только когда своя очередь пуста, а в очереди
+ * терминала не больше watermark байт (ready); иначе кадр пропускается, и следующий doupdate
+ * отправит разницу с уже показанным экраном — терминал получает последнее состояние, а не все
+ * промежуточные. Длина кадра в байтах считается точно по выводу ncurses в канал.
+ *
+ * Дескриптор терминала не переводится в O_NONBLOCK: флаг принадлежит открытому файлу, общему
+ * с оболочкой и другими процессами. Для неблокирующей записи терминал (или канал) открывается
+ * заново отдельным описанием; если это невозможно, запись идёт частями не больше PIPE_BUF после
+ * poll, и такая часть не блокирует.
+ *
+ * Конец канала для записи блокирующий, а вычитывает его тот же поток, что вызывает doupdate:
+ * кадр длиннее ёмкости канала остановил бы ncurses навсегда. Поэтому конструктор проверяет,
+ * что полная перерисовка экрана (клетки терминала × OUTPUT_CELL_BYTES) помещается в канал.
+ */
+class TerminalOutput { // объявление вывода в терминал
+ public: // публичная секция класса
+  explicit TerminalOutput(int sink, size_t watermark = OUTPUT_WATERMARK); // канал для ncurses, throw runtime_error (и если перерисовка не помещается в канал)
+  ~TerminalOutput(); // досылает вывод и закрывает канал
+  TerminalOutput(const TerminalOutput&) = delete; // удалённый копирующий конструктор, запрет копирования
+  TerminalOutput& operator=(const TerminalOutput&) = delete; // удалённый оператор присваивания, запрет копирования
+
+  FILE* stream() const; // поток вывода для newterm
+  void pump(); // байты из канала в очередь и из очереди в терминал, без ожидания
+  bool ready(); // pump и проверка: терминал успевает, можно показать новый кадр
+  void presented(); // кадр выведен: учёт его байт и отправка
+  void skipped(); // кадр пропущен из-за медленного терминала
+  bool flush(int timeout_ms); // досылка всей очереди с ожиданием не дольше timeout_ms, false если не успели
+
+  size_t queued() const; // байт в своей очереди
+  size_t terminal_queued() const; // байт в очереди терминала (TIOCOUTQ, для канала — FIONREAD)
+  size_t capacity() const; // ёмкость канала ncurses: кадр длиннее неё остановил бы ncurses навсегда, конструктор это исключает
+  const OutputStats& stats() const; // счётчики вывода
+  std::vector<std::string> overlay() const; // строки оверлея: байт на кадр и пропуски
+  bool append_summary(const char* path) const; // сводка вывода в конец файла, false если файл не открылся
+
+ private: // приватная секция для внутренних данных
+  size_t collect(); // чтение вывода ncurses из канала в очередь, возвращает прочитанные байты
+  ssize_t write_some(const uint8_t* data, size_t size); // запись без ожидания, 0 — терминал занят
+
+  int sink; // дескриптор терминала (режим записи не меняется)
+  int writer; // отдельное неблокирующее описание терминала (-1 — запись частями после poll)
+  bool sink_tty; // дескриптор терминала — tty
+  int source; // конец канала для чтения
+  FILE* out; // конец канала для записи (поток ncurses)
+  size_t pipe_size; // ёмкость канала
+  size_t watermark; // порог очереди терминала
+  std::vector<uint8_t> queue; // вывод, ещё не принятый терминалом
+  size_t queue_pos; // отправленная часть queue
+  uint64_t frame_bytes; // байт вывода с прошлого показанного кадра
+  OutputStats counters; // счётчики вывода
+}; // конец объявления класса TerminalOutput
+
+}  // namespace s21 // конец пространства имён s21
+
+#endif  // TERMINAL_OUTPUT_H // конец защиты от повторного включения заголовка
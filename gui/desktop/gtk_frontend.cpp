@@ -1,8 +1,12 @@
 #include "gtk_frontend.h" // подключает заголовок с объявлениями класса MyGtkWindow и областей отрисовки
 #define COLOR_RED_BLOCK(cr) \ // макрос для установки красного цвета в контексте Cairo через метод set_source_rgb
     cr->set_source_rgb(1, 0, 0); // задаёт красный цвет (R=1,G=0,B=0) для переданного контекста cr
+#define COLOR_GHOST_BLOCK(cr) \
+    cr->set_source_rgb(0.5, 0.5, 0.5); // задаёт серый цвет контура тени фигуры
 
 #include "../../brick_game/brick_game_single.h" // подключает общий заголовок с игровыми структурами и константами
+#include "../../brick_game/trace.h" // подключает интервалы трассировки
+#include "../../brick_game/pacing.h" // подключает замеры темпа кадров
 
 #define GTK_WINDOW_Y 400 // задаёт высоту окна GTK в пикселях (константа)
 #define GTK_WINDOW_X 550 // задаёт ширину окна GTK в пикселях (константа)
@@ -11,6 +15,10 @@
 #define FRAME_SHIFT 20 // отступы рамки вокруг игрового поля в пикселях
 
 #define NEXT_SHIFT 3 // сдвиг/обрезание области NEXT при расчётах размера кадра
+#define GTK_TICK_MS 5 // период шагов КА, не ждущих таймера, в миллисекундах
+#define OVERLAY_FONT 0.7 // размер шрифта оверлея в блоках поля
+#define REPLAY_FRAME_MS 16 // период кадров просмотра повтора в миллисекундах
+#define REPLAY_JUMP_US 10000000 // перемотка повтора стрелками вверх/вниз в микросекундах
 
 MyGtkWindow::MyGtkWindow() // конструктор окна приложения MyGtkWindow
     : main_box(Gtk::Orientation::VERTICAL), // инициализирует главный вертикальный контейнер
@@ -92,6 +100,15 @@ label {
         sigc::mem_fun(*this, &MyGtkWindow::clicked_button_snake));
     exit_button.signal_clicked().connect( // подключает обработчик нажатия для кнопки Exit
         sigc::mem_fun(*this, &MyGtkWindow::clicked_button_exit));
+
+    if (replay_file != nullptr) { // окно открыто для просмотра повтора
+        try { // файла может не быть или он повреждён
+            replay.reset(new s21::ReplayPlayer(replay_file)); // повтор на первом тике
+            start_game(); // поле вместо стартового экрана
+        } catch (const std::runtime_error &) { // файл не открылся — остаётся стартовый экран
+            replay.reset(); // просмотра нет
+        }
+    }
 } // конец конструктора MyGtkWindow
 
 
@@ -99,6 +116,7 @@ void MyGtkWindow::start_game() { // метод подготовки интерф
     main_box.remove(start_box); // удаляет стартовый бокс из главного контейнера
 
     game_area = Gtk::manage(new GameArea); // создаёт и управляет виджетом игрового поля GameArea
+    game_area->pacer = &pacer; // поле отчитывается о кадрах в замеры окна
     Gtk::Box field_box; // локальный контейнер для поля
     Gtk::Frame *game_area_frame = Gtk::manage(new Gtk::Frame); // создаёт рамку для игрового поля и управляет её памятью
     game_area_frame->set_child(*game_area); // помещает GameArea внутрь рамки
@@ -146,10 +164,22 @@ void MyGtkWindow::start_game() { // метод подготовки интерф
         sigc::mem_fun(*this, &MyGtkWindow::key_press), false);
     add_controller(button_controller); // регистрирует контроллер на уровне окна
 
-    timer_connection = Glib::signal_timeout().connect( // создаёт таймерный сигнал с периодом 5 мс для обновления игры
-        sigc::mem_fun(*this, &MyGtkWindow::update_game), 5);
+    schedule_update(GTK_TICK_MS); // первый шаг игры
 } // конец метода start_game
 
+void MyGtkWindow::schedule_update(unsigned int ms) { // следующий шаг игры через ms миллисекунд
+    timer_connection.disconnect(); // отменяем ранее назначенный шаг
+    timer_connection = Glib::signal_timeout().connect( // однократный таймер (update_game возвращает false)
+        sigc::mem_fun(*this, &MyGtkWindow::update_game), ms);
+} // конец метода schedule_update
+
+MyGtkWindow::~MyGtkWindow() { // деструктор окна приложения
+    if (pacer.total(PACING_INTERVAL).count > 0) { // игра показала хотя бы два кадра
+        const char* path = getenv(PACING_ENV); // путь сводки из окружения
+        pacer.write_summary(path ? path : PACING_FILE); // сводка темпа кадров
+    }
+}
+
 void MyGtkWindow::setup_game_area_frame(Gtk::Frame *game_area_frame) { // настройка внешнего вида и размеров рамки игрового поля
     game_area_frame->set_label_align(Gtk::Align::CENTER); // выравнивание заголовка рамки по центру
     game_area_frame->set_margin_start(FRAME_SHIFT); // левый отступ рамки
@@ -164,16 +194,19 @@ void MyGtkWindow::setup_button_labels() { // сформировать текст
     quit_label.set_markup("<span font_desc='15'>ESC - QUIT</span>"); // задаёт форматированный текст для метки выхода
     pause_label.set_markup("<span font_desc='15'>P - PAUSE</span>"); // задаёт форматированный текст для метки паузы
     action_label.set_markup("<span font_desc='15'>SPACE - ACTION</span>"); // задаёт форматированный текст для метки действия
+    pacing_label.set_markup("<span font_desc='15'>F - FPS</span>"); // задаёт форматированный текст для метки оверлея
     start_label.set_valign(Gtk::Align::START); // вертикальное выравнивание метки START
     quit_label.set_valign(Gtk::Align::START); // вертикальное выравнивание метки QUIT
     pause_label.set_valign(Gtk::Align::START); // вертикальное выравнивание метки PAUSE
     action_label.set_valign(Gtk::Align::START); // вертикальное выравнивание метки ACTION
+    pacing_label.set_valign(Gtk::Align::START); // вертикальное выравнивание метки оверлея
 
     button_box.set_margin_end(50); // правый отступ для блока с метками
     button_box.append(start_label); // добавляет метку START в button_box
     button_box.append(quit_label); // добавляет метку QUIT в button_box
     button_box.append(pause_label); // добавляет метку PAUSE в button_box
     button_box.append(action_label); // добавляет метку ACTION в button_box
+    button_box.append(pacing_label); // добавляет метку оверлея в button_box
 } // конец setup_button_labels
 
 void MyGtkWindow::setup_info_box(Gtk::Frame *next_area_frame) { // настройка информационной панели справа от поля
@@ -209,6 +242,17 @@ void MyGtkWindow::setup_info_box(Gtk::Frame *next_area_frame) { // настро
 bool MyGtkWindow::key_press(guint16 keyval, guint, Gdk::ModifierType state) { // обработчик нажатий клавиш в окне, возвращает флаг продолжения работы
     bool res = true; // результат обработки, true — продолжать таймер/обновления
     (void)state; // явно игнорируем параметр модификаторов, чтобы избежать предупреждений компилятора
+    if (keyval == GDK_KEY_f || keyval == GDK_KEY_F) { // клавиша оверлея — не ввод игры
+        game_area->show_overlay = !game_area->show_overlay; // переключаем оверлей темпа кадров
+        game_area->queue_draw(); // перерисовываем поле с оверлеем или без
+        return res; // ввод в движок не передаётся
+    }
+    if (replay) { // в просмотре повтора клавиши листают запись
+        replay_key(keyval); // перемотка или воспроизведение
+        if (keyval == GDK_KEY_Escape) close(); // выход из просмотра
+        return res; // ввод в движок не передаётся
+    }
+    pacer.input(s21::FramePacer::now_ns()); // задержка ввода отсчитывается до следующего кадра
     if (keyval == GDK_KEY_Right) { // если нажата правая стрелка
         userInput(UserAction_t::Right, false); // отправляем действие Right в движок
     } else if (keyval == GDK_KEY_Left) { // если нажата левая стрелка
@@ -228,9 +272,29 @@ bool MyGtkWindow::key_press(guint16 keyval, guint, Gdk::ModifierType state) { //
         close(); // закрываем окно приложения
         res = false; // устанавливаем результат в false чтобы остановить таймер обновлений
     }
+    if (res) schedule_update(0); // ввод обрабатывается сразу, не дожидаясь срока шага
     return res; // возвращаем флаг продолжения/остановки
 }
 
+void MyGtkWindow::replay_key(guint16 keyval) { // клавиши просмотра повтора
+    if (keyval == GDK_KEY_Left) { // тик назад
+        replay->seek(replay->tick() > 0 ? replay->tick() - 1 : 0); // не раньше первого
+    } else if (keyval == GDK_KEY_Right) { // тик вперёд
+        replay->seek(replay->tick() + 1); // не дальше последнего
+    } else if (keyval == GDK_KEY_Down) { // перемотка назад
+        replay->seek_time(replay->time_us() - REPLAY_JUMP_US); // на REPLAY_JUMP_US раньше
+    } else if (keyval == GDK_KEY_Up) { // перемотка вперёд
+        replay->seek_time(replay->time_us() + REPLAY_JUMP_US); // на REPLAY_JUMP_US позже
+    } else if (keyval == GDK_KEY_Home) { // начало записи
+        replay->seek(0); // первый тик
+    } else if (keyval == GDK_KEY_End) { // конец записи
+        replay->seek(replay->ticks()); // последний тик
+    } else if (keyval == GDK_KEY_space) { // воспроизведение
+        replay->toggle(); // старт или остановка
+    }
+    schedule_update(0); // кадр нового тика сразу
+}
+
 void MyGtkWindow::clicked_button_tetris() { // обработчик клика по кнопке Tetris
     userInput(UserAction_t(Tetris), false); // отправляем в движок выбор игры Tetris
     start_game(); // переключаем интерфейс на игровой режим и запускаем игру
@@ -243,9 +307,26 @@ void MyGtkWindow::clicked_button_snake() { // обработчик клика п
 
 void MyGtkWindow::clicked_button_exit() { close(); } // обработчик клика Exit — закрывает окно
 
-bool MyGtkWindow::update_game() { // вызывается таймером; обновляет состояние игры и интерфейс; возвращает true для продолжения таймера
+bool MyGtkWindow::update_game() { // вызывается таймером; обновляет состояние игры и интерфейс и назначает следующий шаг
+    TRACE_SCOPE("gtk.update_game"); // интервал шага таймера
     bool res = false; // по умолчанию прерываем таймер, если игра завершена или возникла ошибка
+    if (replay) { // просмотр повтора: состояние берётся из тика записи
+        replay->update(); // тик по времени при воспроизведении
+        current_state = replay->gameinfo(); // поле и счётчики тика
+        game_area->game_field = current_state.field; // поле тика
+        game_area->has_ghost = false; // тень в повторе не хранится
+        game_area->queue_draw(); // перерисовка поля
+        next_area->next_field = current_state.next; // область NEXT тика
+        next_area->queue_draw(); // перерисовка NEXT
+        info_update_game(); // счёт, скорость и уровень тика
+        set_title("Brick game replay " + std::to_string(replay->tick() + 1) + "/" + std::to_string(replay->ticks())); // номер тика в заголовке
+        schedule_update(REPLAY_FRAME_MS); // следующий кадр просмотра
+        return res; // false: текущий таймер однократный
+    }
+    uint64_t begin = s21::FramePacer::now_ns(); // начало шага движка
     current_state = updateCurrentState(); // запрашиваем у движка следующий шаг и состояние игры
+    replayRecord(); // тик повтора, если шаг изменил состояние
+    pacer.add(PACING_STEP, s21::FramePacer::now_ns() - begin); // время шага движка
     if (current_state.level == LOSE_LVL) { // если состояние сообщает о проигрыше
         show_game_over_dialog("you lose"); // показываем диалог окончания игры с сообщением о проигрыше
         res = false; // прекращаем таймер обновлений
@@ -254,14 +335,16 @@ bool MyGtkWindow::update_game() { // вызывается таймером; об
         res = false; // прекращаем таймер обновлений
     } else { // если игра продолжается
         game_area->game_field = current_state.field; // передаём указатель на основное поле в виджет игрового поля
+        game_area->has_ghost = getGhost(game_area->ghost); // запрашиваем у движка тень текущей фигуры
         game_area->queue_draw(); // ставим задачу перерисовки игрового поля
 
         next_area->next_field = current_state.next; // передаём указатель на матрицу next во виджет NEXT
         next_area->queue_draw(); // ставим задачу перерисовки области NEXT
         info_update_game(); // обновляем текстовые метки с информацией (счёт, рекорд, скорость, уровень)
-        res = true; // продолжаем таймер обновлений
+        int64_t deadline = nextDeadline(); // микросекунд до шага по таймеру
+        schedule_update(deadline < 0 ? GTK_TICK_MS : (deadline + 999) / 1000); // спим ровно до срока шага
     }
-    return res; // возвращаем флаг продолжения или остановки таймера
+    return res; // false: текущий таймер однократный
 }
 
 void MyGtkWindow::show_game_over_dialog(const Glib::ustring &message) { // отображает модальный диалог с итоговым сообщением
@@ -280,6 +363,7 @@ std::string MyGtkWindow::format_score(const int score) { // форматируе
 }
 
 void MyGtkWindow::info_update_game() { // обновляет метки информационной панели на основе current_state
+    TRACE_SCOPE("gtk.info_update_game"); // интервал обновления меток
     score_value_label.set_markup("<span font_desc='15'>" + format_score(current_state.score) + "</span>"); // обновляем отображение счёта
     hi_score_value_label.set_markup("<span font_desc='15'>" + format_score(current_state.high_score) + "</span>"); // обновляем отображение рекорда
     speed_value_label.set_markup("<span font_desc='15'>" + std::to_string(current_state.speed) + "</span>"); // обновляем отображение скорости
@@ -287,7 +371,9 @@ void MyGtkWindow::info_update_game() { // обновляет метки инфо
 }
 
 void GameArea::on_draw(const Cairo::RefPtr<Cairo::Context> &cr, int width, int height) { // рисование игрового поля через Cairo
+    TRACE_SCOPE("gtk.GameArea.on_draw"); // интервал отрисовки поля
     (void)width; (void)height; // явно игнорируем параметры width и height
+    uint64_t begin = s21::FramePacer::now_ns(); // начало отрисовки кадра
     cr->scale(SCALE, SCALE); // масштабируем контекст, чтобы единица соответствовала одному блоку поля
     if (game_field != nullptr) { // если указатель на поле валиден
         for (int y = 0; y < WINDOW_HEIGHT; y++) { // проходим по всем строкам поля
@@ -299,10 +385,35 @@ void GameArea::on_draw(const Cairo::RefPtr<Cairo::Context> &cr, int width, int h
                 }
             }
         }
+        if (has_ghost) { // если у текущей фигуры есть тень
+            COLOR_GHOST_BLOCK(cr); // устанавливаем цвет контура тени
+            cr->set_line_width(0.1); // толщина контура в масштабированных единицах
+            for (int i = 0; i < GHOST_SIZE; i += 2) { // проходим по блокам тени
+                if (game_field[ghost[i]][ghost[i + 1]] == 0) { // тень рисуем только в пустых ячейках
+                    cr->rectangle(ghost[i + 1] + 0.05, ghost[i] + 0.05, 0.9, 0.9); // контур блока внутри ячейки
+                    cr->stroke(); // обводим контур без заливки
+                }
+            }
+        }
+    }
+    if (pacer != nullptr) { // кадры замеряются
+        if (show_overlay) { // оверлей включён клавишей F
+            cr->set_source_rgb(1, 1, 1); // белый текст поверх поля
+            cr->set_font_size(OVERLAY_FONT); // размер шрифта в блоках поля
+            std::vector<std::string> lines = pacer->overlay(); // FPS, p99 кадра, задержка ввода
+            for (size_t i = 0; i < lines.size(); i++) { // строки оверлея
+                cr->move_to(0.2, 1 + i); // левый верхний угол поля, строка за строкой
+                cr->show_text(lines[i]); // текст строки
+            }
+        }
+        uint64_t now = s21::FramePacer::now_ns(); // кадр отрисован
+        pacer->add(PACING_RENDER, now - begin); // время отрисовки
+        pacer->presented(now); // интервал кадров и задержка ввода
     }
 }
 
 void NextArea::on_draw(const Cairo::RefPtr<Cairo::Context> &cr, int width, int height) { // рисование области NEXT через Cairo
+    TRACE_SCOPE("gtk.NextArea.on_draw"); // интервал отрисовки следующей фигуры
     (void)width; (void)height; // явно игнорируем параметры width и height
     cr->scale(SCALE, SCALE); // масштабируем контекст для удобства рисования блоков
     if (next_field != nullptr) { // если указатель на матрицу next валиден
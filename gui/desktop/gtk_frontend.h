@@ -3,6 +3,10 @@
 
 #include <gtkmm.h> // подключает заголовки библиотеки GTKmm для создания GUI на C++
 #include "../../brick_game//brick_game_single.h" // подключает общий заголовок с определениями игры и константами
+#include "../../brick_game/pacing.h" // подключает замеры темпа кадров
+#include "../../brick_game/replay.h" // подключает просмотр повтора
+
+#include <memory> // подключает std::unique_ptr для просмотра повтора
 
 #define Tetris 1 // макроопределение кода игры Tetris (используется в API выбора игры)
 #define Snake 2 // макроопределение кода игры Snake
@@ -10,8 +14,12 @@
 class GameArea : public Gtk::DrawingArea { // класс виджета для отрисовки основного игрового поля, наследует Gtk::DrawingArea
  public:
   int **game_field; // указатель на матрицу игрового поля, которую виджет отрисовывает
+  int ghost[GHOST_SIZE]; // координаты тени фигуры (пары Y,X)
+  bool has_ghost; // флаг наличия тени фигуры для отрисовки
+  s21::FramePacer *pacer; // замеры кадров окна (nullptr — не замеряются)
+  bool show_overlay; // флаг отрисовки оверлея темпа кадров
 
-  GameArea() : game_field(nullptr) { // конструктор, инициализирует game_field нулевым указателем
+  GameArea() : game_field(nullptr), ghost{}, has_ghost(false), pacer(nullptr), show_overlay(false) { // конструктор, инициализирует game_field нулевым указателем и сбрасывает тень
     set_draw_func(sigc::mem_fun(*this, &GameArea::on_draw)); // устанавливает callback-функцию отрисовки on_draw
   } // конец конструктора
 
@@ -31,6 +39,9 @@ class NextArea : public Gtk::DrawingArea { // класс виджета для 
 class MyGtkWindow : public Gtk::Window { // главный класс окна приложения, наследует Gtk::Window
  public:
   MyGtkWindow(); // конструктор окна, задаёт интерфейс и события
+  ~MyGtkWindow() override; // деструктор окна, пишет сводку темпа кадров
+
+  inline static const char *replay_file = nullptr; // файл повтора для просмотра (задаётся в main до создания окна)
 
  private:
   Glib::RefPtr<Gtk::AlertDialog> dialog; // умный указатель на модальный диалог для оповещений об окончании игры
@@ -50,11 +61,14 @@ class MyGtkWindow : public Gtk::Window { // главный класс окна 
   Gtk::Button exit_button; // кнопка выхода из приложения
 
   GameInfo_t current_state; // структура с текущим состоянием игры, используемая интерфейсом
+  s21::FramePacer pacer; // замеры шага движка, отрисовки и интервалов кадров
+  std::unique_ptr<s21::ReplayPlayer> replay; // просмотр повтора вместо игры (nullptr — игра)
 
   Gtk::Label start_label; // метка подсказки START
   Gtk::Label quit_label; // метка подсказки QUIT
   Gtk::Label pause_label; // метка подсказки PAUSE
   Gtk::Label action_label; // метка подсказки ACTION
+  Gtk::Label pacing_label; // метка подсказки оверлея FPS
 
   Gtk::Label score_label; // текстовая метка "SCORE"
   Gtk::Label score_value_label; // метка для отображения текущего счёта
@@ -72,7 +86,9 @@ class MyGtkWindow : public Gtk::Window { // главный класс окна 
   bool update_game(); // один шаг обновления игры, вызывается таймером; возвращает true для продолжения таймера
   void show_game_over_dialog(const Glib::ustring &message); // показывает диалог завершения игры с детальным сообщением
   bool key_press(guint16 keyval, guint, Gdk::ModifierType state); // обработчик событий клавиатуры для окна
+  void replay_key(guint16 keyval); // перемотка и воспроизведение повтора клавишами
   void start_game(); // переключает интерфейс в режим игры и запускает обновления / события
+  void schedule_update(unsigned int ms); // назначает следующий шаг игры через ms миллисекунд
 
   void setup_button_labels(); // настраивает и добавляет текстовые подписи кнопок управления
   void setup_info_box(Gtk::Frame *next_area_frame); // конфигурирует информационную панель и добавляет в неё NEXT рамку
@@ -1,6 +1,21 @@
 #include "gtk_frontend.h" // подключает заголовок с объявлением MyGtkWindow и виджетов GTK фронтенда
+#include "../../brick_game/trace.h" // подключает запись трассы
+
+#include <cstdlib> // подключает getenv для пути файла трассы
+#include <cstring> // подключает strcmp для ключа просмотра повтора
 
 int main(int argc, char **argv) { // точка входа для GTK-приложения с передачей аргументов командной строки
   auto app = Gtk::Application::create("org.gtkmm.examples.base"); // создаёт экземпляр приложения GTKmm с уникальным ID
-  return app->make_window_and_run<MyGtkWindow>(argc, argv); // создаёт окно типа MyGtkWindow, запускает главный цикл приложения и возвращает код выхода
+  if (argc == 3 && std::strcmp(argv[1], "-r") == 0) { // -r файл — просмотр повтора вместо игры
+    MyGtkWindow::replay_file = argv[2]; // окно откроет повтор
+    argc = 1; // ключи не передаются GTK
+  } // конец разбора ключа
+  traceStart(std::getenv(TRACE_ENV)); // трасса пишется, если задан путь файла
+  const char* flight = std::getenv(FLIGHT_ENV); // файл дампов журнала сессии
+  flightInstall(flight ? flight : FLIGHT_DUMP_FILE); // дампы при поражении, исключении и падении
+  replayStart(MyGtkWindow::replay_file ? nullptr : std::getenv(REPLAY_ENV)); // повтор игры пишется, если задан путь файла
+  int res = app->make_window_and_run<MyGtkWindow>(argc, argv); // создаёт окно типа MyGtkWindow, запускает главный цикл приложения и возвращает код выхода
+  replayStop(); // дописываем индекс и закрываем файл повтора
+  traceStop(); // дописываем и закрываем файл трассы
+  return res; // код выхода приложения
 } // конец main
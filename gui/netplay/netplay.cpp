@@ -0,0 +1,182 @@
+#include "netplay.h" // подключает объявление класса NetplayPeer
+
+#include <arpa/inet.h> // подключает htons и htonl для адреса и порта
+#include <errno.h> // подключает errno для описания ошибок сокета
+#include <netinet/in.h> // подключает sockaddr_in
+#include <poll.h> // подключает poll для ожидания пакетов
+#include <string.h> // подключает strerror
+#include <sys/socket.h> // подключает сокеты
+#include <unistd.h> // подключает close
+
+#include <algorithm> // подключает std::max и std::min
+#include <chrono> // подключает steady_clock для искусственной задержки
+#include <stdexcept> // подключает std::runtime_error для ошибок сокета
+#include <string> // подключает std::string для текста ошибки
+
+#include "../server/protocol.h" // подключает запись и чтение чисел little-endian
+
+namespace s21 { // начало пространства имён s21
+
+static int64_t netplay_now_us() { // монотонное время в микросекундах
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+} // конец функции netplay_now_us
+
+static sockaddr_in loopback(int port) { // адрес 127.0.0.1:port
+  sockaddr_in addr{}; // адрес
+  addr.sin_family = AF_INET; // IPv4
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK); // 127.0.0.1
+  addr.sin_port = htons((uint16_t)port); // порт
+  return addr; // адрес
+} // конец функции loopback
+
+/**
+ * @brief Конструктор.
+ *
+ * @throw std::runtime_error если сокет не удалось создать или привязать
+ */
+NetplayPeer::NetplayPeer(int port, int delay_ms, double loss, unsigned seed)
+    : fd(-1),
+      remote_port(0),
+      delay_us(delay_ms * 1000LL),
+      loss(loss),
+      gen(seed),
+      ack(0),
+      sum_frame(ROLLBACK_NO_FRAME),
+      sum(0),
+      remote_sum_frame(ROLLBACK_NO_FRAME),
+      remote_sum(0),
+      desync(false),
+      counters{} { // узел без соперника
+  fd = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0); // неблокирующий сокет UDP
+  sockaddr_in addr = loopback(port); // адрес узла
+  if (fd < 0 || bind(fd, (sockaddr*)&addr, sizeof(addr)) < 0) { // сокет не создан или порт занят
+    std::string error = std::string("Error: bind udp socket: ") + strerror(errno); // текст ошибки errno
+    if (fd >= 0) close(fd); // закрываем сокет
+    throw std::runtime_error(error); // сообщаем об ошибке
+  } // конец проверки сокета
+} // конец конструктора
+
+NetplayPeer::~NetplayPeer() { close(fd); } // закрывает сокет
+
+int NetplayPeer::port() const { // порт сокета
+  sockaddr_in addr{}; // адрес сокета
+  socklen_t length = sizeof(addr); // длина адреса
+  getsockname(fd, (sockaddr*)&addr, &length); // адрес, выбранный при bind
+  return ntohs(addr.sin_port); // порт
+} // конец метода port
+
+void NetplayPeer::connect(int port) { remote_port = (uint16_t)port; } // адрес соперника
+
+/**
+ * @brief Отправляет пакет с вводом.
+ *
+ * В пакет входит весь свой ввод, начиная с первого кадра, не подтверждённого соперником,
+ * но не старше кольца сессии. Своя контрольная сумма пересчитывается, только когда
+ * сдвинулся последний подтверждённый кадр.
+ */
+void NetplayPeer::send(const RollbackSession& session) { // пакет сопернику
+  if (!remote_port) return; // соперник не задан
+  uint32_t frame = session.frame(); // следующий кадр узла
+  uint32_t first = std::max(ack, frame >= ROLLBACK_MAX_FRAMES - 1 ? frame - (ROLLBACK_MAX_FRAMES - 1) : 0); // первый кадр пакета
+  uint32_t confirmed = session.confirmed_frame(); // последний подтверждённый кадр
+  if (confirmed != sum_frame && session.checksum(confirmed, &sum)) sum_frame = confirmed; // своя контрольная сумма
+  uint8_t buf[NETPLAY_PACKET_SIZE]; // пакет
+  put_u16(buf, NETPLAY_MAGIC); // сигнатура
+  put_u32(buf + 2, session.remote_frames()); // принятый ввод соперника
+  put_u32(buf + 6, first); // первый кадр своего ввода
+  size_t count = 0; // действий в пакете
+  for (uint32_t f = first; f < frame; f++) { // неподтверждённый ввод
+    if (session.local_input(f, &buf[NETPLAY_HEAD_SIZE + count])) count++; // действие кадра
+  } // конец сбора ввода
+  buf[10] = (uint8_t)count; // действий в пакете
+  put_u32(buf + 11, sum_frame); // кадр контрольной суммы
+  put_u32(buf + 15, (uint32_t)sum); // младшая половина суммы
+  put_u32(buf + 19, (uint32_t)(sum >> 32)); // старшая половина суммы
+  if (loss > 0 && std::uniform_real_distribution<double>(0.0, 1.0)(gen) < loss) { // искусственная потеря
+    counters.dropped++; // пакет пропал
+  } else if (delay_us > 0) { // искусственная задержка
+    queue.push_back(Delayed{netplay_now_us() + delay_us, std::vector<uint8_t>(buf, buf + NETPLAY_HEAD_SIZE + count)}); // отправит poll
+  } else { // без задержки
+    transmit(buf, NETPLAY_HEAD_SIZE + count); // пакет сразу
+  } // конец выбора отправки
+} // конец метода send
+
+void NetplayPeer::transmit(const uint8_t* data, size_t size) { // отправка пакета
+  sockaddr_in addr = loopback(remote_port); // адрес соперника
+  if (sendto(fd, data, size, 0, (sockaddr*)&addr, sizeof(addr)) == (ssize_t)size) counters.sent++; // при переполнении буфера пакет теряется, как в сети
+} // конец метода transmit
+
+void NetplayPeer::flush() { // задержанные пакеты
+  int64_t now = netplay_now_us(); // текущий момент
+  while (!queue.empty() && queue.front().due_us <= now) { // срок наступил (задержка у всех одна — очередь упорядочена)
+    transmit(queue.front().data.data(), queue.front().data.size()); // отправка
+    queue.pop_front(); // пакет отправлен
+  } // конец отправки
+} // конец метода flush
+
+/**
+ * @brief Ожидание и приём пакетов.
+ *
+ * Ждёт не дольше timeout_ms и не дольше срока ближайшего задержанного пакета, затем
+ * принимает все пришедшие пакеты и передаёт ввод соперника в сессию.
+ */
+void NetplayPeer::poll(RollbackSession* session, int timeout_ms) { // приём пакетов
+  flush(); // задержанные пакеты
+  if (!queue.empty()) { // ожидание не дольше ближайшего срока
+    int64_t left_ms = (queue.front().due_us - netplay_now_us() + 999) / 1000; // до срока в миллисекундах
+    timeout_ms = (int)std::min<int64_t>(timeout_ms, std::max<int64_t>(left_ms, 0)); // срок ожидания
+  } // конец расчёта ожидания
+  pollfd item = {fd, POLLIN, 0}; // ожидание пакетов
+  ::poll(&item, 1, timeout_ms); // пакет или срок
+  uint8_t buf[NETPLAY_PACKET_SIZE + 1]; // пакет (лишний байт отличает слишком длинный пакет)
+  sockaddr_in from{}; // адрес отправителя
+  socklen_t length = sizeof(from); // длина адреса
+  ssize_t size; // длина пакета
+  while ((size = recvfrom(fd, buf, sizeof(buf), 0, (sockaddr*)&from, &length)) >= 0) { // все пришедшие пакеты
+    if (ntohs(from.sin_port) == remote_port) receive(session, buf, size); // только от соперника
+    length = sizeof(from); // длина адреса для следующего пакета
+  } // конец приёма
+  verify(*session); // сверка отложенной суммы
+  flush(); // пакеты, срок которых наступил во время ожидания
+} // конец метода poll
+
+void NetplayPeer::receive(RollbackSession* session, const uint8_t* data, size_t size) { // разбор пакета
+  if (size < NETPLAY_HEAD_SIZE || get_u16(data) != NETPLAY_MAGIC || size != NETPLAY_HEAD_SIZE + (size_t)data[10]) { // чужой пакет
+    counters.rejected++; // учитываем отказ
+    return; // пакет не разбирается
+  } // конец проверки пакета
+  counters.received++; // учитываем пакет
+  ack = std::max(ack, get_u32(data + 2)); // соперник принял наш ввод
+  uint32_t first = get_u32(data + 6); // первый кадр ввода соперника
+  for (uint32_t i = 0; i < data[10]; i++) { // действия пакета
+    if (first + i >= session->remote_frames()) session->add_remote_input(first + i, data[NETPLAY_HEAD_SIZE + i]); // новые кадры
+  } // конец передачи ввода
+  uint32_t frame = get_u32(data + 11); // кадр контрольной суммы соперника
+  if (frame != ROLLBACK_NO_FRAME && remote_sum_frame == ROLLBACK_NO_FRAME) { // сверять нечего — берём новую сумму
+    remote_sum_frame = frame; // кадр суммы
+    remote_sum = (uint64_t)get_u32(data + 15) | ((uint64_t)get_u32(data + 19) << 32); // сумма соперника
+  } // конец приёма суммы
+} // конец метода receive
+
+/**
+ * @brief Сверяет контрольную сумму соперника со своей.
+ *
+ * Сумма соперника ждёт, пока свой узел не подтвердит тот же кадр; если кадр ушёл из кольца
+ * раньше, сумма отбрасывается без сверки.
+ */
+void NetplayPeer::verify(const RollbackSession& session) { // сверка суммы
+  uint64_t own = 0; // своя сумма того же кадра
+  if (remote_sum_frame == ROLLBACK_NO_FRAME) return; // сверять нечего
+  if (session.checksum(remote_sum_frame, &own)) { // кадр подтверждён и у себя
+    desync = desync || own != remote_sum; // суммы разошлись
+    remote_sum_frame = ROLLBACK_NO_FRAME; // сумма сверена
+  } else if (remote_sum_frame + ROLLBACK_MAX_FRAMES < session.frame()) { // кадр уже не в кольце
+    remote_sum_frame = ROLLBACK_NO_FRAME; // сумма отбрасывается
+  } // конец сверки
+} // конец метода verify
+
+bool NetplayPeer::desynced() const { return desync; } // суммы разошлись
+uint32_t NetplayPeer::acked() const { return ack; } // кадров своего ввода, принятых соперником
+const NetplayStats& NetplayPeer::stats() const { return counters; } // счётчики пакетов
+
+}  // namespace s21 // конец пространства имён s21
@@ -0,0 +1,91 @@
+#ifndef NETPLAY_H // защита от повторного включения заголовка: если NETPLAY_H не определён
+#define NETPLAY_H // определяет макрос NETPLAY_H чтобы предотвратить повторное включение
+
+#include <stddef.h> // подключает size_t для длин пакетов
+#include <stdint.h> // подключает целые типы фиксированной ширины
+
+#include <deque> // подключает очередь пакетов с искусственной задержкой
+#include <random> // подключает генератор искусственных потерь
+#include <vector> // подключает std::vector для данных пакетов
+
+#include "../../brick_game/tetris/rollback.h" // подключает сессию с откатом
+
+/*
+ * Пакет UDP сетевого матча (все многобайтовые числа — little-endian):
+ *   {magic u16, ack u32, first u32, count u8, check_frame u32, checksum u64} и count действий u8.
+ * ack — сколько кадров ввода отправителя уже принято от получателя; first и count — кадры
+ * своего ввода, ещё не подтверждённые получателем (каждый пакет повторяет их все, поэтому
+ * потеря пакета не требует отдельного повтора); check_frame и checksum — контрольная сумма
+ * последнего подтверждённого кадра отправителя (ROLLBACK_NO_FRAME — суммы нет).
+ */
+
+#define NETPLAY_MAGIC 0x504e // сигнатура пакета "NP"
+#define NETPLAY_HEAD_SIZE 23 // длина пакета до списка действий
+#define NETPLAY_PACKET_SIZE (NETPLAY_HEAD_SIZE + ROLLBACK_MAX_FRAMES) // наибольшая длина пакета
+#define NETPLAY_DEFAULT_PORT 7780 // порт узла 0 по умолчанию (узел 1 — следующий)
+
+namespace s21 { // начало пространства имён s21
+
+/**
+ * @brief Счётчики пакетов узла.
+ */
+typedef struct { // статистика транспорта
+  uint64_t sent; // отправлено пакетов
+  uint64_t dropped; // пакетов, выброшенных искусственной потерей
+  uint64_t received; // принято пакетов
+  uint64_t rejected; // пакетов с неверной сигнатурой или длиной
+} NetplayStats; // имя типа — NetplayStats
+
+/**
+ * @brief Узел сетевого матча поверх UDP на 127.0.0.1.
+ *
+ * Переносит ввод RollbackSession между двумя процессами (или потоками) и сверяет контрольные
+ * суммы подтверждённых кадров: расхождение означает рассинхронизацию движков (desynced).
+ * Для проверки на одной машине отправка умеет искусственную задержку delay_ms (пакет ждёт
+ * в очереди и уходит из poll) и потерю доли loss пакетов.
+ */
+class NetplayPeer { // объявление узла
+ public: // публичная секция класса
+  NetplayPeer(int port, int delay_ms = 0, double loss = 0.0, unsigned seed = 0); // сокет на 127.0.0.1:port, throw runtime_error
+  ~NetplayPeer(); // закрывает сокет
+  NetplayPeer(const NetplayPeer&) = delete; // удалённый копирующий конструктор, запрет копирования
+  NetplayPeer& operator=(const NetplayPeer&) = delete; // удалённый оператор присваивания, запрет копирования
+
+  int port() const; // порт сокета (при port 0 — выбранный системой)
+  void connect(int port); // адрес соперника 127.0.0.1:port
+  void send(const RollbackSession& session); // пакет с неподтверждённым вводом и контрольной суммой
+  void poll(RollbackSession* session, int timeout_ms); // отправка задержанных пакетов и приём ввода соперника
+
+  bool desynced() const; // контрольные суммы узлов разошлись
+  uint32_t acked() const; // кадров своего ввода, принятых соперником
+  const NetplayStats& stats() const; // счётчики пакетов
+
+ private: // приватная секция для внутренних структур и данных
+  struct Delayed { // пакет с искусственной задержкой
+    int64_t due_us; // момент отправки
+    std::vector<uint8_t> data; // данные пакета
+  }; // конец объявления Delayed
+
+  void transmit(const uint8_t* data, size_t size); // отправка пакета сопернику
+  void flush(); // отправка задержанных пакетов, срок которых наступил
+  void receive(RollbackSession* session, const uint8_t* data, size_t size); // разбор пакета соперника
+  void verify(const RollbackSession& session); // сверка контрольной суммы соперника со своей
+
+  int fd; // сокет UDP
+  uint16_t remote_port; // порт соперника (0 — не задан)
+  int64_t delay_us; // искусственная задержка
+  double loss; // доля теряемых пакетов
+  std::mt19937 gen; // генератор потерь
+  std::deque<Delayed> queue; // пакеты, ожидающие отправки
+  uint32_t ack; // кадров своего ввода, принятых соперником
+  uint32_t sum_frame; // кадр своей последней контрольной суммы
+  uint64_t sum; // своя последняя контрольная сумма
+  uint32_t remote_sum_frame; // кадр контрольной суммы соперника, ожидающей сверки
+  uint64_t remote_sum; // контрольная сумма соперника
+  bool desync; // суммы разошлись
+  NetplayStats counters; // счётчики пакетов
+}; // конец объявления класса NetplayPeer
+
+}  // namespace s21 // конец пространства имён s21
+
+#endif  // NETPLAY_H // конец защиты от повторного включения заголовка
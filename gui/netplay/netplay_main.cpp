@@ -0,0 +1,82 @@
+#include <stdio.h> // подключает printf и fprintf для итогов матча
+#include <stdlib.h> // подключает atoi и atof для разбора аргументов
+#include <string.h> // подключает strcmp для разбора аргументов
+
+#include <chrono> // подключает steady_clock для темпа кадров
+#include <random> // подключает генератор ввода бота
+
+#include "netplay.h" // подключает узел сетевого матча
+
+#define NETPLAY_DEFAULT_FRAMES 3600 // кадров матча по умолчанию (минута при 60 кадрах в секунду)
+#define NETPLAY_LINGER_MS 1000 // сколько узел ещё отвечает сопернику после своего последнего кадра
+#define NETPLAY_BOT_RATE 6 // бот нажимает в среднем раз в столько кадров
+
+using Clock = std::chrono::steady_clock; // часы темпа кадров
+
+/**
+ * Матч двух процессов на одной машине:
+ *   BrickGameNetplay -p 0 -d 40 -x 10 &
+ *   BrickGameNetplay -p 1 -d 40 -x 10
+ * Каждый узел играет ботом со случайным вводом, шагает 60 кадров в секунду и в конце печатает
+ * контрольную сумму последнего кадра: у обоих узлов она должна совпасть.
+ */
+int main(int argc, char** argv) { // точка входа: BrickGameNetplay [-p игрок] [-l порт] [-r порт] [-s зерно] [-d мс] [-x %] [-f кадры] [-k окно]
+  int player = 0, local_port = -1, remote_port = -1, delay_ms = 0, frames = NETPLAY_DEFAULT_FRAMES; // параметры узла
+  int prediction = ROLLBACK_MAX_PREDICTION; // окно предсказания
+  unsigned seed = 1; // зерно матча (одинаковое у обоих узлов)
+  double loss = 0.0; // доля теряемых пакетов
+  for (int i = 1; i + 1 < argc; i++) { // ключи со значениями
+    if (strcmp(argv[i], "-p") == 0) player = atoi(argv[++i]); // номер игрока
+    else if (strcmp(argv[i], "-l") == 0) local_port = atoi(argv[++i]); // свой порт
+    else if (strcmp(argv[i], "-r") == 0) remote_port = atoi(argv[++i]); // порт соперника
+    else if (strcmp(argv[i], "-s") == 0) seed = (unsigned)atoi(argv[++i]); // зерно матча
+    else if (strcmp(argv[i], "-d") == 0) delay_ms = atoi(argv[++i]); // искусственная задержка
+    else if (strcmp(argv[i], "-x") == 0) loss = atof(argv[++i]) / 100.0; // искусственная потеря в процентах
+    else if (strcmp(argv[i], "-f") == 0) frames = atoi(argv[++i]); // кадров матча
+    else if (strcmp(argv[i], "-k") == 0) prediction = atoi(argv[++i]); // окно предсказания
+  } // конец разбора аргументов
+  if (local_port < 0) local_port = NETPLAY_DEFAULT_PORT + player; // порт узла по умолчанию
+  if (remote_port < 0) remote_port = NETPLAY_DEFAULT_PORT + 1 - player; // порт соперника по умолчанию
+
+  int res = 0; // код завершения
+  try { // ошибки сокета и параметров
+    s21::RollbackSession session(player, seed, prediction); // матч узла
+    s21::NetplayPeer peer(local_port, delay_ms, loss, seed * 2 + player); // транспорт
+    peer.connect(remote_port); // соперник
+    std::mt19937 bot(seed * 31 + player); // ввод бота
+    const UserAction_t moves[] = {Left, Right, Action, Down, Up}; // действия бота
+    Clock::time_point next = Clock::now(), last = next; // срок следующего кадра и момент последнего полезного обмена
+    bool done = false; // свой ввод и ввод соперника закончены
+    while (!done || Clock::now() - last < std::chrono::milliseconds(NETPLAY_LINGER_MS)) { // матч и ответы после него
+      peer.poll(&session, 1); // ввод соперника
+      if (!done && (int)session.frame() < frames && Clock::now() >= next) { // срок кадра
+        session.add_local_input(bot() % NETPLAY_BOT_RATE ? ROLLBACK_NO_INPUT : moves[bot() % 5]); // ввод бота
+        if (session.advance()) next += std::chrono::microseconds(ROLLBACK_TICK_US); // кадр сделан
+        if (Clock::now() - next > std::chrono::milliseconds(100)) next = Clock::now(); // отставание не догоняем
+      } // конец кадра
+      peer.send(session); // ввод сопернику (повтор неподтверждённого)
+      if (!done && (int)session.frame() >= frames && (int)session.remote_frames() >= frames) { // все кадры известны
+        session.synchronize(); // последний откат
+        done = true; // матч окончен
+      } // конец проверки окончания
+      if (!done || (int)peer.acked() < frames) last = Clock::now(); // соперник ещё ждёт наш ввод
+    } // конец цикла матча
+    uint64_t sum = 0; // контрольная сумма последнего кадра
+    session.checksum(session.frame(), &sum); // сумма подтверждённого кадра
+    const s21::RollbackStats& stats = session.stats(); // счётчики отката
+    const s21::NetplayStats& net = peer.stats(); // счётчики пакетов
+    printf("player %d: frames %u, checksum %016llx, winner %d, desync %s\n", player, session.frame(),
+           (unsigned long long)sum, session.match().winner(), peer.desynced() ? "YES" : "no"); // итог матча
+    printf("rollbacks %llu, resimulated %llu, stalls %llu, max rollback %lld us, avg %.1f frames/ms\n",
+           (unsigned long long)stats.rollbacks, (unsigned long long)stats.resimulated, (unsigned long long)stats.stalls,
+           (long long)stats.max_rollback_us,
+           stats.rollback_us ? stats.resimulated * 1000.0 / stats.rollback_us : 0.0); // откаты
+    printf("packets sent %llu, dropped %llu, received %llu, rejected %llu\n", (unsigned long long)net.sent,
+           (unsigned long long)net.dropped, (unsigned long long)net.received, (unsigned long long)net.rejected); // пакеты
+    res = peer.desynced() ? 2 : 0; // рассинхронизация — отдельный код
+  } catch (const std::exception& e) { // сокет не создан или неверные параметры
+    fprintf(stderr, "%s\n", e.what()); // сообщение об ошибке
+    res = 1; // код ошибки
+  } // конец обработки ошибок
+  return res; // код завершения
+} // конец main
@@ -0,0 +1,92 @@
+#ifndef PROTOCOL_H // защита от повторного включения заголовка: если PROTOCOL_H не определён
+#define PROTOCOL_H // определяет макрос PROTOCOL_H чтобы предотвратить повторное включение
+
+#include <stddef.h> // подключает size_t для длин сообщений
+#include <stdint.h> // подключает целые типы фиксированной ширины для полей протокола
+
+/*
+ * Двоичный протокол сервера BrickGame.
+ *
+ * Каждое сообщение — заголовок PROTO_HEADER_SIZE байт {type u8, flags u8, length u16}
+ * и length байт данных. Все многобайтовые числа — little-endian.
+ *
+ * Клиент -> сервер:
+ *   MSG_CREATE  {game u8, pieces u8, height u16, width u16} — создать сессию (одна на соединение)
+ *   MSG_INPUT   {action u8, hold u8} — действие игрока, аналог userInput
+ *   MSG_CLOSE   {} — завершить сессию, соединение остаётся открытым
+ *   MSG_WATCH   {session u32} — смотреть трансляцию сессии (0 — перестать смотреть)
+ *
+ * Сервер -> клиент:
+ *   MSG_CREATED {session u32, height u16, width u16} — сессия создана, поле height x width
+ *   MSG_DELTA   {score i32, high_score i32, level i32, speed i32, pause u8, count u16}
+ *               и count клеток {plane u8, row u16, col u16, value i8} — изменения с прошлого MSG_DELTA,
+ *               аналог updateCurrentState; флаг DELTA_FLAG_MORE — следом идёт продолжение кадра
+ *   MSG_ERROR   {code u8} — ошибка запроса
+ *   MSG_WATCHING {session u32, height u16, width u16} — зритель подписан на трансляцию
+ *   MSG_FRAME   {session u32, seq u32, score i32, high_score i32, level i32, speed i32, pause u8,
+ *               height u16, width u16}, битовая карта клеток поля и области next и серии
+ *               {длина u8, значение i8} — кадр трансляции (см. FrameEncoder), флаг FRAME_FLAG_KEY —
+ *               опорный кадр
+ */
+
+#define PROTO_HEADER_SIZE 4 // размер заголовка сообщения
+#define PROTO_MAX_PAYLOAD 65535 // наибольшая длина данных сообщения (поле length u16)
+
+#define MSG_CREATE 0x01 // создание сессии
+#define MSG_INPUT 0x02 // действие игрока
+#define MSG_CLOSE 0x03 // завершение сессии
+#define MSG_WATCH 0x04 // подписка на трансляцию
+#define MSG_CREATED 0x81 // сессия создана
+#define MSG_DELTA 0x82 // изменения состояния
+#define MSG_ERROR 0x83 // ошибка запроса
+#define MSG_WATCHING 0x84 // подписка оформлена
+#define MSG_FRAME 0x85 // кадр трансляции
+
+#define CREATE_SIZE 6 // длина данных MSG_CREATE
+#define INPUT_SIZE 2 // длина данных MSG_INPUT
+#define WATCH_SIZE 4 // длина данных MSG_WATCH
+#define CREATED_SIZE 8 // длина данных MSG_CREATED
+#define WATCHING_SIZE 8 // длина данных MSG_WATCHING
+#define DELTA_HEAD_SIZE 19 // длина данных MSG_DELTA до списка клеток
+#define DELTA_CELL_SIZE 6 // длина описания одной клетки в MSG_DELTA
+#define DELTA_MAX_CELLS ((PROTO_MAX_PAYLOAD - DELTA_HEAD_SIZE) / DELTA_CELL_SIZE) // клеток в одном сообщении
+
+#define DELTA_FLAG_MORE 0x01 // кадр продолжается в следующем MSG_DELTA
+#define FRAME_FLAG_KEY 0x01 // опорный кадр трансляции
+
+#define PLANE_FIELD 0 // клетка игрового поля gameinfo.field
+#define PLANE_NEXT 1 // клетка области следующей фигуры gameinfo.next
+
+#define ERR_BAD_MESSAGE 1 // неизвестный тип или неверная длина сообщения
+#define ERR_NO_SESSION 2 // действие без созданной сессии
+#define ERR_SESSION_EXISTS 3 // повторное создание сессии в соединении
+#define ERR_BAD_GAME 4 // неизвестная игра или недопустимый размер поля
+#define ERR_TOO_LARGE 5 // поле сессии слишком велико для трансляции
+
+namespace s21 { // начало пространства имён s21
+
+inline void put_u16(uint8_t* buf, uint16_t value) { // запись u16 little-endian
+  buf[0] = (uint8_t)value; // младший байт
+  buf[1] = (uint8_t)(value >> 8); // старший байт
+} // конец функции put_u16
+
+inline void put_u32(uint8_t* buf, uint32_t value) { // запись u32 little-endian
+  put_u16(buf, (uint16_t)value); // младшая половина
+  put_u16(buf + 2, (uint16_t)(value >> 16)); // старшая половина
+} // конец функции put_u32
+
+inline uint16_t get_u16(const uint8_t* buf) { return (uint16_t)(buf[0] | (buf[1] << 8)); } // чтение u16 little-endian
+
+inline uint32_t get_u32(const uint8_t* buf) { // чтение u32 little-endian
+  return (uint32_t)get_u16(buf) | ((uint32_t)get_u16(buf + 2) << 16); // младшая и старшая половины
+} // конец функции get_u32
+
+inline void put_header(uint8_t* buf, uint8_t type, uint8_t flags, size_t length) { // запись заголовка сообщения
+  buf[0] = type; // тип сообщения
+  buf[1] = flags; // флаги
+  put_u16(buf + 2, (uint16_t)length); // длина данных
+} // конец функции put_header
+
+}  // namespace s21 // конец пространства имён s21
+
+#endif  // PROTOCOL_H // конец защиты от повторного включения заголовка
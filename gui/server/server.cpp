@@ -0,0 +1,543 @@
+#include "server.h" // подключает объявление класса GameServer
+
+#include <arpa/inet.h> // подключает htons и htonl для адреса и порта
+#include <errno.h> // подключает errno для разбора ошибок неблокирующих вызовов
+#include <netinet/in.h> // подключает sockaddr_in
+#include <netinet/tcp.h> // подключает TCP_NODELAY
+#include <string.h> // подключает memcpy и strerror
+#include <sys/epoll.h> // подключает epoll
+#include <sys/socket.h> // подключает сокеты
+#include <sys/timerfd.h> // подключает timerfd для таймера гравитации
+#include <sys/un.h> // подключает sockaddr_un
+#include <unistd.h> // подключает close, read и unlink
+
+#include <algorithm> // подключает std::min и std::remove
+#include <chrono> // подключает steady_clock для сроков шагов
+
+namespace s21 { // начало пространства имён s21
+
+static void throw_errno(const char* what) { // исключение с описанием последней системной ошибки
+  throw std::runtime_error(std::string("Error: ") + what + ": " + strerror(errno)); // текст ошибки errno
+} // конец функции throw_errno
+
+static uint64_t server_now_us() { // монотонное время в микросекундах (те же часы, что у Timer)
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count(); // микросекунды
+} // конец функции server_now_us
+
+GameServer::GameServer()
+    : epoll_fd(-1), timer_fd(-1), running(true), next_session(0), session_count(0),
+      wheel(server_now_us()) { // конструктор сервера
+  epoll_fd = epoll_create1(EPOLL_CLOEXEC); // экземпляр epoll
+  if (epoll_fd < 0) throw_errno("epoll_create1"); // epoll недоступен
+  timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC); // таймер гравитации
+  if (timer_fd < 0) { // таймер не создан
+    close(epoll_fd); // деструктор не будет вызван
+    throw_errno("timerfd_create"); // сообщаем об ошибке
+  } // конец проверки таймера
+  itimerspec period{}; // период таймера
+  period.it_interval.tv_nsec = SERVER_TICK_MS * 1000000L; // повтор каждые SERVER_TICK_MS мс
+  period.it_value = period.it_interval; // первое срабатывание через тот же период
+  timerfd_settime(timer_fd, 0, &period, nullptr); // запуск таймера
+  epoll_event event{}; // подписка на таймер
+  event.events = EPOLLIN; // срабатывание таймера — готовность к чтению
+  event.data.fd = timer_fd; // источник события
+  epoll_ctl(epoll_fd, EPOLL_CTL_ADD, timer_fd, &event); // регистрация таймера
+} // конец конструктора
+
+GameServer::~GameServer() { // деструктор сервера
+  while (!conns.empty()) close_connection(conns.begin()->first); // соединения и их сессии
+  for (int fd : listen_fds) close(fd); // прослушивающие сокеты
+  if (!unix_path.empty()) unlink(unix_path.c_str()); // файл Unix-сокета
+  close(timer_fd); // таймер
+  close(epoll_fd); // epoll
+} // конец деструктора
+
+/**
+ * @brief Начинает прослушивание Unix-сокета.
+ *
+ * Оставшийся от прошлого запуска файл сокета удаляется.
+ * @throw std::runtime_error если сокет не удалось создать или привязать
+ */
+void GameServer::listen_unix(const std::string& path) { // прослушивание Unix-сокета
+  sockaddr_un addr{}; // адрес сокета
+  if (path.size() >= sizeof(addr.sun_path)) throw std::runtime_error("Error: Socket path is too long"); // путь не помещается
+  addr.sun_family = AF_UNIX; // Unix-сокет
+  memcpy(addr.sun_path, path.c_str(), path.size() + 1); // путь вместе с нулём
+  int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0); // неблокирующий сокет
+  if (fd < 0) throw_errno("socket"); // сокет не создан
+  unlink(path.c_str()); // удаляем старый файл сокета
+  if (bind(fd, (sockaddr*)&addr, sizeof(addr)) < 0 || listen(fd, SOMAXCONN) < 0) { // привязка и прослушивание
+    close(fd); // сокет больше не нужен
+    throw_errno("bind unix socket"); // сообщаем об ошибке
+  } // конец проверки привязки
+  unix_path = path; // файл удаляется в деструкторе
+  add_listener(fd); // регистрация в epoll
+} // конец метода listen_unix
+
+/**
+ * @brief Начинает прослушивание TCP на 127.0.0.1.
+ *
+ * @param port номер порта, 0 — любой свободный
+ * @return номер порта, к которому привязан сокет
+ * @throw std::runtime_error если сокет не удалось создать или привязать
+ */
+int GameServer::listen_tcp(int port) { // прослушивание TCP
+  int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0); // неблокирующий сокет
+  if (fd < 0) throw_errno("socket"); // сокет не создан
+  int yes = 1; // значение опции
+  setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes)); // повторный запуск на том же порту
+  sockaddr_in addr{}; // адрес сокета
+  addr.sin_family = AF_INET; // IPv4
+  addr.sin_port = htons((uint16_t)port); // порт
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK); // только локальные соединения
+  socklen_t length = sizeof(addr); // размер адреса
+  if (bind(fd, (sockaddr*)&addr, length) < 0 || listen(fd, SOMAXCONN) < 0 ||
+      getsockname(fd, (sockaddr*)&addr, &length) < 0) { // привязка, прослушивание и выбранный порт
+    close(fd); // сокет больше не нужен
+    throw_errno("bind tcp socket"); // сообщаем об ошибке
+  } // конец проверки привязки
+  add_listener(fd); // регистрация в epoll
+  return ntohs(addr.sin_port); // порт, выбранный системой
+} // конец метода listen_tcp
+
+void GameServer::add_listener(int fd) { // регистрация прослушивающего сокета
+  epoll_event event{}; // подписка на новые соединения
+  event.events = EPOLLIN; // соединение ожидает приёма
+  event.data.fd = fd; // источник события
+  epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event); // регистрация сокета
+  listen_fds.push_back(fd); // запоминаем сокет
+} // конец метода add_listener
+
+/**
+ * @brief Одна итерация цикла событий.
+ *
+ * Ждёт события не дольше timeout_ms миллисекунд и обрабатывает их: таймер, новые
+ * соединения, чтение и запись. Соединения, помеченные к закрытию, закрываются в конце итерации.
+ */
+void GameServer::run_once(int timeout_ms) { // итерация цикла событий
+  epoll_event events[SERVER_MAX_EVENTS]; // готовые события
+  int count = epoll_wait(epoll_fd, events, SERVER_MAX_EVENTS, timeout_ms); // ожидание событий
+  for (int i = 0; i < count; i++) { // проход по событиям
+    int fd = events[i].data.fd; // источник события
+    auto it = conns.find(fd); // соединение источника
+    if (fd == timer_fd) { // таймер гравитации
+      uint64_t expirations = 0; // число пропущенных срабатываний (шаг делается один)
+      if (read(timer_fd, &expirations, sizeof(expirations)) > 0) on_tick(); // шаг всех сессий
+    } else if (it == conns.end()) { // прослушивающий сокет
+      accept_all(fd); // приём соединений
+    } else if (it->second->closing) { // соединение уже помечено к закрытию
+      continue; // события больше не обрабатываются
+    } else if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) { // данные или закрытие
+      on_readable(it->second.get()); // чтение обнаружит и закрытие соединения
+      if (events[i].events & EPOLLOUT) on_writable(it->second.get()); // место в сокете освободилось
+    } else if (events[i].events & EPOLLOUT) { // место в сокете освободилось
+      on_writable(it->second.get()); // отправка буфера
+    } // конец выбора источника
+  } // конец прохода по событиям
+  std::vector<int> dead; // соединения к закрытию
+  for (auto& entry : conns) // проход по соединениям
+    if (entry.second->closing) dead.push_back(entry.first); // помечено к закрытию
+  for (int fd : dead) close_connection(fd); // закрываем после обработки всех событий
+} // конец метода run_once
+
+void GameServer::run() { // цикл событий
+  while (running.load()) run_once(100); // проверка флага остановки не реже 10 раз в секунду
+} // конец метода run
+
+void GameServer::stop() { running.store(false); } // остановка цикла run
+
+size_t GameServer::connections() const { return conns.size(); } // количество соединений
+
+size_t GameServer::sessions() const { return session_count; } // количество сессий
+
+void GameServer::accept_all(int listen_fd) { // приём ожидающих соединений
+  for (;;) { // до опустошения очереди приёма
+    int fd = accept4(listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC); // неблокирующее соединение
+    if (fd < 0) break; // очередь пуста или ошибка
+    int yes = 1; // значение опции
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(yes)); // кадры без задержки (для Unix-сокета не действует)
+    std::unique_ptr<Connection> conn(new Connection); // состояние соединения
+    conn->fd = fd; // дескриптор
+    epoll_event event{}; // подписка на чтение
+    event.events = EPOLLIN; // запись включается только при непустом буфере
+    event.data.fd = fd; // источник события
+    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event); // регистрация соединения
+    conns[fd] = std::move(conn); // запоминаем соединение
+  } // конец цикла приёма
+} // конец метода accept_all
+
+/**
+ * @brief Читает доступное из сокета и обрабатывает полные сообщения.
+ *
+ * За одно событие читается не больше SERVER_READ_BUDGET байт, чтобы один быстрый клиент не
+ * занимал цикл событий: epoll сообщает о готовности по уровню, и остаток будет прочитан на
+ * следующей итерации. Неполное сообщение остаётся во входном буфере до следующего чтения;
+ * входной буфер больше SERVER_IN_LIMIT означает нарушение протокола, и соединение закрывается.
+ */
+void GameServer::on_readable(Connection* conn) { // чтение соединения
+  uint8_t chunk[SERVER_READ_CHUNK]; // блок чтения
+  for (size_t total = 0; total < SERVER_READ_BUDGET;) { // до опустошения сокета или бюджета события
+    ssize_t n = recv(conn->fd, chunk, sizeof(chunk), 0); // чтение блока
+    if (n > 0) { // получены данные
+      conn->in.insert(conn->in.end(), chunk, chunk + n); // добавляем во входной буфер
+      total += n; // бюджет события
+      if (conn->in.size() > SERVER_IN_LIMIT) conn->closing = true; // клиент шлёт больше, чем можно разобрать
+      if (conn->closing) break; // дальше не читаем
+    } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) { // данных больше нет
+      break; // ждём следующего события
+    } else if (n < 0 && errno == EINTR) { // прерывание сигналом
+      continue; // повторяем чтение
+    } else { // соединение закрыто клиентом или ошибка
+      conn->closing = true; // закрытие в конце итерации
+      break; // дальше не читаем
+    } // конец разбора результата чтения
+  } // конец цикла чтения
+  size_t pos = 0; // начало неразобранных данных
+  while (!conn->closing && conn->in.size() - pos >= PROTO_HEADER_SIZE) { // есть полный заголовок
+    const uint8_t* header = conn->in.data() + pos; // заголовок сообщения
+    size_t length = get_u16(header + 2); // длина данных
+    if (conn->in.size() - pos < PROTO_HEADER_SIZE + length) break; // сообщение пришло не целиком
+    handle_message(conn, header[0], header + PROTO_HEADER_SIZE, length); // обработка сообщения
+    pos += PROTO_HEADER_SIZE + length; // следующее сообщение
+  } // конец разбора сообщений
+  conn->in.erase(conn->in.begin(), conn->in.begin() + pos); // удаляем разобранные сообщения
+  on_writable(conn); // отправка ответов
+} // конец метода on_readable
+
+/**
+ * @brief Отправляет выходной буфер, пока сокет принимает данные.
+ *
+ * Остаток ждёт EPOLLOUT; при превышении SERVER_OUT_LIMIT (клиент не читает)
+ * соединение закрывается.
+ */
+void GameServer::on_writable(Connection* conn) { // отправка буфера
+  bool progress = true; // сокет принимает данные
+  while (progress && !conn->closing) { // пока есть что отправлять
+    if (conn->frame_pos == 0 && conn->out_pos < conn->out.size()) { // ответы — между кадрами трансляции
+      progress = write_some(conn, conn->out.data(), conn->out.size(), &conn->out_pos); // отправка ответов
+    } else if (!conn->frames.empty()) { // кадры трансляции
+      const std::vector<uint8_t>& frame = *conn->frames.front(); // первый кадр очереди
+      progress = write_some(conn, frame.data(), frame.size(), &conn->frame_pos); // отправка кадра
+      if (conn->frame_pos == frame.size()) { // кадр отправлен целиком
+        conn->frames.pop_front(); // общий буфер освобождается вместе с последней ссылкой
+        conn->frame_pos = 0; // следующий кадр
+      } // конец проверки кадра
+    } else { // отправлять нечего
+      progress = false; // выход из цикла
+    } // конец выбора данных
+  } // конец цикла отправки
+  if (conn->out_pos == conn->out.size()) { // всё отправлено
+    conn->out.clear(); // буфер пуст
+    conn->out_pos = 0; // начало буфера
+  } else if (conn->out.size() - conn->out_pos > SERVER_OUT_LIMIT) { // клиент не успевает читать
+    conn->closing = true; // закрытие в конце итерации
+  } // конец проверки остатка
+  if (!conn->closing) update_events(conn); // подписка на EPOLLOUT по остатку
+} // конец метода on_writable
+
+/**
+ * @brief Одна попытка отправить data[*pos..size).
+ *
+ * @return true если данные отправлены частично или вызов прерван сигналом,
+ * false если сокет заполнен или соединение разорвано (тогда оно помечается к закрытию)
+ */
+bool GameServer::write_some(Connection* conn, const uint8_t* data, size_t size, size_t* pos) { // попытка отправки
+  bool res = true; // по умолчанию отправка продолжается
+  ssize_t n = send(conn->fd, data + *pos, size - *pos, MSG_NOSIGNAL); // отправка без SIGPIPE
+  if (n > 0) { // часть данных отправлена
+    *pos += n; // сдвигаем начало неотправленных данных
+  } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) { // сокет заполнен
+    res = false; // ждём EPOLLOUT
+  } else if (n < 0 && errno != EINTR) { // ошибка соединения
+    conn->closing = true; // закрытие в конце итерации
+    res = false; // отправка прекращена
+  } // конец разбора результата отправки
+  return res; // результат попытки
+} // конец метода write_some
+
+/**
+ * @brief Шаг сессий с наступившим сроком.
+ *
+ * Аналог updateCurrentState: один вызов fsm сессии и кадр с изменениями. Часы читаются
+ * один раз за тик, сессии без наступившего срока не затрагиваются, поэтому тик стоит
+ * пропорционально числу сессий, которым пора шагать. Если их больше SERVER_TICK_BUDGET,
+ * остальные остаются в очереди готовых и шагают первыми на следующем тике.
+ */
+void GameServer::on_tick() { // шаг сессий
+  uint64_t now = server_now_us(); // время тика
+  wheel.advance(now); // сроки до этого момента
+  uint32_t session = 0; // номер сессии с наступившим сроком
+  for (int budget = SERVER_TICK_BUDGET; budget > 0 && wheel.pop(&session); budget--) { // самые ранние сроки первыми
+    auto it = session_index.find(session); // соединение игрока
+    if (it == session_index.end()) continue; // сессия уже закрыта
+    Connection* conn = it->second; // соединение
+    if (conn->closing) continue; // соединение закрывается, сессия не шагает
+    conn->game->fsm(); // шаг КА: гравитация и таймеры игры
+    send_delta(conn); // изменения кадра
+    publish(conn); // кадр трансляции
+    on_writable(conn); // отправка
+    reschedule(conn, now); // срок следующего шага
+  } // конец прохода по готовым сессиям
+} // конец метода on_tick
+
+/**
+ * @brief Записывает в колесо срок следующего шага сессии.
+ *
+ * КА, ждущий таймера, шагает к его сроку; остальные состояния (появление фигуры,
+ * прикрепление, пауза) — на следующем тике, как при опросе каждый тик.
+ */
+void GameServer::reschedule(Connection* conn, uint64_t now_us) { // срок следующего шага
+  int64_t deadline = conn->game->next_deadline(); // микросекунд до шага по таймеру
+  wheel.schedule(conn->timer, now_us + (deadline > 0 ? (uint64_t)deadline : 1)); // -1 и 0 — ближайший тик
+} // конец метода reschedule
+
+void GameServer::handle_message(Connection* conn, uint8_t type, const uint8_t* data, size_t length) { // обработка сообщения
+  if (type == MSG_CREATE && length == CREATE_SIZE) { // создание сессии
+    if (conn->game) { // сессия уже есть
+      send_error(conn, ERR_SESSION_EXISTS); // одна сессия на соединение
+    } else { // сессии нет
+      create_session(conn, data); // создание
+    } // конец проверки сессии
+  } else if (type == MSG_INPUT && length == INPUT_SIZE && data[0] <= Action) { // действие игрока
+    if (!conn->game) { // сессии нет
+      send_error(conn, ERR_NO_SESSION); // действие некуда передать
+    } else { // сессия есть
+      conn->game->set_user_action((UserAction_t)data[0]); // как userInput
+      conn->game->fsm(); // действие обрабатывается сразу, не дожидаясь таймера
+      send_delta(conn); // изменения кадра
+      publish(conn); // кадр трансляции
+      reschedule(conn, server_now_us()); // ускорение или поворот меняют срок шага
+    } // конец проверки сессии
+  } else if (type == MSG_CLOSE && length == 0) { // завершение сессии
+    if (!conn->game) { // сессии нет
+      send_error(conn, ERR_NO_SESSION); // нечего завершать
+    } else { // сессия есть
+      close_session(conn); // удаление сессии
+    } // конец проверки сессии
+  } else if (type == MSG_WATCH && length == WATCH_SIZE) { // подписка на трансляцию
+    watch(conn, get_u32(data)); // номер сессии
+  } else { // неизвестное сообщение или неверная длина
+    send_error(conn, ERR_BAD_MESSAGE); // ошибка разбора
+  } // конец выбора по типу сообщения
+} // конец метода handle_message
+
+/**
+ * @brief Создаёт сессию соединения по MSG_CREATE.
+ *
+ * Номера игр и наборов фигур совпадают с GameFabric::GameName и GameFabric::PieceSet.
+ * Поле тетриса ограничено SERVER_MAX_CELLS клетками, размер арены змейки проверяет SnakeArena.
+ */
+void GameServer::create_session(Connection* conn, const uint8_t* data) { // создание сессии
+  int game = data[0]; // номер игры
+  int pieces = data[1]; // номер набора фигур
+  int height = get_u16(data + 2); // высота поля
+  int width = get_u16(data + 4); // ширина поля
+  bool tetris = (game == (int)GameFabric::GameName::Tetris); // сессия тетриса
+  if (pieces > (int)GameFabric::PieceSet::Training || (tetris && height * width > SERVER_MAX_CELLS)) { // запрос вне пределов
+    send_error(conn, ERR_BAD_GAME); // недопустимый набор фигур или размер поля
+    return; // сессия не создаётся
+  } // конец проверки запроса
+  try { // фабрика проверяет игру и размер поля
+    conn->game = GameFabric::create_game((GameFabric::GameName)game, height, width,
+                                         (GameFabric::PieceSet)pieces); // создание сессии
+  } catch (const std::exception&) { // недопустимая игра или размер
+    send_error(conn, ERR_BAD_GAME); // сообщаем клиенту
+    return; // сессия не создана
+  } // конец создания сессии
+  conn->session = ++next_session; // номер сессии
+  conn->rows = conn->game->get_field_height(); // высота передаваемого поля (окно арены змейки)
+  conn->cols = conn->game->get_field_width(); // ширина передаваемого поля
+  conn->shadow.assign(conn->rows * conn->cols + NEXT_SIZE * NEXT_SIZE, 0); // клиент начинает с пустого поля
+  conn->sent = false; // первый кадр отправляется целиком
+  session_count++; // сессий стало больше
+  session_index[conn->session] = conn; // сессию можно смотреть
+  conn->timer = wheel.create(conn->session); // таймер шагов сессии
+  wheel.schedule(conn->timer, server_now_us()); // первый шаг на ближайшем тике
+  uint8_t reply[CREATED_SIZE]; // данные ответа
+  put_u32(reply, conn->session); // номер сессии
+  put_u16(reply + 4, (uint16_t)conn->rows); // высота поля
+  put_u16(reply + 6, (uint16_t)conn->cols); // ширина поля
+  send_message(conn, MSG_CREATED, 0, reply, sizeof(reply)); // ответ клиенту
+  send_delta(conn); // начальный кадр
+} // конец метода create_session
+
+void GameServer::close_session(Connection* conn) { // удаление сессии
+  for (Connection* watcher : conn->watchers) { // зрители сессии
+    watcher->watching = 0; // трансляции больше нет
+    watcher->synced = false; // следующая подписка начнётся с опорного кадра
+    send_error(watcher, ERR_NO_SESSION); // сообщаем зрителю
+    on_writable(watcher); // отправка
+  } // конец прохода по зрителям
+  conn->watchers.clear(); // зрителей нет
+  conn->encoder.reset(); // кодировщик не нужен
+  session_index.erase(conn->session); // сессию больше нельзя смотреть
+  wheel.release(conn->timer); // сроков у сессии больше нет
+  conn->timer = WHEEL_NONE; // таймера нет
+  GameFabric::destroy_game(conn->game); // фабрика завершает партию и удаляет движок
+  conn->game = nullptr; // сессии нет
+  conn->shadow.clear(); // теневая копия не нужна
+  session_count--; // сессий стало меньше
+} // конец метода close_session
+
+/**
+ * @brief Подписывает соединение на трансляцию сессии.
+ *
+ * Прежняя подписка снимается; session 0 — только отписка. Первый зритель получает
+ * новый кодировщик, следующий — запрос опорного кадра у существующего, поэтому первый
+ * кадр после подписки — опорный.
+ */
+void GameServer::watch(Connection* conn, uint32_t session) { // подписка на трансляцию
+  unwatch(conn); // снимаем прежнюю подписку
+  auto it = session_index.find(session); // соединение игрока
+  if (session != 0 && it == session_index.end()) { // сессии нет
+    send_error(conn, ERR_NO_SESSION); // сообщаем зрителю
+  } else if (session != 0 && it->second->rows * it->second->cols > SPECTATOR_MAX_CELLS) { // поле не для трансляции
+    send_error(conn, ERR_TOO_LARGE); // сообщаем зрителю
+  } else { // подписка или отписка
+    Connection* player = (session != 0) ? it->second : nullptr; // соединение игрока
+    if (player && player->watchers.empty()) // первый зритель
+      player->encoder.reset(new FrameEncoder(session, player->rows, player->cols)); // трансляция с опорного кадра
+    else if (player) // трансляция уже идёт
+      player->encoder->request_key(); // новый зритель начнёт со следующего шага
+    if (player) player->watchers.push_back(conn); // новый зритель
+    conn->watching = session; // номер сессии
+    uint8_t reply[WATCHING_SIZE]; // данные ответа
+    put_u32(reply, session); // номер сессии
+    put_u16(reply + 4, (uint16_t)(player ? player->rows : 0)); // высота поля
+    put_u16(reply + 6, (uint16_t)(player ? player->cols : 0)); // ширина поля
+    send_message(conn, MSG_WATCHING, 0, reply, sizeof(reply)); // ответ зрителю
+  } // конец выбора результата
+} // конец метода watch
+
+void GameServer::unwatch(Connection* conn) { // отписка зрителя
+  auto it = session_index.find(conn->watching); // соединение игрока
+  if (conn->watching != 0 && it != session_index.end()) { // зритель подписан
+    std::vector<Connection*>& watchers = it->second->watchers; // зрители сессии
+    watchers.erase(std::remove(watchers.begin(), watchers.end(), conn), watchers.end()); // удаляем зрителя
+  } // конец проверки подписки
+  conn->watching = 0; // подписки нет
+  conn->synced = false; // следующая подписка начнётся с опорного кадра
+  while (conn->frames.size() > (conn->frame_pos > 0 ? 1u : 0u)) conn->frames.pop_back(); // начатый кадр дописывается
+} // конец метода unwatch
+
+/**
+ * @brief Кодирует кадр шага сессии и ставит его в очереди зрителей.
+ *
+ * Кадр кодируется один раз, зрители получают общий буфер. Зритель, не получивший
+ * опорного кадра, пропускает разностные кадры.
+ */
+void GameServer::publish(Connection* conn) { // трансляция кадра
+  if (conn->watchers.empty()) return; // зрителей нет
+  SharedFrame frame = conn->encoder->encode(conn->game->get_gameinfo()); // кадр шага
+  if (!frame) return; // ничего не изменилось
+  bool key = (*frame)[1] & FRAME_FLAG_KEY; // опорный кадр
+  for (Connection* watcher : conn->watchers) { // зрители сессии
+    if (watcher->frames.size() >= SPECTATOR_QUEUE_LIMIT) { // зритель не успевает читать
+      while (watcher->frames.size() > (watcher->frame_pos > 0 ? 1u : 0u)) watcher->frames.pop_back(); // сброс очереди
+      watcher->synced = false; // ждём опорного кадра
+      conn->encoder->request_key(); // опорный кадр на следующем шаге
+    } // конец проверки очереди
+    if (key) watcher->synced = true; // опорный кадр синхронизирует зрителя
+    if (!watcher->synced) continue; // разностный кадр без опорного бесполезен
+    watcher->frames.push_back(frame); // общий буфер, копии нет
+    on_writable(watcher); // отправка
+  } // конец прохода по зрителям
+} // конец метода publish
+
+uint8_t* GameServer::reserve(Connection* conn, size_t length) { // место в выходном буфере
+  if (conn->out_pos > 0 && conn->out_pos >= conn->out.size() / 2) { // отправленная часть — больше половины
+    conn->out.erase(conn->out.begin(), conn->out.begin() + conn->out_pos); // сдвигаем остаток в начало
+    conn->out_pos = 0; // начало буфера
+  } // конец сжатия буфера
+  size_t offset = conn->out.size(); // конец данных
+  conn->out.resize(offset + length); // место для сообщения
+  return conn->out.data() + offset; // начало места
+} // конец метода reserve
+
+void GameServer::send_message(Connection* conn, uint8_t type, uint8_t flags, const uint8_t* data,
+                              size_t length) { // постановка сообщения в очередь
+  uint8_t* buf = reserve(conn, PROTO_HEADER_SIZE + length); // место для заголовка и данных
+  put_header(buf, type, flags, length); // заголовок
+  if (length > 0) memcpy(buf + PROTO_HEADER_SIZE, data, length); // данные
+} // конец метода send_message
+
+void GameServer::send_error(Connection* conn, uint8_t code) { send_message(conn, MSG_ERROR, 0, &code, 1); } // MSG_ERROR
+
+/**
+ * @brief Отправляет кадр с изменениями с прошлого MSG_DELTA.
+ *
+ * Поле и область next сравниваются с теневой копией; если не изменились ни клетки,
+ * ни счёт, кадр не отправляется. Кадр больше PROTO_MAX_PAYLOAD делится на несколько
+ * сообщений, все кроме последнего помечены DELTA_FLAG_MORE.
+ */
+void GameServer::send_delta(Connection* conn) { // кадр с изменениями
+  const GameInfo_t& info = conn->game->get_gameinfo(); // состояние сессии
+  scratch.clear(); // изменившиеся клетки
+  int* shadow = conn->shadow.data(); // теневая копия
+  for (int plane = PLANE_FIELD; plane <= PLANE_NEXT; plane++) { // поле и область next
+    int rows = (plane == PLANE_FIELD) ? conn->rows : NEXT_SIZE; // высота матрицы
+    int cols = (plane == PLANE_FIELD) ? conn->cols : NEXT_SIZE; // ширина матрицы
+    int** matrix = (plane == PLANE_FIELD) ? info.field : info.next; // матрица
+    for (int y = 0; y < rows; y++) { // проход по строкам
+      for (int x = 0; x < cols; x++, shadow++) { // проход по клеткам строки
+        if (matrix[y][x] != *shadow) { // клетка изменилась
+          *shadow = matrix[y][x]; // обновляем теневую копию
+          uint8_t cell[DELTA_CELL_SIZE]; // описание клетки
+          cell[0] = (uint8_t)plane; // матрица
+          put_u16(cell + 1, (uint16_t)y); // строка
+          put_u16(cell + 3, (uint16_t)x); // столбец
+          cell[5] = (uint8_t)(int8_t)matrix[y][x]; // значение
+          scratch.insert(scratch.end(), cell, cell + DELTA_CELL_SIZE); // в список изменений
+        } // конец проверки клетки
+      } // конец прохода по клеткам строки
+    } // конец прохода по строкам
+  } // конец прохода по матрицам
+  bool stats_changed = !conn->sent || info.score != conn->last.score || info.high_score != conn->last.high_score ||
+                       info.level != conn->last.level || info.speed != conn->last.speed ||
+                       info.pause != conn->last.pause; // изменился счёт или уровень
+  if (scratch.empty() && !stats_changed) return; // кадр не нужен
+  conn->last = info; // запоминаем счёт кадра
+  conn->sent = true; // кадр отправлен
+  size_t total = scratch.size() / DELTA_CELL_SIZE; // изменившихся клеток
+  size_t done = 0; // отправлено клеток
+  do { // хотя бы одно сообщение, даже без клеток
+    size_t count = std::min(total - done, (size_t)DELTA_MAX_CELLS); // клеток в сообщении
+    size_t length = DELTA_HEAD_SIZE + count * DELTA_CELL_SIZE; // длина данных
+    uint8_t* buf = reserve(conn, PROTO_HEADER_SIZE + length); // место для сообщения
+    put_header(buf, MSG_DELTA, (done + count < total) ? DELTA_FLAG_MORE : 0, length); // заголовок
+    buf += PROTO_HEADER_SIZE; // данные
+    put_u32(buf, (uint32_t)info.score); // счёт
+    put_u32(buf + 4, (uint32_t)info.high_score); // рекорд
+    put_u32(buf + 8, (uint32_t)info.level); // уровень или код завершения
+    put_u32(buf + 12, (uint32_t)info.speed); // скорость
+    buf[16] = (uint8_t)info.pause; // пауза
+    put_u16(buf + 17, (uint16_t)count); // количество клеток
+    if (count > 0) memcpy(buf + DELTA_HEAD_SIZE, scratch.data() + done * DELTA_CELL_SIZE, count * DELTA_CELL_SIZE); // клетки
+    done += count; // следующая часть кадра
+  } while (done < total); // конец цикла по частям кадра
+} // конец метода send_delta
+
+void GameServer::update_events(Connection* conn) { // подписка на EPOLLOUT
+  bool want = conn->out_pos < conn->out.size() || !conn->frames.empty(); // есть неотправленные данные
+  if (want != conn->writing) { // подписка изменилась
+    epoll_event event{}; // новая подписка
+    event.events = want ? (EPOLLIN | EPOLLOUT) : EPOLLIN; // чтение всегда, запись — по остатку
+    event.data.fd = conn->fd; // источник события
+    epoll_ctl(epoll_fd, EPOLL_CTL_MOD, conn->fd, &event); // изменение подписки
+    conn->writing = want; // запоминаем подписку
+  } // конец проверки подписки
+} // конец метода update_events
+
+void GameServer::close_connection(int fd) { // закрытие соединения
+  auto it = conns.find(fd); // соединение
+  if (it != conns.end()) { // соединение открыто
+    unwatch(it->second.get()); // подписка соединения
+    if (it->second->game) close_session(it->second.get()); // сессия соединения
+    epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr); // отписка от событий
+    close(fd); // закрытие сокета
+    conns.erase(it); // удаление состояния
+  } // конец проверки соединения
+} // конец метода close_connection
+
+}  // namespace s21 // конец пространства имён s21
@@ -0,0 +1,125 @@
+#ifndef SERVER_H // защита от повторного включения заголовка: если SERVER_H не определён
+#define SERVER_H // определяет макрос SERVER_H чтобы предотвратить повторное включение
+
+#include <stddef.h> // подключает size_t для размеров буферов
+#include <stdint.h> // подключает целые типы фиксированной ширины
+
+#include <atomic> // подключает атомарный флаг остановки цикла
+#include <deque> // подключает очередь кадров трансляции зрителя
+#include <memory> // подключает std::unique_ptr для соединений
+#include <string> // подключает std::string для пути Unix-сокета
+#include <unordered_map> // подключает таблицу соединений по дескриптору
+#include <vector> // подключает std::vector для буферов и теневых копий поля
+
+#include "../../brick_game/brick_game_single.h" // подключает Game, GameFabric и GameInfo_t
+#include "../../brick_game/timer_wheel.h" // подключает колесо сроков шагов сессий
+#include "protocol.h" // подключает описание двоичного протокола
+#include "spectator.h" // подключает кодировщик трансляции для зрителей
+
+#define SERVER_TICK_MS 10 // период таймера гравитации в миллисекундах
+#define SERVER_TICK_BUDGET 4096 // наибольшее число шагов сессий за один тик (остальные ждут следующего)
+#define SERVER_MAX_EVENTS 256 // событий epoll за один вызов epoll_wait
+#define SERVER_READ_CHUNK 4096 // размер блока чтения из сокета
+#define SERVER_READ_BUDGET (1 << 16) // наибольшее число байт, читаемых из соединения за одно событие готовности
+#define SERVER_IN_LIMIT (2 * (PROTO_HEADER_SIZE + PROTO_MAX_PAYLOAD) + SERVER_READ_BUDGET) // предел неразобранных входных данных, после него соединение закрывается
+#define SERVER_OUT_LIMIT (1 << 20) // предел неотправленных данных соединения, после него соединение закрывается
+#define SERVER_MAX_CELLS 65536 // наибольшее число клеток поля тетриса в сессии сервера
+
+namespace s21 { // начало пространства имён s21
+
+/**
+ * @brief Сервер игр без интерфейса на epoll.
+ *
+ * Принимает соединения через Unix-сокет и TCP на 127.0.0.1, в каждом соединении — не больше
+ * одной сессии, созданной GameFabric::create_game. Весь ввод-вывод неблокирующий и идёт через
+ * один экземпляр epoll в одном потоке: у соединения свой входной и выходной буфер, запись
+ * включается (EPOLLOUT) только пока выходной буфер не пуст. Гравитацию обслуживает timerfd:
+ * каждые SERVER_TICK_MS миллисекунд сервер один раз читает часы и проходит колесо таймеров
+ * TimerWheel, в котором у каждой сессии записан срок следующего шага (Game::next_deadline
+ * или следующий тик, если КА не ждёт таймера). Шаг, как updateCurrentState во фронтенде,
+ * делают только сессии с наступившим сроком, самые просроченные первыми и не больше
+ * SERVER_TICK_BUDGET за тик, а клиенту уходят только клетки, изменившиеся с прошлого кадра
+ * (сравнение с теневой копией поля).
+ *
+ * Соединение может смотреть чужую сессию (MSG_WATCH): кадр трансляции кодируется один раз
+ * за шаг сессии и ставится в очередь каждого зрителя общим буфером SharedFrame. Зритель
+ * получает кадры, начиная с ближайшего опорного; если зритель не успевает читать и его
+ * очередь превышает SPECTATOR_QUEUE_LIMIT, очередь сбрасывается до следующего опорного кадра.
+ */
+class GameServer { // объявление сервера
+ public: // публичная секция класса
+  GameServer(); // конструктор: создаёт epoll и таймер, throw runtime_error при ошибке
+  ~GameServer(); // деструктор: закрывает сокеты и удаляет сессии
+  GameServer(const GameServer&) = delete; // удалённый копирующий конструктор, запрет копирования
+  GameServer& operator=(const GameServer&) = delete; // удалённый оператор присваивания, запрет копирования
+
+  void listen_unix(const std::string& path); // прослушивание Unix-сокета path
+  int listen_tcp(int port); // прослушивание 127.0.0.1:port (0 — любой свободный), возвращает порт
+  void run_once(int timeout_ms); // одна итерация цикла событий
+  void run(); // цикл событий до вызова stop
+  void stop(); // остановка run, можно вызывать из другого потока или обработчика сигнала
+
+  size_t connections() const; // количество открытых соединений
+  size_t sessions() const; // количество созданных сессий
+
+ private: // приватная секция для внутренних структур и данных
+  struct Connection { // состояние одного соединения
+    int fd = -1; // дескриптор сокета
+    std::vector<uint8_t> in; // принятые, но ещё не разобранные байты
+    std::vector<uint8_t> out; // данные, ожидающие отправки
+    size_t out_pos = 0; // отправленная часть out
+    bool writing = false; // подписка на EPOLLOUT включена
+    Game* game = nullptr; // сессия соединения
+    uint32_t timer = WHEEL_NONE; // таймер срока шага сессии в колесе
+    uint32_t session = 0; // номер сессии
+    int rows = 0; // высота поля сессии
+    int cols = 0; // ширина поля сессии
+    std::vector<int> shadow; // поле и область next на момент прошлого кадра
+    GameInfo_t last{}; // счёт и уровень прошлого кадра
+    bool sent = false; // первый кадр уже отправлен
+    bool closing = false; // соединение будет закрыто после обработки событий
+    std::unique_ptr<FrameEncoder> encoder; // кодировщик трансляции сессии соединения
+    std::vector<Connection*> watchers; // зрители сессии соединения
+    uint32_t watching = 0; // сессия, которую смотрит соединение (0 — никакая)
+    bool synced = false; // зритель получил опорный кадр
+    std::deque<SharedFrame> frames; // кадры трансляции, ожидающие отправки
+    size_t frame_pos = 0; // отправленная часть первого кадра
+  }; // конец объявления Connection
+
+  int epoll_fd; // экземпляр epoll
+  int timer_fd; // таймер гравитации
+  std::vector<int> listen_fds; // прослушивающие сокеты
+  std::string unix_path; // путь Unix-сокета для удаления при завершении
+  std::unordered_map<int, std::unique_ptr<Connection>> conns; // соединения по дескриптору
+  std::unordered_map<uint32_t, Connection*> session_index; // соединения игроков по номеру сессии
+  std::atomic<bool> running; // флаг работы цикла run
+  uint32_t next_session; // номер следующей сессии
+  size_t session_count; // количество созданных сессий
+  std::vector<uint8_t> scratch; // изменившиеся клетки кадра (буфер переиспользуется)
+  TimerWheel wheel; // сроки шагов сессий
+
+ private: // приватная секция для вспомогательных методов
+  void add_listener(int fd); // регистрация прослушивающего сокета в epoll
+  void accept_all(int listen_fd); // приём всех ожидающих соединений
+  void on_readable(Connection* conn); // чтение и разбор сообщений
+  void on_writable(Connection* conn); // отправка выходного буфера
+  void on_tick(); // шаг сессий с наступившим сроком
+  void reschedule(Connection* conn, uint64_t now_us); // срок следующего шага сессии после её шага
+  void handle_message(Connection* conn, uint8_t type, const uint8_t* data, size_t length); // обработка сообщения
+  void create_session(Connection* conn, const uint8_t* data); // MSG_CREATE
+  void close_session(Connection* conn); // удаление сессии соединения
+  void watch(Connection* conn, uint32_t session); // MSG_WATCH
+  void unwatch(Connection* conn); // отписка зрителя от трансляции
+  void publish(Connection* conn); // кадр трансляции шага сессии всем зрителям
+  bool write_some(Connection* conn, const uint8_t* data, size_t size, size_t* pos); // одна попытка отправки
+  uint8_t* reserve(Connection* conn, size_t length); // место для length байт в конце выходного буфера
+  void send_message(Connection* conn, uint8_t type, uint8_t flags, const uint8_t* data, size_t length); // постановка в очередь
+  void send_error(Connection* conn, uint8_t code); // MSG_ERROR
+  void send_delta(Connection* conn); // MSG_DELTA с изменившимися клетками
+  void update_events(Connection* conn); // включение и выключение EPOLLOUT
+  void close_connection(int fd); // закрытие соединения и удаление его сессии
+}; // конец объявления класса GameServer
+
+}  // namespace s21 // конец пространства имён s21
+
+#endif  // SERVER_H // конец защиты от повторного включения заголовка
@@ -0,0 +1,47 @@
+#include <signal.h> // подключает signal для остановки по SIGINT и SIGTERM
+#include <stdio.h> // подключает fprintf для сообщений запуска
+#include <stdlib.h> // подключает atoi и srand
+#include <string.h> // подключает strcmp для разбора аргументов
+#include <time.h> // подключает time для инициализации генератора случайных чисел
+
+#include "../../brick_game/slab.h" // подключает распределитель блоков сессий
+#include "server.h" // подключает класс GameServer
+
+#define DEFAULT_SOCKET_PATH "/tmp/brickgame.sock" // Unix-сокет по умолчанию
+#define DEFAULT_TCP_PORT 7777 // TCP-порт по умолчанию
+
+static s21::GameServer* server = nullptr; // сервер для обработчика сигнала
+
+static void on_signal(int) { // обработчик SIGINT и SIGTERM
+  if (server) server->stop(); // run завершится на следующей итерации
+} // конец обработчика сигнала
+
+int main(int argc, char** argv) { // точка входа: BrickGameServer [-u путь] [-p порт] [-H]
+  const char* path = DEFAULT_SOCKET_PATH; // путь Unix-сокета
+  int port = DEFAULT_TCP_PORT; // TCP-порт
+  for (int i = 1; i < argc; i++) { // ключи
+    if (strcmp(argv[i], "-H") == 0) s21::SlabPool::use_huge_pages(true); // сессии на больших страницах
+    else if (i + 1 < argc && strcmp(argv[i], "-u") == 0) path = argv[++i]; // путь Unix-сокета
+    else if (i + 1 < argc && strcmp(argv[i], "-p") == 0) port = atoi(argv[++i]); // TCP-порт
+  } // конец разбора аргументов
+
+  int res = 0; // код завершения
+  srand(time(NULL)); // инициализируем генератор случайных чисел текущим временем
+  const char* flight = getenv(FLIGHT_ENV); // файл дампов журналов сессий
+  flightInstall(flight ? flight : FLIGHT_DUMP_FILE); // дампы при поражении, исключении и падении
+  try { // ошибки создания сокетов
+    s21::GameServer game_server; // сервер
+    game_server.listen_unix(path); // Unix-сокет
+    port = game_server.listen_tcp(port); // TCP на 127.0.0.1
+    server = &game_server; // сервер доступен обработчику сигнала
+    signal(SIGINT, on_signal); // Ctrl+C
+    signal(SIGTERM, on_signal); // kill
+    fprintf(stderr, "BrickGameServer: unix %s, tcp 127.0.0.1:%d\n", path, port); // адреса сервера
+    game_server.run(); // цикл событий до сигнала
+    server = nullptr; // сервер удаляется при выходе из блока
+  } catch (const std::exception& e) { // сокет не создан
+    fprintf(stderr, "%s\n", e.what()); // сообщение об ошибке
+    res = 1; // код ошибки
+  } // конец обработки ошибок
+  return res; // код завершения
+} // конец main
@@ -0,0 +1,136 @@
+#include "spectator.h" // подключает объявление классов FrameEncoder и FrameDecoder
+
+namespace s21 { // начало пространства имён s21
+
+// ================= FrameEncoder ==================
+FrameEncoder::FrameEncoder(uint32_t session, int rows, int cols)
+    : session(session), rows(rows), cols(cols), seq(0), since_key(0), have_key(false),
+      last(rows * cols + NEXT_SIZE * NEXT_SIZE, 0), last_info{}, cells(last.size()) {} // конструктор кодировщика
+
+void FrameEncoder::request_key() { have_key = false; } // следующий кадр — опорный
+
+uint32_t FrameEncoder::frames() const { return seq; } // количество выпущенных кадров
+
+/**
+ * @brief Кодирует кадр шага сессии.
+ *
+ * Опорный кадр выпускается первым, после request_key и каждые SPECTATOR_KEYFRAME_INTERVAL
+ * шагов, разностный — только если изменились клетки или счёт.
+ * @return общий буфер с сообщением MSG_FRAME или nullptr, если кадр не нужен
+ */
+SharedFrame FrameEncoder::encode(const GameInfo_t& info) { // кодирование кадра
+  size_t total = cells.size(); // клеток в кадре
+  int* cell = cells.data(); // клетки шага: поле, затем область next
+  for (int y = 0; y < rows; y++) // строки поля
+    for (int x = 0; x < cols; x++) *cell++ = info.field[y][x]; // клетки строки
+  for (int y = 0; y < NEXT_SIZE; y++) // строки области next
+    for (int x = 0; x < NEXT_SIZE; x++) *cell++ = info.next[y][x]; // клетки строки
+
+  since_key++; // шагов с опорного кадра
+  bool key = !have_key || since_key >= SPECTATOR_KEYFRAME_INTERVAL; // нужен опорный кадр
+  bool changed = info.score != last_info.score || info.high_score != last_info.high_score ||
+                 info.level != last_info.level || info.speed != last_info.speed ||
+                 info.pause != last_info.pause || cells != last; // изменилось состояние
+  if (!key && !changed) return nullptr; // кадр не нужен
+
+  size_t bitmap = (total + 7) / 8; // длина битовой карты
+  auto frame = std::make_shared<std::vector<uint8_t>>(PROTO_HEADER_SIZE + FRAME_HEAD_SIZE + bitmap, 0); // буфер кадра
+  uint8_t* head = frame->data() + PROTO_HEADER_SIZE; // данные кадра
+  put_u32(head, session); // номер сессии
+  put_u32(head + 4, seq); // номер кадра
+  put_u32(head + 8, (uint32_t)info.score); // счёт
+  put_u32(head + 12, (uint32_t)info.high_score); // рекорд
+  put_u32(head + 16, (uint32_t)info.level); // уровень или код завершения
+  put_u32(head + 20, (uint32_t)info.speed); // скорость
+  head[24] = (uint8_t)info.pause; // пауза
+  put_u16(head + 25, (uint16_t)rows); // высота поля
+  put_u16(head + 27, (uint16_t)cols); // ширина поля
+
+  const size_t bits = PROTO_HEADER_SIZE + FRAME_HEAD_SIZE; // начало битовой карты (буфер растёт, указатель не хранится)
+  int run_value = 0; // значение текущей серии
+  int run_length = 0; // длина текущей серии
+  for (size_t i = 0; i < total; i++) { // проход по клеткам
+    bool selected = key ? cells[i] != 0 : cells[i] != last[i]; // занятая или изменившаяся клетка
+    if (!selected) continue; // клетка не передаётся
+    (*frame)[bits + i / 8] |= (uint8_t)(1 << (i % 8)); // отмечаем клетку
+    if (run_length > 0 && (cells[i] != run_value || run_length == 255)) { // серия закончилась
+      frame->push_back((uint8_t)run_length); // длина серии
+      frame->push_back((uint8_t)(int8_t)run_value); // значение серии
+      run_length = 0; // новая серия
+    } // конец проверки серии
+    run_value = cells[i]; // значение серии
+    run_length++; // серия стала длиннее
+  } // конец прохода по клеткам
+  if (run_length > 0) { // последняя серия
+    frame->push_back((uint8_t)run_length); // длина серии
+    frame->push_back((uint8_t)(int8_t)run_value); // значение серии
+  } // конец записи последней серии
+
+  put_header(frame->data(), MSG_FRAME, key ? FRAME_FLAG_KEY : 0, frame->size() - PROTO_HEADER_SIZE); // заголовок
+  last.swap(cells); // клетки кадра становятся прошлыми
+  last_info = info; // счёт кадра
+  if (key) { // опорный кадр
+    have_key = true; // опорный кадр выпущен
+    since_key = 0; // отсчёт до следующего опорного кадра
+  } // конец учёта опорного кадра
+  seq++; // номер следующего кадра
+  return frame; // общий буфер кадра
+} // конец метода encode
+
+// ================= FrameDecoder ==================
+/**
+ * @brief Применяет MSG_FRAME к состоянию зрителя.
+ *
+ * Опорный кадр применяется всегда, разностный — только следующий по номеру за применённым.
+ * @return true если кадр применён
+ */
+bool FrameDecoder::apply(uint8_t flags, const uint8_t* data, size_t length) { // применение кадра
+  if (length < FRAME_HEAD_SIZE) return synced = false; // кадр повреждён
+  bool key = flags & FRAME_FLAG_KEY; // опорный кадр
+  uint32_t frame_seq = get_u32(data + 4); // номер кадра
+  int frame_rows = get_u16(data + 25); // высота поля
+  int frame_cols = get_u16(data + 27); // ширина поля
+  if (!key && (!synced || frame_seq != seq + 1 || frame_rows != rows || frame_cols != cols))
+    return synced = false; // кадр пропущен — ждём опорного
+  size_t total = (size_t)frame_rows * frame_cols + NEXT_SIZE * NEXT_SIZE; // клеток в кадре
+  size_t bitmap = (total + 7) / 8; // длина битовой карты
+  if (length < FRAME_HEAD_SIZE + bitmap) return synced = false; // кадр повреждён
+  if (key) { // опорный кадр задаёт всё состояние
+    session = get_u32(data); // номер сессии
+    rows = frame_rows; // высота поля
+    cols = frame_cols; // ширина поля
+    field.assign(rows * cols, 0); // пустое поле
+    next.assign(NEXT_SIZE * NEXT_SIZE, 0); // пустая область next
+  } // конец подготовки опорного кадра
+  seq = frame_seq; // номер применённого кадра
+  info.score = (int)get_u32(data + 8); // счёт
+  info.high_score = (int)get_u32(data + 12); // рекорд
+  info.level = (int)get_u32(data + 16); // уровень
+  info.speed = (int)get_u32(data + 20); // скорость
+  info.pause = data[24]; // пауза
+
+  const uint8_t* bits = data + FRAME_HEAD_SIZE; // битовая карта
+  const uint8_t* runs = bits + bitmap; // серии значений
+  const uint8_t* end = data + length; // конец кадра
+  int run_length = 0; // остаток текущей серии
+  int run_value = 0; // значение текущей серии
+  bool ok = true; // серий хватило на все отмеченные клетки
+  for (size_t i = 0; i < total && ok; i++) { // проход по клеткам
+    if (!(bits[i / 8] & (1 << (i % 8)))) continue; // клетка не передана
+    if (run_length == 0 && runs + 2 <= end) { // следующая серия
+      run_length = runs[0]; // длина серии
+      run_value = (int8_t)runs[1]; // значение серии
+      runs += 2; // к следующей серии
+    } // конец чтения серии
+    ok = run_length > 0; // серия есть
+    if (ok) { // клетка получает значение серии
+      int* target = (i < (size_t)rows * cols) ? &field[i] : &next[i - (size_t)rows * cols]; // поле или next
+      *target = run_value; // новое значение
+      run_length--; // серия короче
+    } // конец записи клетки
+  } // конец прохода по клеткам
+  synced = ok; // повреждённый кадр сбрасывает синхронизацию
+  return ok; // результат применения
+} // конец метода apply
+
+}  // namespace s21 // конец пространства имён s21
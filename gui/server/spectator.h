@@ -0,0 +1,75 @@
+#ifndef SPECTATOR_H // защита от повторного включения заголовка: если SPECTATOR_H не определён
+#define SPECTATOR_H // определяет макрос SPECTATOR_H чтобы предотвратить повторное включение
+
+#include <stddef.h> // подключает size_t для длин кадров
+#include <stdint.h> // подключает целые типы фиксированной ширины
+
+#include <memory> // подключает std::shared_ptr для общего буфера кадра
+#include <vector> // подключает std::vector для кадров и копий поля
+
+#include "../../brick_game/brick_game_single.h" // подключает GameInfo_t и NEXT_SIZE
+#include "protocol.h" // подключает описание двоичного протокола
+
+#define SPECTATOR_KEYFRAME_INTERVAL 100 // шагов между опорными кадрами
+#define SPECTATOR_MAX_CELLS 4096 // наибольшее число клеток поля сессии для трансляции
+#define SPECTATOR_QUEUE_LIMIT 256 // кадров в очереди зрителя, после которых очередь сбрасывается
+#define FRAME_HEAD_SIZE 29 // длина данных MSG_FRAME до битовой карты
+
+namespace s21 { // начало пространства имён s21
+
+using SharedFrame = std::shared_ptr<const std::vector<uint8_t>>; // готовое сообщение MSG_FRAME, общее для всех зрителей
+
+/**
+ * @brief Кодировщик трансляции одной сессии для зрителей.
+ *
+ * Кадр кодируется один раз за шаг сессии и раздаётся всем зрителям общим буфером со
+ * счётчиком ссылок. Клетки поля и области next идут одной последовательностью: опорный
+ * кадр — битовая карта занятых клеток и цвета занятых клеток, разностный — битовая карта
+ * изменившихся клеток и их новые значения; значения сжаты кодированием длин серий
+ * (пары {длина u8, значение i8}). Опорный кадр выпускается каждые SPECTATOR_KEYFRAME_INTERVAL
+ * шагов и по request_key — на следующем шаге после подписки нового зрителя или сброса
+ * очереди отставшего, чтобы они не ждали очередного планового опорного кадра.
+ */
+class FrameEncoder { // объявление кодировщика
+ public: // публичная секция класса
+  FrameEncoder(uint32_t session, int rows, int cols); // кодировщик сессии с полем rows x cols
+
+  SharedFrame encode(const GameInfo_t& info); // кадр шага или nullptr, если ничего не изменилось и опорный кадр не нужен
+  void request_key(); // следующий кадр — опорный (новый или отставший зритель)
+  uint32_t frames() const; // количество выпущенных кадров
+
+ private: // приватная секция для внутренних данных
+  uint32_t session; // номер транслируемой сессии
+  int rows; // высота поля
+  int cols; // ширина поля
+  uint32_t seq; // номер следующего кадра
+  int since_key; // шагов с последнего опорного кадра
+  bool have_key; // опорный кадр уже выпущен
+  std::vector<int> last; // поле и область next на момент прошлого кадра
+  GameInfo_t last_info; // счёт и уровень прошлого кадра
+  std::vector<int> cells; // клетки текущего шага
+}; // конец объявления класса FrameEncoder
+
+/**
+ * @brief Декодировщик трансляции на стороне зрителя.
+ *
+ * Разностные кадры применяются только после опорного и только по порядку номеров:
+ * при пропуске кадра зритель ждёт следующего опорного.
+ */
+class FrameDecoder { // объявление декодировщика
+ public: // публичная секция класса
+  bool apply(uint8_t flags, const uint8_t* data, size_t length); // применение MSG_FRAME, false если кадр пропущен
+
+  bool synced = false; // состояние совпадает с сессией
+  uint32_t session = 0; // номер сессии
+  uint32_t seq = 0; // номер последнего применённого кадра
+  int rows = 0; // высота поля
+  int cols = 0; // ширина поля
+  std::vector<int> field; // поле rows x cols по строкам
+  std::vector<int> next; // область next NEXT_SIZE x NEXT_SIZE по строкам
+  GameInfo_t info{}; // счёт и уровень (field и next не используются)
+}; // конец объявления класса FrameDecoder
+
+}  // namespace s21 // конец пространства имён s21
+
+#endif  // SPECTATOR_H // конец защиты от повторного включения заголовка
@@ -0,0 +1,77 @@
+// tests/ansi_renderer_tests.cpp
+#include <gtest/gtest.h> // подключает фреймворк Google Test для определения тестов и макросов EXPECT_*
+#include <fcntl.h> // подключает fcntl для неблокирующего чтения канала
+#include <unistd.h> // подключает pipe, read и close
+#include <string> // подключает std::string для разбора кадров
+
+#include "../gui/cli/ansi_renderer.h" // подключаем отрисовку ANSI без ncurses
+
+// Вспомогательная функция: последний собранный кадр строкой
+static std::string frame(const s21::AnsiRenderer& screen) { return std::string(screen.data(), screen.size()); }
+
+TEST(ansi_renderer, sends_only_changed_cells) { // тест: первый кадр целиком, дальше только изменения
+  s21::AnsiRenderer screen(4, 10);
+  screen.text(1, 2, "abc");
+  ASSERT_GT(screen.compose(), 0u);
+  std::string first = frame(screen);
+  EXPECT_EQ(first.rfind(ANSI_SYNC_BEGIN, 0), 0u); // кадр внутри синхронного обновления
+  EXPECT_EQ(first.substr(first.size() - strlen(ANSI_SYNC_END)), ANSI_SYNC_END);
+  EXPECT_NE(first.find("\x1b[2J"), std::string::npos); // первый кадр очищает экран
+  EXPECT_NE(first.find("abc"), std::string::npos);
+
+  EXPECT_EQ(screen.compose(), 0u); // изменений нет — выводить нечего
+  screen.put(1, 3, 'X');
+  screen.put(1, 4, 'Y');
+  ASSERT_GT(screen.compose(), 0u);
+  EXPECT_EQ(frame(screen), ANSI_SYNC_BEGIN "\x1b[2;4H\x1b[0mXY" ANSI_SYNC_END); // один переход курсора на две ячейки подряд
+
+  screen.invalidate();
+  EXPECT_GT(screen.compose(), first.size() - 1); // после invalidate — снова весь экран
+}
+
+TEST(ansi_renderer, colors_cells_from_values) { // тест: цвет фона по значению клетки, смена цвета только при разнице
+  int rows[WINDOW_HEIGHT][WINDOW_WIDTH] = {}, next_rows[4][WINDOW_WIDTH] = {};
+  int* field[WINDOW_HEIGHT];
+  int* next[4];
+  for (int i = 0; i < WINDOW_HEIGHT; i++) field[i] = rows[i];
+  for (int i = 0; i < 4; i++) next[i] = next_rows[i];
+  rows[19][0] = 3; // жёлтая клетка
+  rows[19][1] = 3;
+  rows[19][2] = 7; // мусор — белая клетка
+  GameInfo_t stats = {field, next, 120, 500, 1, 1, 0};
+  s21::AnsiRenderer screen(27, 34);
+  s21::ansi_draw_game(&screen, stats, nullptr, 0, 0);
+  screen.compose();
+  std::string image = frame(screen);
+  EXPECT_NE(image.find("\x1b[0;43m    "), std::string::npos); // две клетки одним цветом без повторного SGR
+  EXPECT_NE(image.find("\x1b[0;47m  "), std::string::npos);
+  EXPECT_NE(image.find("0000120"), std::string::npos); // счёт
+  EXPECT_NE(image.find("┌"), std::string::npos); // рамка в UTF-8
+
+  rows[19][1] = 0; // клетка очищена
+  screen.blank();
+  s21::ansi_draw_game(&screen, stats, nullptr, 0, 0);
+  screen.compose();
+  EXPECT_EQ(frame(screen), ANSI_SYNC_BEGIN "\x1b[21;4H\x1b[0m  " ANSI_SYNC_END);
+}
+
+TEST(ansi_renderer, presents_each_frame_with_one_write) { // тест: кадр уходит в дескриптор одним вызовом write
+  int sink[2];
+  ASSERT_EQ(pipe(sink), 0);
+  fcntl(sink[0], F_SETFL, O_NONBLOCK);
+  s21::AnsiRenderer screen(27, 34, sink[1]);
+  GameInfo_t stats = {};
+  s21::ansi_draw_game(&screen, stats, nullptr, 0, 0);
+  EXPECT_TRUE(screen.present());
+  EXPECT_TRUE(screen.present()); // без изменений — без вызова
+  screen.text(10, 8, ">Tetris");
+  EXPECT_TRUE(screen.present());
+  EXPECT_EQ(screen.stats().frames, 2u);
+  EXPECT_EQ(screen.stats().writes, 2u);
+  char buf[16384];
+  ssize_t n = read(sink[0], buf, sizeof(buf));
+  EXPECT_EQ((uint64_t)n, screen.stats().bytes);
+  EXPECT_THROW(s21::AnsiRenderer(0, 10), std::invalid_argument);
+  close(sink[0]);
+  close(sink[1]);
+}
@@ -0,0 +1,151 @@
+// tests/flight_tests.cpp
+#include <gtest/gtest.h> // подключает фреймворк Google Test для определения тестов и макросов EXPECT_*
+#include <signal.h> // подключает sigaltstack и SIGSEGV для проверки дампа при падении
+#include <fstream> // подключает std::ifstream для чтения файла дампов
+#include <iterator> // подключает std::istreambuf_iterator для чтения файла целиком
+#include <memory> // подключает std::unique_ptr для журналов без сессий
+#include <vector> // подключает std::vector для содержимого дампа
+
+// Сделать private/protected публичными для тестов — обязательно до включения заголовков
+#define private public // временно переопределяем private на public чтобы тесты могли создать экземпляр
+#define protected public // временно переопределяем protected на public для доступа к журналу сессии
+#include "../brick_game/flight.h" // подключаем бортовой самописец
+#include "../brick_game/snake/snake_arena.h" // подключаем змейку на арене
+#include "../brick_game/tetris/tetris.h" // подключаем тетрис
+#undef private // восстанавливаем оригинальное значение private
+#undef protected // восстанавливаем оригинальное значение protected
+#include "tests.h" // подключаем RecordGuard
+
+#define FLIGHT_TEST_FILE "flight_test.bin" // временный файл дампов
+
+static std::vector<uint8_t> read_dumps() { // содержимое файла дампов
+  std::ifstream input(FLIGHT_TEST_FILE, std::ios::binary);
+  return std::vector<uint8_t>(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+}
+
+static size_t count_of(const std::string& text, const std::string& what) { // число вхождений подстроки
+  size_t count = 0;
+  for (size_t pos = text.find(what); pos != std::string::npos; pos = text.find(what, pos + what.size())) count++;
+  return count;
+}
+
+TEST(flight, ring_keeps_latest_records_in_order) { // тест: кольцо вытесняет старейшие записи, дамп упорядочен
+  s21::FlightRecorder recorder;
+  for (int i = 0; i < FLIGHT_RING_SIZE + 88; i++) recorder.record(FLIGHT_INPUT, 2, i);
+  EXPECT_EQ(recorder.size(), (size_t)FLIGHT_RING_SIZE);
+  EXPECT_EQ(recorder.total(), (uint64_t)FLIGHT_RING_SIZE + 88);
+
+  std::vector<uint8_t> buf(FLIGHT_DUMP_MAX);
+  size_t size = recorder.dump_bytes(buf.data(), FLIGHT_REASON_MANUAL);
+  ASSERT_EQ(size, FLIGHT_DUMP_MAX);
+  FlightDumpHeader header;
+  memcpy(&header, buf.data(), sizeof(header));
+  EXPECT_EQ(header.count, (uint32_t)FLIGHT_RING_SIZE);
+  EXPECT_EQ(header.reason, FLIGHT_REASON_MANUAL);
+  FlightRecord first, last;
+  memcpy(&first, buf.data() + sizeof(header), sizeof(first));
+  memcpy(&last, buf.data() + size - sizeof(last), sizeof(last));
+  EXPECT_EQ(first.value, 88); // старейшая сохранённая запись
+  EXPECT_EQ(last.value, FLIGHT_RING_SIZE + 87); // последняя запись
+  EXPECT_LE(first.ns, last.ns);
+
+  std::string text = s21::flight_decode(buf.data(), size);
+  EXPECT_EQ(text.find("manual, last 512 of 600 records"), text.find("manual")); // заголовок сессии
+  EXPECT_EQ(count_of(text, "input"), (size_t)FLIGHT_RING_SIZE);
+  EXPECT_THROW(s21::flight_decode(buf.data(), size - 1), std::invalid_argument); // обрезанный дамп
+  buf[0] = 'X';
+  EXPECT_THROW(s21::flight_decode(buf.data(), size), std::invalid_argument); // не дамп
+}
+
+TEST(flight, tetris_loss_is_dumped_once) { // тест: поражение дописывает журнал сессии один раз
+  RecordGuard guard("tetris_data.bin");
+  remove(FLIGHT_TEST_FILE);
+  ASSERT_TRUE(flightInstall(FLIGHT_TEST_FILE));
+  {
+    s21::Tetris tetris; // отдельный экземпляр
+    tetris.set_user_action(Start);
+    tetris.fsm(); // GameStart -> Spawn
+    tetris.fsm(); // Spawn -> Moving
+    tetris.set_user_action(Terminate);
+    tetris.fsm(); // Moving -> GameOver
+    tetris.fsm(); // GameOver: уровень LOSE_LVL, дамп
+    tetris.fsm(); // повторный GameOver дамп не пишет
+  }
+  flightInstall(nullptr); // остальные тесты дампы не пишут
+  std::vector<uint8_t> dump = read_dumps();
+  std::string text = s21::flight_decode(dump.data(), dump.size());
+  EXPECT_EQ(count_of(text, "session"), 1u);
+  EXPECT_NE(text.find(": lose"), std::string::npos);
+  EXPECT_NE(text.find("input     Moving    Terminate"), std::string::npos);
+  EXPECT_NE(text.find("state     GameOver  Moving"), std::string::npos);
+  EXPECT_EQ(count_of(text, "spawn "), 1u);
+  EXPECT_EQ(count_of(text, "game_over"), 1u);
+  remove(FLIGHT_TEST_FILE);
+}
+
+TEST(flight, closed_session_is_not_dumped) { // тест: закрытие сессии фабрикой — не поражение
+  RecordGuard guard("tetris_data.bin");
+  remove(FLIGHT_TEST_FILE);
+  ASSERT_TRUE(flightInstall(FLIGHT_TEST_FILE));
+  s21::Game* game = s21::GameFabric::create_game(s21::GameFabric::GameName::Tetris, WINDOW_HEIGHT, WINDOW_WIDTH);
+  game->set_user_action(Start);
+  game->fsm();
+  s21::GameFabric::destroy_game(game);
+  flightInstall(nullptr);
+  EXPECT_TRUE(read_dumps().empty());
+  remove(FLIGHT_TEST_FILE);
+}
+
+TEST(flight, escaped_exception_is_dumped) { // тест: исключение из шага КА дописывает журнал и уходит дальше
+  remove(FLIGHT_TEST_FILE);
+  ASSERT_TRUE(flightInstall(FLIGHT_TEST_FILE));
+  {
+    s21::SnakeArena arena(WINDOW_HEIGHT, WINDOW_WIDTH); // арена размером с окно
+    for (uint64_t& word : arena.occupied) word = ~0ULL; // все клетки заняты — яблоку некуда
+    arena.statemachine = s21::Game::Spawn;
+    EXPECT_THROW(arena.fsm(), std::runtime_error);
+  }
+  flightInstall(nullptr);
+  std::vector<uint8_t> dump = read_dumps();
+  std::string text = s21::flight_decode(dump.data(), dump.size());
+  EXPECT_NE(text.find(": exception"), std::string::npos);
+  EXPECT_NE(text.find("exception Spawn"), std::string::npos);
+  remove(FLIGHT_TEST_FILE);
+}
+
+TEST(flight, ring_capacity_is_a_parameter) { // тест: ёмкость кольца задаётся при создании, дамп хранит последние записи
+  s21::FlightRecorder recorder(8);
+  EXPECT_EQ(recorder.capacity(), 8u);
+  for (int i = 0; i < 20; i++) recorder.record(FLIGHT_LOCK, 2, i);
+  EXPECT_EQ(recorder.size(), 8u);
+  EXPECT_EQ(recorder.total(), 20u);
+  uint8_t buf[FLIGHT_DUMP_MAX];
+  size_t size = recorder.dump_bytes(buf, FLIGHT_REASON_MANUAL);
+  EXPECT_EQ(size, sizeof(FlightDumpHeader) + 8 * sizeof(FlightRecord));
+  FlightRecord first;
+  memcpy(&first, buf + sizeof(FlightDumpHeader), sizeof(first));
+  EXPECT_EQ(first.value, 12); // старейшая из последних восьми
+  EXPECT_THROW(s21::FlightRecorder(3), std::invalid_argument);
+  EXPECT_THROW(s21::FlightRecorder(2 * FLIGHT_RING_SIZE), std::invalid_argument);
+}
+
+TEST(flight, crash_dump_covers_sessions_without_slot) { // тест: при падении сессии сверх списка учитываются записью overflow
+  remove(FLIGHT_TEST_FILE);
+  EXPECT_EXIT(
+      {
+        std::vector<std::unique_ptr<s21::FlightRecorder>> recorders;
+        for (int i = 0; i < FLIGHT_MAX_SESSIONS + 10; i++) recorders.emplace_back(new s21::FlightRecorder(4));
+        recorders[0]->record(FLIGHT_INPUT, 0, Start);
+        flightInstall(FLIGHT_TEST_FILE);
+        stack_t stack;
+        sigaltstack(nullptr, &stack);
+        if (stack.ss_flags & SS_DISABLE) _exit(1); // стек обработчика не установлен
+        raise(SIGSEGV);
+      },
+      ::testing::KilledBySignal(SIGSEGV), "");
+  std::vector<uint8_t> dump = read_dumps();
+  std::string text = s21::flight_decode(dump.data(), dump.size());
+  EXPECT_EQ(count_of(text, ": signal 11"), (size_t)FLIGHT_MAX_SESSIONS); // все места списка
+  EXPECT_NE(text.find("10 sessions without a crash slot were not saved"), std::string::npos);
+  remove(FLIGHT_TEST_FILE);
+}
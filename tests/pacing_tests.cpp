@@ -0,0 +1,83 @@
+// tests/pacing_tests.cpp
+#include <gtest/gtest.h> // подключает фреймворк Google Test для определения тестов и макросов EXPECT_*
+#include <fstream> // подключает std::ifstream для чтения файла сводки
+#include <sstream> // подключает std::stringstream для содержимого сводки
+
+// Сделать private публичными для тестов — обязательно до включения заголовков
+#define private public // временно переопределяем private на public для доступа к гистограммам
+#include "../brick_game/pacing.h" // подключаем замеры темпа кадров
+#undef private // восстанавливаем оригинальное значение private
+
+#define PACING_TEST_FILE "pacing_test.txt" // временный файл сводки
+#define MS 1000000ULL // наносекунд в миллисекунде
+
+TEST(pacing, window_forgets_old_frames) { // тест: окно помнит только последние PACING_WINDOW значений
+  s21::FramePacer pacer;
+  for (int i = 0; i < PACING_WINDOW; i++) pacer.add(PACING_STEP, 100 * MS); // медленные шаги
+  for (int i = 0; i < PACING_WINDOW; i++) pacer.add(PACING_STEP, 2 * MS); // быстрые шаги вытесняют медленные
+  PacingStats_t window = pacer.window(PACING_STEP);
+  EXPECT_EQ(window.count, (unsigned long long)PACING_WINDOW);
+  EXPECT_DOUBLE_EQ(window.mean_ms, 2.0);
+  EXPECT_DOUBLE_EQ(window.max_ms, 2.0);
+  EXPECT_NEAR(window.p99_ms, 2.0, 0.1); // верхняя граница корзины близка к значению
+  PacingStats_t total = pacer.total(PACING_STEP);
+  EXPECT_EQ(total.count, 2ULL * PACING_WINDOW);
+  EXPECT_DOUBLE_EQ(total.mean_ms, 51.0);
+  EXPECT_DOUBLE_EQ(total.max_ms, 100.0);
+  EXPECT_NEAR(total.p99_ms, 100.0, 5.0);
+  for (uint32_t count : pacer.series[PACING_STEP].window_buckets) EXPECT_LE(count, (uint32_t)PACING_WINDOW);
+}
+
+TEST(pacing, p99_sees_rare_slow_frame) { // тест: редкий долгий кадр виден в p99, но не в медиане
+  s21::FramePacer pacer;
+  for (int i = 0; i < 99; i++) pacer.add(PACING_RENDER, 1 * MS);
+  pacer.add(PACING_RENDER, 50 * MS);
+  pacer.add(PACING_RENDER, 50 * MS);
+  PacingStats_t window = pacer.window(PACING_RENDER);
+  EXPECT_NEAR(window.p50_ms, 1.0, 0.05);
+  EXPECT_NEAR(window.p99_ms, 50.0, 2.5);
+  EXPECT_DOUBLE_EQ(window.max_ms, 50.0);
+}
+
+TEST(pacing, interval_and_input_latency) { // тест: интервал кадров, FPS и задержка от ввода до кадра
+  s21::FramePacer pacer;
+  EXPECT_EQ(pacer.fps(), 0.0); // кадров ещё не было
+  uint64_t now = 1000 * MS;
+  pacer.presented(now); // первый кадр интервала не даёт
+  EXPECT_EQ(pacer.total(PACING_INTERVAL).count, 0ULL);
+  for (int i = 0; i < 10; i++) {
+    if (i == 4) {
+      pacer.input(now + 3 * MS); // первый ввод перед кадром
+      pacer.input(now + 9 * MS); // второй ввод задержку не сдвигает
+    }
+    now += 20 * MS;
+    pacer.presented(now);
+  }
+  EXPECT_EQ(pacer.total(PACING_INTERVAL).count, 10ULL);
+  EXPECT_DOUBLE_EQ(pacer.window(PACING_INTERVAL).mean_ms, 20.0);
+  EXPECT_DOUBLE_EQ(pacer.fps(), 50.0);
+  PacingStats_t latency = pacer.total(PACING_LATENCY);
+  EXPECT_EQ(latency.count, 1ULL); // ввод учтён один раз
+  EXPECT_DOUBLE_EQ(latency.max_ms, 17.0);
+
+  std::vector<std::string> lines = pacer.overlay();
+  ASSERT_EQ(lines.size(), 3u);
+  EXPECT_EQ(lines[0], "FPS    50.0");
+  for (const std::string& line : lines) EXPECT_LE(line.size(), 11u); // помещается в боковую панель консоли
+}
+
+TEST(pacing, summary_is_written) { // тест: сводка за всё время пишется в файл
+  s21::FramePacer pacer;
+  pacer.presented(1 * MS);
+  pacer.presented(17 * MS);
+  pacer.add(PACING_STEP, 1 * MS);
+  ASSERT_TRUE(pacer.write_summary(PACING_TEST_FILE));
+  std::ifstream input(PACING_TEST_FILE);
+  std::stringstream text;
+  text << input.rdbuf();
+  EXPECT_NE(text.str().find("frames 2"), std::string::npos);
+  EXPECT_NE(text.str().find("interval"), std::string::npos);
+  EXPECT_NE(text.str().find("latency"), std::string::npos);
+  remove(PACING_TEST_FILE);
+  EXPECT_FALSE(pacer.write_summary("no_such_dir/pacing.txt")); // каталога нет
+}
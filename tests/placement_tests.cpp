@@ -0,0 +1,157 @@
+// tests/placement_tests.cpp
+#include <gtest/gtest.h> // подключает фреймворк Google Test для определения тестов и макросов EXPECT_*
+#include <memory> // подключает std::unique_ptr для объекта перебора
+
+// Сделать private/protected публичными для тестов — обязательно до включения заголовков
+#define private public // временно переопределяем private на public чтобы тесты могли обращаться к внутренним методам
+#define protected public // временно переопределяем protected на public для доступа к защищённым членам
+#include "../brick_game/tetris/placement.h" // подключаем перебор положений вместе с классом Tetris
+#undef private // восстанавливаем оригинальное значение private
+#undef protected // восстанавливаем оригинальное значение protected
+
+using s21::PlacementFinder; // импортируем имя класса перебора
+using s21::Tetris; // импортируем имя класса Tetris
+
+// Вспомогательная функция: количество положений фигуры с номером random на поле field
+static int count_placements(PlacementFinder* finder, int** field, int random) {
+  int brick[BRICK_SIZE]; // координаты фигуры
+  Tetris::get_instance()->new_brick(brick, random); // фигура в исходном положении
+  return finder->find(field, brick); // перебор положений
+}
+
+TEST(tetris_placement, empty_field_counts) { // тест: число положений на пустом поле совпадает с ручным подсчётом
+  Tetris* t = Tetris::get_instance(); // синглтон Tetris (только вспомогательные методы)
+  std::unique_ptr<PlacementFinder> finder(new PlacementFinder(t)); // объект перебора на поле синглтона
+  int** field = t->init_matrix(nullptr, WINDOW_HEIGHT, WINDOW_WIDTH); // пустое поле
+  t->fill_array_zero(field, WINDOW_HEIGHT, WINDOW_WIDTH); // обнуляем поле
+
+  EXPECT_EQ(count_placements(finder.get(), field, 1), 34); // Teewee: 8 + 8 + 9 + 9
+  EXPECT_EQ(count_placements(finder.get(), field, 2), 17); // Hero: 7 горизонтальных + 10 вертикальных
+  EXPECT_EQ(count_placements(finder.get(), field, 3), 9); // Smashboy: 9 столбцов, один поворот
+
+  t->free_memory_matrix(field, WINDOW_HEIGHT); // освобождаем поле
+}
+
+TEST(tetris_placement, paths_replay_to_placement) { // тест: восстановленный путь приводит фигуру в найденное положение
+  Tetris* t = Tetris::get_instance(); // синглтон Tetris
+  std::unique_ptr<PlacementFinder> finder(new PlacementFinder(t)); // объект перебора на поле синглтона
+  int** field = t->init_matrix(nullptr, WINDOW_HEIGHT, WINDOW_WIDTH); // поле
+  t->fill_array_zero(field, WINDOW_HEIGHT, WINDOW_WIDTH); // обнуляем поле
+  for (int x = 0; x < WINDOW_WIDTH - 3; x++) field[WINDOW_HEIGHT - 1][x] = 1; // неровный рельеф
+  field[WINDOW_HEIGHT - 2][2] = 1; // выступ
+
+  int start[BRICK_SIZE]; // исходное положение
+  t->new_brick(start, 4); // Orange Ricky
+  int found = finder->find(field, start); // перебор положений
+  ASSERT_GT(found, 0); // положения есть
+  UserAction_t path[PLACEMENT_STATES]; // буфер пути
+  for (int i = 0; i < found; i++) { // проверяем каждое положение
+    int length = finder->path(i, path, PLACEMENT_STATES); // путь к положению
+    ASSERT_EQ(length, finder->get(i).path_length); // длина совпадает с сохранённой
+    int brick[BRICK_SIZE]; // фигура, двигаемая по пути
+    t->brick_copy(brick, start); // из исходного положения
+    for (int k = 0; k < length; k++) { // применяем действия
+      if (path[k] == Down) { // опускание
+        ASSERT_TRUE(t->check_down(field, brick)); // опускание допустимо
+        t->coord_shift(brick, 0, 1); // сдвиг вниз
+      } else { // сдвиг или поворот
+        t->brick_move(brick, path[k], field); // по правилам игры
+      }
+    }
+    EXPECT_FALSE(t->check_down(field, brick)); // фигура лежит
+    for (int k = 0; k < BRICK_SIZE; k++) EXPECT_EQ(brick[k], finder->get(i).brick[k]); // координаты совпадают
+  }
+
+  t->free_memory_matrix(field, WINDOW_HEIGHT); // освобождаем поле
+}
+
+TEST(tetris_placement, tuck_under_overhang) { // тест: находится положение под нависающим блоком
+  Tetris* t = Tetris::get_instance(); // синглтон Tetris
+  std::unique_ptr<PlacementFinder> finder(new PlacementFinder(t)); // объект перебора на поле синглтона
+  int** field = t->init_matrix(nullptr, WINDOW_HEIGHT, WINDOW_WIDTH); // поле
+  t->fill_array_zero(field, WINDOW_HEIGHT, WINDOW_WIDTH); // обнуляем поле
+  for (int x = 0; x <= 5; x++) field[WINDOW_HEIGHT - 3][x] = 1; // полка, закрывающая левый нижний угол сверху
+
+  int found = count_placements(finder.get(), field, 2); // перебор для Hero
+  bool tucked = false; // найдено ли положение под полкой
+  for (int i = 0; i < found; i++) { // перебор результатов
+    const PlacementFinder::Placement& p = finder->get(i); // положение
+    for (int k = 0; k < BRICK_SIZE; k += 2) // блоки фигуры
+      if (p.brick[k] == WINDOW_HEIGHT - 1 && p.brick[k + 1] == 0) tucked = true; // блок в углу под полкой
+  }
+  EXPECT_TRUE(tucked); // подсовывание найдено
+
+  t->free_memory_matrix(field, WINDOW_HEIGHT); // освобождаем поле
+}
+
+TEST(tetris_placement, find_current_restores_field) { // тест: find_current не изменяет поле игры
+  Tetris tetris; // отдельный экземпляр, не затрагивающий синглтон
+  std::unique_ptr<PlacementFinder> finder(new PlacementFinder(&tetris)); // объект перебора этой сессии
+  EXPECT_EQ(finder->find_current(), 0); // вне Moving положений нет
+
+  int brick[BRICK_SIZE]; // текущая фигура
+  tetris.new_brick(brick, 1); // Teewee
+  tetris.gameinfo.field = tetris.matrix_init(WINDOW_HEIGHT, WINDOW_WIDTH); // поле игры, освобождается деструктором Game
+  tetris.fill_array_zero(tetris.gameinfo.field, WINDOW_HEIGHT, WINDOW_WIDTH); // обнуляем поле
+  tetris.current_brick = brick; // фигура на поле
+  tetris.current_color = 3; // цвет фигуры
+  tetris.spawn_brick(tetris.gameinfo.field, brick, tetris.current_color); // рисуем фигуру
+  tetris.statemachine = Tetris::Moving; // фигура перемещается
+
+  EXPECT_EQ(finder->find_current(), 34); // фигура на поле не мешает перебору
+  int filled = 0; // количество занятых клеток после перебора
+  for (int i = 0; i < WINDOW_HEIGHT; i++) // проход по строкам
+    for (int j = 0; j < WINDOW_WIDTH; j++) filled += tetris.gameinfo.field[i][j] == 3; // клетки фигуры
+  EXPECT_EQ(filled, BRICK_SIZE / 2); // фигура возвращена на поле
+}
+
+TEST(tetris_placement, board_and_pieces_come_from_the_game) { // тест: размеры поля и набор фигур берутся из сессии
+  s21::RuntimeTetris* wide = dynamic_cast<s21::RuntimeTetris*>(
+      s21::GameFabric::create_game(s21::GameFabric::GameName::Tetris, WINDOW_HEIGHT, 30)); // колодец шириной 30
+  ASSERT_NE(wide, nullptr);
+  s21::BasicPlacementFinder<s21::RuntimeTetris> wide_finder(wide);
+  EXPECT_EQ(wide_finder.states(), WINDOW_HEIGHT * 30 * PLACEMENT_ROTATIONS);
+  int brick[2 * PIECE_MAX_CELLS]; // фигура в исходном положении
+  wide->new_brick(brick, 3); // Smashboy
+  EXPECT_EQ(wide_finder.find(wide->gameinfo.field, brick), 29); // 29 столбцов вместо 9 на стандартном поле
+  wide->new_brick(brick, 2); // Hero
+  EXPECT_EQ(wide_finder.find(wide->gameinfo.field, brick), 27 + 30); // горизонтальные и вертикальные
+  s21::GameFabric::destroy_game(wide);
+
+  using PentominoTetris = s21::TetrisGame<s21::StandardBoard, s21::PentominoPieces>;
+  PentominoTetris* pentomino = dynamic_cast<PentominoTetris*>(s21::GameFabric::create_game(
+      s21::GameFabric::GameName::Tetris, WINDOW_HEIGHT, WINDOW_WIDTH, s21::GameFabric::PieceSet::Pentomino));
+  ASSERT_NE(pentomino, nullptr);
+  s21::BasicPlacementFinder<PentominoTetris> finder(pentomino);
+  UserAction_t path[PLACEMENT_STATES]; // буфер пути
+  for (int piece = 1; piece <= s21::PentominoPieces::count; piece++) { // каждая фигура набора
+    int start[2 * PIECE_MAX_CELLS]; // исходное положение
+    pentomino->new_brick(start, piece);
+    int found = finder.find(pentomino->gameinfo.field, start);
+    ASSERT_GT(found, 0) << "piece " << piece;
+    for (int i = 0; i < found; i++) { // путь приводит в найденное положение из пяти блоков
+      int length = finder.path(i, path, PLACEMENT_STATES);
+      int moved[2 * PIECE_MAX_CELLS];
+      pentomino->brick_copy(moved, start);
+      for (int k = 0; k < length; k++) {
+        if (path[k] == Down) pentomino->coord_shift(moved, 0, 1);
+        else pentomino->brick_move(moved, path[k], pentomino->gameinfo.field);
+      }
+      EXPECT_FALSE(pentomino->check_down(pentomino->gameinfo.field, moved));
+      for (int k = 0; k < 2 * PIECE_MAX_CELLS; k++) ASSERT_EQ(moved[k], finder.get(i).brick[k]) << "piece " << piece;
+    }
+  }
+  s21::GameFabric::destroy_game(pentomino);
+
+  using TrainingTetris = s21::TetrisGame<s21::RuntimeBoard, s21::TrainingPieces>;
+  TrainingTetris* training = dynamic_cast<TrainingTetris*>(s21::GameFabric::create_game(
+      s21::GameFabric::GameName::Tetris, WINDOW_HEIGHT, 12, s21::GameFabric::PieceSet::Training)); // тренировочный набор на поле 20x12
+  ASSERT_NE(training, nullptr);
+  s21::BasicPlacementFinder<TrainingTetris> training_finder(training);
+  for (int piece = 1; piece <= s21::TrainingPieces::count; piece++) { // каждая фигура набора
+    int start[2 * PIECE_MAX_CELLS]; // исходное положение
+    training->new_brick(start, piece);
+    EXPECT_GT(training_finder.find(training->gameinfo.field, start), 0) << "piece " << piece;
+  }
+  s21::GameFabric::destroy_game(training);
+}
@@ -0,0 +1,161 @@
+// tests/replay_tests.cpp
+#include <gtest/gtest.h> // подключает фреймворк Google Test для определения тестов и макросов EXPECT_*
+#include <stdio.h> // подключает remove и fopen для файлов повтора
+#include <unistd.h> // подключает getpid и truncate
+
+#include <algorithm> // подключает std::shuffle для случайного порядка тиков
+#include <random> // подключает генератор порядка тиков
+#include <string> // подключает std::string для путей файлов
+#include <vector> // подключает std::vector для снимков тиков
+
+#include "../brick_game/replay.h" // подключаем запись и чтение повтора
+#include "../brick_game/rewind.h" // подключаем формат записей разности
+
+static std::string replay_path(const char* name) { // путь временного файла повтора
+  return "/tmp/brickgame_" + std::string(name) + "_" + std::to_string(getpid()) + ".replay";
+}
+
+// Состояние тика для сверки: снимок содержит время таймера, поэтому сравниваются хэш поля и счётчики
+struct TickState {
+  uint64_t hash;
+  int score;
+  size_t size;
+};
+
+// Вспомогательная функция: партия тетриса, каждый шаг которой пишется тиком; возвращает состояния тиков
+static std::vector<TickState> record_game(const std::string& path, int steps, size_t keyframe_interval) {
+  std::vector<TickState> states; // состояния тиков по порядку
+  const UserAction_t moves[] = {Left, Right, Action, Down, Start}; // ввод партии
+  s21::Game* game = s21::GameFabric::create_game(s21::GameFabric::GameName::Tetris, WINDOW_HEIGHT, WINDOW_WIDTH);
+  s21::ReplayWriter writer(path.c_str(), keyframe_interval);
+  game->set_user_action(Start);
+  for (int i = 0; i < steps && game->get_gameinfo().level != LOSE_LVL; i++) {
+    game->set_user_action(moves[i % 5]);
+    game->fsm();
+    writer.record(*game);
+    states.push_back({game->state_hash(), game->get_gameinfo().score, game->snapshot_size()});
+  }
+  EXPECT_TRUE(writer.finish());
+  s21::GameFabric::destroy_game(game);
+  return states;
+}
+
+TEST(replay, random_ticks_match_recorded_states) { // тест: любой тик в любом порядке восстанавливает записанное состояние
+  std::string path = replay_path("random");
+  std::vector<TickState> states = record_game(path, 3000, 64);
+  s21::ReplayReader reader(path.c_str());
+  ASSERT_EQ(reader.ticks(), states.size());
+  EXPECT_EQ(reader.keyframe_interval(), 64u);
+  std::vector<size_t> order(states.size());
+  for (size_t i = 0; i < order.size(); i++) order[i] = i;
+  std::shuffle(order.begin(), order.end(), std::minstd_rand(47)); // случайный доступ
+  s21::Game* game = reader.open(order[0]); // сессия на случайном тике
+  ASSERT_NE(game, nullptr);
+  std::vector<uint8_t> snapshot;
+  for (size_t tick : order) {
+    ASSERT_TRUE(reader.snapshot(tick, &snapshot));
+    EXPECT_EQ(snapshot.size(), states[tick].size);
+    ASSERT_TRUE(reader.seek(game, tick));
+    ASSERT_EQ(game->state_hash(), states[tick].hash) << "tick " << tick;
+    ASSERT_EQ(game->get_gameinfo().score, states[tick].score) << "tick " << tick;
+  }
+  EXPECT_FALSE(reader.snapshot(states.size(), &snapshot)); // за последним тиком
+  EXPECT_FALSE(reader.seek(game, states.size()));
+  s21::GameFabric::destroy_game(game);
+  remove(path.c_str());
+}
+
+TEST(replay, deltas_keep_file_small) { // тест: тики между опорными снимками занимают малую часть снимка
+  std::string path = replay_path("size");
+  std::vector<TickState> states = record_game(path, 2000, REPLAY_KEYFRAME_INTERVAL);
+  FILE* file = fopen(path.c_str(), "rb");
+  ASSERT_NE(file, nullptr);
+  fseek(file, 0, SEEK_END);
+  long size = ftell(file);
+  fclose(file);
+  size_t full = 0; // размер тех же тиков полными снимками
+  for (const TickState& state : states) full += state.size;
+  EXPECT_LT((size_t)size * 4, full); // разности в разы меньше снимков
+  remove(path.c_str());
+}
+
+TEST(replay, player_seeks_by_tick_and_time) { // тест: просмотр переходит по номеру и по времени записи
+  std::string path = replay_path("player");
+  std::vector<TickState> states = record_game(path, 500, 32);
+  s21::ReplayPlayer player(path.c_str());
+  EXPECT_EQ(player.tick(), 0u);
+  EXPECT_EQ(player.ticks(), states.size());
+  EXPECT_TRUE(player.seek(states.size() + 10)); // за концом — последний тик
+  EXPECT_EQ(player.tick(), states.size() - 1);
+  EXPECT_GE(player.duration_us(), player.time_us());
+  ASSERT_TRUE(player.seek(123));
+  int64_t t = player.time_us();
+  ASSERT_TRUE(player.seek_time(t));
+  EXPECT_GE(player.tick(), 123u); // тики с тем же временем: берётся последний из них
+  EXPECT_EQ(player.time_us(), t);
+  ASSERT_TRUE(player.seek_time(-1)); // раньше первого тика — первый тик
+  EXPECT_EQ(player.tick(), 0u);
+  EXPECT_NE(player.gameinfo().field, nullptr);
+  player.toggle();
+  EXPECT_TRUE(player.playing());
+  player.seek(10); // перемотка останавливает воспроизведение
+  EXPECT_FALSE(player.playing());
+  remove(path.c_str());
+}
+
+TEST(replay, damaged_deltas_are_rejected) { // тест: разность, выходящая за снимок или за свою запись, не применяется
+  std::string path = replay_path("delta");
+  std::vector<TickState> states = record_game(path, 100, 16);
+  FILE* file = fopen(path.c_str(), "r+b");
+  ASSERT_NE(file, nullptr);
+  s21::ReplayTrailer trailer;
+  fseek(file, -(long)sizeof(trailer), SEEK_END);
+  ASSERT_EQ(fread(&trailer, sizeof(trailer), 1, file), 1u);
+  std::vector<s21::ReplayIndexEntry> index(trailer.ticks); // индекс тиков
+  fseek(file, (long)trailer.index_offset, SEEK_SET);
+  ASSERT_EQ(fread(index.data(), sizeof(s21::ReplayIndexEntry), index.size(), file), index.size());
+  std::vector<size_t> damaged; // тики с испорченной разностью
+  for (size_t tick = 0; tick < index.size() && damaged.size() < 2; tick++) {
+    if (index[tick].key == tick || index[tick].size < REWIND_RECORD_HEAD) continue; // нужен тик с разностью
+    uint8_t head[REWIND_RECORD_HEAD] = {0xFF, 0xFF, 0xFF, 0xFF}; // запись за концом снимка
+    if (damaged.size() == 1) { // вторая — длиннее своей разности
+      head[0] = head[1] = 0;
+      head[2] = (uint8_t)index[tick].size;
+      head[3] = (uint8_t)(index[tick].size >> 8);
+    }
+    fseek(file, (long)index[tick].offset, SEEK_SET);
+    fwrite(head, 1, REWIND_RECORD_HEAD, file);
+    damaged.push_back(tick);
+  }
+  fclose(file);
+  ASSERT_EQ(damaged.size(), 2u);
+  s21::ReplayReader reader(path.c_str());
+  s21::Game* game = s21::GameFabric::create_game(s21::GameFabric::GameName::Tetris, WINDOW_HEIGHT, WINDOW_WIDTH);
+  std::vector<uint8_t> snapshot;
+  for (size_t tick : damaged) {
+    EXPECT_FALSE(reader.snapshot(tick, &snapshot));
+    EXPECT_FALSE(reader.seek(game, tick));
+  }
+  EXPECT_TRUE(reader.seek(game, 0)); // целые тики читаются
+  s21::GameFabric::destroy_game(game);
+  remove(path.c_str());
+}
+
+TEST(replay, truncated_files_are_rejected) { // тест: файл без хвоста и чужой файл не открываются
+  std::string path = replay_path("bad");
+  record_game(path, 100, 16);
+  FILE* file = fopen(path.c_str(), "rb");
+  ASSERT_NE(file, nullptr);
+  fseek(file, 0, SEEK_END);
+  long size = ftell(file);
+  fclose(file);
+  ASSERT_EQ(truncate(path.c_str(), size - 1), 0); // хвост оборван
+  EXPECT_THROW(s21::ReplayReader reader(path.c_str()), std::runtime_error);
+  file = fopen(path.c_str(), "wb");
+  fputs("not a replay file, but long enough to hold a header and a trailer", file);
+  fclose(file);
+  EXPECT_THROW(s21::ReplayReader reader(path.c_str()), std::runtime_error);
+  remove(path.c_str());
+  EXPECT_THROW(s21::ReplayPlayer player(path.c_str()), std::runtime_error); // файла нет
+  EXPECT_FALSE(replayStart(nullptr)); // запись выключена
+}
@@ -0,0 +1,147 @@
+// tests/rewind_tests.cpp
+#include <gtest/gtest.h> // подключает фреймворк Google Test для определения тестов и макросов EXPECT_*
+#include <stdexcept> // подключает std::invalid_argument
+#include <vector> // подключает std::vector для копий снимков
+
+// Сделать private/protected публичными для тестов — обязательно до включения заголовков
+#define private public // временно переопределяем private на public чтобы тесты могли проверять состояние КА
+#define protected public // временно переопределяем protected на public для доступа к состоянию КА
+#include "../brick_game/rewind.h" // подключаем буфер отката
+#include "../brick_game/tetris/tetris.h" // подключаем тетрис
+#undef private // восстанавливаем оригинальное значение private
+#undef protected // восстанавливаем оригинальное значение protected
+#include "tests.h" // подключаем RecordGuard
+
+using s21::Game; // импортируем имя базового класса
+using s21::GameFabric; // импортируем имя фабрики
+using s21::RewindBuffer; // импортируем имя буфера отката
+
+// Вспомогательная функция: steps шагов партии, после каждого шага снимок попадает в буфер и в history
+static void play(Game* game, RewindBuffer* rewind, std::vector<std::vector<uint8_t>>* history, int steps) {
+  const UserAction_t moves[] = {Left, Action, Right, Down, Right, Down, Left, Left, Down, Action}; // без мгновенного сброса: партия длится дольше
+  for (int i = 0; i < steps && game->statemachine != Game::GameOver; i++) {
+    if (game->statemachine == Game::Moving) game->set_user_action(moves[rand() % 10]);
+    game->fsm();
+    rewind->record(*game);
+    history->push_back(game->snapshot());
+  }
+}
+
+// Вспомогательная функция: сессия в партии (GameStart -> Spawn)
+static Game* start_tetris() {
+  Game* game = GameFabric::create_game(GameFabric::GameName::Tetris, WINDOW_HEIGHT, WINDOW_WIDTH);
+  game->set_user_action(Start);
+  game->fsm();
+  return game;
+}
+
+TEST(rewind, peek_returns_recorded_snapshots) { // тест: любой из последних шагов восстанавливается байт в байт
+  RecordGuard guard("tetris_data.bin");
+  srand(17);
+  Game* game = start_tetris();
+  RewindBuffer rewind(100, 16);
+  std::vector<std::vector<uint8_t>> history; // полные снимки шагов
+  play(game, &rewind, &history, 300);
+  ASSERT_EQ(history.size(), 300u);
+  EXPECT_EQ(rewind.size(), 100u); // старые шаги вытеснены
+  std::vector<uint8_t> snapshot;
+  for (size_t back = 0; back < rewind.size(); back++) { // каждый сохранённый шаг
+    ASSERT_TRUE(rewind.peek(back, &snapshot));
+    // снимок в буфере записан record, копия в history — следующим вызовом snapshot; отличается только таймер
+    const std::vector<uint8_t>& copy = history[history.size() - 1 - back];
+    ASSERT_EQ(snapshot.size(), copy.size()) << back;
+    int differ = 0; // отличающиеся байты
+    for (size_t i = 0; i < copy.size(); i++) differ += snapshot[i] != copy[i];
+    ASSERT_LE(differ, (int)sizeof(int64_t)) << back; // не больше поля таймера
+  }
+  EXPECT_FALSE(rewind.peek(100, &snapshot)); // шага за пределами буфера нет
+  GameFabric::destroy_game(game);
+}
+
+TEST(rewind, damaged_deltas_are_rejected) { // тест: запись разности за пределами разности или снимка не применяется
+  std::vector<uint8_t> base(64, 1), data(base); // опорный снимок и снимок шага
+  data[10] = 7;
+  data[40] = 9;
+  std::vector<uint8_t> delta; // разность шага
+  s21::delta_encode(base.data(), base.size(), data.data(), data.size(), &delta);
+  std::vector<uint8_t> out(base); // копия опорного
+  ASSERT_TRUE(s21::delta_apply(delta.data(), delta.size(), out.data(), out.size()));
+  EXPECT_EQ(out, data);
+  out = base;
+  EXPECT_FALSE(s21::delta_apply(delta.data(), delta.size() - 1, out.data(), out.size())); // оборванная запись
+  out = base;
+  EXPECT_FALSE(s21::delta_apply(delta.data(), delta.size(), out.data(), 32)); // запись за концом снимка
+  out = base;
+  const uint8_t far[] = {0xFF, 0xFF, 1, 0, 0x55}; // пропуск за конец снимка
+  EXPECT_FALSE(s21::delta_apply(far, sizeof(far), out.data(), out.size()));
+  const uint8_t head[] = {0, 0, 1}; // оборванный заголовок
+  EXPECT_FALSE(s21::delta_apply(head, sizeof(head), out.data(), out.size()));
+  EXPECT_EQ(out, base); // до повреждённой записи ничего не применено
+}
+
+TEST(rewind, deltas_are_small) { // тест: шаг тетриса стоит десятки байт, а не целое поле
+  RecordGuard guard("tetris_data.bin");
+  srand(5);
+  Game* game = start_tetris();
+  RewindBuffer rewind(600);
+  std::vector<std::vector<uint8_t>> history;
+  play(game, &rewind, &history, 600);
+  size_t full = 0; // байт в полных снимках
+  for (size_t i = history.size() - rewind.size(); i < history.size(); i++) full += history[i].size();
+  EXPECT_LT(rewind.memory() * 5, full); // разности в разы меньше копий
+  GameFabric::destroy_game(game);
+}
+
+TEST(rewind, rewind_restores_state_and_continues) { // тест: откат возвращает поле и счёт и позволяет продолжить
+  RecordGuard guard("tetris_data.bin");
+  srand(23);
+  Game* game = start_tetris();
+  Game* reference = start_tetris(); // сессия для сравнения
+  RewindBuffer rewind(64, 8);
+  std::vector<std::vector<uint8_t>> history;
+  play(game, &rewind, &history, 200);
+  ASSERT_GE(history.size(), 40u);
+
+  ASSERT_TRUE(reference->restore(history[history.size() - 31].data(), history[history.size() - 31].size()));
+  ASSERT_TRUE(rewind.rewind(game, 30)); // 30 шагов назад
+  EXPECT_EQ(rewind.size(), 34u); // более поздние шаги удалены
+  for (int y = 0; y < WINDOW_HEIGHT; y++)
+    for (int x = 0; x < WINDOW_WIDTH; x++) ASSERT_EQ(game->gameinfo.field[y][x], reference->gameinfo.field[y][x]);
+  EXPECT_EQ(game->gameinfo.score, reference->gameinfo.score);
+  EXPECT_EQ(game->statemachine, reference->statemachine);
+
+  play(game, &rewind, &history, 100); // запись продолжается от восстановленного шага
+  EXPECT_EQ(rewind.size(), 64u);
+  std::vector<uint8_t> snapshot;
+  ASSERT_TRUE(rewind.peek(0, &snapshot));
+  EXPECT_TRUE(game->restore(snapshot.data(), snapshot.size()));
+  EXPECT_FALSE(rewind.rewind(game, 64)); // шага нет в буфере
+  GameFabric::destroy_game(game);
+  GameFabric::destroy_game(reference);
+}
+
+TEST(rewind, rewind_out_of_game_over) { // тест: ходы перед GameOver можно разобрать и переиграть
+  RecordGuard guard("tetris_data.bin");
+  srand(29);
+  Game* game = start_tetris();
+  RewindBuffer rewind(50);
+  std::vector<std::vector<uint8_t>> history;
+  const UserAction_t drop[] = {Up};
+  for (int i = 0; i < 2000 && game->statemachine != Game::GameOver; i++) { // сбросы до конца партии
+    if (game->statemachine == Game::Moving) game->set_user_action(drop[0]);
+    game->fsm();
+    rewind.record(*game);
+  }
+  ASSERT_EQ(game->statemachine, Game::GameOver);
+  game->fsm(); // GameOver: фигуры освобождены
+  rewind.record(*game);
+  EXPECT_EQ(game->gameinfo.level, -1);
+
+  ASSERT_TRUE(rewind.rewind(game, 10)); // за несколько шагов до конца партии
+  EXPECT_NE(game->statemachine, Game::GameOver);
+  EXPECT_GT(game->gameinfo.level, 0); // фигуры снова выделены
+  play(game, &rewind, &history, 50); // партия продолжается
+  GameFabric::destroy_game(game);
+
+  EXPECT_THROW(RewindBuffer(0), std::invalid_argument);
+}
@@ -0,0 +1,145 @@
+// tests/rollback_tests.cpp
+#include <gtest/gtest.h> // подключает фреймворк Google Test для определения тестов и макросов EXPECT_*
+#include <atomic> // подключает счётчик узлов, закончивших матч
+#include <random> // подключает генератор ввода
+#include <thread> // подключает std::thread для второго узла
+#include <vector> // подключает std::vector для ввода и снимков
+
+#include "../brick_game/tetris/rollback.h" // подключаем матч по кадрам и сессию с откатом
+#include "../gui/netplay/netplay.h" // подключаем узел UDP
+
+// Вспомогательная функция: ввод игрока для кадра — чаще всего ничего, иногда сдвиг, поворот или сброс
+static uint8_t bot_input(std::mt19937& gen) {
+  const UserAction_t moves[] = {Left, Right, Action, Down, Up};
+  return gen() % 4 ? ROLLBACK_NO_INPUT : (uint8_t)moves[gen() % 5];
+}
+
+TEST(lockstep, same_seed_and_input_give_same_match) { // тест: матч зависит только от зерна и ввода
+  s21::LockstepMatch a(48), b(48), c(49);
+  std::mt19937 gen(1);
+  for (int f = 0; f < 2000; f++) {
+    uint8_t inputs[ROLLBACK_PLAYERS] = {bot_input(gen), bot_input(gen)};
+    a.step(inputs);
+    b.step(inputs);
+    c.step(inputs);
+    ASSERT_EQ(a.checksum(), b.checksum()) << "frame " << f;
+  }
+  EXPECT_EQ(a.frame(), 2000u);
+  EXPECT_NE(a.checksum(), c.checksum()); // другое зерно — другие фигуры
+  EXPECT_EQ(a.board_info(0).score, b.board_info(0).score);
+}
+
+TEST(lockstep, restore_replays_the_same_frames) { // тест: снимок и повтор кадров дают то же состояние
+  s21::LockstepMatch match(7);
+  std::mt19937 gen(2);
+  std::vector<uint8_t> inputs(2 * 600);
+  for (uint8_t& input : inputs) input = bot_input(gen);
+  for (int f = 0; f < 100; f++) match.step(&inputs[2 * f]);
+  std::vector<uint8_t> saved(match.state_size());
+  ASSERT_EQ(match.save(saved.data(), saved.size()), saved.size());
+  EXPECT_EQ(match.save(saved.data(), saved.size() - 1), 0u); // буфер мал
+  for (int f = 100; f < 600; f++) match.step(&inputs[2 * f]);
+  uint64_t expected = match.checksum();
+  ASSERT_TRUE(match.restore(saved.data(), saved.size()));
+  EXPECT_EQ(match.frame(), 100u);
+  for (int f = 100; f < 600; f++) match.step(&inputs[2 * f]);
+  EXPECT_EQ(match.checksum(), expected);
+  EXPECT_FALSE(match.restore(saved.data(), saved.size() / 2)); // оборванный снимок
+}
+
+TEST(lockstep, garbage_decides_the_match) { // тест: мусор доходит до соперника, и матч заканчивается
+  s21::LockstepMatch match(3);
+  std::mt19937 gen(3);
+  int f = 0;
+  for (; f < 200000 && !match.finished(); f++) {
+    uint8_t inputs[ROLLBACK_PLAYERS] = {(uint8_t)(gen() % 2 ? Up : ROLLBACK_NO_INPUT), bot_input(gen)}; // первый сбрасывает фигуры
+    match.step(inputs);
+  }
+  EXPECT_TRUE(match.finished());
+  EXPECT_NE(match.winner(), -1);
+  EXPECT_EQ(match.board_info(match.winner() == 0 ? 1 : 0).level, -1); // проигравшее поле закончило партию
+}
+
+TEST(rollback, late_inputs_resimulate_to_the_direct_result) { // тест: откаты приводят к тому же матчу, что и шаг с полным вводом
+  const int frames = 1500, latency = 5; // ввод соперника приходит на latency кадров позже
+  std::mt19937 gen(4);
+  std::vector<uint8_t> local(frames), remote(frames);
+  for (int f = 0; f < frames; f++) local[f] = bot_input(gen), remote[f] = bot_input(gen);
+  s21::LockstepMatch direct(11); // тот же матч без предсказаний
+  s21::RollbackSession session(1, 11);
+  for (int f = 0; f < frames; f++) {
+    uint8_t inputs[ROLLBACK_PLAYERS] = {remote[f], local[f]};
+    direct.step(inputs);
+    if (f >= latency) {
+      ASSERT_TRUE(session.add_remote_input(f - latency, remote[f - latency]));
+    }
+    session.add_local_input(local[f]);
+    ASSERT_TRUE(session.advance());
+  }
+  for (int f = frames - latency; f < frames; f++) ASSERT_TRUE(session.add_remote_input(f, remote[f]));
+  EXPECT_FALSE(session.add_remote_input(frames + 3, 0)); // кадры только по порядку
+  session.synchronize();
+  uint64_t sum = 0;
+  ASSERT_TRUE(session.checksum(frames, &sum));
+  EXPECT_EQ(sum, direct.checksum());
+  EXPECT_EQ(session.confirmed_frame(), (uint32_t)frames);
+  EXPECT_GT(session.stats().rollbacks, 0u);
+  EXPECT_GT(session.stats().resimulated, session.stats().rollbacks); // откат пересчитывает несколько кадров
+  uint8_t input = 0;
+  ASSERT_TRUE(session.local_input(frames - 1, &input));
+  EXPECT_EQ(input, local[frames - 1]);
+  EXPECT_FALSE(session.local_input(0, &input)); // кадр ушёл из кольца
+}
+
+TEST(rollback, stalls_when_too_far_ahead) { // тест: без ввода соперника узел опережает его не больше окна
+  s21::RollbackSession session(0, 5, 4);
+  int advanced = 0;
+  for (int f = 0; f < 20; f++) advanced += session.advance();
+  EXPECT_EQ(advanced, 4);
+  EXPECT_EQ(session.stats().stalls, 16u);
+  uint64_t sum = 0;
+  EXPECT_TRUE(session.checksum(0, &sum)); // начальное состояние подтверждено
+  EXPECT_FALSE(session.checksum(1, &sum)); // кадр 1 посчитан с предсказанием
+  ASSERT_TRUE(session.add_remote_input(0, ROLLBACK_NO_INPUT));
+  EXPECT_TRUE(session.advance());
+  EXPECT_THROW(s21::RollbackSession(2, 0), std::invalid_argument);
+  EXPECT_THROW(s21::RollbackSession(0, 0, ROLLBACK_MAX_FRAMES), std::invalid_argument);
+}
+
+TEST(netplay, loopback_peers_agree_under_latency_and_loss) { // тест: два узла через UDP с задержкой и потерями не расходятся
+  const uint32_t frames = 240;
+  s21::NetplayPeer peers[2] = {s21::NetplayPeer(0, 15, 0.2, 1), s21::NetplayPeer(0, 15, 0.2, 2)};
+  peers[0].connect(peers[1].port());
+  peers[1].connect(peers[0].port());
+  s21::RollbackSession sessions[2] = {s21::RollbackSession(0, 77), s21::RollbackSession(1, 77)};
+  std::atomic<int> finished{0};
+  auto node = [&](int i) {
+    std::mt19937 gen(10 + i);
+    bool done = false;
+    for (int loop = 0; loop < 200000 && finished.load() < 2; loop++) {
+      peers[i].poll(&sessions[i], 1);
+      if (sessions[i].frame() < frames) {
+        sessions[i].add_local_input(bot_input(gen));
+        sessions[i].advance();
+      }
+      peers[i].send(sessions[i]);
+      if (!done && sessions[i].frame() >= frames && sessions[i].remote_frames() >= frames) {
+        sessions[i].synchronize();
+        done = true;
+        finished++;
+      }
+    }
+  };
+  std::thread other(node, 1);
+  node(0);
+  other.join();
+  ASSERT_EQ(finished.load(), 2);
+  uint64_t sum[2] = {0, 0};
+  ASSERT_TRUE(sessions[0].checksum(frames, &sum[0]));
+  ASSERT_TRUE(sessions[1].checksum(frames, &sum[1]));
+  EXPECT_EQ(sum[0], sum[1]);
+  EXPECT_FALSE(peers[0].desynced());
+  EXPECT_FALSE(peers[1].desynced());
+  EXPECT_GT(peers[0].stats().dropped + peers[1].stats().dropped, 0u);
+  EXPECT_GT(sessions[0].stats().rollbacks + sessions[1].stats().rollbacks, 0u);
+}
@@ -0,0 +1,405 @@
+// tests/server_tests.cpp
+#ifdef __linux__ // сервер использует epoll и собирается только в Linux
+#include <gtest/gtest.h> // подключает фреймворк Google Test для определения тестов и макросов EXPECT_*
+#include <arpa/inet.h> // подключает htons и htonl для адреса клиента
+#include <netinet/in.h> // подключает sockaddr_in
+#include <string.h> // подключает memcpy для пути сокета
+#include <sys/ioctl.h> // подключает FIONREAD для остатка в сокете сервера
+#include <sys/socket.h> // подключает сокеты клиента
+#include <sys/un.h> // подключает sockaddr_un
+#include <unistd.h> // подключает close и getpid
+
+#include <string> // подключает std::string для пути сокета
+#include <vector> // подключает std::vector для буферов клиента
+
+// Сделать private/protected публичными для тестов — обязательно до включения заголовков
+#define private public // временно переопределяем private на public чтобы тесты видели соединения сервера
+#define protected public // временно переопределяем protected на public для доступа к состоянию КА
+#include "../gui/server/server.h" // подключаем сервер и протокол
+#undef private // восстанавливаем оригинальное значение private
+#undef protected // восстанавливаем оригинальное значение protected
+
+using s21::GameServer; // импортируем имя сервера
+
+// Клиент-заглушка: блокирующий сокет, разбор ответов и восстановление поля по кадрам
+struct TestClient {
+  int fd = -1; // сокет клиента
+  std::vector<uint8_t> in; // принятые байты
+  uint32_t session = 0; // номер сессии из MSG_CREATED
+  int rows = 0, cols = 0; // размер поля
+  std::vector<int> field; // восстановленное поле
+  std::vector<int> next = std::vector<int>(NEXT_SIZE * NEXT_SIZE, 0); // восстановленная область next
+  int score = 0, level = 0, pause = 0; // счёт, уровень и пауза последнего кадра
+  std::vector<int> errors; // коды MSG_ERROR
+  int deltas = 0; // количество полных кадров
+  uint32_t watching = 0; // сессия из MSG_WATCHING
+  s21::FrameDecoder spectator; // состояние трансляции
+  int frames = 0; // принятых кадров трансляции
+
+  ~TestClient() {
+    if (fd >= 0) close(fd);
+  }
+
+  bool connect_unix(const std::string& path) {
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    return connect(fd, (sockaddr*)&addr, sizeof(addr)) == 0;
+  }
+
+  bool connect_tcp(int port) {
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons((uint16_t)port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    fd = socket(AF_INET, SOCK_STREAM, 0);
+    return connect(fd, (sockaddr*)&addr, sizeof(addr)) == 0;
+  }
+
+  void send_raw(uint8_t type, const std::vector<uint8_t>& data) { // сообщение с заголовком
+    std::vector<uint8_t> msg(PROTO_HEADER_SIZE + data.size());
+    s21::put_header(msg.data(), type, 0, data.size());
+    std::copy(data.begin(), data.end(), msg.begin() + PROTO_HEADER_SIZE);
+    ASSERT_EQ(send(fd, msg.data(), msg.size(), MSG_NOSIGNAL), (ssize_t)msg.size());
+  }
+
+  void create(int game, int height, int width, int pieces = 0) { // MSG_CREATE
+    std::vector<uint8_t> data(CREATE_SIZE);
+    data[0] = (uint8_t)game;
+    data[1] = (uint8_t)pieces;
+    s21::put_u16(&data[2], (uint16_t)height);
+    s21::put_u16(&data[4], (uint16_t)width);
+    send_raw(MSG_CREATE, data);
+  }
+
+  void input(UserAction_t action) { send_raw(MSG_INPUT, {(uint8_t)action, 0}); } // MSG_INPUT
+
+  void receive() { // чтение всего доступного без ожидания и разбор сообщений
+    uint8_t chunk[4096];
+    ssize_t n;
+    while ((n = recv(fd, chunk, sizeof(chunk), MSG_DONTWAIT)) > 0) in.insert(in.end(), chunk, chunk + n);
+    size_t pos = 0;
+    while (in.size() - pos >= PROTO_HEADER_SIZE) {
+      const uint8_t* header = in.data() + pos;
+      size_t length = s21::get_u16(header + 2);
+      if (in.size() - pos < PROTO_HEADER_SIZE + length) break;
+      apply(header[0], header[1], header + PROTO_HEADER_SIZE);
+      pos += PROTO_HEADER_SIZE + length;
+    }
+    in.erase(in.begin(), in.begin() + pos);
+  }
+
+  void apply(uint8_t type, uint8_t flags, const uint8_t* data) { // применение сообщения к локальному состоянию
+    if (type == MSG_CREATED) {
+      session = s21::get_u32(data);
+      rows = s21::get_u16(data + 4);
+      cols = s21::get_u16(data + 6);
+      field.assign(rows * cols, 0);
+    } else if (type == MSG_DELTA) {
+      score = (int)s21::get_u32(data);
+      level = (int)s21::get_u32(data + 8);
+      pause = data[16];
+      int count = s21::get_u16(data + 17);
+      for (int i = 0; i < count; i++) {
+        const uint8_t* cell = data + DELTA_HEAD_SIZE + i * DELTA_CELL_SIZE;
+        int y = s21::get_u16(cell + 1), x = s21::get_u16(cell + 3);
+        int value = (int8_t)cell[5];
+        if (cell[0] == PLANE_FIELD) field[y * cols + x] = value;
+        else next[y * NEXT_SIZE + x] = value;
+      }
+      if (!(flags & DELTA_FLAG_MORE)) deltas++;
+    } else if (type == MSG_ERROR) {
+      errors.push_back(data[0]);
+    } else if (type == MSG_WATCHING) {
+      watching = s21::get_u32(data);
+    } else if (type == MSG_FRAME) {
+      EXPECT_TRUE(spectator.apply(flags, data, s21::get_u16(data - 2))); // длина из заголовка
+      frames++;
+    }
+  }
+
+  void watch(uint32_t id) { // MSG_WATCH
+    std::vector<uint8_t> data(WATCH_SIZE);
+    s21::put_u32(data.data(), id);
+    send_raw(MSG_WATCH, data);
+  }
+};
+
+// Вспомогательная функция: несколько итераций сервера и чтение ответов клиентами
+static void pump(GameServer* server, std::vector<TestClient*> clients, int iterations = 5, int timeout = 0) {
+  for (int i = 0; i < iterations; i++) {
+    server->run_once(timeout); // сервер обрабатывает события
+    for (TestClient* client : clients) client->receive(); // клиенты читают ответы
+  }
+}
+
+// Вспомогательная функция: поле клиента совпадает с полем сессии на сервере
+static void expect_same_field(GameServer* server, const TestClient& client) {
+  const GameServer::Connection* conn = nullptr;
+  for (auto& entry : server->conns)
+    if (entry.second->session == client.session) conn = entry.second.get();
+  ASSERT_NE(conn, nullptr);
+  const GameInfo_t& info = conn->game->get_gameinfo();
+  for (int y = 0; y < client.rows; y++)
+    for (int x = 0; x < client.cols; x++) ASSERT_EQ(client.field[y * client.cols + x], info.field[y][x]);
+  for (int y = 0; y < NEXT_SIZE; y++)
+    for (int x = 0; x < NEXT_SIZE; x++) ASSERT_EQ(client.next[y * NEXT_SIZE + x], info.next[y][x]);
+  EXPECT_EQ(client.score, info.score);
+  EXPECT_EQ(client.level, info.level);
+}
+
+// Вспомогательная функция: состояние декодировщика совпадает с состоянием игры
+static void expect_same_spectator(const s21::FrameDecoder& decoder, const GameInfo_t& info) {
+  ASSERT_TRUE(decoder.synced);
+  for (int y = 0; y < decoder.rows; y++)
+    for (int x = 0; x < decoder.cols; x++) ASSERT_EQ(decoder.field[y * decoder.cols + x], info.field[y][x]);
+  for (int y = 0; y < NEXT_SIZE; y++)
+    for (int x = 0; x < NEXT_SIZE; x++) ASSERT_EQ(decoder.next[y * NEXT_SIZE + x], info.next[y][x]);
+  EXPECT_EQ(decoder.info.score, info.score);
+  EXPECT_EQ(decoder.info.level, info.level);
+}
+
+TEST(game_server, unix_session_mirrors_field) { // тест: клиент через Unix-сокет восстанавливает поле из кадров
+  std::string path = "/tmp/brickgame_test_" + std::to_string(getpid()) + ".sock";
+  GameServer server;
+  server.listen_unix(path);
+  TestClient client;
+  ASSERT_TRUE(client.connect_unix(path));
+  client.create((int)s21::GameFabric::GameName::Tetris, WINDOW_HEIGHT, WINDOW_WIDTH);
+  pump(&server, {&client});
+  EXPECT_EQ(server.connections(), 1u);
+  EXPECT_EQ(server.sessions(), 1u);
+  EXPECT_EQ(client.session, 1u);
+  EXPECT_EQ(client.rows, WINDOW_HEIGHT);
+  EXPECT_EQ(client.cols, WINDOW_WIDTH);
+  EXPECT_EQ(client.deltas, 1); // начальный кадр
+
+  client.input(Start); // GameStart -> Spawn
+  pump(&server, {&client});
+  const UserAction_t moves[] = {Left, Left, Action, Right, Down, Up, Right, Action, Up, Left, Up};
+  for (UserAction_t move : moves) { // ввод и гравитация по таймеру
+    client.input(move);
+    pump(&server, {&client}, 3, 2 * SERVER_TICK_MS);
+    expect_same_field(&server, client);
+  }
+  EXPECT_EQ(client.level, 1);
+
+  client.input(Pause);
+  pump(&server, {&client});
+  EXPECT_EQ(client.pause, 1); // пауза пришла в кадре
+
+  client.send_raw(MSG_CLOSE, {});
+  pump(&server, {&client});
+  EXPECT_EQ(server.sessions(), 0u); // сессия удалена, соединение открыто
+  EXPECT_EQ(server.connections(), 1u);
+  client.create((int)s21::GameFabric::GameName::Snake, WINDOW_HEIGHT, WINDOW_WIDTH);
+  pump(&server, {&client});
+  EXPECT_EQ(client.session, 2u); // новая сессия в том же соединении
+  EXPECT_TRUE(client.errors.empty());
+}
+
+TEST(game_server, tcp_many_sessions) { // тест: много сессий через TCP шагают по одному таймеру
+  GameServer server;
+  int port = server.listen_tcp(0); // любой свободный порт
+  ASSERT_GT(port, 0);
+  const int count = 200;
+  std::vector<TestClient> clients(count);
+  std::vector<TestClient*> all;
+  for (int i = 0; i < count; i++) {
+    ASSERT_TRUE(clients[i].connect_tcp(port));
+    bool tetris = i % 2 == 0; // тетрис и большие арены змейки вперемешку
+    clients[i].create((int)(tetris ? s21::GameFabric::GameName::Tetris : s21::GameFabric::GameName::Snake),
+                      tetris ? 24 : 100, tetris ? 12 : 100, i % 3);
+    all.push_back(&clients[i]);
+  }
+  pump(&server, all, 20);
+  ASSERT_EQ(server.sessions(), (size_t)count);
+  for (TestClient* client : all) client->input(Start);
+  pump(&server, all, 10, SERVER_TICK_MS);
+  for (int i = 0; i < count; i++) {
+    EXPECT_TRUE(clients[i].errors.empty());
+    expect_same_field(&server, clients[i]);
+  }
+
+  for (int i = 0; i < count / 2; i++) close(clients[i].fd), clients[i].fd = -1; // половина клиентов уходит
+  pump(&server, all, 5);
+  EXPECT_EQ(server.connections(), (size_t)(count - count / 2));
+  EXPECT_EQ(server.sessions(), (size_t)(count - count / 2));
+}
+
+TEST(game_server, protocol_errors) { // тест: неверные запросы получают MSG_ERROR, соединение остаётся рабочим
+  GameServer server;
+  int port = server.listen_tcp(0);
+  TestClient client;
+  ASSERT_TRUE(client.connect_tcp(port));
+  client.input(Left); // сессии ещё нет
+  client.send_raw(0x7f, {}); // неизвестный тип
+  client.send_raw(MSG_INPUT, {1}); // неверная длина
+  client.create(9, WINDOW_HEIGHT, WINDOW_WIDTH); // неизвестная игра
+  client.create((int)s21::GameFabric::GameName::Tetris, 2, 2); // поле меньше фигуры
+  client.create((int)s21::GameFabric::GameName::Tetris, 1000, 1000); // поле больше SERVER_MAX_CELLS
+  client.create((int)s21::GameFabric::GameName::Tetris, WINDOW_HEIGHT, WINDOW_WIDTH);
+  client.create((int)s21::GameFabric::GameName::Tetris, WINDOW_HEIGHT, WINDOW_WIDTH); // повторное создание
+  pump(&server, {&client});
+  std::vector<int> expected = {ERR_NO_SESSION, ERR_BAD_MESSAGE, ERR_BAD_MESSAGE, ERR_BAD_GAME,
+                               ERR_BAD_GAME,   ERR_BAD_GAME,    ERR_SESSION_EXISTS};
+  EXPECT_EQ(client.errors, expected);
+  EXPECT_EQ(server.sessions(), 1u);
+  EXPECT_EQ(client.session, 1u);
+}
+
+TEST(game_server, reads_are_bounded_per_event) { // тест: одно событие читает не больше SERVER_READ_BUDGET, остаток — на следующих
+  GameServer server;
+  int port = server.listen_tcp(0);
+  TestClient client;
+  ASSERT_TRUE(client.connect_tcp(port));
+  pump(&server, {&client}); // сервер принял соединение
+  GameServer::Connection* conn = server.conns.begin()->second.get();
+  std::vector<uint8_t> payload(60000, 0); // MSG_INPUT неверной длины
+  client.send_raw(MSG_INPUT, payload);
+  client.send_raw(MSG_INPUT, payload);
+  usleep(20000); // данные дошли до сокета сервера
+  server.on_readable(conn);
+  int pending = 0;
+  ASSERT_EQ(ioctl(conn->fd, FIONREAD, &pending), 0);
+  EXPECT_GT(pending, 0); // второе сообщение ещё в сокете
+  EXPECT_LE(conn->in.size(), (size_t)SERVER_READ_BUDGET);
+  pump(&server, {&client}, 20);
+  EXPECT_EQ(client.errors, std::vector<int>({ERR_BAD_MESSAGE, ERR_BAD_MESSAGE})); // оба сообщения разобраны
+  EXPECT_TRUE(conn->in.empty());
+}
+
+TEST(game_server, large_frame_is_split) { // тест: кадр больше PROTO_MAX_PAYLOAD приходит несколькими сообщениями
+  GameServer server;
+  int port = server.listen_tcp(0);
+  TestClient client;
+  ASSERT_TRUE(client.connect_tcp(port));
+  client.create((int)s21::GameFabric::GameName::Tetris, 256, 256);
+  pump(&server, {&client});
+  GameServer::Connection* conn = server.conns.begin()->second.get();
+  for (int y = 0; y < 256; y++)
+    for (int x = 0; x < 256; x++) conn->game->gameinfo.field[y][x] = 1 + (x + y) % 6; // изменено всё поле
+  server.send_delta(conn);
+  std::vector<uint8_t> flags; // флаги сообщений кадра в выходном буфере
+  for (size_t pos = conn->out_pos; pos < conn->out.size(); pos += PROTO_HEADER_SIZE + s21::get_u16(&conn->out[pos + 2]))
+    flags.push_back(conn->out[pos + 1]);
+  ASSERT_GE(flags.size(), 2u); // клеток больше, чем помещается в одно сообщение
+  for (size_t i = 0; i + 1 < flags.size(); i++) EXPECT_EQ(flags[i], DELTA_FLAG_MORE); // продолжение кадра
+  EXPECT_EQ(flags.back(), 0); // последняя часть
+  server.on_writable(conn);
+  pump(&server, {&client}, 20);
+  expect_same_field(&server, client);
+}
+
+TEST(game_server, spectator_frames_round_trip) { // тест: кадры трансляции восстанавливают игру и намного меньше GameInfo_t
+  s21::Game* game = s21::GameFabric::create_game(s21::GameFabric::GameName::Tetris, WINDOW_HEIGHT, WINDOW_WIDTH);
+  s21::FrameEncoder encoder(7, WINDOW_HEIGHT, WINDOW_WIDTH);
+  s21::FrameDecoder decoder;
+  game->set_user_action(Start);
+  size_t bytes = 0, frames = 0, keys = 0;
+  const UserAction_t moves[] = {Left, Action, Down, Right, Down, Up, Start, Start};
+  for (int step = 0; step < 600 && game->get_gameinfo().level >= 0; step++) { // до конца партии
+    game->fsm();
+    game->set_user_action(moves[step % 8]);
+    s21::SharedFrame frame = encoder.encode(game->get_gameinfo());
+    if (!frame) continue; // шаг ничего не изменил
+    frames++;
+    bytes += frame->size();
+    keys += ((*frame)[1] & FRAME_FLAG_KEY) != 0;
+    ASSERT_TRUE(decoder.apply((*frame)[1], frame->data() + PROTO_HEADER_SIZE, frame->size() - PROTO_HEADER_SIZE));
+    expect_same_spectator(decoder, game->get_gameinfo());
+  }
+  ASSERT_GT(frames, 0u);
+  EXPECT_EQ(decoder.session, 7u);
+  EXPECT_GE(keys, 2u); // опорные кадры повторяются
+  size_t plain = (WINDOW_HEIGHT * WINDOW_WIDTH + NEXT_SIZE * NEXT_SIZE) * sizeof(int); // поле и next числами int
+  EXPECT_LT(bytes / frames * 8, plain); // кадр в разы меньше
+  s21::GameFabric::destroy_game(game);
+}
+
+TEST(game_server, spectator_waits_for_keyframe) { // тест: после пропуска кадра зритель ждёт опорного
+  s21::Game* game = s21::GameFabric::create_game(s21::GameFabric::GameName::Snake, WINDOW_HEIGHT, WINDOW_WIDTH);
+  s21::FrameEncoder encoder(1, WINDOW_HEIGHT, WINDOW_WIDTH);
+  s21::FrameDecoder decoder;
+  int** field = game->gameinfo.field;
+  std::vector<s21::SharedFrame> frames;
+  for (int i = 0; i <= SPECTATOR_KEYFRAME_INTERVAL; i++) { // каждый шаг меняет одну клетку
+    field[i % WINDOW_HEIGHT][i % WINDOW_WIDTH] = 1 + i % 6;
+    frames.push_back(encoder.encode(game->gameinfo));
+  }
+  EXPECT_TRUE(decoder.apply((*frames[0])[1], frames[0]->data() + PROTO_HEADER_SIZE, frames[0]->size() - PROTO_HEADER_SIZE));
+  EXPECT_FALSE(decoder.apply((*frames[2])[1], frames[2]->data() + PROTO_HEADER_SIZE,
+                             frames[2]->size() - PROTO_HEADER_SIZE)); // кадр 1 пропущен
+  EXPECT_FALSE(decoder.apply((*frames[3])[1], frames[3]->data() + PROTO_HEADER_SIZE,
+                             frames[3]->size() - PROTO_HEADER_SIZE)); // без опорного не применяется
+  const s21::SharedFrame& key = frames.back();
+  EXPECT_EQ((*key)[1], FRAME_FLAG_KEY); // опорный кадр через SPECTATOR_KEYFRAME_INTERVAL шагов
+  EXPECT_TRUE(decoder.apply((*key)[1], key->data() + PROTO_HEADER_SIZE, key->size() - PROTO_HEADER_SIZE));
+  expect_same_spectator(decoder, game->gameinfo);
+  encoder.request_key(); // новый зритель
+  s21::SharedFrame late = encoder.encode(game->gameinfo);
+  ASSERT_NE(late, nullptr); // поле не менялось, но кадр нужен
+  EXPECT_EQ((*late)[1], FRAME_FLAG_KEY); // опорный сразу, а не через SPECTATOR_KEYFRAME_INTERVAL шагов
+  s21::FrameDecoder joined;
+  EXPECT_TRUE(joined.apply((*late)[1], late->data() + PROTO_HEADER_SIZE, late->size() - PROTO_HEADER_SIZE));
+  expect_same_spectator(joined, game->gameinfo);
+  s21::GameFabric::destroy_game(game);
+}
+
+TEST(game_server, many_watchers_share_frames) { // тест: одна сессия транслируется сотням зрителей
+  std::string path = "/tmp/brickgame_watch_" + std::to_string(getpid()) + ".sock";
+  GameServer server;
+  server.listen_unix(path);
+  TestClient player;
+  ASSERT_TRUE(player.connect_unix(path));
+  player.create((int)s21::GameFabric::GameName::Tetris, WINDOW_HEIGHT, WINDOW_WIDTH);
+  player.input(Start);
+  pump(&server, {&player});
+  const int count = 300;
+  std::vector<TestClient> watchers(count);
+  std::vector<TestClient*> all = {&player};
+  for (TestClient& watcher : watchers) {
+    ASSERT_TRUE(watcher.connect_unix(path));
+    watcher.watch(player.session);
+    all.push_back(&watcher);
+  }
+  pump(&server, all, 10);
+  GameServer::Connection* conn = server.session_index[player.session];
+  EXPECT_EQ(conn->watchers.size(), (size_t)count);
+
+  const UserAction_t moves[] = {Left, Action, Right, Up, Left, Up};
+  for (UserAction_t move : moves) {
+    player.input(move);
+    pump(&server, all, 3, SERVER_TICK_MS);
+  }
+  pump(&server, all, 5);
+  for (TestClient& watcher : watchers) {
+    EXPECT_EQ(watcher.watching, player.session);
+    EXPECT_GT(watcher.frames, 0);
+    expect_same_spectator(watcher.spectator, conn->game->get_gameinfo());
+  }
+  TestClient late; // зритель подключается к идущей трансляции
+  ASSERT_TRUE(late.connect_unix(path));
+  late.watch(player.session);
+  all.push_back(&late);
+  pump(&server, all, 5);
+  player.input(Left);
+  pump(&server, all, 3, SERVER_TICK_MS);
+  pump(&server, all, 5);
+  EXPECT_GT(late.frames, 0); // опорный кадр на первом же шаге
+  expect_same_spectator(late.spectator, conn->game->get_gameinfo());
+
+  close(watchers[0].fd), watchers[0].fd = -1; // зритель уходит
+  watchers[1].watch(0); // зритель отписывается
+  pump(&server, all, 5);
+  EXPECT_EQ(conn->watchers.size(), (size_t)count - 1); // два ушли, один подключился позже
+  player.send_raw(MSG_CLOSE, {}); // сессия завершена — зрители получают ошибку
+  pump(&server, all, 5);
+  EXPECT_EQ(watchers[2].errors, std::vector<int>{ERR_NO_SESSION});
+  EXPECT_TRUE(watchers[1].errors.empty());
+  watchers[2].watch(12345); // несуществующая сессия
+  pump(&server, all, 5);
+  EXPECT_EQ(watchers[2].errors.back(), ERR_NO_SESSION);
+}
+#endif  // __linux__
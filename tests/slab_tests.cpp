@@ -0,0 +1,85 @@
+// tests/slab_tests.cpp
+#include <gtest/gtest.h> // подключает фреймворк Google Test для определения тестов и макросов EXPECT_*
+#include <stdint.h> // подключает uintptr_t для проверки выравнивания
+#include <vector> // подключает std::vector для списка блоков
+
+#include "../brick_game/brick_game_single.h" // подключаем фабрику сессий
+#include "../brick_game/slab.h" // подключаем slab-распределитель
+#include "../brick_game/tetris/tetris.h" // подключаем тетрис для размера объекта сессии
+
+TEST(slab_pool, blocks_are_aligned_and_reused) { // тест: блоки выравнены по строке кэша, освобождённый выдаётся снова
+  EXPECT_EQ(s21::SlabPool::block_size(1), (size_t)SLAB_ALIGN);
+  EXPECT_EQ(s21::SlabPool::block_size(SLAB_ALIGN), (size_t)SLAB_ALIGN);
+  EXPECT_EQ(s21::SlabPool::block_size(SLAB_ALIGN + 1), (size_t)2 * SLAB_ALIGN);
+
+  size_t used = s21::SlabPool::in_use();
+  std::vector<void*> blocks;
+  for (int i = 0; i < 100; i++) blocks.push_back(s21::SlabPool::allocate(100 + i)); // классы 128, 192 и 256
+  for (void* block : blocks) EXPECT_EQ((uintptr_t)block % SLAB_ALIGN, 0u);
+  EXPECT_GT(s21::SlabPool::in_use(), used);
+  void* last = blocks.back();
+  s21::SlabPool::deallocate(last, 199); // блок класса 256
+  EXPECT_EQ(s21::SlabPool::allocate(250), last); // последний освобождённый блок класса
+  for (int i = 0; i < 100; i++) s21::SlabPool::deallocate(blocks[i], 100 + i);
+  EXPECT_EQ(s21::SlabPool::in_use(), used); // все блоки возвращены
+
+  void* big = s21::SlabPool::allocate(SLAB_MAX_BLOCK + 1); // большой блок — через operator new
+  EXPECT_EQ(s21::SlabPool::in_use(), used);
+  s21::SlabPool::deallocate(big, SLAB_MAX_BLOCK + 1);
+}
+
+TEST(slab_pool, sessions_come_from_slab_without_growth) { // тест: сессии фабрики — блоки slab, повторное создание не берёт новых чанков
+  using s21::GameFabric;
+  size_t used = s21::SlabPool::in_use();
+  std::vector<s21::Game*> games;
+  for (int i = 0; i < 64; i++) { // тетрис, змейка и поля нестандартного размера
+    games.push_back(GameFabric::create_game(GameFabric::GameName::Tetris, WINDOW_HEIGHT, WINDOW_WIDTH));
+    games.push_back(GameFabric::create_game(GameFabric::GameName::Tetris, 24, 12));
+    games.push_back(GameFabric::create_game(GameFabric::GameName::Snake, WINDOW_HEIGHT, WINDOW_WIDTH));
+  }
+  for (s21::Game* game : games) EXPECT_EQ((uintptr_t)game % SLAB_ALIGN, 0u);
+  size_t per_round = s21::SlabPool::in_use() - used; // объекты сессий и их поля
+  for (s21::Game* game : games) GameFabric::destroy_game(game);
+  EXPECT_EQ(s21::SlabPool::in_use(), used);
+
+  size_t mapped = s21::SlabPool::mapped();
+  for (int round = 0; round < 10; round++) { // те же сессии снова
+    games.clear();
+    for (int i = 0; i < 64; i++) {
+      games.push_back(GameFabric::create_game(GameFabric::GameName::Tetris, WINDOW_HEIGHT, WINDOW_WIDTH));
+      games.push_back(GameFabric::create_game(GameFabric::GameName::Tetris, 24, 12));
+      games.push_back(GameFabric::create_game(GameFabric::GameName::Snake, WINDOW_HEIGHT, WINDOW_WIDTH));
+    }
+    EXPECT_EQ(s21::SlabPool::in_use() - used, per_round);
+    for (s21::Game* game : games) GameFabric::destroy_game(game);
+  }
+  EXPECT_EQ(s21::SlabPool::mapped(), mapped); // блоки переиспользуются из списков
+  EXPECT_EQ(s21::SlabPool::in_use(), used);
+}
+
+TEST(slab_pool, tetris_session_fits_4_kb) { // тест: сессия тетриса — четыре блока slab, объект не больше 512 байт, всего не больше 4 КБ
+  EXPECT_LE(s21::SlabPool::block_size(sizeof(s21::TetrisGame<s21::StandardBoard, s21::StandardPieces>)), 512u);
+  EXPECT_LE(s21::SlabPool::block_size(sizeof(s21::TetrisGame<s21::RuntimeBoard, s21::StandardPieces>)), 512u);
+  EXPECT_LE(s21::SlabPool::block_size(sizeof(s21::TetrisGame<s21::StandardBoard, s21::PentominoPieces>)), 512u);
+  size_t used = s21::SlabPool::in_use();
+  s21::Game* game = s21::GameFabric::create_game(s21::GameFabric::GameName::Tetris, WINDOW_HEIGHT, WINDOW_WIDTH);
+  size_t ring = FLIGHT_SESSION_RING * sizeof(FlightRecord); // журнал сессии — отдельный блок
+  size_t field = WINDOW_HEIGHT * (sizeof(int*) + WINDOW_WIDTH * sizeof(int)); // поле с указателями строк
+  size_t next = NEXT_SIZE * (sizeof(int*) + NEXT_SIZE * sizeof(int)); // область next
+  size_t total = s21::SlabPool::block_size(sizeof(s21::Tetris)) + s21::SlabPool::block_size(ring) +
+                 s21::SlabPool::block_size(field) + s21::SlabPool::block_size(next); // объект, журнал, поле и next
+  EXPECT_EQ(s21::SlabPool::in_use() - used, total); // вся сессия — блоки slab
+  EXPECT_LE(total, 4096u); // 512 + 2048 + 960 + 256 байт
+  s21::GameFabric::destroy_game(game);
+  EXPECT_EQ(s21::SlabPool::in_use(), used);
+}
+
+TEST(slab_pool, huge_pages_fall_back_to_regular_pages) { // тест: без настроенных больших страниц чанк берётся обычным mmap
+  s21::SlabPool::use_huge_pages(true);
+  size_t mapped = s21::SlabPool::mapped();
+  std::vector<void*> blocks;
+  for (size_t bytes = 0; bytes <= SLAB_CHUNK_SIZE; bytes += SLAB_MAX_BLOCK) blocks.push_back(s21::SlabPool::allocate(SLAB_MAX_BLOCK));
+  EXPECT_GT(s21::SlabPool::mapped(), mapped); // новый чанк получен
+  for (void* block : blocks) s21::SlabPool::deallocate(block, SLAB_MAX_BLOCK);
+  s21::SlabPool::use_huge_pages(false);
+}
@@ -0,0 +1,129 @@
+// tests/snake_arena_tests.cpp
+#include <gtest/gtest.h> // подключает фреймворк Google Test для определения тестов и макросов EXPECT_*
+#include <memory> // подключает std::unique_ptr для сессий арены
+#include <set> // подключает std::set для проверки уникальности клеток тела
+
+// Сделать private/protected публичными для тестов — обязательно до включения заголовков
+#define private public // временно переопределяем private на public чтобы тесты могли создавать отдельные арены
+#define protected public // временно переопределяем protected на public для доступа к состоянию КА
+#include "../brick_game/snake/snake_arena.h" // подключаем змейку на большой арене
+#undef private // восстанавливаем оригинальное значение private
+#undef protected // восстанавливаем оригинальное значение protected
+
+using s21::SnakeArena; // импортируем имя класса арены
+
+// Вспомогательная функция: старт партии до состояния Moving
+static void start_arena(SnakeArena* arena) {
+  arena->action = Start; // нажатие "старт"
+  arena->fsm(); // GameStart -> Spawn
+  arena->fsm(); // Spawn -> Moving
+}
+
+// Вспомогательная функция: один шаг змейки с действием input, яблоко обрабатывается сразу
+static void step(SnakeArena* arena, UserAction_t input) {
+  arena->action = input; // действие игрока
+  arena->set_direction(); // поворот, если он допустим
+  arena->statemachine = SnakeArena::Shifting; // шаг без ожидания таймера
+  arena->fsm(); // Shifting -> Moving или Attaching
+  if (arena->statemachine == SnakeArena::Attaching) arena->fsm(); // яблоко или столкновение
+  if (arena->statemachine == SnakeArena::Spawn) arena->fsm(); // новое яблоко
+}
+
+// Вспомогательная функция: кольцевой буфер и битовая карта описывают одно и то же тело
+static void expect_body_consistent(const SnakeArena& arena) {
+  std::set<uint32_t> body; // клетки тела из кольцевого буфера
+  for (uint32_t i = 0; i < arena.size; i++) { // от головы к хвосту
+    uint32_t cell = arena.ring[(arena.head_pos + i) % arena.cells]; // клетка сегмента
+    EXPECT_TRUE(arena.is_occupied(cell)); // клетка отмечена в битовой карте
+    body.insert(cell); // запоминаем клетку
+  }
+  EXPECT_EQ(body.size(), arena.size); // сегменты не пересекаются
+  size_t bits = 0; // количество отмеченных клеток
+  for (uint64_t word : arena.occupied) bits += __builtin_popcountll(word); // подсчёт битов
+  EXPECT_EQ(bits, arena.size); // в битовой карте нет лишних клеток
+}
+
+TEST(snake_arena, million_cell_arena_plays) { // тест: арена 1000x1000 ходит и растёт без рассинхронизации тела
+  std::unique_ptr<SnakeArena> arena(new SnakeArena(1000, 1000)); // миллион клеток
+  start_arena(arena.get()); // старт партии
+  EXPECT_EQ(arena->length(), 4u); // стартовая длина
+  expect_body_consistent(*arena); // стартовое тело
+
+  for (int i = 0; i < 50; i++) { // змейка ест яблоки, поставленные перед головой
+    arena->apple = arena->head() - arena->width; // яблоко над головой
+    step(arena.get(), Up); // шаг на яблоко
+  }
+  arena->apple = arena->cells - 1; // следующее яблоко в стороне от пути
+  for (int i = 0; i < 300; i++) step(arena.get(), (i / 100) % 2 ? Left : Up); // зигзаг по арене
+  EXPECT_NE(arena->statemachine, SnakeArena::GameOver); // змейка не врезалась
+  EXPECT_EQ(arena->gameinfo.score, 50); // все яблоки съедены
+  EXPECT_EQ(arena->length(), 54u); // рост завершился
+  expect_body_consistent(*arena); // тело после роста и поворотов
+}
+
+TEST(snake_arena, viewport_follows_head) { // тест: окно вывода сдвигается вслед за головой и прижимается к краю
+  std::unique_ptr<SnakeArena> arena(new SnakeArena(200, 300)); // большая арена
+  start_arena(arena.get()); // старт партии
+  for (int i = 0; i < 120; i++) step(arena.get(), Left); // к левой стене
+  for (int i = 0; i < 30; i++) step(arena.get(), Up); // вверх
+  int head_y = arena->head() / arena->width; // строка головы
+  int head_x = arena->head() % arena->width; // столбец головы
+  EXPECT_EQ(arena->viewport_x(), std::max(head_x - WINDOW_WIDTH / 2, 0)); // окно по горизонтали
+  EXPECT_EQ(arena->viewport_y(), std::max(head_y - WINDOW_HEIGHT / 2, 0)); // окно по вертикали
+  EXPECT_EQ(arena->gameinfo.field[head_y - arena->viewport_y()][head_x - arena->viewport_x()], 4); // голова в окне
+
+  for (int i = 0; i < head_x; i++) step(arena.get(), Left); // вплотную к левой стене
+  EXPECT_EQ(arena->viewport_x(), 0); // окно прижато к краю
+  EXPECT_EQ(arena->gameinfo.field[head_y - arena->viewport_y()][0], 4); // голова в левом столбце окна
+}
+
+TEST(snake_arena, wall_ends_game) { // тест: выход за стену арены завершает игру поражением
+  std::unique_ptr<SnakeArena> arena(new SnakeArena(WINDOW_HEIGHT, WINDOW_WIDTH)); // минимальная арена
+  start_arena(arena.get()); // старт партии
+  arena->apple = arena->cells - 1; // яблоко в стороне от пути
+  for (int i = 0; i < WINDOW_HEIGHT && arena->statemachine != SnakeArena::GameOver; i++) step(arena.get(), Up);
+  ASSERT_EQ(arena->statemachine, SnakeArena::GameOver); // столкновение со стеной
+  arena->fsm(); // установка кода завершения
+  EXPECT_EQ(arena->gameinfo.level, LOSE_LVL); // поражение
+}
+
+TEST(snake_arena, body_crash_keeps_tail) { // тест: столкновение с телом не снимает отметку хвоста с битовой карты
+  std::unique_ptr<SnakeArena> arena(new SnakeArena(100, 100)); // арена с запасом места
+  start_arena(arena.get()); // старт партии
+  for (int i = 0; i < 4; i++) { // змейка растёт вверх
+    arena->apple = arena->head() - arena->width; // яблоко над головой
+    step(arena.get(), Up); // шаг на яблоко
+  }
+  arena->apple = arena->cells - 1; // следующее яблоко в стороне от пути
+  for (int i = 0; i < 4; i++) step(arena.get(), Up); // рост завершается
+  ASSERT_EQ(arena->length(), 8u);
+  step(arena.get(), Left); // петля в собственное тело
+  step(arena.get(), Down);
+  step(arena.get(), Right);
+  ASSERT_EQ(arena->statemachine, SnakeArena::GameOver); // столкновение с телом
+  EXPECT_TRUE(arena->crashed);
+  expect_body_consistent(*arena); // тело и битовая карта совпадают и после столкновения
+}
+
+TEST(snake_arena, apple_fallback_scan) { // тест: на почти заполненной арене яблоко находится перебором битовой карты
+  std::unique_ptr<SnakeArena> arena(new SnakeArena(WINDOW_HEIGHT, WINDOW_WIDTH)); // минимальная арена
+  std::fill(arena->occupied.begin(), arena->occupied.end(), ~0ULL); // все клетки заняты
+  arena->set_occupied(137, false); // кроме одной
+  arena->spawn_apple(); // выбор клетки
+  EXPECT_EQ(arena->apple, 137u); // единственная свободная клетка
+  arena->set_occupied(137, true); // свободных клеток нет
+  EXPECT_THROW(arena->spawn_apple(), std::runtime_error); // яблоко поставить некуда
+}
+
+TEST(snake_arena, create_game_checks_size) { // тест: фабрика создаёт арену нужного размера и отклоняет недопустимые
+  s21::Game* game = s21::GameFabric::create_game(s21::GameFabric::GameName::Snake, 1000, 1000);
+  SnakeArena* arena = dynamic_cast<SnakeArena*>(game); // арена, а не стандартная змейка
+  ASSERT_NE(arena, nullptr);
+  EXPECT_EQ(arena->arena_height(), 1000);
+  EXPECT_EQ(arena->arena_width(), 1000);
+  s21::GameFabric::destroy_game(game);
+
+  EXPECT_THROW(s21::GameFabric::create_game(s21::GameFabric::GameName::Snake, 30, 5), std::invalid_argument); // уже окна
+  EXPECT_THROW(s21::GameFabric::create_game(s21::GameFabric::GameName::Snake, 65536, 65536),
+               std::invalid_argument); // индексы не помещаются в uint32_t
+}
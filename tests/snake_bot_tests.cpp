@@ -0,0 +1,49 @@
+// tests/snake_bot_tests.cpp
+#include <gtest/gtest.h> // подключает фреймворк Google Test для определения тестов и макросов EXPECT_*
+#include <set> // подключает std::set для проверки уникальности номеров клеток
+
+// Сделать private/protected публичными для тестов — обязательно до включения заголовков
+#define private public // временно переопределяем private на public чтобы тесты могли создавать отдельные экземпляры
+#define protected public // временно переопределяем protected на public для доступа к состоянию КА
+#include "../brick_game/snake/snake_bot.h" // подключаем автопилот вместе с классом Snake
+#undef private // восстанавливаем оригинальное значение private
+#undef protected // восстанавливаем оригинальное значение protected
+#include "tests.h" // подключаем RecordGuard
+
+TEST(snake_bot, cycle_is_hamiltonian) { // тест: цикл проходит каждую клетку ровно один раз и идёт по соседям
+  s21::SnakeBot bot; // создаём автопилот
+  std::set<int> indexes; // множество встреченных номеров клеток
+  for (int y = 0; y < WINDOW_HEIGHT; y++) { // проход по строкам поля
+    for (int x = 0; x < WINDOW_WIDTH; x++) { // проход по столбцам поля
+      indexes.insert(bot.cycle_index(y, x)); // запоминаем номер клетки
+      int next = bot.cycle_next(y, x); // следующая клетка цикла
+      int dy = next / WINDOW_WIDTH - y; // смещение по строкам
+      int dx = next % WINDOW_WIDTH - x; // смещение по столбцам
+      EXPECT_EQ(std::abs(dy) + std::abs(dx), 1); // следующая клетка — соседняя
+    }
+  }
+  EXPECT_EQ((int)indexes.size(), WINDOW_HEIGHT * WINDOW_WIDTH); // все номера различны
+}
+
+TEST(snake_bot, soak_reaches_win_level) { // тест: автопилот доводит отдельную змейку до победы
+  RecordGuard guard("snake_data.bin"); // рекорд, который перепишет игра, восстанавливается в конце теста
+  s21::Snake snake; // отдельный экземпляр змейки, не затрагивающий синглтон
+  s21::SnakeBot bot; // автопилот
+  snake.set_user_action(Start); // старт игры
+  snake.fsm(); // GameStart -> Spawn
+  long steps = 0; // количество шагов КА
+  while (snake.gameinfo.level != WIN_LVL && snake.gameinfo.level != LOSE_LVL &&
+         steps < 2000000) { // до конца игры или до защитного лимита
+    snake.set_user_action(bot.next_action(snake)); // решение автопилота
+    snake.fsm(); // шаг КА
+    steps++; // считаем шаги
+  }
+  EXPECT_EQ(snake.gameinfo.level, WIN_LVL); // змейка заполнила поле
+  EXPECT_EQ(snake.snake_size, WINDOW_HEIGHT * WINDOW_WIDTH); // длина равна числу клеток
+}
+
+TEST(snake_bot, start_outside_moving_is_noop) { // тест: вне состояния Moving автопилот не вмешивается
+  s21::Snake snake; // отдельный экземпляр змейки
+  s21::SnakeBot bot; // автопилот
+  EXPECT_EQ(bot.next_action(snake), Start); // в GameStart возвращается Start
+}
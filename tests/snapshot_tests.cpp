@@ -0,0 +1,275 @@
+// tests/snapshot_tests.cpp
+#include <gtest/gtest.h> // подключает фреймворк Google Test для определения тестов и макросов EXPECT_*
+#include <algorithm> // подключает std::equal для частей снимка
+#include <chrono> // подключает часы для замера времени снимка
+#include <cstring> // подключает memcpy для порчи снимка
+#include <stdexcept> // подключает std::invalid_argument
+#include <vector> // подключает std::vector для буферов снимков
+
+// Сделать private/protected публичными для тестов — обязательно до включения заголовков
+#define private public // временно переопределяем private на public чтобы тесты могли сравнивать состояние движков
+#define protected public // временно переопределяем protected на public для доступа к состоянию КА
+#include "../brick_game/snake/snake.h" // подключаем стандартную змейку
+#include "../brick_game/snake/snake_arena.h" // подключаем змейку на большой арене
+#include "../brick_game/snapshot.h" // подключаем формат снимка
+#include "../brick_game/tetris/tetris.h" // подключаем тетрис
+#undef private // восстанавливаем оригинальное значение private
+#undef protected // восстанавливаем оригинальное значение protected
+#include "tests.h" // подключаем RecordGuard
+
+using s21::Game; // импортируем имя базового класса
+using s21::GameFabric; // импортируем имя фабрики
+
+// Вспомогательная функция: поле, область next и счёт двух сессий совпадают
+static void expect_same_info(Game* a, Game* b) {
+  ASSERT_EQ(a->get_field_height(), b->get_field_height());
+  ASSERT_EQ(a->get_field_width(), b->get_field_width());
+  for (int y = 0; y < a->get_field_height(); y++)
+    for (int x = 0; x < a->get_field_width(); x++) ASSERT_EQ(a->gameinfo.field[y][x], b->gameinfo.field[y][x]);
+  for (int y = 0; y < NEXT_SIZE; y++)
+    for (int x = 0; x < NEXT_SIZE; x++) ASSERT_EQ(a->gameinfo.next[y][x], b->gameinfo.next[y][x]);
+  EXPECT_EQ(a->gameinfo.score, b->gameinfo.score);
+  EXPECT_EQ(a->gameinfo.level, b->gameinfo.level);
+  EXPECT_EQ(a->gameinfo.speed, b->gameinfo.speed);
+  EXPECT_EQ(a->statemachine, b->statemachine);
+}
+
+// Вспомогательная функция: одинаковый ввод в обе сессии, после каждого шага состояние совпадает
+static void play_both(Game* a, Game* b, const UserAction_t* moves, int count, int steps) {
+  for (int i = 0; i < steps && a->statemachine != Game::GameOver; i++) {
+    a->set_user_action(moves[i % count]);
+    b->set_user_action(moves[i % count]);
+    a->fsm();
+    b->fsm();
+    expect_same_info(a, b);
+  }
+}
+
+TEST(snapshot, tetris_round_trip_continues_identically) { // тест: восстановленный тетрис продолжает ту же партию
+  RecordGuard guard("tetris_data.bin");
+  srand(11); // воспроизводимый генератор фигур
+  Game* game = GameFabric::create_game(GameFabric::GameName::Tetris, 24, 12, GameFabric::PieceSet::Pentomino);
+  game->set_user_action(Start);
+  game->fsm(); // GameStart -> Spawn
+  const UserAction_t moves[] = {Left, Action, Right, Right, Up, Left, Left, Up};
+  for (int i = 0; i < 40 && game->statemachine != Game::GameOver; i++) { // партия до середины
+    game->set_user_action(moves[i % 8]);
+    game->fsm();
+  }
+  ASSERT_NE(game->statemachine, Game::GameOver);
+
+  std::vector<uint8_t> snapshot = game->snapshot(); // снимок середины партии
+  EXPECT_EQ(snapshot.size(), game->snapshot_size());
+  Game* copy = GameFabric::restore_game(snapshot.data(), snapshot.size()); // новая сессия из снимка
+  EXPECT_EQ(copy->get_field_height(), 24);
+  EXPECT_EQ(copy->get_field_width(), 12);
+  expect_same_info(game, copy);
+  play_both(game, copy, moves, 8, 400); // следующие фигуры совпадают: генератор входит в снимок
+
+  GameFabric::destroy_game(game);
+  GameFabric::destroy_game(copy);
+}
+
+TEST(snapshot, restore_replaces_running_game) { // тест: снимок возвращает сессию к прошлому состоянию, в том числе до старта
+  RecordGuard guard("tetris_data.bin");
+  srand(3);
+  Game* game = GameFabric::create_game(GameFabric::GameName::Tetris, WINDOW_HEIGHT, WINDOW_WIDTH);
+  std::vector<uint8_t> before_start = game->snapshot(); // фигуры ещё не выделены
+  game->set_user_action(Start);
+  game->fsm(); // GameStart -> Spawn
+  game->fsm(); // Spawn -> Moving
+  std::vector<uint8_t> started = game->snapshot(); // партия идёт
+  for (int i = 0; i < 30; i++) { // несколько сбросов
+    game->set_user_action(Up);
+    game->fsm();
+  }
+  ASSERT_TRUE(game->restore(started.data(), started.size())); // назад к началу партии
+  EXPECT_EQ(game->statemachine, Game::Moving);
+  EXPECT_EQ(game->gameinfo.score, 0);
+
+  ASSERT_TRUE(game->restore(before_start.data(), before_start.size())); // назад к моменту до старта
+  EXPECT_EQ(game->statemachine, Game::GameStart);
+  EXPECT_EQ(game->gameinfo.level, 0);
+  ASSERT_TRUE(game->restore(started.data(), started.size())); // и снова в партию
+  EXPECT_GT(game->gameinfo.level, 0);
+  GameFabric::destroy_game(game); // фигуры освобождаются один раз
+}
+
+TEST(snapshot, snake_round_trip_continues_identically) { // тест: восстановленная змейка продолжает ту же партию
+  RecordGuard guard("snake_data.bin");
+  Game* game = GameFabric::create_game(GameFabric::GameName::Snake, WINDOW_HEIGHT, WINDOW_WIDTH);
+  game->set_user_action(Start);
+  game->fsm(); // GameStart -> Spawn
+  game->fsm(); // Spawn -> Moving
+  const UserAction_t moves[] = {Action, Left, Action, Up, Action, Right, Action, Up};
+  for (int i = 0; i < 12; i++) { // несколько шагов
+    game->set_user_action(moves[i % 8]);
+    game->fsm();
+  }
+  std::vector<uint8_t> snapshot = game->snapshot();
+  Game* copy = GameFabric::restore_game(snapshot.data(), snapshot.size());
+  expect_same_info(game, copy);
+  play_both(game, copy, moves, 8, 60);
+  GameFabric::destroy_game(game);
+  GameFabric::destroy_game(copy);
+}
+
+TEST(snapshot, arena_round_trip_keeps_body) { // тест: снимок арены хранит тело от головы, а не всю арену
+  s21::SnakeArena* arena =
+      dynamic_cast<s21::SnakeArena*>(GameFabric::create_game(GameFabric::GameName::Snake, 1000, 1000));
+  ASSERT_NE(arena, nullptr);
+  arena->set_user_action(Start);
+  arena->fsm(); // GameStart -> Spawn
+  arena->fsm(); // Spawn -> Moving
+  arena->head_pos = arena->cells - 2; // тело переходит через конец кольцевого буфера
+  for (uint32_t i = 0; i < arena->size; i++) arena->ring[(arena->head_pos + i) % arena->cells] = 500500 + i * 1000;
+  std::vector<uint8_t> snapshot = arena->snapshot();
+  EXPECT_LT(snapshot.size(), 8192u); // миллион клеток арены в снимок не попадает
+
+  s21::SnakeArena* copy = dynamic_cast<s21::SnakeArena*>(GameFabric::restore_game(snapshot.data(), snapshot.size()));
+  ASSERT_NE(copy, nullptr);
+  EXPECT_EQ(copy->arena_height(), 1000);
+  EXPECT_EQ(copy->length(), arena->length());
+  for (uint32_t i = 0; i < copy->size; i++) { // тело и битовая карта восстановлены
+    uint32_t cell = copy->ring[(copy->head_pos + i) % copy->cells];
+    EXPECT_EQ(cell, 500500 + i * 1000);
+    EXPECT_TRUE(copy->is_occupied(cell));
+  }
+  EXPECT_EQ(copy->apple, arena->apple);
+  EXPECT_EQ(copy->gen, arena->gen); // следующие яблоки совпадут
+  GameFabric::destroy_game(arena);
+  GameFabric::destroy_game(copy);
+}
+
+TEST(snapshot, invalid_arena_body_is_rejected) { // тест: разорванное, повторяющееся или слишком длинное тело не меняет арену
+  s21::SnakeArena* arena =
+      dynamic_cast<s21::SnakeArena*>(GameFabric::create_game(GameFabric::GameName::Snake, 40, 40));
+  ASSERT_NE(arena, nullptr);
+  arena->set_user_action(Start);
+  arena->fsm(); // GameStart -> Spawn
+  arena->fsm(); // Spawn -> Moving
+  std::vector<uint8_t> valid = arena->snapshot();
+  uint32_t head = arena->head(); // голова до порчи снимков
+  size_t body = valid.size() - arena->size * sizeof(uint32_t); // начало тела в снимке
+  auto segment = [&](std::vector<uint8_t>& snapshot, uint32_t i, uint32_t cell) { // замена сегмента i
+    memcpy(snapshot.data() + body + i * sizeof(uint32_t), &cell, sizeof(cell));
+  };
+  std::vector<uint8_t> torn = valid; // хвост оторван от тела
+  segment(torn, arena->size - 1, head + 5);
+  std::vector<uint8_t> repeated = valid; // сегмент совпадает с головой
+  segment(repeated, 2, head);
+  std::vector<uint8_t> wrapped = valid; // тело переходит через правый край на следующую строку
+  segment(wrapped, 0, 39);
+  segment(wrapped, 1, 40);
+  segment(wrapped, 2, 80);
+  std::vector<uint8_t> outside = valid; // сегмент за пределами арены
+  segment(outside, arena->size - 1, 40 * 40);
+  for (std::vector<uint8_t>* bad : {&torn, &repeated, &wrapped, &outside}) {
+    EXPECT_FALSE(arena->restore(bad->data(), bad->size()));
+    EXPECT_THROW(GameFabric::restore_game(bad->data(), bad->size()), std::invalid_argument);
+  }
+  EXPECT_EQ(arena->head(), head); // арена не изменилась
+  EXPECT_TRUE(arena->is_occupied(head));
+
+  arena->growth = 40 * 40; // рост больше свободной части арены
+  std::vector<uint8_t> overgrown = arena->snapshot();
+  arena->growth = 0;
+  EXPECT_FALSE(arena->restore(overgrown.data(), overgrown.size()));
+  EXPECT_TRUE(arena->restore(valid.data(), valid.size()));
+  GameFabric::destroy_game(arena);
+}
+
+TEST(snapshot, bad_snapshots_are_rejected) { // тест: повреждённый или чужой снимок не меняет сессию
+  RecordGuard guard("tetris_data.bin");
+  RecordGuard snake_guard("snake_data.bin");
+  Game* game = GameFabric::create_game(GameFabric::GameName::Tetris, WINDOW_HEIGHT, WINDOW_WIDTH);
+  std::vector<uint8_t> snapshot = game->snapshot();
+
+  std::vector<uint8_t> truncated(snapshot.begin(), snapshot.end() - 1); // снимок без последнего байта
+  EXPECT_FALSE(game->restore(truncated.data(), truncated.size()));
+  EXPECT_THROW(GameFabric::restore_game(truncated.data(), truncated.size()), std::invalid_argument);
+
+  std::vector<uint8_t> wrong_version = snapshot; // снимок другой версии
+  wrong_version[4]++;
+  EXPECT_THROW(GameFabric::restore_game(wrong_version.data(), wrong_version.size()), std::invalid_argument);
+
+  std::vector<uint8_t> wrong_kind = snapshot; // заголовок змейки с данными тетриса
+  wrong_kind[6] = SNAPSHOT_SNAKE;
+  EXPECT_THROW(GameFabric::restore_game(wrong_kind.data(), wrong_kind.size()), std::invalid_argument);
+
+  std::vector<uint8_t> huge = snapshot; // поле больше самого снимка
+  s21::SnapshotHeader header;
+  memcpy(&header, huge.data(), sizeof(header));
+  header.height = header.width = 1 << 20;
+  memcpy(huge.data(), &header, sizeof(header));
+  EXPECT_THROW(GameFabric::restore_game(huge.data(), huge.size()), std::invalid_argument); // поле не выделяется
+
+  Game* snake = GameFabric::create_game(GameFabric::GameName::Snake, WINDOW_HEIGHT, WINDOW_WIDTH);
+  std::vector<uint8_t> wide = snake->snapshot(); // змейка с чужим размером поля
+  memcpy(&header, wide.data(), sizeof(header));
+  header.width = WINDOW_WIDTH + 1;
+  memcpy(wide.data(), &header, sizeof(header));
+  EXPECT_FALSE(snake->restore(wide.data(), wide.size()));
+  EXPECT_THROW(GameFabric::restore_game(wide.data(), wide.size()), std::invalid_argument);
+  GameFabric::destroy_game(snake);
+
+  Game* other = GameFabric::create_game(GameFabric::GameName::Tetris, 30, 40); // поле другого размера
+  EXPECT_FALSE(other->restore(snapshot.data(), snapshot.size()));
+  EXPECT_EQ(game->save(snapshot.data(), snapshot.size() - 1), 0u); // буфер мал
+  EXPECT_THROW(GameFabric::restore_game(snapshot.data(), 4), std::invalid_argument); // короче заголовка
+
+  GameFabric::destroy_game(other);
+  GameFabric::destroy_game(game);
+}
+
+TEST(snapshot, invalid_tetris_state_is_rejected) { // тест: фигура вне поля или неверные счётчики не меняют сессию
+  RecordGuard guard("tetris_data.bin");
+  srand(5);
+  Game* game = GameFabric::create_game(GameFabric::GameName::Tetris, WINDOW_HEIGHT, WINDOW_WIDTH);
+  game->set_user_action(Start);
+  game->fsm(); // GameStart -> Spawn
+  for (int i = 0; i < 6; i++) game->fsm(); // фигура на поле
+  ASSERT_NE(game->statemachine, Game::GameOver);
+  std::vector<uint8_t> snapshot = game->snapshot();
+  for (int i = 0; i < 30 && game->statemachine != Game::GameOver; i++) { // партия уходит дальше
+    game->set_user_action(Down);
+    game->fsm();
+  }
+  std::vector<uint8_t> current = game->snapshot(); // состояние, которое должно сохраниться
+
+  // хвост снимка тетриса: фигуры (2 * 8 int), заполненность строк и высоты столбцов
+  size_t heights = snapshot.size() - WINDOW_WIDTH * sizeof(int);
+  size_t fills = heights - WINDOW_HEIGHT * sizeof(int);
+  size_t bricks = fills - 16 * sizeof(int);
+  const int bad[][2] = {{(int)bricks, WINDOW_HEIGHT}, {(int)bricks + 4, -1}, {(int)bricks + 32, NEXT_SIZE},
+                        {(int)fills, WINDOW_WIDTH + 1}, {(int)heights, -1}, {(int)heights + 4, WINDOW_HEIGHT + 1}};
+  for (const auto& item : bad) {
+    std::vector<uint8_t> broken = snapshot;
+    memcpy(broken.data() + item[0], &item[1], sizeof(int));
+    EXPECT_FALSE(game->restore(broken.data(), broken.size())) << "offset " << item[0];
+    std::vector<uint8_t> after = game->snapshot(); // таймер идёт — сравниваем всё, кроме скалярных полей тетриса
+    size_t base = after.size() - game->state_size(); // заголовок, общая часть, поле и next
+    EXPECT_TRUE(std::equal(after.begin(), after.begin() + base, current.begin())); // поле и счёт прежние
+    EXPECT_TRUE(std::equal(after.begin() + bricks, after.end(), current.begin() + bricks)); // фигуры и счётчики прежние
+  }
+  EXPECT_TRUE(game->restore(snapshot.data(), snapshot.size())); // исходный снимок корректен
+  GameFabric::destroy_game(game);
+}
+
+TEST(snapshot, save_and_restore_are_fast) { // тест: снимок стандартной партии пишется и читается за микросекунды
+  RecordGuard guard("tetris_data.bin");
+  Game* game = GameFabric::create_game(GameFabric::GameName::Tetris, WINDOW_HEIGHT, WINDOW_WIDTH);
+  game->set_user_action(Start);
+  game->fsm(); // GameStart -> Spawn
+  game->fsm(); // Spawn -> Moving
+  std::vector<uint8_t> buf(game->snapshot_size()); // буфер выделяется один раз
+  const int rounds = 10000; // повторов замера
+  auto begin = std::chrono::steady_clock::now();
+  for (int i = 0; i < rounds; i++) {
+    ASSERT_EQ(game->save(buf.data(), buf.size()), buf.size());
+    ASSERT_TRUE(game->restore(buf.data(), buf.size()));
+  }
+  auto us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin).count();
+  EXPECT_LT(us / rounds, 100); // с большим запасом для отладочной сборки
+  GameFabric::destroy_game(game);
+}
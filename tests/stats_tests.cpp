@@ -0,0 +1,120 @@
+// tests/stats_tests.cpp
+#include <gtest/gtest.h> // подключает фреймворк Google Test для определения тестов и макросов EXPECT_*
+#include <thread> // подключает std::thread для проверки счётчиков нескольких потоков
+#include <vector> // подключает std::vector для списка потоков
+
+// Сделать private/protected публичными для тестов — обязательно до включения заголовков
+#define private public // временно переопределяем private на public чтобы тесты могли готовить поле
+#define protected public // временно переопределяем protected на public для доступа к состоянию КА
+#include "../brick_game/stats.h" // подключаем счётчики
+#include "../brick_game/tetris/tetris.h" // подключаем тетрис
+#undef private // восстанавливаем оригинальное значение private
+#undef protected // восстанавливаем оригинальное значение protected
+#include "tests.h" // подключаем RecordGuard
+
+using s21::Tetris; // импортируем имя класса Tetris
+
+TEST(game_stats, histogram_buckets_bound_relative_error) { // тест: корзины монотонны, погрешность не больше 1/8
+  int last = -1;
+  for (uint64_t value = 0; value < 100000; value += 1 + value / 64) { // значения по всему малому диапазону
+    int bucket = s21::stats_bucket(value);
+    EXPECT_GE(bucket, last); // номер корзины не убывает
+    EXPECT_LT(bucket, STATS_BUCKETS);
+    uint64_t top = s21::stats_bucket_max(bucket);
+    EXPECT_GE(top, value); // значение внутри корзины
+    EXPECT_LE(top - value, value / 8 + 1); // относительная погрешность
+    last = bucket;
+  }
+  EXPECT_EQ(s21::stats_bucket(UINT64_MAX), STATS_BUCKETS - 1); // последняя корзина
+  EXPECT_EQ(s21::stats_bucket_max(STATS_BUCKETS - 1), UINT64_MAX);
+}
+
+#ifdef GAME_STATS
+TEST(game_stats, fsm_states_are_counted) { // тест: каждый шаг КА попадает в счётчик своего состояния
+  RecordGuard guard("tetris_data.bin");
+  srand(41);
+  resetGameStats();
+  Tetris tetris; // отдельный экземпляр
+  tetris.set_user_action(Start);
+  int steps = 0; // шагов КА
+  const UserAction_t moves[] = {Left, Right, Action, Down, Up};
+  for (; steps < 3000 && tetris.statemachine != Tetris::GameOver; steps++) {
+    if (tetris.statemachine == Tetris::Moving) tetris.set_user_action(moves[rand() % 5]);
+    tetris.fsm();
+  }
+  tetris.fsm(); // GameOver
+  steps++;
+
+  GameStats_t stats = getGameStats();
+  EXPECT_EQ(stats.enabled, 1);
+  unsigned long long calls = 0; // сумма по состояниям
+  for (int s = 0; s < STATS_STATE_COUNT; s++) calls += stats.states[s].calls;
+  EXPECT_EQ(calls, (unsigned long long)steps);
+  EXPECT_EQ(stats.states[Tetris::GameStart].calls, 1u);
+  EXPECT_GT(stats.states[Tetris::Moving].calls, 0u);
+  EXPECT_GT(stats.states[Tetris::Attaching].calls, 0u);
+  const StateStats_t& moving = stats.states[Tetris::Moving];
+  EXPECT_LE(moving.p50_ns, moving.p99_ns); // квантили упорядочены
+  EXPECT_LE(moving.max_ns, moving.total_ns);
+  EXPECT_GE(s21::stats_bucket_max(s21::stats_bucket(moving.max_ns)), moving.p99_ns); // квантиль не выше максимума
+  EXPECT_EQ(getStateLatency(Tetris::Moving, 0.99), moving.p99_ns);
+  EXPECT_GT(stats.events[STAT_ROTATIONS] + stats.events[STAT_REJECTED_MOVES], 0u);
+
+  resetGameStats();
+  EXPECT_EQ(getGameStats().states[Tetris::Moving].calls, 0u);
+}
+
+TEST(game_stats, tetris_events_are_counted) { // тест: удалённые строки, повороты и отклонённые ходы
+  RecordGuard guard("tetris_data.bin");
+  resetGameStats();
+  Tetris tetris; // отдельный экземпляр
+  int** field = tetris.gameinfo.field;
+  for (int y = WINDOW_HEIGHT - 4; y < WINDOW_HEIGHT; y++)
+    for (int x = 0; x < WINDOW_WIDTH - 1; x++) field[y][x] = 1; // четыре строки без последнего столбца
+  tetris.counters_init();
+  int brick[BRICK_SIZE] = {1, WINDOW_WIDTH - 1, 0, WINDOW_WIDTH - 1, 2, WINDOW_WIDTH - 1, 3, WINDOW_WIDTH - 1}; // вертикальная палка
+  tetris.current_brick = brick;
+  tetris.current_color = 4;
+  tetris.spawn_brick(field, brick, tetris.current_color);
+  tetris.statemachine = Tetris::Moving;
+
+  tetris.set_user_action(Right); // палка у правой стены
+  tetris.fsm();
+  EXPECT_EQ(getGameStats().events[STAT_REJECTED_MOVES], 1u);
+  tetris.set_user_action(Up); // мгновенный сброс в колодец
+  tetris.fsm(); // Moving -> Attaching
+  tetris.fsm(); // Attaching: удаление строк
+  EXPECT_EQ(tetris.gameinfo.score, 1500); // тетрис
+  EXPECT_EQ(getGameStats().events[STAT_LINES_CLEARED], 4u);
+
+  int free_brick[BRICK_SIZE] = {6, 4, 5, 4, 7, 4, 8, 4}; // та же палка посреди пустого поля
+  tetris.current_brick = free_brick;
+  tetris.spawn_brick(field, free_brick, tetris.current_color);
+  tetris.statemachine = Tetris::Moving;
+  tetris.set_user_action(Action); // поворот в горизонталь
+  tetris.fsm();
+  GameStats_t stats = getGameStats();
+  EXPECT_EQ(stats.events[STAT_ROTATIONS], 1u);
+  EXPECT_EQ(stats.events[STAT_REJECTED_MOVES], 1u);
+  tetris.current_brick = nullptr; // фигура на стеке теста
+}
+
+TEST(game_stats, threads_are_merged_on_read) { // тест: счётчики потоков суммируются, в том числе завершившихся
+  resetGameStats();
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([] {
+      for (int i = 0; i < 1000; i++) s21::stats_event(STAT_FILE_WRITES, 1); // счётчик потока
+      s21::stats_state(0, 100); // один вызов состояния GameStart
+    });
+  }
+  for (std::thread& thread : threads) thread.join(); // счётчики переходят в сумму завершившихся
+  s21::stats_event(STAT_FILE_WRITES, 1); // счётчик основного потока
+  GameStats_t stats = getGameStats();
+  EXPECT_EQ(stats.events[STAT_FILE_WRITES], 4001u);
+  EXPECT_EQ(stats.states[0].calls, 4u);
+  EXPECT_EQ(stats.states[0].max_ns, 100u);
+  resetGameStats();
+  EXPECT_EQ(getGameStats().events[STAT_FILE_WRITES], 0u);
+}
+#endif
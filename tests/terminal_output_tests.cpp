@@ -0,0 +1,126 @@
+// tests/terminal_output_tests.cpp
+#include <gtest/gtest.h> // подключает фреймворк Google Test для определения тестов и макросов EXPECT_*
+#include <fcntl.h> // подключает fcntl для ёмкости канала
+#include <stdlib.h> // подключает posix_openpt для псевдотерминала
+#include <sys/ioctl.h> // подключает TIOCSWINSZ для размера псевдотерминала
+#include <sys/socket.h> // подключает socketpair для терминала, который нельзя открыть заново
+#include <unistd.h> // подключает pipe, read и close
+#include <stdexcept> // подключает std::runtime_error
+#include <string> // подключает std::string для кадров
+
+#include "../gui/cli/terminal_output.h" // подключаем неблокирующий вывод в терминал
+
+// Вспомогательная функция: кадр size байт в поток ncurses
+static void write_frame(s21::TerminalOutput& output, size_t size) {
+  std::string frame(size, 'x');
+  fwrite(frame.data(), 1, frame.size(), output.stream());
+  fflush(output.stream());
+}
+
+// Вспомогательная функция: всё, что «терминал» (канал) уже принял
+static std::string read_all(int fd) {
+  std::string data;
+  char buf[4096];
+  ssize_t n;
+  while ((n = read(fd, buf, sizeof(buf))) > 0) data.append(buf, n);
+  return data;
+}
+
+TEST(terminal_output, counts_bytes_per_frame) { // тест: байты кадра считаются по выводу ncurses и доходят до терминала
+  int sink[2];
+  ASSERT_EQ(pipe(sink), 0);
+  fcntl(sink[0], F_SETFL, O_NONBLOCK);
+  {
+    s21::TerminalOutput output(sink[1]);
+    EXPECT_EQ(fcntl(sink[1], F_GETFL) & O_NONBLOCK, 0); // общий дескриптор остаётся блокирующим
+    EXPECT_GE(output.capacity(), 4096u);
+    fputs("hello", output.stream());
+    fflush(output.stream());
+    output.presented();
+    write_frame(output, 300);
+    output.presented();
+    EXPECT_EQ(output.stats().frames, 2u);
+    EXPECT_EQ(output.stats().last_bytes, 300u);
+    EXPECT_EQ(output.stats().max_bytes, 300u);
+    EXPECT_EQ(output.stats().bytes, 305u);
+    EXPECT_EQ(read_all(sink[0]), "hello" + std::string(300, 'x'));
+    EXPECT_TRUE(output.ready());
+  }
+  EXPECT_EQ(fcntl(sink[1], F_GETFL) & O_NONBLOCK, 0); // режим записи не менялся
+  close(sink[0]);
+  close(sink[1]);
+}
+
+TEST(terminal_output, skips_frames_while_terminal_is_behind) { // тест: медленный терминал не блокирует цикл, кадры пропускаются
+  int sink[2];
+  ASSERT_EQ(pipe(sink), 0);
+  fcntl(sink[0], F_SETFL, O_NONBLOCK);
+#ifdef F_SETPIPE_SZ
+  fcntl(sink[1], F_SETPIPE_SZ, 4096); // маленький буфер «терминала»
+#endif
+  {
+    s21::TerminalOutput output(sink[1]);
+    for (int i = 0; i < 200; i++) { // терминал ничего не читает
+      if (output.ready()) {
+        write_frame(output, 1500);
+        output.presented();
+      } else {
+        output.skipped();
+      }
+    }
+    EXPECT_GT(output.stats().skipped, 0u);
+    EXPECT_LT(output.stats().frames, 10u); // отправлено только то, что терминал успел принять
+    EXPECT_GT(output.queued() + output.terminal_queued(), OUTPUT_WATERMARK);
+    EXPECT_LE(output.stats().max_queued, output.terminal_queued() + 2 * 1500u); // очередь не растёт больше пары кадров
+    while (!read_all(sink[0]).empty() || output.queued() > 0) output.pump(); // терминал догоняет
+    EXPECT_TRUE(output.ready());
+    EXPECT_TRUE(output.flush(100));
+  }
+  close(sink[0]);
+  close(sink[1]);
+}
+
+TEST(terminal_output, socket_sink_is_written_without_blocking) { // тест: без нового описания запись идёт частями после poll
+  int sink[2];
+  ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, sink), 0);
+  fcntl(sink[0], F_SETFL, O_NONBLOCK);
+  {
+    s21::TerminalOutput output(sink[1]);
+    for (int i = 0; i < 400; i++) { // «терминал» ничего не читает, цикл не должен зависнуть
+      if (output.ready()) {
+        write_frame(output, 3000);
+        output.presented();
+      } else {
+        output.skipped();
+      }
+    }
+    EXPECT_GT(output.stats().skipped, 0u);
+    EXPECT_EQ(fcntl(sink[1], F_GETFL) & O_NONBLOCK, 0);
+    std::string data;
+    while (output.queued() > 0 || !data.empty()) { // терминал догоняет
+      data = read_all(sink[0]);
+      output.pump();
+    }
+    EXPECT_EQ(output.queued(), 0u);
+  }
+  close(sink[0]);
+  close(sink[1]);
+}
+
+TEST(terminal_output, redraw_larger_than_pipe_is_rejected) { // тест: экран, перерисовка которого не помещается в канал, не принимается
+  int master = posix_openpt(O_RDWR | O_NOCTTY);
+  ASSERT_GE(master, 0);
+  ASSERT_EQ(grantpt(master), 0);
+  ASSERT_EQ(unlockpt(master), 0);
+  int terminal = open(ptsname(master), O_RDWR | O_NOCTTY);
+  ASSERT_GE(terminal, 0);
+  struct winsize screen = {OUTPUT_DEFAULT_ROWS, OUTPUT_DEFAULT_COLS, 0, 0}; // обычный экран
+  ASSERT_EQ(ioctl(terminal, TIOCSWINSZ, &screen), 0);
+  EXPECT_NO_THROW(s21::TerminalOutput output(terminal));
+  screen.ws_row = 4000; // перерисовка 4000x4000 больше любого канала
+  screen.ws_col = 4000;
+  ASSERT_EQ(ioctl(terminal, TIOCSWINSZ, &screen), 0);
+  EXPECT_THROW(s21::TerminalOutput output(terminal), std::runtime_error); // фронтенд оставляет ncurses писать в терминал
+  close(terminal);
+  close(master);
+}
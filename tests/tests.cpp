@@ -67,6 +67,61 @@ TEST(timer_tests, time_components_reflect_elapsed_time) { // тест соотв
   EXPECT_EQ(min, 0); // минуты должны оставаться равными нулю
 } // конец теста time_components_reflect_elapsed_time
 
+// Проверяет, что срок следующего шага отсчитывается от прошлого срока, а не от момента проверки
+TEST(timer_tests, late_check_does_not_drift) { // тест абсолютного срока шага
+  s21::Timer t; // создаём таймер
+  t.resume(1300000); // проверка опоздала на 300 мс после срока в 1000 мс
+  EXPECT_TRUE(t.game_timer_check(1, 1000, 1000, 10)); // шаг сработал
+  EXPECT_GE(t.get_elapsed_us(), 300000); // опоздание входит в следующий интервал
+  EXPECT_LE(t.next_deadline(), 700000); // до следующего шага не больше 700 мс
+  EXPECT_GT(t.next_deadline(), 600000); // и не меньше (с запасом на планировщик)
+} // конец теста late_check_does_not_drift
+
+// Проверяет, что пропущенные шаги догоняются подряд, а долгое отставание даёт один шаг
+TEST(timer_tests, missed_steps_catch_up) { // тест догоняющих шагов
+  s21::Timer t; // создаём таймер
+  t.resume(2500000); // пропущено два срока по 1000 мс
+  EXPECT_TRUE(t.game_timer_check(1, 1000, 1000, 10)); // первый пропущенный шаг
+  EXPECT_TRUE(t.game_timer_check(1, 1000, 1000, 10)); // второй пропущенный шаг
+  EXPECT_FALSE(t.game_timer_check(1, 1000, 1000, 10)); // таймер догнал время
+  EXPECT_LE(t.next_deadline(), 500000); // до шага осталась половина интервала
+
+  t.resume(TIMER_MAX_CATCHUP * 1000000LL + 500000); // отставание больше TIMER_MAX_CATCHUP интервалов (пауза)
+  EXPECT_TRUE(t.game_timer_check(1, 1000, 1000, 10)); // один шаг
+  EXPECT_FALSE(t.game_timer_check(1, 1000, 1000, 10)); // остальные пропущены
+  EXPECT_GT(t.next_deadline(), 900000); // следующий шаг через полный интервал
+} // конец теста missed_steps_catch_up
+
+// Проверяет интервалы таблицы скоростей в микросекундах
+TEST(timer_tests, speed_intervals_in_microseconds) { // тест таблицы интервалов
+  s21::Timer t; // создаём таймер
+  EXPECT_FALSE(t.game_timer_check(10, 1000, 200, 10)); // максимальная скорость
+  EXPECT_GT(t.next_deadline(), 150000); // интервал 200 мс
+  EXPECT_LE(t.next_deadline(), 200000);
+  EXPECT_FALSE(t.game_timer_check(0, 1000, 200, 10)); // нулевая скорость тетриса
+  EXPECT_GT(t.next_deadline(), 1088888 - 50000); // 1000 + 800 / 9 мс без округления до миллисекунд
+  EXPECT_LE(t.next_deadline(), 1088888);
+  EXPECT_FALSE(t.game_timer_check(TIMER_SPEEDS + 5, 1000, 200, 10)); // скорость вне таблицы приводится к последней
+} // конец теста speed_intervals_in_microseconds
+
+// Проверяет, что игра сообщает срок шага только в Moving без паузы
+TEST(timer_tests, game_reports_next_deadline) { // тест Game::next_deadline
+  RecordGuard guard("tetris_data.bin"); // рекорд тетриса не меняется
+  s21::Game* game = s21::GameFabric::create_game(s21::GameFabric::GameName::Tetris, WINDOW_HEIGHT, WINDOW_WIDTH);
+  EXPECT_EQ(game->next_deadline(), -1); // игра не начата
+  game->set_user_action(Start);
+  game->fsm(); // GameStart -> Spawn
+  game->fsm(); // Spawn -> Moving
+  game->fsm(); // Moving: проверка таймера
+  int64_t deadline = game->next_deadline(); // срок падения фигуры
+  EXPECT_GT(deadline, 0);
+  EXPECT_LE(deadline, 1088888);
+  game->set_user_action(Pause);
+  game->fsm(); // пауза
+  EXPECT_EQ(game->next_deadline(), -1); // на паузе таймер не ждут
+  s21::GameFabric::destroy_game(game);
+} // конец теста game_reports_next_deadline
+
 // Проверяет, что updateCurrentState возвращает пустую GameInfo_t если игры нет
 TEST(api_tests, updateCurrentState_no_game_returns_default) { // тест API для случая, когда игра не установлена
   // Постараемся убедиться, что игры нет. Если у вас есть метод reset, используйте его.
@@ -3,6 +3,8 @@
 
 #include <gtest/gtest.h> // подключает Google Test для написания и выполнения модульных тестов
 
+#include <cstdio> // подключает fopen для сохранения файлов рекордов
+
 #include <iostream> // подключает потоки ввода/вывода (std::cout, std::cerr) для отладки тестов
 
 #include "../brick_game/brick_game_single.h" // подключает заголовок с определениями игры, структур и констант (WINDOW_WIDTH/HEIGHT и т.д.)
@@ -19,4 +21,26 @@ void horizontal_shift(s21::Game* snake_game, const int& x_half,
 void vertical_shift(s21::Game* snake_game, const int& y_half, const int& x_half,
                     const int& apple_y, int& head_y); // прототип вспомогательной функции для тестов: выполняет последовательность вызовов КА, чтобы сдвинуть голову змейки по Y в сторону apple_y с учётом положения по X
 
+// Вспомогательный класс: сохраняет файл рекорда и восстанавливает его в деструкторе
+class RecordGuard {
+ public:
+  explicit RecordGuard(const char* name) : name(name) {
+    FILE* record = fopen(name, "rb"); // рекорд, который может перезаписать партия
+    had_record = record && fread(&saved, sizeof(int), 1, record) == 1;
+    if (record) fclose(record);
+  }
+  ~RecordGuard() {
+    if (had_record) { // восстанавливаем рекорд
+      FILE* record = fopen(name, "wb");
+      fwrite(&saved, sizeof(int), 1, record);
+      fclose(record);
+    }
+  }
+
+ private:
+  const char* name; // имя файла рекорда
+  int saved = 0; // сохранённый рекорд
+  bool had_record = false; // файл рекорда существовал
+};
+
 #endif  // TESTS_H // конец защиты от повторного включения заголовка
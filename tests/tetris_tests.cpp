@@ -5,6 +5,8 @@
 #include <cstdlib> // подключает C-функции stdlib, например remove
 #include <thread> // подключает std::this_thread::sleep_for для пауз в тестах
 #include <chrono> // подключает типы времени (milliseconds и пр.) для задержек
+#include <algorithm> // подключает std::sort для сравнения клеток фигур
+#include <vector> // подключает std::vector для списков клеток
 
 // Сделать private/protected публичными для тестов — обязательно до включения заголовка tetris.h
 #define private public // временно переопределяем private на public чтобы тесты могли обращаться к внутренним методам
@@ -12,6 +14,7 @@
 #include "../brick_game/tetris/tetris.h" // подключаем реализацию Tetris, теперь с раскрытыми модификаторами доступа
 #undef private // восстанавливаем оригинальное значение private
 #undef protected // восстанавливаем оригинальное значение protected
+#include "tests.h" // подключаем RecordGuard
 
 using s21::Tetris; // импортируем имя класса Tetris в локальное пространство имён теста
 
@@ -23,7 +26,7 @@ static void zero_matrix(int** m, int h, int w) { // обнуляет матри
 }
 
 
-TEST(tetris_backend, is_Smashboy_and_is_Hero_and_coord_shift) { // тест проверки распознавания фигур и сдвига координат
+TEST(tetris_backend, piece_of_and_coord_shift) { // тест распознавания фигур по таблице набора и сдвига координат
   Tetris *t = Tetris::get_instance(); // получаем единственный экземпляр Tetris (синглтон)
   int brick[BRICK_SIZE]; // массив для хранения координат фигуры (Y,X пары)
 
@@ -32,25 +35,17 @@ TEST(tetris_backend, is_Smashboy_and_is_Hero_and_coord_shift) { // тест пр
   brick[2] = 0; brick[3] = 1; // блок 2 (Y0, X1)
   brick[4] = 1; brick[5] = 0; // блок 3 (Y1, X0)
   brick[6] = 1; brick[7] = 1; // блок 4 (Y1, X1)
-  EXPECT_EQ(t->is_Smashboy(brick), 1); // ожидаем, что это квадрат (Smashboy)
+  EXPECT_EQ(s21::StandardPieces::table.piece_of(brick), 2); // ожидаем, что это квадрат (Smashboy)
 
   // Not Smashboy
   brick[6] = 2; brick[7] = 1; // модифицируем один блок, делая фигуру не квадратом
-  EXPECT_EQ(t->is_Smashboy(brick), 0); // ожидаем отрицательный результат
-
-  // Hero horizontal
-  brick[0] = 5; brick[1] = 1; // задаём горизонтальную линию (Y одинаковы)
-  brick[2] = 5; brick[3] = 2;
-  brick[4] = 5; brick[5] = 3;
-  brick[6] = 5; brick[7] = 4;
-  EXPECT_EQ(t->is_Hero(brick), 1); // ожидаем, что это Hero (линия)
-
-  // Hero vertical
-  brick[0] = 1; brick[1] = 7; // задаём вертикальную линию (X одинаковы)
-  brick[2] = 2; brick[3] = 7;
-  brick[4] = 3; brick[5] = 7;
-  brick[6] = 4; brick[7] = 7;
-  EXPECT_EQ(t->is_Hero(brick), 1); // ожидаем, что это Hero
+  EXPECT_NE(s21::StandardPieces::table.piece_of(brick), 2); // ожидаем отрицательный результат
+
+  // Hero в положении появления и после поворота
+  t->new_brick(brick, 2); // Hero
+  EXPECT_EQ(s21::StandardPieces::table.piece_of(brick), 1); // ожидаем, что это Hero (линия)
+  t->brick_move(brick, Action, t->gameinfo.field); // вертикальная линия
+  EXPECT_EQ(s21::StandardPieces::table.piece_of(brick), 1); // ожидаем, что это Hero
 
   // coord_shift Y then X
   int cs[BRICK_SIZE] = {0,0, 1,1, 2,2, 3,3}; // начальные координаты (Y,X pairs)
@@ -409,3 +404,306 @@ TEST(tetris_check_attaching, returns_one_when_blocked_and_does_not_shift) { // 
   t->free_memory_matrix(field, WINDOW_HEIGHT); // освобождаем поле
 }
 
+
+// tests for Tetris::drop_distance / hard_drop / ghost
+TEST(tetris_hard_drop, drop_distance_matches_repeated_check_down) { // тест: высота сброса совпадает с пошаговым опусканием
+  Tetris *t = Tetris::get_instance();
+
+  int **field = t->init_matrix(nullptr, WINDOW_HEIGHT, WINDOW_WIDTH); // создаём поле
+  t->fill_array_zero(field, WINDOW_HEIGHT, WINDOW_WIDTH);
+  field[WINDOW_HEIGHT - 1][3] = 1; // неровный рельеф
+  field[WINDOW_HEIGHT - 4][5] = 1; // выступ под правым блоком фигуры
+  field[6][4] = 1; // нависающий блок, под которым фигура не проходит
+
+  for (int r = 1; r <= 7; r++) { // все фигуры
+    int brick[BRICK_SIZE]; // фигура в исходном положении
+    t->new_brick(brick, r);
+    int steps = 0; // количество шагов пошагового опускания
+    int stepped[BRICK_SIZE]; // копия для пошагового опускания
+    t->brick_copy(stepped, brick);
+    while (t->check_down(field, stepped)) { // опускаем, пока можно
+      t->coord_shift(stepped, 0, 1);
+      steps++;
+    }
+    EXPECT_EQ(t->drop_distance(field, brick), steps) << "brick " << r; // один проход даёт тот же результат
+  }
+
+  t->free_memory_matrix(field, WINDOW_HEIGHT); // освобождаем поле
+}
+
+TEST(tetris_hard_drop, up_drops_and_attaches_in_one_step) { // тест: действие Up опускает фигуру и переводит КА в Attaching
+  Tetris tetris; // отдельный экземпляр, не затрагивающий синглтон
+  int ghost[GHOST_SIZE]; // буфер тени
+  EXPECT_FALSE(tetris.ghost(ghost)); // до появления фигуры тени нет
+
+  int brick[BRICK_SIZE]; // текущая фигура
+  tetris.new_brick(brick, 3); // Smashboy
+  tetris.current_brick = brick;
+  tetris.current_color = 2;
+  tetris.spawn_brick(tetris.gameinfo.field, brick, tetris.current_color); // фигура на поле
+  tetris.statemachine = Tetris::Moving;
+
+  ASSERT_TRUE(tetris.ghost(ghost)); // тень есть
+  EXPECT_EQ(ghost[0], WINDOW_HEIGHT - 2); // тень лежит на дне
+  EXPECT_EQ(ghost[4], WINDOW_HEIGHT - 1);
+  EXPECT_EQ(ghost[BRICK_SIZE], ghost[BRICK_SIZE - 2]); // пятая пара повторяет последний блок
+  EXPECT_EQ(ghost[BRICK_SIZE + 1], ghost[BRICK_SIZE - 1]);
+  EXPECT_EQ(tetris.gameinfo.field[0][4], 2); // ghost не убирает фигуру с поля
+
+  tetris.set_user_action(Up); // мгновенный сброс
+  tetris.fsm();
+  EXPECT_EQ(tetris.statemachine, Tetris::Attaching); // фигура сразу прикрепляется
+  EXPECT_EQ(tetris.action, Start); // действие сброшено
+  for (int i = 0; i < BRICK_SIZE; i++) EXPECT_EQ(brick[i], ghost[i]); // фигура оказалась на месте тени
+  EXPECT_EQ(tetris.gameinfo.field[0][4], 0); // старое место освобождено
+  EXPECT_EQ(tetris.gameinfo.field[WINDOW_HEIGHT - 1][4], 2); // фигура на дне
+}
+
+TEST(tetris_hard_drop, ghost_is_const_and_skips_own_cells) { // тест: тень считается без изменения поля, клетки фигуры не мешают
+  Tetris tetris; // отдельный экземпляр, не затрагивающий синглтон
+  tetris.gameinfo.field[WINDOW_HEIGHT - 1][3] = 1; // неровный рельеф
+  tetris.gameinfo.field[WINDOW_HEIGHT - 4][5] = 1;
+  tetris.gameinfo.field[9][4] = 1; // нависание над столбцом 4
+  tetris.counters_init();
+  const s21::Game &view = tetris; // ghost доступен через константную ссылку
+  for (int r = 1; r <= 7; r++) { // все фигуры
+    int brick[BRICK_SIZE];
+    tetris.new_brick(brick, r);
+    tetris.coord_shift(brick, 0, 2); // фигура чуть ниже верха поля
+    tetris.current_brick = brick;
+    tetris.spawn_brick(tetris.gameinfo.field, brick, 5); // фигура на поле
+    tetris.statemachine = Tetris::Moving;
+    std::vector<int> before; // поле до вызова ghost
+    for (int y = 0; y < WINDOW_HEIGHT; y++) before.insert(before.end(), tetris.gameinfo.field[y], tetris.gameinfo.field[y] + WINDOW_WIDTH);
+
+    int ghost[GHOST_SIZE];
+    ASSERT_TRUE(view.ghost(ghost));
+    std::vector<int> after;
+    for (int y = 0; y < WINDOW_HEIGHT; y++) after.insert(after.end(), tetris.gameinfo.field[y], tetris.gameinfo.field[y] + WINDOW_WIDTH);
+    EXPECT_EQ(before, after) << "brick " << r; // поле не менялось
+
+    tetris.despawn(tetris.gameinfo.field, brick); // ожидаемая тень — пошаговый спуск по полю без фигуры
+    int stepped[BRICK_SIZE];
+    tetris.brick_copy(stepped, brick);
+    while (tetris.check_down(tetris.gameinfo.field, stepped)) tetris.coord_shift(stepped, 0, 1);
+    for (int i = 0; i < BRICK_SIZE; i++) EXPECT_EQ(ghost[i], stepped[i]) << "brick " << r;
+  }
+  tetris.current_brick = nullptr;
+}
+
+// tests for Tetris::row_fill / column_height
+template <class Engine>
+static void expect_counters_match_field(Engine& tetris) { // сверяет счётчики с полным пересчётом по полю
+  const int height = tetris.board.height(); // высота поля движка
+  const int width = tetris.board.width(); // ширина поля движка
+  for (int y = 0; y < height; y++) { // проход по строкам
+    int fill = 0; // занятые ячейки строки
+    for (int x = 0; x < width; x++) fill += tetris.gameinfo.field[y][x] != 0;
+    ASSERT_EQ(tetris.row_fill[y], fill) << "row " << y;
+  }
+  for (int x = 0; x < width; x++) { // проход по столбцам
+    int y = 0; // верхняя занятая строка
+    while (y < height && !tetris.gameinfo.field[y][x]) y++;
+    ASSERT_EQ(tetris.column_height[x], height - y) << "column " << x;
+  }
+}
+
+TEST(tetris_counters, tetris_clear_updates_rows_and_heights) { // тест: очистка четырёх строк по счётчикам
+  RecordGuard guard("tetris_data.bin");
+  Tetris tetris; // отдельный экземпляр, не затрагивающий синглтон
+  int** field = tetris.gameinfo.field;
+  for (int y = WINDOW_HEIGHT - 4; y < WINDOW_HEIGHT; y++)
+    for (int x = 0; x < WINDOW_WIDTH - 1; x++) field[y][x] = 1; // четыре строки без последнего столбца
+  field[WINDOW_HEIGHT - 5][0] = 1; // столбец 0 выше удаляемых строк
+  int* marker = field[WINDOW_HEIGHT - 5]; // строка над удаляемыми должна опуститься без копирования
+  tetris.counters_init();
+
+  int brick[BRICK_SIZE] = {1, WINDOW_WIDTH - 1, 0, WINDOW_WIDTH - 1, 2, WINDOW_WIDTH - 1, 3, WINDOW_WIDTH - 1}; // вертикальная палка
+  tetris.current_brick = brick;
+  tetris.current_color = 4;
+  tetris.spawn_brick(field, brick, tetris.current_color);
+  tetris.statemachine = Tetris::Moving;
+
+  tetris.set_user_action(Up); // мгновенный сброс в колодец
+  tetris.fsm(); // Moving -> Attaching
+  tetris.fsm(); // Attaching: удаление строк
+  EXPECT_EQ(tetris.gameinfo.score, 1500); // тетрис
+  EXPECT_EQ(tetris.gameinfo.field[WINDOW_HEIGHT - 1], marker); // строка переехала перестановкой указателя
+  EXPECT_EQ(tetris.gameinfo.field[WINDOW_HEIGHT - 1][0], 1);
+  EXPECT_EQ(tetris.column_height[0], 1); // столбец опустился на четыре строки
+  EXPECT_EQ(tetris.column_height[WINDOW_WIDTH - 1], 0); // верх столбца удалён — пересчитан
+  expect_counters_match_field(tetris);
+}
+
+TEST(tetris_counters, random_play_keeps_counters_consistent) { // тест: счётчики совпадают с полем на протяжении партии
+  RecordGuard guard("tetris_data.bin");
+  srand(21); // воспроизводимая последовательность фигур и ходов
+  Tetris tetris; // отдельный экземпляр
+  tetris.set_user_action(Start);
+  tetris.fsm(); // GameStart -> Spawn
+  const UserAction_t moves[] = {Left, Right, Action, Up};
+  for (int step = 0; step < 20000 && tetris.statemachine != Tetris::GameOver; step++) {
+    if (tetris.statemachine == Tetris::Spawn) expect_counters_match_field(tetris); // на поле только лежащие блоки
+    if (tetris.statemachine == Tetris::Moving) tetris.set_user_action(moves[rand() % 4]);
+    tetris.fsm();
+  }
+  tetris.set_user_action(Terminate);
+  tetris.statemachine = Tetris::GameOver;
+  tetris.fsm(); // освобождение фигур
+}
+
+// tests for GameFabric::create_game / TetrisGame<RuntimeBoard>
+TEST(tetris_board, create_game_selects_board_policy) { // тест: стандартный размер — фиксированное поле, иной — поле времени выполнения
+  s21::Game* standard = s21::GameFabric::create_game(s21::GameFabric::GameName::Tetris, WINDOW_HEIGHT, WINDOW_WIDTH);
+  EXPECT_NE(dynamic_cast<Tetris*>(standard), nullptr); // фиксированный размер поля
+  s21::GameFabric::destroy_game(standard);
+
+  s21::Game* wide = s21::GameFabric::create_game(s21::GameFabric::GameName::Tetris, 30, 40);
+  EXPECT_NE(dynamic_cast<s21::RuntimeTetris*>(wide), nullptr); // размер поля выбран при создании
+  s21::GameFabric::destroy_game(wide);
+
+  EXPECT_THROW(s21::GameFabric::create_game(s21::GameFabric::GameName::Tetris, 3, 40), std::invalid_argument);
+  EXPECT_THROW(s21::GameFabric::create_game(s21::GameFabric::GameName::Snake, 10, 40), std::invalid_argument); // арена меньше окна вывода
+}
+
+TEST(tetris_board, wide_well_plays_to_game_over) { // тест: партия на колодце 30x40 с мгновенными сбросами
+  RecordGuard guard("tetris_data.bin");
+  srand(7); // воспроизводимая последовательность
+  s21::RuntimeTetris* wide = dynamic_cast<s21::RuntimeTetris*>(
+      s21::GameFabric::create_game(s21::GameFabric::GameName::Tetris, 30, 40));
+  ASSERT_NE(wide, nullptr);
+  wide->set_user_action(Start);
+  wide->fsm(); // GameStart -> Spawn
+  wide->fsm(); // Spawn -> Moving
+  for (int i = 0; i < BRICK_SIZE; i += 2) { // фигура появилась в середине колодца
+    EXPECT_GE(wide->current_brick[i + 1], 18);
+    EXPECT_LE(wide->current_brick[i + 1], 21);
+  }
+  const UserAction_t moves[] = {Left, Left, Left, Right, Right, Right, Action, Up};
+  int steps = 0;
+  while (wide->statemachine != Tetris::GameOver && steps++ < 200000) {
+    if (wide->statemachine == Tetris::Spawn) expect_counters_match_field(*wide); // счётчики совпадают с полем
+    if (wide->statemachine == Tetris::Moving) wide->set_user_action(moves[rand() % 8]);
+    wide->fsm();
+  }
+  EXPECT_EQ(wide->statemachine, Tetris::GameOver); // колодец заполнился без выхода за границы
+  wide->fsm(); // GameOver: освобождение фигур
+  s21::GameFabric::destroy_game(wide);
+}
+
+// tests for compile-time piece sets (pieces.h)
+static_assert(s21::StandardPieces::table.rotate_size[1] == 5, "Hero rotates in a 5x5 matrix"); // посчитано при компиляции
+static_assert(!s21::StandardPieces::table.rotates[2], "Smashboy does not rotate");
+static_assert(!s21::PentominoPieces::table.rotates[9], "X pentomino does not rotate");
+
+using PentominoTetris = s21::TetrisGame<s21::StandardBoard, s21::PentominoPieces>;
+
+// Вспомогательная функция: номера клеток фигуры по возрастанию (поворот меняет порядок блоков)
+static std::vector<int> sorted_cells(const int* brick, int size) {
+  std::vector<int> cells;
+  for (int i = 0; i < size; i += 2) cells.push_back(brick[i] * WINDOW_WIDTH + brick[i + 1]);
+  std::sort(cells.begin(), cells.end());
+  return cells;
+}
+
+// Вспомогательная функция: четыре поворота каждой фигуры набора в центре пустого поля возвращают её на место
+template <class Engine, class Pieces>
+static void expect_rotations_cycle(Engine& tetris) {
+  const int size = 2 * Pieces::cells; // размер описания фигуры
+  for (int piece = 1; piece <= Pieces::count; piece++) { // проход по фигурам набора
+    int brick[2 * PIECE_MAX_CELLS] = {0}; // координаты фигуры
+    int start[2 * PIECE_MAX_CELLS] = {0}; // исходное положение
+    tetris.new_brick(brick, piece); // фигура в положении появления
+    tetris.coord_shift(brick, 0, 8); // в середину поля, вдали от стен
+    memcpy(start, brick, sizeof(int) * size);
+    for (int r = 0; r < PIECE_ROTATIONS; r++) { // четыре поворота
+      EXPECT_EQ(Pieces::table.piece_of(brick), piece - 1); // фигура узнаётся в любом повороте
+      tetris.brick_move(brick, Action, tetris.gameinfo.field); // поворот по правилам игры
+    }
+    EXPECT_EQ(sorted_cells(start, size), sorted_cells(brick, size)) << "piece " << piece; // полный оборот
+  }
+}
+
+TEST(tetris_pieces, standard_table_matches_legacy_templates) { // тест: таблица набора совпадает с прежними шаблонами фигур
+  const int legacy[7][BRICK_SIZE] = {
+      {1, 4, 1, 3, 0, 4, 1, 5}, {0, 5, 0, 4, 0, 3, 0, 6}, {0, 4, 0, 5, 1, 4, 1, 5}, {1, 4, 1, 3, 1, 5, 0, 5},
+      {1, 4, 0, 3, 1, 3, 1, 5}, {1, 4, 0, 3, 0, 4, 1, 5}, {1, 4, 1, 3, 0, 4, 0, 5}}; // TEEWEE ... RHODE_ISLAND_Z
+  for (int p = 0; p < 7; p++) {
+    for (int i = 0; i < BRICK_SIZE; i++) EXPECT_EQ(s21::StandardPieces::table.spawn[p][i], legacy[p][i]);
+    EXPECT_EQ(s21::StandardPieces::table.rotate_size[p], p == 1 ? 5 : 3); // Hero — 5, остальные — 3
+    EXPECT_EQ(s21::StandardPieces::table.rotates[p], p != 2); // не поворачивается только Smashboy
+  }
+  int far[BRICK_SIZE] = {0, 0, 0, 3, 0, 4, 0, 5}; // блоки не из набора
+  EXPECT_EQ(s21::StandardPieces::table.piece_of(far), -1);
+}
+
+TEST(tetris_pieces, rotations_cycle_for_every_set) { // тест: каждая фигура каждого набора возвращается после полного оборота
+  Tetris standard; // стандартный набор
+  expect_rotations_cycle<Tetris, s21::StandardPieces>(standard);
+  PentominoTetris pentomino; // пентамино
+  expect_rotations_cycle<PentominoTetris, s21::PentominoPieces>(pentomino);
+  s21::TetrisGame<s21::StandardBoard, s21::TrainingPieces> training; // тренировочный набор
+  expect_rotations_cycle<s21::TetrisGame<s21::StandardBoard, s21::TrainingPieces>, s21::TrainingPieces>(training);
+}
+
+TEST(tetris_pieces, pentomino_game_plays_to_game_over) { // тест: партия из пентамино через create_game
+  RecordGuard guard("tetris_data.bin");
+  srand(32); // воспроизводимая последовательность
+  PentominoTetris* game = dynamic_cast<PentominoTetris*>(s21::GameFabric::create_game(
+      s21::GameFabric::GameName::Tetris, WINDOW_HEIGHT, WINDOW_WIDTH, s21::GameFabric::PieceSet::Pentomino));
+  ASSERT_NE(game, nullptr);
+  game->set_user_action(Start);
+  game->fsm(); // GameStart -> Spawn
+  const UserAction_t moves[] = {Left, Right, Action, Action, Down, Up};
+  int ghost[GHOST_SIZE];
+  int steps = 0;
+  while (game->statemachine != Tetris::GameOver && steps++ < 200000) {
+    if (game->statemachine == Tetris::Spawn) expect_counters_match_field(*game); // счётчики совпадают с полем
+    if (game->statemachine == Tetris::Moving) {
+      EXPECT_GE(PentominoTetris::brick_size, 10); // пять блоков в фигуре
+      EXPECT_GE(s21::PentominoPieces::table.piece_of(game->current_brick), 0); // фигура остаётся фигурой набора
+      ASSERT_TRUE(game->ghost(ghost)); // тень из пяти блоков
+      int stepped[2 * PIECE_MAX_CELLS]; // ожидаемая тень — пошаговый спуск
+      memcpy(stepped, game->current_brick, sizeof(stepped));
+      game->despawn(game->gameinfo.field, stepped);
+      while (game->check_down(game->gameinfo.field, stepped)) game->coord_shift(stepped, 0, 1);
+      game->spawn_brick(game->gameinfo.field, game->current_brick, game->current_color);
+      for (int i = 0; i < GHOST_SIZE; i++) ASSERT_EQ(ghost[i], stepped[i]);
+      game->set_user_action(moves[rand() % 6]);
+    }
+    game->fsm();
+  }
+  EXPECT_EQ(game->statemachine, Tetris::GameOver);
+  game->fsm(); // GameOver: освобождение фигур
+  s21::GameFabric::destroy_game(game);
+}
+
+TEST(tetris_engine, step_all_matches_virtual_fsm) { // тест: пакетный шаг движка совпадает с шагом через Game::fsm
+  Tetris* a = dynamic_cast<Tetris*>(s21::GameFabric::create_game(s21::GameFabric::GameName::Tetris, WINDOW_HEIGHT, WINDOW_WIDTH));
+  Tetris* b = dynamic_cast<Tetris*>(s21::GameFabric::create_game(s21::GameFabric::GameName::Tetris, WINDOW_HEIGHT, WINDOW_WIDTH));
+  ASSERT_NE(a, nullptr);
+  ASSERT_NE(b, nullptr);
+  a->keep_record = b->keep_record = false; // рекорд в файл не пишется
+  a->set_user_action(Start);
+  a->fsm(); // GameStart -> Spawn
+  ASSERT_TRUE(b->restore(a->snapshot().data(), a->snapshot_size())); // тот же генератор фигур и то же поле
+  const UserAction_t moves[] = {Down, Down, Down, Up}; // ходы без зависимости от таймера
+  Tetris* const batch[] = {b}; // пакет из одной сессии
+  int steps = 0;
+  while (a->statemachine != Tetris::GameOver && steps < 100000) {
+    UserAction_t move = moves[steps++ % 4];
+    a->set_user_action(move);
+    b->set_user_action(move);
+    a->fsm(); // виртуальный вызов run_state
+    Tetris::step_all(batch, 1); // прямой вызов обработчиков
+    ASSERT_EQ(a->statemachine, b->statemachine) << "step " << steps;
+    ASSERT_EQ(a->get_gameinfo().score, b->get_gameinfo().score) << "step " << steps;
+  }
+  for (int i = 0; i < WINDOW_HEIGHT; i++) // партии совпали до конца (снимки отличаются временем таймера)
+    for (int j = 0; j < WINDOW_WIDTH; j++) EXPECT_EQ(a->get_gameinfo().field[i][j], b->get_gameinfo().field[i][j]);
+  EXPECT_EQ(b->statemachine, Tetris::GameOver);
+  a->fsm(); // GameOver: освобождение фигур
+  b->step();
+  s21::GameFabric::destroy_game(a);
+  s21::GameFabric::destroy_game(b);
+}
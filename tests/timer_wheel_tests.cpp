@@ -0,0 +1,95 @@
+// tests/timer_wheel_tests.cpp
+#include <gtest/gtest.h> // подключает фреймворк Google Test для определения тестов и макросов EXPECT_*
+#include <random> // подключает std::mt19937 для случайных сроков
+#include <vector> // подключает std::vector для ожидаемого порядка
+
+#include "../brick_game/timer_wheel.h" // подключаем колесо таймеров
+
+#define T0 1000000000ULL // время создания колеса в микросекундах
+
+static std::vector<uint32_t> drain(s21::TimerWheel* wheel) { // все готовые таймеры по порядку
+  std::vector<uint32_t> tags;
+  uint32_t tag = 0;
+  while (wheel->pop(&tag)) tags.push_back(tag);
+  return tags;
+}
+
+TEST(timer_wheel, fires_at_deadline_not_before) { // тест: срок на любом уровне срабатывает ровно в свой тик
+  s21::TimerWheel wheel(T0);
+  const uint64_t delays_ms[] = {1, 63, 64, 65, 4095, 4096, 4097, 300000, 20000000}; // уровни 0..3 и дальше колеса
+  std::vector<uint32_t> timers;
+  for (uint32_t i = 0; i < sizeof(delays_ms) / sizeof(delays_ms[0]); i++) {
+    timers.push_back(wheel.create(i));
+    wheel.schedule(timers.back(), T0 + delays_ms[i] * 1000);
+  }
+  for (uint32_t i = 0; i < timers.size(); i++) {
+    uint64_t deadline = T0 + delays_ms[i] * 1000;
+    EXPECT_EQ(wheel.advance(deadline - 1000), 0u) << delays_ms[i]; // за тик до срока таймер ещё ждёт
+    EXPECT_EQ(wheel.advance(deadline), 1u) << delays_ms[i]; // в тик срока — готов
+    uint32_t tag = 0;
+    uint64_t fired = 0;
+    ASSERT_TRUE(wheel.pop(&tag, &fired));
+    EXPECT_EQ(tag, i);
+    EXPECT_EQ(fired, deadline);
+  }
+  EXPECT_EQ(wheel.size(), 0u);
+}
+
+TEST(timer_wheel, due_timers_pop_earliest_first) { // тест: готовые таймеры выдаются по возрастанию срока
+  s21::TimerWheel wheel(T0);
+  std::mt19937 gen(7);
+  const uint32_t count = 5000;
+  std::vector<uint64_t> deadline(count);
+  for (uint32_t i = 0; i < count; i++) {
+    deadline[i] = T0 + gen() % 10000000; // до 10 секунд
+    wheel.schedule(wheel.create(i), deadline[i]);
+  }
+  uint64_t now = T0;
+  uint64_t last = 0;
+  size_t fired = 0;
+  while (fired < count) {
+    now += 37000; // хозяин опаздывает на десятки тиков
+    wheel.advance(now);
+    uint32_t tag = 0;
+    uint64_t when = 0;
+    for (int budget = 50; budget > 0 && wheel.pop(&tag, &when); budget--, fired++) { // перегрузка: не больше 50 за тик
+      EXPECT_GE(when, last); // порядок сроков не нарушается и между тиками
+      EXPECT_LE(deadline[tag], now); // раньше срока не срабатывает
+      EXPECT_LE(when - deadline[tag], 999u); // срок округлён вверх до тика
+      last = when;
+    }
+  }
+  EXPECT_EQ(wheel.size(), 0u);
+}
+
+TEST(timer_wheel, reschedule_cancel_and_release) { // тест: перенос, отмена и переиспользование таймера
+  s21::TimerWheel wheel(T0);
+  uint32_t a = wheel.create(10), b = wheel.create(20), c = wheel.create(30);
+  wheel.schedule(a, T0 + 5000);
+  wheel.schedule(b, T0 + 3000);
+  wheel.schedule(c, T0 + 70000);
+  wheel.schedule(a, T0 + 1000); // перенос раньше
+  wheel.cancel(c); // отмена
+  EXPECT_FALSE(wheel.pending(c));
+  EXPECT_EQ(wheel.size(), 2u);
+  wheel.advance(T0 + 100000);
+  EXPECT_EQ(drain(&wheel), std::vector<uint32_t>({10, 20}));
+
+  wheel.schedule(b, T0 + 200000);
+  wheel.advance(T0 + 200000);
+  wheel.release(b); // удаление готового таймера
+  EXPECT_EQ(wheel.ready(), 0u);
+  EXPECT_EQ(wheel.create(40), b); // номер переиспользуется
+  wheel.schedule(a, T0); // прошедший срок — сразу готов
+  EXPECT_EQ(drain(&wheel), std::vector<uint32_t>({10}));
+}
+
+TEST(timer_wheel, idle_timers_cost_nothing) { // тест: далёкие сроки не срабатывают и не выдаются
+  s21::TimerWheel wheel(T0);
+  for (uint32_t i = 0; i < 100000; i++) wheel.schedule(wheel.create(i), T0 + 3600000000ULL); // через час
+  uint32_t near = wheel.create(7);
+  wheel.schedule(near, T0 + 10000);
+  EXPECT_EQ(wheel.advance(T0 + 20000), 1u); // готов только ближний таймер
+  EXPECT_EQ(drain(&wheel), std::vector<uint32_t>({7}));
+  EXPECT_EQ(wheel.size(), 100000u);
+}
@@ -0,0 +1,104 @@
+// tests/trace_tests.cpp
+#include <gtest/gtest.h> // подключает фреймворк Google Test для определения тестов и макросов EXPECT_*
+#include <fstream> // подключает std::ifstream для чтения файла трассы
+#include <sstream> // подключает std::stringstream для чтения файла целиком
+#include <string> // подключает std::string для содержимого трассы
+#include <thread> // подключает std::thread для интервалов нескольких потоков
+#include <vector> // подключает std::vector для списка потоков
+
+// Сделать private/protected публичными для тестов — обязательно до включения заголовков
+#define private public // временно переопределяем private на public чтобы тесты могли создать экземпляр
+#define protected public // временно переопределяем protected на public для доступа к состоянию КА
+#include "../brick_game/trace.h" // подключаем запись трассы
+#include "../brick_game/tetris/tetris.h" // подключаем тетрис
+#undef private // восстанавливаем оригинальное значение private
+#undef protected // восстанавливаем оригинальное значение protected
+#include "tests.h" // подключаем RecordGuard
+
+#define TRACE_TEST_FILE "trace_test.json" // временный файл трассы
+
+static std::string read_trace() { // содержимое файла трассы
+  std::ifstream input(TRACE_TEST_FILE);
+  std::stringstream buffer;
+  buffer << input.rdbuf();
+  return buffer.str();
+}
+
+static size_t count_of(const std::string& text, const std::string& what) { // число вхождений подстроки
+  size_t count = 0;
+  for (size_t pos = text.find(what); pos != std::string::npos; pos = text.find(what, pos + what.size())) count++;
+  return count;
+}
+
+TEST(trace, disabled_without_path) { // тест: без пути запись не начинается, интервалы ничего не пишут
+  EXPECT_FALSE(traceStart(nullptr));
+  EXPECT_FALSE(s21::trace_enabled.load());
+  { TRACE_SCOPE("test.ignored"); }
+  traceStop(); // остановка без записи ничего не делает
+}
+
+TEST(trace, spans_of_all_threads_are_written) { // тест: события потоков, в том числе завершившихся, попадают в JSON
+  unsigned long long dropped = traceDropped();
+  ASSERT_TRUE(traceStart(TRACE_TEST_FILE));
+  EXPECT_FALSE(traceStart(TRACE_TEST_FILE)); // запись уже идёт
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 3; t++) {
+    threads.emplace_back([] {
+      for (int i = 0; i < 100; i++) TRACE_SCOPE("test.worker"); // интервалы потока
+    });
+  }
+  for (std::thread& thread : threads) thread.join(); // буферы завершившихся потоков дописываются потоком записи
+  {
+    TRACE_SCOPE("test.outer");
+    TRACE_SCOPE("test.inner");
+  }
+  traceStop();
+  { TRACE_SCOPE("test.after_stop"); } // после остановки не пишется
+
+  std::string json = read_trace();
+  EXPECT_EQ(json.rfind("{\"traceEvents\":[", 0), 0u); // начало объекта
+  EXPECT_NE(json.find("]"), std::string::npos);
+  EXPECT_EQ(count_of(json, "\"name\":\"test.worker\""), 300u);
+  EXPECT_EQ(count_of(json, "\"name\":\"test.outer\""), 1u);
+  EXPECT_EQ(count_of(json, "\"name\":\"test.inner\""), 1u);
+  EXPECT_EQ(count_of(json, "test.after_stop"), 0u);
+  EXPECT_EQ(count_of(json, "\"ph\":\"X\""), 302u);
+  EXPECT_EQ(count_of(json, "},\n{"), 301u); // события разделены запятыми
+  EXPECT_EQ(traceDropped(), dropped);
+  remove(TRACE_TEST_FILE);
+}
+
+TEST(trace, full_ring_drops_events) { // тест: переполненный буфер потока отбрасывает события и считает их
+  unsigned long long dropped = traceDropped();
+  ASSERT_TRUE(traceStart(TRACE_TEST_FILE));
+  std::thread([] {
+    for (int i = 0; i < TRACE_RING_SIZE * 4; i++) TRACE_SCOPE("test.flood"); // быстрее периода записи
+  }).join();
+  traceStop();
+  std::string json = read_trace();
+  unsigned long long written = count_of(json, "test.flood");
+  EXPECT_GE(written, (unsigned long long)TRACE_RING_SIZE); // как минимум один полный буфер
+  EXPECT_EQ(written + traceDropped() - dropped, (unsigned long long)TRACE_RING_SIZE * 4); // ничего не потеряно без учёта
+  remove(TRACE_TEST_FILE);
+}
+
+TEST(trace, engine_states_are_traced) { // тест: шаги КА и поворот попадают в трассу
+  RecordGuard guard("tetris_data.bin");
+  ASSERT_TRUE(traceStart(TRACE_TEST_FILE));
+  {
+    s21::Tetris tetris; // отдельный экземпляр
+    tetris.set_user_action(Start);
+    tetris.fsm(); // GameStart
+    tetris.fsm(); // Spawn
+    tetris.set_user_action(Action);
+    tetris.fsm(); // Moving: поворот
+  }
+  traceStop();
+  std::string json = read_trace();
+  EXPECT_EQ(count_of(json, "\"name\":\"fsm.GameStart\""), 1u);
+  EXPECT_EQ(count_of(json, "\"name\":\"fsm.Spawn\""), 1u);
+  EXPECT_EQ(count_of(json, "\"name\":\"fsm.Moving\""), 1u);
+  EXPECT_GE(count_of(json, "\"name\":\"tetris.rotate\""), 1u);
+  EXPECT_EQ(count_of(json, "\"name\":\"tetris.init_score\""), 1u);
+  remove(TRACE_TEST_FILE);
+}
@@ -0,0 +1,130 @@
+// tests/versus_tests.cpp
+#include <gtest/gtest.h> // подключает фреймворк Google Test для определения тестов и макросов EXPECT_*
+#include <set> // подключает std::set для проверки уникальности мест
+#include <thread> // подключает std::thread для одновременной записи в очередь
+
+// Сделать private/protected публичными для тестов — обязательно до включения заголовков
+#define private public // временно переопределяем private на public чтобы тесты могли обращаться к внутренним методам
+#define protected public // временно переопределяем protected на public для доступа к состоянию КА
+#include "../brick_game/tetris/versus.h" // подключаем матч соперничества вместе с классом Tetris
+#include "../brick_game/zobrist.h" // подключаем полный пересчёт хэша поля
+#undef private // восстанавливаем оригинальное значение private
+#undef protected // восстанавливаем оригинальное значение protected
+
+using s21::GarbageInbox; // импортируем имя очереди мусора
+using s21::GarbagePacket; // импортируем имя пакета мусора
+using s21::Tetris; // импортируем имя класса Tetris
+using s21::VersusMatch; // импортируем имя матча
+
+TEST(tetris_versus, inbox_keeps_packets_from_many_writers) { // тест: очередь без блокировок не теряет пакеты писателей
+  GarbageInbox inbox; // очередь
+  const int writers = 4, per_writer = 5000; // четыре потока по 5000 пакетов
+  std::vector<std::thread> pool;
+  for (int w = 0; w < writers; w++) {
+    pool.emplace_back([&inbox, w] {
+      for (int i = 0; i < per_writer; i++)
+        while (!inbox.push(GarbagePacket{1, i, w})) std::this_thread::yield(); // ждём, пока читатель освободит место
+    });
+  }
+  std::vector<int> last(writers, -1); // последний номер пакета от каждого писателя
+  int received = 0;
+  GarbagePacket packet;
+  while (received < writers * per_writer) {
+    if (inbox.pop(&packet)) {
+      EXPECT_EQ(packet.hole, last[packet.sender] + 1); // пакеты одного писателя приходят по порядку
+      last[packet.sender] = packet.hole;
+      received++;
+    }
+  }
+  for (auto& thread : pool) thread.join();
+  EXPECT_FALSE(inbox.pop(&packet)); // лишних пакетов нет
+
+  for (int i = 0; i < GARBAGE_QUEUE_SIZE; i++) EXPECT_TRUE(inbox.push(GarbagePacket{1, 0, 0}));
+  EXPECT_FALSE(inbox.push(GarbagePacket{1, 0, 0})); // очередь заполнена
+}
+
+TEST(tetris_versus, add_garbage_raises_field_and_counters) { // тест: мусор поднимает поле и обновляет счётчики
+  Tetris tetris; // отдельный экземпляр
+  tetris.gameinfo.field[WINDOW_HEIGHT - 1][0] = 3; // один блок на дне
+  tetris.gameinfo.field[WINDOW_HEIGHT - 4][6] = 5; // и блок выше, через пустую строку
+  tetris.counters_init();
+  tetris.hash_init();
+  EXPECT_TRUE(tetris.add_garbage(2, 4, GARBAGE_COLOR)); // две строки с дыркой в столбце 4
+  EXPECT_EQ(tetris.field_hash, s21::zobrist_matrix(ZOBRIST_FIELD, tetris.gameinfo.field, WINDOW_HEIGHT, WINDOW_WIDTH)); // хэш сдвинут без пересчёта
+  EXPECT_EQ(tetris.gameinfo.field[WINDOW_HEIGHT - 3][0], 3); // блок поднялся на две строки
+  for (int y = WINDOW_HEIGHT - 2; y < WINDOW_HEIGHT; y++) {
+    EXPECT_EQ(tetris.row_fill[y], WINDOW_WIDTH - 1);
+    EXPECT_EQ(tetris.gameinfo.field[y][4], 0); // дырка
+    EXPECT_EQ(tetris.gameinfo.field[y][5], GARBAGE_COLOR);
+  }
+  EXPECT_EQ(tetris.row_fill[WINDOW_HEIGHT - 3], 1);
+  EXPECT_EQ(tetris.column_height[0], 3);
+  EXPECT_EQ(tetris.column_height[4], 0); // над дыркой пусто
+  EXPECT_EQ(tetris.column_height[5], 2);
+
+  tetris.gameinfo.field[1][7] = 3; // блок у верха поля
+  tetris.counters_init();
+  tetris.hash_init();
+  EXPECT_FALSE(tetris.add_garbage(2, 0, GARBAGE_COLOR)); // блок вытолкнут за верх
+  EXPECT_EQ(tetris.field_hash, s21::zobrist_matrix(ZOBRIST_FIELD, tetris.gameinfo.field, WINDOW_HEIGHT, WINDOW_WIDTH)); // вытолкнутый блок ушёл из хэша
+}
+
+TEST(tetris_versus, clear_sends_garbage_to_target) { // тест: тетрис одного поля превращается в четыре строки мусора у соперника
+  VersusMatch match(2, VersusMatch::Targeting::Cyclic, 1);
+  Tetris* attacker = match.board_list[0]->game;
+  Tetris* victim = match.board_list[1]->game;
+  attacker->lines_cleared = 4; // прикрепившаяся фигура удалила четыре строки
+  match.on_lock(0);
+  EXPECT_EQ(match.lines_sent(0), 4);
+
+  match.on_lock(1); // соперник прикрепил фигуру без удаления строк
+  EXPECT_EQ(match.lines_received(1), 4);
+  int garbage = 0;
+  for (int y = 0; y < WINDOW_HEIGHT; y++)
+    for (int x = 0; x < WINDOW_WIDTH; x++) garbage += victim->gameinfo.field[y][x] == GARBAGE_COLOR;
+  EXPECT_EQ(garbage, 4 * (WINDOW_WIDTH - 1)); // четыре строки с дыркой
+
+  attacker->lines_cleared = 7; // следующая фигура удалила три строки: атака двумя строками
+  match.on_lock(0);
+  victim->lines_cleared = 2; // соперник удалил две строки: атака в одну строку гасит одну из двух
+  match.on_lock(1);
+  EXPECT_EQ(match.lines_sent(1), 0); // атака ушла на гашение
+  EXPECT_EQ(match.lines_received(1), 4); // при удалении строк мусор не вставляется
+  ASSERT_EQ(match.board_list[1]->pending.size(), 1u);
+  EXPECT_EQ(match.board_list[1]->pending.front().rows, 1); // осталась одна строка
+}
+
+TEST(tetris_versus, seed_fixes_piece_order) { // тест: одинаковое зерно — одинаковые фигуры на каждом поле
+  srand(1);
+  VersusMatch first(3, VersusMatch::Targeting::Cyclic, 9);
+  srand(2); // последовательность rand не влияет на фигуры матча
+  VersusMatch second(3, VersusMatch::Targeting::Cyclic, 9);
+  for (int i = 0; i < first.boards(); i++) {
+    Tetris* a = first.board_list[i]->game;
+    Tetris* b = second.board_list[i]->game;
+    EXPECT_EQ(a->start_seed, b->start_seed);
+    EXPECT_TRUE(a->rng == b->rng) << "board " << i; // генератор фигур в том же состоянии
+    for (int y = 0; y < NEXT_SIZE; y++)
+      for (int x = 0; x < NEXT_SIZE; x++) EXPECT_EQ(a->gameinfo.next[y][x] != 0, b->gameinfo.next[y][x] != 0);
+  }
+  EXPECT_NE(first.board_list[0]->game->start_seed, first.board_list[1]->game->start_seed); // у полей свои зёрна
+}
+
+TEST(tetris_versus, hundred_boards_play_to_one_winner) { // тест: сто полей в четырёх потоках доигрывают до одного победителя
+  srand(33); // воспроизводимая последовательность фигур
+  VersusMatch match(100, VersusMatch::Targeting::Random, 33);
+  match.run(4, 1000000);
+  EXPECT_LE(match.alive(), 1); // два последних поля могут выбыть одновременно в разных потоках
+  int winner = match.winner();
+  ASSERT_GE(winner, 0);
+  std::set<int> places; // места выбывших
+  long sent = 0, received = 0;
+  for (int i = 0; i < match.boards(); i++) {
+    if (i != winner) places.insert(match.place(i)); // у победителя место 0 (или 1 при одновременном выбывании)
+    sent += match.lines_sent(i);
+    received += match.lines_received(i);
+  }
+  EXPECT_EQ(places.size(), 99u); // места различны
+  EXPECT_EQ(*places.rbegin(), 100); // до сотого
+  EXPECT_LE(received, sent); // вставлено не больше отправленного
+}
@@ -0,0 +1,145 @@
+// tests/zobrist_tests.cpp
+#include <gtest/gtest.h> // подключает фреймворк Google Test для определения тестов и макросов EXPECT_*
+#include <atomic> // подключает счётчик ошибок потоков
+#include <cstdlib> // подключает srand и rand для воспроизводимой партии
+#include <memory> // подключает std::unique_ptr для перебора положений
+#include <thread> // подключает std::thread для одновременной записи в таблицу
+#include <vector> // подключает std::vector для потоков
+
+// Сделать private/protected публичными для тестов — обязательно до включения заголовка tetris.h
+#define private public // временно переопределяем private на public чтобы тесты могли читать хэши движка
+#define protected public // временно переопределяем protected на public для доступа к состоянию КА
+#include "../brick_game/tetris/placement.h" // подключаем перебор положений (и Tetris), теперь с раскрытыми модификаторами доступа
+#undef private // восстанавливаем оригинальное значение private
+#undef protected // восстанавливаем оригинальное значение protected
+#include "../brick_game/transposition.h" // подключаем таблицу транспозиций
+
+// Вспомогательная функция: хэши, которые движок ведёт по ходу игры, совпадают с полным пересчётом
+template <class Engine>
+static void expect_hashes_match_field(Engine& tetris) {
+  ASSERT_EQ(tetris.field_hash, s21::zobrist_matrix(ZOBRIST_FIELD, tetris.gameinfo.field, tetris.board.height(), tetris.board.width()));
+  ASSERT_EQ(tetris.next_hash, s21::zobrist_matrix(ZOBRIST_NEXT, tetris.gameinfo.next, NEXT_SIZE, NEXT_SIZE));
+  if (tetris.statemachine == s21::Game::Spawn) { // фигура легла — хэш движка совпадает с пересчётом Game
+    EXPECT_EQ(tetris.state_hash(), tetris.s21::Game::state_hash());
+  }
+}
+
+// Вспомогательная функция: путь ввода к самому низкому положению фигуры, которое достигается без подсовывания
+static int lowest_drop_path(s21::PlacementFinder* finder, UserAction_t* path) {
+  int best = -1, best_depth = -1, length = 0; // лучшее положение, сумма его Y и длина пути
+  for (int i = 0; i < finder->find_current(); i++) {
+    UserAction_t candidate[PLACEMENT_STATES];
+    int n = finder->path(i, candidate, PLACEMENT_STATES), k = 0;
+    while (k < n && candidate[k] != Down) k++; // сдвиги и повороты
+    bool plain = true; // после первого Down только опускание — путь равен сбросу
+    for (int j = k; j < n; j++) plain = plain && candidate[j] == Down;
+    int depth = 0;
+    for (int j = 0; j < BRICK_SIZE; j += 2) depth += finder->get(i).brick[j];
+    if (plain && depth > best_depth) best = i, best_depth = depth, length = k;
+  }
+  if (best >= 0) finder->path(best, path, PLACEMENT_STATES);
+  return best >= 0 ? length : 0; // сдвиги и повороты до сброса
+}
+
+TEST(zobrist, incremental_hash_matches_full_recount) { // тест: хэш поля через движения, удаление строк и мусор
+  srand(46); // воспроизводимые партии
+  UserAction_t path[PLACEMENT_STATES]; // ввод текущей фигуры
+  int cleared = 0; // удалённые строки всех партий
+  for (int round = 0; round < 2; round++) { // две партии
+    s21::Tetris* game = dynamic_cast<s21::Tetris*>(s21::GameFabric::create_game(s21::GameFabric::GameName::Tetris, WINDOW_HEIGHT, WINDOW_WIDTH));
+    ASSERT_NE(game, nullptr);
+    std::unique_ptr<s21::PlacementFinder> finder(new s21::PlacementFinder(game)); // бот кладёт фигуры пониже, чтобы строки удалялись
+    game->keep_record = false; // рекорд в файл не пишется
+    game->set_user_action(Start);
+    int steps = 0, length = -1, next = 0; // length < 0 — путь фигуры ещё не построен
+    while (game->statemachine != s21::Game::GameOver && steps++ < 2000) {
+      if (game->statemachine == s21::Game::Spawn) {
+        length = -1; // новая фигура
+        if (steps % 13 == 0) game->add_garbage(1, rand() % WINDOW_WIDTH, 8); // мусор снизу
+      }
+      if (game->statemachine == s21::Game::Moving) {
+        if (length < 0) length = lowest_drop_path(finder.get(), path), next = 0; // путь от места появления
+        game->set_user_action(next < length ? path[next++] : Down); // сдвиги, повороты и сброс
+      }
+      game->fsm();
+      expect_hashes_match_field(*game);
+    }
+    cleared += game->lines_cleared;
+    s21::GameFabric::destroy_game(game);
+  }
+  EXPECT_GT(cleared, 0); // удаление строк проверено
+}
+
+TEST(zobrist, equal_states_hash_equal_across_sessions) { // тест: копия сессии из снимка даёт тот же хэш, ход — другой
+  s21::Tetris* a = dynamic_cast<s21::Tetris*>(s21::GameFabric::create_game(s21::GameFabric::GameName::Tetris, WINDOW_HEIGHT, WINDOW_WIDTH));
+  s21::Tetris* b = dynamic_cast<s21::Tetris*>(s21::GameFabric::create_game(s21::GameFabric::GameName::Tetris, WINDOW_HEIGHT, WINDOW_WIDTH));
+  a->keep_record = b->keep_record = false;
+  a->set_user_action(Start);
+  a->fsm(); // GameStart -> Spawn
+  a->fsm(); // Spawn -> Moving
+  EXPECT_NE(a->state_hash(), b->state_hash()); // партия идёт только в a
+  ASSERT_TRUE(b->restore(a->snapshot().data(), a->snapshot_size()));
+  EXPECT_EQ(a->state_hash(), b->state_hash()); // то же состояние в другой сессии
+  uint64_t before = a->state_hash();
+  a->set_user_action(Left);
+  a->fsm(); // фигура сдвинулась
+  EXPECT_NE(a->state_hash(), before);
+  a->set_user_action(Right);
+  a->fsm(); // фигура вернулась
+  EXPECT_EQ(a->state_hash(), b->state_hash()); // хэш не зависит от пути к состоянию
+  s21::GameFabric::destroy_game(a);
+  s21::GameFabric::destroy_game(b);
+}
+
+TEST(zobrist, scratch_matrices_leave_hashes_alone) { // тест: хэш ведётся по явному пространству ключей, а не по адресу матрицы
+  s21::Tetris tetris;
+  tetris.keep_record = false;
+  int brick[BRICK_SIZE] = {2, 4, 2, 5, 3, 4, 3, 5}; // квадрат
+  int** scratch = tetris.init_matrix(NULL, WINDOW_HEIGHT, WINDOW_WIDTH); // матрица вне сессии
+  uint64_t field = tetris.field_hash, next = tetris.next_hash;
+  tetris.spawn_brick(scratch, brick, 3); // без пространства ключей
+  for (int y = 2; y < WINDOW_HEIGHT; y++) for (int x = 0; x < WINDOW_WIDTH; x++) scratch[y][x] = 1;
+  EXPECT_GT(tetris.remove_full_rows(scratch, NULL, false), 0);
+  EXPECT_EQ(tetris.field_hash, field);
+  EXPECT_EQ(tetris.next_hash, next);
+  tetris.spawn_brick(tetris.gameinfo.field, brick, 3, ZOBRIST_FIELD); // клетки поля игры
+  EXPECT_EQ(tetris.field_hash, s21::zobrist_matrix(ZOBRIST_FIELD, tetris.gameinfo.field, tetris.board.height(), tetris.board.width()));
+  tetris.despawn(tetris.gameinfo.field, brick, ZOBRIST_FIELD);
+  EXPECT_EQ(tetris.field_hash, field);
+  tetris.free_memory_matrix(scratch, WINDOW_HEIGHT);
+}
+
+TEST(transposition_table, probe_store_and_collisions) { // тест: запись, промах и замещение в слоте
+  s21::TranspositionTable table(4); // 16 записей
+  EXPECT_EQ(table.capacity(), 16u);
+  uint64_t value = 0;
+  EXPECT_FALSE(table.probe(0, &value)); // пустой слот не совпадает с хэшем пустого поля
+  table.store(0x1234, 77);
+  ASSERT_TRUE(table.probe(0x1234, &value));
+  EXPECT_EQ(value, 77u);
+  EXPECT_FALSE(table.probe(0x1234 + 16, &value)); // тот же слот, другой ключ
+  table.store(0x1234 + 16, 5); // замещение
+  EXPECT_FALSE(table.probe(0x1234, &value));
+  table.clear();
+  EXPECT_FALSE(table.probe(0x1234 + 16, &value));
+  EXPECT_THROW(s21::TranspositionTable(TT_MAX_BITS + 1), std::invalid_argument);
+}
+
+TEST(transposition_table, concurrent_writers_never_return_foreign_values) { // тест: разорванные записи выглядят как промахи
+  s21::TranspositionTable table(6); // маленькая таблица — потоки постоянно пишут в одни слоты
+  std::atomic<int> wrong{0}; // найденные чужие значения
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([&table, &wrong, t] {
+      for (uint64_t i = 0; i < 200000; i++) {
+        uint64_t key = s21::zobrist_key(ZOBRIST_FIELD, i * 4 + t); // ключ потока
+        table.store(key, key * 3 + 1); // значение восстанавливается по ключу
+        uint64_t probe_key = s21::zobrist_key(ZOBRIST_FIELD, (i * 7 + 3 * t) % 800000); // ключ любого потока
+        uint64_t value = 0;
+        if (table.probe(probe_key, &value) && value != probe_key * 3 + 1) wrong++; // чужое значение
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  EXPECT_EQ(wrong.load(), 0);
+}
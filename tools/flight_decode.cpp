@@ -0,0 +1,29 @@
+#include <stdio.h> // подключает fopen и fprintf для чтения файла и вывода
+
+#include <stdexcept> // подключает std::invalid_argument для повреждённого дампа
+#include <vector> // подключает std::vector для содержимого файла
+
+#include "../brick_game/flight.h" // подключает декодер дампов журналов сессий
+
+int main(int argc, char** argv) { // точка входа: FlightDecode [файл], по умолчанию FLIGHT_DUMP_FILE
+  const char* path = argc > 1 ? argv[1] : FLIGHT_DUMP_FILE; // файл дампов
+  FILE* file = fopen(path, "rb"); // открываем файл дампов
+  if (!file) { // файла нет
+    fprintf(stderr, "FlightDecode: cannot open %s\n", path); // сообщение об ошибке
+    return 1; // код ошибки
+  } // конец проверки открытия
+  std::vector<uint8_t> dump; // содержимое файла
+  uint8_t chunk[4096]; // блок чтения
+  size_t read = 0; // прочитано байт в блоке
+  while ((read = fread(chunk, 1, sizeof(chunk), file)) > 0) dump.insert(dump.end(), chunk, chunk + read); // файл целиком
+  fclose(file); // закрываем файл
+
+  int res = 0; // код завершения
+  try { // дамп может быть обрезан падением процесса
+    fputs(s21::flight_decode(dump.data(), dump.size()).c_str(), stdout); // текст дампов
+  } catch (const std::invalid_argument& e) { // повреждённый дамп
+    fprintf(stderr, "FlightDecode: %s\n", e.what()); // сообщение об ошибке
+    res = 1; // код ошибки
+  } // конец обработки ошибок
+  return res; // код завершения
+} // конец main